@@ -1030,6 +1030,27 @@ TEST (active_transactions, restart_dropped)
 	ASSERT_TIMELY (5s, node.ledger.cache.cemented_count == 2);
 }
 
+// Rewriting the work of a ledger block drops the cached RPC responses built from it
+TEST (active_transactions, restart_dropped_response_cache)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.rpc_response_cache_size = 16;
+	auto & node = *system.add_node (node_config);
+	nano::genesis genesis;
+	auto send (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::xrb_ratio, nano::test_genesis_key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	ASSERT_EQ (nano::process_result::progress, node.process (*send).code);
+	node.active.recently_dropped.add (send->qualified_root ());
+	node.rpc_response_cache.put ("block_info", "{}", { nano::test_genesis_key.pub }, node.rpc_response_cache.generation ());
+	ASSERT_EQ (1, node.rpc_response_cache.size ());
+	ASSERT_TRUE (node.work_generate_blocking (*send, send->difficulty () + 1).is_initialized ());
+	node.process_active (send);
+	node.block_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::election, nano::stat::detail::election_restart));
+	ASSERT_EQ (0, node.rpc_response_cache.size ());
+}
+
 // Ensures votes are tallied on election::publish even if no vote is inserted through inactive_votes_cache
 TEST (active_transactions, conflicting_block_vote_existing_election)
 {
@@ -5,6 +5,7 @@
 #include <kizunano/lib/utility.hpp>
 #include <kizunano/lib/work.hpp>
 #include <kizunano/node/common.hpp>
+#include <kizunano/secure/bulk_writer.hpp>
 #include <kizunano/secure/ledger.hpp>
 #include <kizunano/secure/utility.hpp>
 #include <kizunano/secure/versioning.hpp>
@@ -275,6 +276,30 @@ TEST (block_store, pending_iterator)
 	ASSERT_EQ (nano::epoch::epoch_1, pending.epoch);
 }
 
+TEST (block_store, pending_amounts)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto transaction (store->tx_begin_write ());
+	store->pending_put (transaction, nano::pending_key (1, 5), { 2, 10, nano::epoch::epoch_0 });
+	store->pending_put (transaction, nano::pending_key (1, 6), { 2, std::numeric_limits<nano::uint128_t>::max (), nano::epoch::epoch_0 });
+	store->pending_put (transaction, nano::pending_key (1, 7), { 2, 1000, nano::epoch::epoch_0 });
+	store->pending_put (transaction, nano::pending_key (1, 8), { 2, 10, nano::epoch::epoch_0 });
+	store->pending_put (transaction, nano::pending_key (2, 9), { 2, 5000, nano::epoch::epoch_0 });
+	std::vector<std::pair<nano::uint128_t, nano::block_hash>> entries;
+	for (auto i (store->pending_amounts_begin (transaction, nano::pending_amount_key (1, std::numeric_limits<nano::uint128_t>::max (), 0))), n (store->pending_amounts_end ()); i != n && i->first.account == 1; ++i)
+	{
+		entries.emplace_back (i->first.amount ().number (), i->first.hash);
+	}
+	std::vector<std::pair<nano::uint128_t, nano::block_hash>> expected{ { std::numeric_limits<nano::uint128_t>::max (), 6 }, { 1000, 7 }, { 10, 5 }, { 10, 8 } };
+	ASSERT_EQ (expected, entries);
+	store->pending_del (transaction, nano::pending_key (1, 7));
+	auto first (store->pending_amounts_begin (transaction, nano::pending_amount_key (1, 999, 0)));
+	ASSERT_NE (store->pending_amounts_end (), first);
+	ASSERT_EQ (nano::pending_amount_key (1, 10, 5), first->first);
+}
+
 /**
  * Regression test for Issue 1164
  * This reconstructs the situation where a key is larger in pending than the account being iterated in pending_v1, leaving
@@ -1544,6 +1569,33 @@ TEST (block_store, peers)
 	}
 }
 
+TEST (block_store, peer_info)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::endpoint_key endpoint (boost::asio::ip::address_v6::any ().to_bytes (), 100);
+	nano::endpoint_key endpoint1 (boost::asio::ip::address_v6::any ().to_bytes (), 101);
+	nano::peer_info info (250.5, 1.25);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->peer_put (transaction, endpoint);
+		store->peer_put (transaction, endpoint1, info);
+	}
+	auto transaction (store->tx_begin_read ());
+	auto i (store->peers_begin (transaction));
+	ASSERT_NE (store->peers_end (), i);
+	// Peers stored without a score read as unscored
+	ASSERT_EQ (100, i->first.port ());
+	ASSERT_EQ (nano::peer_info (), i->second);
+	++i;
+	ASSERT_NE (store->peers_end (), i);
+	ASSERT_EQ (101, i->first.port ());
+	ASSERT_EQ (info, i->second);
+	++i;
+	ASSERT_EQ (store->peers_end (), i);
+}
+
 TEST (block_store, endpoint_key_byte_order)
 {
 	boost::asio::ip::address_v6 address (boost::asio::ip::make_address_v6 ("::ffff:127.0.0.1"));
@@ -1602,6 +1654,87 @@ TEST (block_store, online_weight)
 	ASSERT_EQ (store->online_weight_end (), store->online_weight_begin (transaction));
 }
 
+TEST (block_store, bootstrap_checkpoint)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	std::vector<uint8_t> data{ 1, 2, 3 };
+	std::vector<uint8_t> result;
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_TRUE (store->bootstrap_checkpoint_get (transaction, 0, result));
+		store->bootstrap_checkpoint_put (transaction, 0, data);
+		// Deleting a missing checkpoint is allowed
+		store->bootstrap_checkpoint_del (transaction, 1);
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_FALSE (store->bootstrap_checkpoint_get (transaction, 0, result));
+		ASSERT_EQ (data, result);
+		store->bootstrap_checkpoint_del (transaction, 0);
+	}
+	auto transaction (store->tx_begin_read ());
+	ASSERT_TRUE (store->bootstrap_checkpoint_get (transaction, 0, result));
+}
+
+TEST (block_store, bulk_writer)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	nano::block_hash hash1 (1);
+	nano::block_hash hash2 (2);
+	nano::block_hash hash3 (3);
+	nano::account account1 (10);
+	nano::account account2 (20);
+	nano::account account3 (30);
+	auto bytes = [](nano::account const & account_a) {
+		return std::vector<uint8_t> (account_a.bytes.begin (), account_a.bytes.end ());
+	};
+	nano::bulk_writer writer (*store, nano::tables::frontiers);
+	// Out of order, the second value of a key wins
+	writer.put (hash3, bytes (account1));
+	writer.put (hash2, bytes (account2));
+	writer.put (hash3, bytes (account3));
+	ASSERT_EQ (0, writer.rows);
+	ASSERT_FALSE (writer.flush ());
+	ASSERT_EQ (2, writer.rows);
+	// Keys below the ones already loaded
+	writer.put (hash1, bytes (account1));
+	ASSERT_FALSE (writer.flush ());
+	ASSERT_EQ (3, writer.rows);
+	auto transaction (store->tx_begin_read ());
+	ASSERT_EQ (account1, store->frontier_get (transaction, hash1));
+	ASSERT_EQ (account2, store->frontier_get (transaction, hash2));
+	ASSERT_EQ (account3, store->frontier_get (transaction, hash3));
+}
+
+// Loading a key already in the table overwrites it and is not counted again
+TEST (block_store, bulk_writer_existing)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	std::vector<uint8_t> value1 (8, 1);
+	std::vector<uint8_t> value2 (8, 2);
+	nano::bulk_writer writer (*store, nano::tables::state_blocks);
+	writer.put (nano::block_hash (1), value1);
+	writer.put (nano::block_hash (2), value1);
+	ASSERT_FALSE (writer.flush ());
+	writer.put (nano::block_hash (2), value2);
+	writer.put (nano::block_hash (3), value2);
+	ASSERT_FALSE (writer.flush ());
+	ASSERT_EQ (4, writer.rows);
+	auto transaction (store->tx_begin_read ());
+	ASSERT_EQ (3, store->block_count (transaction).state);
+	std::vector<std::vector<uint8_t>> values;
+	store->table_for_each (transaction, nano::tables::state_blocks, [&values](nano::store_entry_view const & entry_a) {
+		values.emplace_back (entry_a.value, entry_a.value + entry_a.value_size);
+	});
+	ASSERT_EQ ((std::vector<std::vector<uint8_t>>{ value1, value2, value2 }), values);
+}
+
 // Adding confirmation height to accounts
 TEST (mdb_block_store, upgrade_v13_v14)
 {
@@ -2035,6 +2168,109 @@ TEST (mdb_block_store, upgrade_v17_v18)
 	ASSERT_LT (17, store.version_get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v18_v19)
+{
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	nano::state_block open (key1.pub, 0, key2.pub, nano::Gxrb_ratio, send.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	{
+		nano::logger_mt logger;
+		nano::mdb_store store (logger, path);
+		auto transaction (store.tx_begin_write ());
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+		// A v18 store has no delegators index
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.delegators, 0));
+		store.version_put (transaction, 18);
+	}
+	nano::logger_mt logger;
+	nano::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (18, store.version_get (transaction));
+	ASSERT_EQ (2, store.count (transaction, store.delegators));
+	auto i (store.delegators_begin (transaction, nano::delegator_key (nano::genesis_account, 0)));
+	ASSERT_NE (store.delegators_end (), i);
+	ASSERT_EQ (nano::delegator_key (nano::genesis_account, nano::genesis_account), i->first);
+	i = store.delegators_begin (transaction, nano::delegator_key (key2.pub, 0));
+	ASSERT_NE (store.delegators_end (), i);
+	ASSERT_EQ (nano::delegator_key (key2.pub, key1.pub), i->first);
+}
+
+TEST (mdb_block_store, upgrade_v19_v20)
+{
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - 10, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	nano::send_block send2 (send1.hash (), key1.pub, nano::genesis_amount - 1000, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (send1.hash ()));
+	{
+		nano::logger_mt logger;
+		nano::mdb_store store (logger, path);
+		auto transaction (store.tx_begin_write ());
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+		// A v19 store has no pending amounts index
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.pending_amounts, 0));
+		store.version_put (transaction, 19);
+	}
+	nano::logger_mt logger;
+	nano::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (19, store.version_get (transaction));
+	ASSERT_EQ (2, store.count (transaction, store.pending_amounts));
+	auto i (store.pending_amounts_begin (transaction, nano::pending_amount_key (key1.pub, std::numeric_limits<nano::uint128_t>::max (), 0)));
+	ASSERT_NE (store.pending_amounts_end (), i);
+	ASSERT_EQ (nano::pending_amount_key (key1.pub, 990, send2.hash ()), i->first);
+	++i;
+	ASSERT_NE (store.pending_amounts_end (), i);
+	ASSERT_EQ (nano::pending_amount_key (key1.pub, 10, send1.hash ()), i->first);
+}
+
+TEST (mdb_block_store, upgrade_v20_v21)
+{
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send (genesis.hash (), key1.pub, nano::genesis_amount - 10, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	nano::open_block open (send.hash (), key1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+	{
+		nano::logger_mt logger;
+		nano::mdb_store store (logger, path);
+		auto transaction (store.tx_begin_write ());
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+		// A v20 store has no heights index
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.heights, 0));
+		store.version_put (transaction, 20);
+	}
+	nano::logger_mt logger;
+	nano::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (20, store.version_get (transaction));
+	ASSERT_EQ (3, store.count (transaction, store.heights));
+	ASSERT_EQ (genesis.hash (), store.block_at_height (transaction, nano::genesis_account, 1));
+	ASSERT_EQ (send.hash (), store.block_at_height (transaction, nano::genesis_account, 2));
+	ASSERT_EQ (open.hash (), store.block_at_height (transaction, key1.pub, 1));
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	auto dir (nano::unique_path ());
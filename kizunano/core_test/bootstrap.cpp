@@ -1,6 +1,9 @@
 #include <kizunano/core_test/testutil.hpp>
+#include <kizunano/node/bootstrap/bootstrap_checkpoint.hpp>
 #include <kizunano/node/bootstrap/bootstrap_frontier.hpp>
 #include <kizunano/node/bootstrap/bootstrap_lazy.hpp>
+#include <kizunano/node/bootstrap/bootstrap_lazy_containers.hpp>
+#include <kizunano/node/bootstrap/bootstrap_priority.hpp>
 #include <kizunano/node/testing.hpp>
 
 #include <gtest/gtest.h>
@@ -170,6 +173,71 @@ TEST (bulk_pull, count_limit)
 	ASSERT_EQ (nullptr, block);
 }
 
+// Blocks copied from the store are identical to serialized ones
+TEST (bulk_pull, serialize_next)
+{
+	nano::system system (1);
+	auto send1 (std::make_shared<nano::send_block> (system.nodes[0]->latest (nano::test_genesis_key.pub), nano::test_genesis_key.pub, 1, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (system.nodes[0]->latest (nano::test_genesis_key.pub))));
+	ASSERT_EQ (nano::process_result::progress, system.nodes[0]->process (*send1).code);
+	auto state1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, 0, nano::test_genesis_key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (send1->hash ())));
+	ASSERT_EQ (nano::process_result::progress, system.nodes[0]->process (*state1).code);
+	auto connection (std::make_shared<nano::bootstrap_server> (nullptr, system.nodes[0]));
+	auto req = std::make_unique<nano::bulk_pull> ();
+	req->start = nano::test_genesis_key.pub;
+	req->end.clear ();
+	connection->requests.push (std::unique_ptr<nano::message>{});
+	auto request (std::make_shared<nano::bulk_pull_server> (connection, std::move (req)));
+	std::vector<uint8_t> expected;
+	{
+		nano::vectorstream stream (expected);
+		nano::genesis genesis;
+		nano::serialize_block (stream, *state1);
+		nano::serialize_block (stream, *send1);
+		nano::serialize_block (stream, *genesis.open);
+	}
+	std::vector<uint8_t> buffer;
+	auto transaction (system.nodes[0]->store.tx_begin_read ());
+	ASSERT_TRUE (request->serialize_next (transaction, buffer));
+	ASSERT_TRUE (request->serialize_next (transaction, buffer));
+	ASSERT_TRUE (request->serialize_next (transaction, buffer));
+	ASSERT_FALSE (request->serialize_next (transaction, buffer));
+	ASSERT_EQ (expected, buffer);
+}
+
+TEST (bootstrap_compression, frame)
+{
+	nano::genesis genesis;
+	nano::keypair key;
+	nano::state_block send (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 100, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0);
+	std::vector<uint8_t> raw;
+	for (auto i (0); i < 4; ++i)
+	{
+		nano::vectorstream stream (raw);
+		nano::serialize_block (stream, send);
+	}
+	nano::bootstrap_compressor compressor;
+	std::vector<uint8_t> frame;
+	if (!nano::bootstrap_compression::available ())
+	{
+		ASSERT_TRUE (compressor.compress (raw, frame));
+		return;
+	}
+	ASSERT_FALSE (compressor.compress (raw, frame));
+	ASSERT_LT (frame.size (), raw.size ());
+	uint32_t compressed_size (0);
+	uint32_t raw_size (0);
+	ASSERT_FALSE (nano::bootstrap_decompressor::header (frame.data (), compressed_size, raw_size));
+	ASSERT_EQ (frame.size (), nano::bootstrap_compression::frame_header_size + compressed_size);
+	ASSERT_EQ (raw.size (), raw_size);
+	nano::bootstrap_decompressor decompressor;
+	std::vector<uint8_t> decoded;
+	ASSERT_FALSE (decompressor.decompress (frame.data () + nano::bootstrap_compression::frame_header_size, compressed_size, raw_size, decoded));
+	ASSERT_EQ (raw, decoded);
+	// Frames not matching their announced size are rejected
+	ASSERT_TRUE (decompressor.decompress (frame.data () + nano::bootstrap_compression::frame_header_size, compressed_size, raw_size + 1, decoded));
+	ASSERT_TRUE (decompressor.decompress (frame.data () + nano::bootstrap_compression::frame_header_size, compressed_size - 1, raw_size, decoded));
+}
+
 TEST (bootstrap_processor, DISABLED_process_none)
 {
 	nano::system system (1);
@@ -243,6 +311,44 @@ TEST (bootstrap_processor, process_two)
 	node1->stop ();
 }
 
+// Compressed bulk pulls are used if both nodes enable them, otherwise blocks are streamed raw
+TEST (bootstrap_processor, process_compressed)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.enable_voting = false;
+	node_config.bootstrap_compression = true;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 = system.add_node (node_config, node_flags);
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	for (auto i (0); i < 20; ++i)
+	{
+		ASSERT_NE (nullptr, system.wallet (0)->send_action (nano::test_genesis_key.pub, nano::test_genesis_key.pub, 100));
+	}
+	node_config.peering_port = nano::get_available_port ();
+	node_flags.disable_rep_crawler = true;
+	auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::unique_path (), system.alarm, node_config, system.work, node_flags));
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	ASSERT_TIMELY (10s, node1->latest (nano::test_genesis_key.pub) == node0->latest (nano::test_genesis_key.pub));
+	auto raw (node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::compression_raw, nano::stat::dir::in));
+	auto compressed (node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::compression_compressed, nano::stat::dir::in));
+	if (nano::bootstrap_compression::available ())
+	{
+		ASSERT_EQ (raw, node0->stats.count (nano::stat::type::bootstrap, nano::stat::detail::compression_raw, nano::stat::dir::out));
+		ASSERT_LT (0, compressed);
+		ASSERT_LT (compressed, raw);
+	}
+	else
+	{
+		ASSERT_EQ (0, raw);
+		ASSERT_EQ (0, compressed);
+	}
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::compression_error, nano::stat::dir::in));
+	node1->stop ();
+}
+
 // Bootstrap can pull universal blocks
 TEST (bootstrap_processor, process_state)
 {
@@ -919,6 +1025,92 @@ TEST (bootstrap_processor, wallet_lazy_pending)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, priority)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	auto node0 = system.add_node (config, node_flags);
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::Gxrb_ratio, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *node0->work_generate_blocking (genesis.hash ())));
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *node0->work_generate_blocking (send1->hash ())));
+	node0->block_processor.add (send1);
+	node0->block_processor.add (send2);
+	node0->block_processor.flush ();
+	// Start priority bootstrap with the genesis account only
+	nano::node_flags node_flags1;
+	node_flags1.disable_legacy_bootstrap = true;
+	node_flags1.disable_wallet_bootstrap = true;
+	node_flags1.disable_priority_bootstrap = false;
+	auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::unique_path (), system.alarm, nano::node_config (nano::get_available_port (), system.logging), system.work, node_flags1));
+	node1->network.udp_channels.insert (node0->network.endpoint (), node1->network_params.protocol.protocol_version);
+	node1->bootstrap_initiator.bootstrap_priority (nano::test_genesis_key.pub, nano::bootstrap_limits::priority_gap);
+	{
+		auto priority_attempt (node1->bootstrap_initiator.current_priority_attempt ());
+		ASSERT_NE (nullptr, priority_attempt);
+		ASSERT_EQ (nano::test_genesis_key.pub.to_account (), priority_attempt->id);
+	}
+	ASSERT_TIMELY (10s, node1->ledger.block_exists (send2->hash ()));
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::initiate_priority, nano::stat::dir::out));
+	node1->stop ();
+}
+
+TEST (bootstrap_attempt_priority, ordering)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_priority_bootstrap = false;
+	auto node (system.add_node (node_flags));
+	nano::keypair key1;
+	nano::keypair key2;
+	// Not started, so accounts stay queued
+	auto attempt (std::make_shared<nano::bootstrap_attempt_priority> (node, 0));
+	attempt->priority_add (key1.pub, nano::bootstrap_limits::priority_pending);
+	attempt->priority_add (key2.pub, nano::bootstrap_limits::priority_gap);
+	ASSERT_EQ (2, attempt->wallet_size ());
+	ASSERT_EQ (key2.pub, attempt->accounts.get<nano::bootstrap_attempt_priority::priority_tag> ().begin ()->account);
+	// Priorities add up
+	attempt->priority_add (key1.pub, nano::bootstrap_limits::priority_wallet);
+	ASSERT_EQ (2, attempt->wallet_size ());
+	ASSERT_EQ (key1.pub, attempt->accounts.get<nano::bootstrap_attempt_priority::priority_tag> ().begin ()->account);
+	ASSERT_EQ (nano::bootstrap_limits::priority_pending + nano::bootstrap_limits::priority_wallet, attempt->accounts.get<nano::bootstrap_attempt_priority::priority_tag> ().begin ()->priority);
+}
+
+TEST (bootstrap_attempt_priority, requested)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_priority_bootstrap = false;
+	auto node (system.add_node (node_flags));
+	nano::keypair key1;
+	nano::keypair key2;
+	auto attempt (std::make_shared<nano::bootstrap_attempt_priority> (node, 0));
+	nano::priority_account_item item1;
+	item1.account = key1.pub;
+	item1.requests = 1;
+	item1.in_flight = 2;
+	auto item2 (item1);
+	item2.account = key2.pub;
+	attempt->requested[key1.pub] = item1;
+	attempt->requested[key2.pub] = item2;
+	// Dropped once both the chain and the pending pull completed
+	attempt->account_pulled (key1.pub);
+	ASSERT_EQ (1, attempt->requested.count (key1.pub));
+	attempt->account_pulled (key1.pub);
+	ASSERT_EQ (0, attempt->requested.count (key1.pub));
+	ASSERT_EQ (0, attempt->wallet_size ());
+	// A failed pull queues the account again, the other pull completing later is ignored
+	attempt->requeue_pending (key2.pub);
+	ASSERT_EQ (0, attempt->requested.count (key2.pub));
+	ASSERT_EQ (1, attempt->wallet_size ());
+	attempt->account_pulled (key2.pub);
+	ASSERT_EQ (1, attempt->wallet_size ());
+}
+
 TEST (bootstrap_processor, multiple_attempts)
 {
 	nano::system system;
@@ -1015,6 +1207,233 @@ TEST (bootstrap_processor, bootstrap_fork)
 	node1->stop ();
 }
 
+// Frontier ranges are split off to other peers holding the same ledger as their connections become idle
+TEST (bootstrap_processor, frontier_ranges)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	config.peering_port = nano::get_available_port ();
+	auto node1 (system.add_node (config, node_flags));
+	nano::block_hash latest (node0->latest (nano::test_genesis_key.pub));
+	std::vector<nano::account> accounts;
+	for (auto i (0); i < 32; ++i)
+	{
+		nano::keypair key;
+		auto send (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, latest, nano::test_genesis_key.pub, nano::genesis_amount - (i + 1) * nano::Gxrb_ratio, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (latest)));
+		auto open (std::make_shared<nano::state_block> (key.pub, 0, key.pub, nano::Gxrb_ratio, send->hash (), key.prv, key.pub, *system.work.generate (key.pub)));
+		for (auto node : { node0, node1 })
+		{
+			ASSERT_EQ (nano::process_result::progress, node->process (*send).code);
+			ASSERT_EQ (nano::process_result::progress, node->process (*open).code);
+		}
+		latest = send->hash ();
+		accounts.push_back (key.pub);
+	}
+	auto node2 (std::make_shared<nano::node> (system.io_ctx, nano::get_available_port (), nano::unique_path (), system.alarm, system.logging, system.work));
+	ASSERT_FALSE (node2->init_error ());
+	node2->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	node2->bootstrap_initiator.connections->add_connection (node1->network.endpoint ());
+	system.deadline_set (10s);
+	while (node2->ledger.cache.account_count != node0->ledger.cache.account_count)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	for (auto const & account : accounts)
+	{
+		ASSERT_EQ (node0->latest (account), node2->latest (account));
+	}
+	node2->stop ();
+}
+
+TEST (lazy_fingerprint_map, insert_erase)
+{
+	nano::lazy_fingerprint_map<nano::uint128_t> map;
+	// Keys sharing the low bits probe into the same run of slots
+	std::vector<uint64_t> keys;
+	for (uint64_t i (1); i <= 100; ++i)
+	{
+		keys.push_back (i << 32);
+		ASSERT_TRUE (map.insert (keys.back (), i));
+	}
+	ASSERT_FALSE (map.insert (keys.front (), 0));
+	ASSERT_EQ (100, map.size ());
+	for (size_t i (0); i < keys.size (); i += 2)
+	{
+		ASSERT_TRUE (map.erase (keys[i]));
+	}
+	ASSERT_FALSE (map.erase (keys.front ()));
+	ASSERT_EQ (50, map.size ());
+	for (size_t i (0); i < keys.size (); ++i)
+	{
+		auto value (map.find (keys[i]));
+		if (i % 2 == 0)
+		{
+			ASSERT_EQ (nullptr, value);
+		}
+		else
+		{
+			ASSERT_NE (nullptr, value);
+			ASSERT_EQ (i + 1, *value);
+		}
+	}
+	ASSERT_EQ (1, nano::lazy_fingerprint_map<nano::uint128_t>::fingerprint (nano::block_hash (0)));
+}
+
+TEST (lazy_fingerprint_set, spill)
+{
+	auto path (nano::unique_path ());
+	nano::lazy_fingerprint_set set (path);
+	std::vector<nano::block_hash> hashes;
+	for (auto i (0); i < 2000; ++i)
+	{
+		nano::block_hash hash;
+		nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		hashes.push_back (hash);
+		ASSERT_TRUE (set.insert (hashes.back ()));
+	}
+	auto memory (set.memory ());
+	ASSERT_TRUE (set.spill ());
+	ASSERT_EQ (2000, set.spilled ());
+	ASSERT_EQ (2000, set.size ());
+	ASSERT_LT (set.memory (), memory);
+	ASSERT_TRUE (boost::filesystem::exists (path));
+	for (auto const & hash : hashes)
+	{
+		ASSERT_TRUE (set.contains (hash));
+		ASSERT_FALSE (set.insert (hash));
+	}
+	nano::block_hash missing;
+	nano::random_pool::generate_block (missing.bytes.data (), missing.bytes.size ());
+	ASSERT_FALSE (set.contains (missing));
+	// Erasing a spilled hash hides it until it is inserted again
+	ASSERT_TRUE (set.erase (hashes[0]));
+	ASSERT_FALSE (set.erase (hashes[0]));
+	ASSERT_FALSE (set.contains (hashes[0]));
+	ASSERT_EQ (1999, set.size ());
+	ASSERT_TRUE (set.insert (hashes[0]));
+	ASSERT_TRUE (set.contains (hashes[0]));
+	ASSERT_EQ (2000, set.size ());
+	set.clear ();
+	ASSERT_EQ (0, set.size ());
+	ASSERT_FALSE (set.contains (hashes[1]));
+	ASSERT_FALSE (boost::filesystem::exists (path));
+	// Without a spill path everything stays in memory
+	nano::lazy_fingerprint_set memory_only;
+	ASSERT_TRUE (memory_only.insert (hashes[1]));
+	ASSERT_FALSE (memory_only.spill ());
+	ASSERT_TRUE (memory_only.contains (hashes[1]));
+}
+
+TEST (lazy_fingerprint_set, spill_merge)
+{
+	auto path (nano::unique_path ());
+	nano::lazy_fingerprint_set set (path);
+	// Nothing to spill
+	ASSERT_FALSE (set.spill ());
+	ASSERT_EQ (0, set.runs_count ());
+	std::vector<nano::block_hash> hashes;
+	for (auto i (0); i < 8; ++i)
+	{
+		for (auto j (0); j < 1000; ++j)
+		{
+			nano::block_hash hash;
+			nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+			hashes.push_back (hash);
+			ASSERT_TRUE (set.insert (hashes.back ()));
+		}
+		if (i == 4)
+		{
+			ASSERT_TRUE (set.erase (hashes[0]));
+		}
+		ASSERT_TRUE (set.spill ());
+	}
+	// Equally sized spills are merged into a single run, dropping the erased hash
+	ASSERT_EQ (1, set.runs_count ());
+	ASSERT_EQ (7999, set.spilled ());
+	ASSERT_EQ (7999, set.size ());
+	ASSERT_EQ (1, std::distance (boost::filesystem::directory_iterator (path), boost::filesystem::directory_iterator ()));
+	ASSERT_FALSE (set.contains (hashes[0]));
+	for (auto i (hashes.begin () + 1), n (hashes.end ()); i != n; ++i)
+	{
+		ASSERT_TRUE (set.contains (*i));
+	}
+	ASSERT_TRUE (set.insert (hashes[0]));
+	ASSERT_EQ (8000, set.size ());
+}
+
+TEST (bootstrap_checkpoint, serialization)
+{
+	nano::bootstrap_checkpoint checkpoint1;
+	checkpoint1.pulls.emplace_back (nano::account (1), nano::block_hash (2), nano::block_hash (3), 4, 5, 6);
+	checkpoint1.pulls.back ().processed = 7;
+	checkpoint1.lazy_pulls.emplace_back (nano::block_hash (8), 9);
+	checkpoint1.lazy_keys.push_back (nano::block_hash (10));
+	nano::lazy_state_backlog_item item;
+	item.link = nano::link (11);
+	item.balance = 12;
+	item.retry_limit = 13;
+	checkpoint1.lazy_state_backlog.emplace_back (nano::block_hash (14), item);
+	std::vector<uint8_t> data;
+	{
+		nano::vectorstream stream (data);
+		checkpoint1.serialize (stream);
+	}
+	nano::bootstrap_checkpoint checkpoint2;
+	nano::bufferstream stream (data.data (), data.size ());
+	ASSERT_FALSE (checkpoint2.deserialize (stream));
+	ASSERT_EQ (1, checkpoint2.pulls.size ());
+	auto const & pull (checkpoint2.pulls.front ());
+	ASSERT_EQ (nano::account (1), pull.account_or_head.account);
+	ASSERT_EQ (nano::block_hash (2), pull.head);
+	ASSERT_EQ (nano::block_hash (2), pull.head_original);
+	ASSERT_EQ (nano::block_hash (3), pull.end);
+	ASSERT_EQ (5, pull.count);
+	ASSERT_EQ (6, pull.retry_limit);
+	ASSERT_EQ (7, pull.processed);
+	ASSERT_EQ (checkpoint1.lazy_pulls, checkpoint2.lazy_pulls);
+	ASSERT_EQ (checkpoint1.lazy_keys, checkpoint2.lazy_keys);
+	ASSERT_EQ (1, checkpoint2.lazy_state_backlog.size ());
+	ASSERT_EQ (nano::block_hash (14), checkpoint2.lazy_state_backlog.front ().first);
+	ASSERT_EQ (item.link, checkpoint2.lazy_state_backlog.front ().second.link);
+	ASSERT_EQ (item.balance, checkpoint2.lazy_state_backlog.front ().second.balance);
+	ASSERT_EQ (item.retry_limit, checkpoint2.lazy_state_backlog.front ().second.retry_limit);
+	// Truncated data is rejected
+	nano::bufferstream truncated (data.data (), data.size () - 1);
+	ASSERT_TRUE (checkpoint2.deserialize (truncated));
+}
+
+// A lazy attempt interrupted by a restart is resumed with its keys
+TEST (bootstrap_checkpoint, lazy_resume)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_legacy_bootstrap = true;
+	auto path (nano::unique_path ());
+	nano::keypair key;
+	{
+		auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::get_available_port (), path, system.alarm, system.logging, system.work, node_flags));
+		ASSERT_FALSE (node1->init_error ());
+		node1->start ();
+		node1->bootstrap_initiator.bootstrap_lazy (key.pub);
+		ASSERT_TIMELY (5s, node1->bootstrap_initiator.current_lazy_attempt () != nullptr && node1->bootstrap_initiator.current_lazy_attempt ()->started);
+		node1->stop ();
+	}
+	auto node2 (std::make_shared<nano::node> (system.io_ctx, nano::get_available_port (), path, system.alarm, system.logging, system.work, node_flags));
+	ASSERT_FALSE (node2->init_error ());
+	node2->bootstrap_initiator.resume ();
+	auto attempt (std::dynamic_pointer_cast<nano::bootstrap_attempt_lazy> (node2->bootstrap_initiator.current_lazy_attempt ()));
+	ASSERT_NE (nullptr, attempt);
+	{
+		nano::lock_guard<std::mutex> guard (attempt->mutex);
+		ASSERT_EQ (1, attempt->lazy_keys.count (nano::hash_or_account (key.pub).hash));
+	}
+	node2->stop ();
+}
+
 TEST (frontier_req_response, DISABLED_destruction)
 {
 	{
@@ -1,6 +1,9 @@
 #include <kizunano/core_test/testutil.hpp>
+#include <kizunano/ipc_flatbuffers_lib/flatbuffer_producer.hpp>
+#include <kizunano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
 #include <kizunano/lib/ipc_client.hpp>
 #include <kizunano/lib/tomlconfig.hpp>
+#include <kizunano/node/ipc/flatbuffers_handler.hpp>
 #include <kizunano/node/ipc/ipc_access_config.hpp>
 #include <kizunano/node/ipc/ipc_server.hpp>
 #include <kizunano/node/testing.hpp>
@@ -17,6 +20,33 @@
 
 using namespace std::chrono_literals;
 
+namespace
+{
+/** Runs \p request_a through the Flatbuffers handler and returns the response envelope */
+template <typename T>
+std::shared_ptr<flatbuffers::FlatBufferBuilder> flatbuffers_call (nano::node & node_a, nano::ipc::ipc_server & ipc_server_a, T & request_a)
+{
+	auto request (nano::ipc::flatbuffer_producer::make_buffer (request_a));
+	std::shared_ptr<flatbuffers::FlatBufferBuilder> result;
+	auto handler (std::make_shared<nano::ipc::flatbuffers_handler> (node_a, ipc_server_a, nullptr, node_a.config.ipc_config));
+	handler->process (request->GetBufferPointer (), request->GetSize (), [&result](std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb_a) {
+		result = fbb_a;
+	});
+	return result;
+}
+
+/** Sends 100 and then 200 raw from the genesis account to \p destination_a */
+std::pair<std::shared_ptr<nano::state_block>, std::shared_ptr<nano::state_block>> flatbuffers_sends (nano::system & system_a, nano::account const & destination_a)
+{
+	nano::genesis genesis;
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 100, destination_a, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system_a.work.generate (genesis.hash ())));
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, nano::genesis_amount - 300, destination_a, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system_a.work.generate (send1->hash ())));
+	EXPECT_EQ (nano::process_result::progress, system_a.nodes[0]->process (*send1).code);
+	EXPECT_EQ (nano::process_result::progress, system_a.nodes[0]->process (*send2).code);
+	return std::make_pair (send1, send2);
+}
+}
+
 TEST (ipc, asynchronous)
 {
 	nano::system system (1);
@@ -126,6 +156,7 @@ TEST (ipc, permissions_default_user)
 	nano::ipc::access access;
 	access.deserialize_toml (toml);
 	ASSERT_TRUE (access.has_access ("", nano::ipc::access_permission::api_account_weight));
+	ASSERT_TRUE (access.has_access_to_all ("", { nano::ipc::access_permission::api_accounts_info, nano::ipc::access_permission::api_blocks_info, nano::ipc::access_permission::api_pending, nano::ipc::access_permission::api_account_history }));
 }
 
 TEST (ipc, permissions_deny_default)
@@ -216,3 +247,145 @@ TEST (ipc, permissions_default_user_order)
 	nano::ipc::access access;
 	ASSERT_TRUE (access.deserialize_toml (toml));
 }
+
+TEST (ipc, flatbuffers_accounts_info)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (node, node_rpc_config);
+	nano::keypair key;
+	auto sends (flatbuffers_sends (system, key.pub));
+	nanoapi::AccountsInfoT request;
+	request.accounts = { nano::test_genesis_key.pub.to_account (), key.pub.to_account () };
+	auto response (flatbuffers_call (node, ipc_server, request));
+	auto accounts (nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_AccountsInfoResponse ()->accounts ());
+	ASSERT_NE (nullptr, accounts);
+	ASSERT_EQ (2, accounts->size ());
+	auto genesis (accounts->Get (0));
+	ASSERT_EQ (nano::test_genesis_key.pub.to_account (), genesis->account ()->str ());
+	ASSERT_EQ (sends.second->hash ().to_string (), genesis->frontier ()->str ());
+	ASSERT_EQ (nano::genesis ().hash ().to_string (), genesis->open_block ()->str ());
+	ASSERT_EQ (nano::test_genesis_key.pub.to_account (), genesis->representative ()->str ());
+	ASSERT_EQ (nano::amount (nano::genesis_amount - 300).to_string_dec (), genesis->balance ()->str ());
+	ASSERT_EQ (3, genesis->block_count ());
+	ASSERT_EQ (1, genesis->confirmation_height ());
+	ASSERT_EQ (nano::genesis ().hash ().to_string (), genesis->confirmation_height_frontier ()->str ());
+	// Unopened accounts only have the account set
+	auto unopened (accounts->Get (1));
+	ASSERT_EQ (key.pub.to_account (), unopened->account ()->str ());
+	ASSERT_EQ (nullptr, unopened->frontier ());
+	ASSERT_EQ (0, unopened->block_count ());
+}
+
+TEST (ipc, flatbuffers_blocks_info)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (node, node_rpc_config);
+	nano::keypair key;
+	auto sends (flatbuffers_sends (system, key.pub));
+	nano::block_hash missing (1);
+	nanoapi::BlocksInfoT request;
+	request.hashes = { sends.first->hash ().to_string (), missing.to_string () };
+	auto response (flatbuffers_call (node, ipc_server, request));
+	auto blocks (nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_BlocksInfoResponse ()->blocks ());
+	ASSERT_NE (nullptr, blocks);
+	ASSERT_EQ (2, blocks->size ());
+	auto info (blocks->Get (0));
+	ASSERT_EQ (sends.first->hash ().to_string (), info->hash ()->str ());
+	ASSERT_EQ (nano::test_genesis_key.pub.to_account (), info->account ()->str ());
+	ASSERT_EQ ("100", info->amount ()->str ());
+	ASSERT_EQ (nano::amount (nano::genesis_amount - 100).to_string_dec (), info->balance ()->str ());
+	ASSERT_EQ (2, info->height ());
+	ASSERT_FALSE (info->confirmed ());
+	auto block (info->block_as_BlockState ());
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (sends.first->hash ().to_string (), block->hash ()->str ());
+	ASSERT_EQ (key.pub.to_account (), block->link_as_account ()->str ());
+	ASSERT_EQ (nanoapi::BlockSubType::BlockSubType_send, block->subtype ());
+	// Blocks not in the ledger only have the hash set
+	auto unknown (blocks->Get (1));
+	ASSERT_EQ (missing.to_string (), unknown->hash ()->str ());
+	ASSERT_EQ (nanoapi::Block::Block_NONE, unknown->block_type ());
+	ASSERT_EQ (nullptr, unknown->account ());
+}
+
+TEST (ipc, flatbuffers_pending)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (node, node_rpc_config);
+	nano::keypair key;
+	nano::keypair empty;
+	auto sends (flatbuffers_sends (system, key.pub));
+	// Entries of an account are ordered by hash
+	auto first (sends.first->hash ());
+	auto second (sends.second->hash ());
+	if (second < first)
+	{
+		std::swap (first, second);
+	}
+	nanoapi::PendingT request;
+	request.accounts = { key.pub.to_account (), empty.pub.to_account () };
+	request.count = 1;
+	auto response (flatbuffers_call (node, ipc_server, request));
+	auto accounts (nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_PendingResponse ()->accounts ());
+	ASSERT_NE (nullptr, accounts);
+	ASSERT_EQ (2, accounts->size ());
+	ASSERT_EQ (key.pub.to_account (), accounts->Get (0)->account ()->str ());
+	ASSERT_EQ (1, accounts->Get (0)->entries ()->size ());
+	ASSERT_EQ (first.to_string (), accounts->Get (0)->entries ()->Get (0)->hash ()->str ());
+	ASSERT_EQ (nano::test_genesis_key.pub.to_account (), accounts->Get (0)->entries ()->Get (0)->source ()->str ());
+	ASSERT_EQ (second.to_string (), accounts->Get (0)->next ()->str ());
+	ASSERT_EQ (0, accounts->Get (1)->entries ()->size ());
+	ASSERT_EQ (nullptr, accounts->Get (1)->next ());
+	// Starts apply to the account at the same index
+	request.starts = { second.to_string () };
+	response = flatbuffers_call (node, ipc_server, request);
+	accounts = nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_PendingResponse ()->accounts ();
+	ASSERT_EQ (1, accounts->Get (0)->entries ()->size ());
+	ASSERT_EQ (second.to_string (), accounts->Get (0)->entries ()->Get (0)->hash ()->str ());
+	ASSERT_EQ (nullptr, accounts->Get (0)->next ());
+	// Entries below the threshold are skipped
+	request.starts.clear ();
+	request.count = 10;
+	request.threshold = "150";
+	response = flatbuffers_call (node, ipc_server, request);
+	accounts = nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_PendingResponse ()->accounts ();
+	ASSERT_EQ (1, accounts->Get (0)->entries ()->size ());
+	ASSERT_EQ (sends.second->hash ().to_string (), accounts->Get (0)->entries ()->Get (0)->hash ()->str ());
+	ASSERT_EQ ("200", accounts->Get (0)->entries ()->Get (0)->amount ()->str ());
+}
+
+TEST (ipc, flatbuffers_account_history)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (node, node_rpc_config);
+	nano::keypair key;
+	auto sends (flatbuffers_sends (system, key.pub));
+	nanoapi::AccountHistoryT request;
+	request.account = nano::test_genesis_key.pub.to_account ();
+	request.height = 2;
+	request.count = 1;
+	auto response (flatbuffers_call (node, ipc_server, request));
+	auto history (nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_AccountHistoryResponse ());
+	ASSERT_NE (nullptr, history);
+	ASSERT_EQ (nano::test_genesis_key.pub.to_account (), history->account ()->str ());
+	ASSERT_EQ (1, history->blocks ()->size ());
+	ASSERT_EQ (sends.first->hash ().to_string (), history->blocks ()->Get (0)->hash ()->str ());
+	ASSERT_EQ (2, history->blocks ()->Get (0)->height ());
+	ASSERT_EQ (3, history->next_height ());
+	// The end of the chain gives no next height
+	request.height = history->next_height ();
+	response = flatbuffers_call (node, ipc_server, request);
+	history = nanoapi::GetEnvelope (response->GetBufferPointer ())->message_as_AccountHistoryResponse ();
+	ASSERT_EQ (1, history->blocks ()->size ());
+	ASSERT_EQ (sends.second->hash ().to_string (), history->blocks ()->Get (0)->hash ()->str ());
+	ASSERT_EQ (3, history->blocks ()->Get (0)->height ());
+	ASSERT_EQ (0, history->next_height ());
+}
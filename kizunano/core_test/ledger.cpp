@@ -2,7 +2,9 @@
 #include <kizunano/lib/stats.hpp>
 #include <kizunano/lib/threading.hpp>
 #include <kizunano/node/election.hpp>
+#include <kizunano/node/ledger_snapshot.hpp>
 #include <kizunano/node/testing.hpp>
+#include <kizunano/secure/ledger_stream.hpp>
 
 #include <gtest/gtest.h>
 
@@ -1539,6 +1541,78 @@ TEST (ledger, change_representative_move_representation)
 	ASSERT_EQ (nano::genesis_amount, ledger.weight (key3.pub));
 }
 
+TEST (ledger, delegators_index)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	auto transaction (store->tx_begin_write ());
+	nano::genesis genesis;
+	store->initialize (transaction, genesis, ledger.cache);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	auto delegators = [&store, &transaction](nano::account const & representative_a) {
+		std::vector<nano::account> result;
+		for (auto i (store->delegators_begin (transaction, nano::delegator_key (representative_a, 0))), n (store->delegators_end ()); i != n && i->first.representative == representative_a; ++i)
+		{
+			result.push_back (i->first.account);
+		}
+		return result;
+	};
+	ASSERT_EQ (std::vector<nano::account>{ nano::test_genesis_key.pub }, delegators (nano::test_genesis_key.pub));
+	nano::keypair key1;
+	nano::keypair rep1;
+	nano::send_block send (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+	nano::open_block open (send.hash (), rep1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+	ASSERT_EQ (std::vector<nano::account>{ key1.pub }, delegators (rep1.pub));
+	nano::state_block change (nano::test_genesis_key.pub, send.hash (), rep1.pub, nano::genesis_amount - 100, 0, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (send.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+	ASSERT_TRUE (delegators (nano::test_genesis_key.pub).empty ());
+	ASSERT_EQ (2, delegators (rep1.pub).size ());
+	ASSERT_FALSE (ledger.rollback (transaction, change.hash ()));
+	ASSERT_EQ (std::vector<nano::account>{ nano::test_genesis_key.pub }, delegators (nano::test_genesis_key.pub));
+	ASSERT_FALSE (ledger.rollback (transaction, open.hash ()));
+	ASSERT_TRUE (delegators (rep1.pub).empty ());
+}
+
+TEST (ledger, heights_index)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	auto transaction (store->tx_begin_write ());
+	nano::genesis genesis;
+	store->initialize (transaction, genesis, ledger.cache);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::keypair key1;
+	ASSERT_EQ (genesis.hash (), store->block_at_height (transaction, nano::genesis_account, 1));
+	nano::send_block send (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+	nano::state_block open (key1.pub, 0, key1.pub, 100, send.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+	nano::state_block change (key1.pub, open.hash (), nano::test_genesis_key.pub, 100, 0, key1.prv, key1.pub, *pool.generate (open.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+	ASSERT_EQ (send.hash (), store->block_at_height (transaction, nano::genesis_account, 2));
+	ASSERT_EQ (open.hash (), store->block_at_height (transaction, key1.pub, 1));
+	ASSERT_EQ (change.hash (), store->block_at_height (transaction, key1.pub, 2));
+	ASSERT_TRUE (store->block_at_height (transaction, key1.pub, 3).is_zero ());
+	std::vector<nano::block_hash> chain;
+	for (auto i (store->heights_begin (transaction, nano::account_height_key (key1.pub, 1))), n (store->heights_end ()); i != n && i->first.account == key1.pub; ++i)
+	{
+		chain.push_back (i->second);
+	}
+	ASSERT_EQ ((std::vector<nano::block_hash>{ open.hash (), change.hash () }), chain);
+	ASSERT_FALSE (ledger.rollback (transaction, send.hash ()));
+	ASSERT_TRUE (store->block_at_height (transaction, nano::genesis_account, 2).is_zero ());
+	ASSERT_TRUE (store->block_at_height (transaction, key1.pub, 1).is_zero ());
+	ASSERT_TRUE (store->block_at_height (transaction, key1.pub, 2).is_zero ());
+}
+
 TEST (ledger, send_open_receive_rollback)
 {
 	nano::logger_mt logger;
@@ -3241,3 +3315,108 @@ TEST (ledger, block_confirmed)
 	ledger.store.confirmation_height_put (transaction, nano::genesis_account, height);
 	ASSERT_TRUE (ledger.block_confirmed (transaction, send1->hash ()));
 }
+
+// Blocks are exported after their sources, so a fresh ledger accepts them in stream order
+TEST (ledger_stream, export_import)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	nano::genesis genesis;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::keypair key1;
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - 100, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	nano::state_block open1 (key1.pub, 0, key1.pub, 100, send1.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	nano::state_block send2 (key1.pub, open1.hash (), key1.pub, 50, nano::genesis_account, key1.prv, key1.pub, *pool.generate (open1.hash ()));
+	nano::state_block receive1 (nano::genesis_account, send1.hash (), nano::genesis_account, nano::genesis_amount - 50, send2.hash (), nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (send1.hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, receive1).code);
+	}
+	std::stringstream stream;
+	nano::ledger_stream exporter (ledger);
+	ASSERT_FALSE (exporter.export_blocks (stream));
+	ASSERT_EQ (5, exporter.blocks);
+	auto data (stream.str ());
+
+	auto store2 = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	nano::ledger ledger2 (*store2, stats);
+	store2->initialize (store2->tx_begin_write (), genesis, ledger2.cache);
+	nano::ledger_stream importer (ledger2);
+	ASSERT_FALSE (importer.import_blocks (stream));
+	ASSERT_EQ (4, importer.blocks);
+	ASSERT_EQ (1, importer.skipped);
+	ASSERT_EQ (5, ledger2.cache.block_count);
+	ASSERT_TRUE (ledger2.block_exists (receive1.hash ()));
+	ASSERT_EQ (nano::genesis_amount - 50, ledger2.account_balance (store2->tx_begin_read (), nano::genesis_account));
+
+	// A flipped bit fails the chunk checksum
+	data[data.size () / 2] ^= 1;
+	std::stringstream corrupted (data);
+	nano::ledger_stream importer2 (ledger2);
+	ASSERT_TRUE (importer2.import_blocks (corrupted));
+	ASSERT_FALSE (importer2.error_message.empty ());
+	ASSERT_EQ (0, importer2.blocks);
+}
+
+TEST (ledger_snapshot, export_import)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	nano::genesis genesis;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::keypair key1;
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - 100, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	nano::state_block open1 (key1.pub, 0, key1.pub, 100, send1.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	nano::state_block send2 (key1.pub, open1.hash (), key1.pub, 50, nano::genesis_account, key1.prv, key1.pub, *pool.generate (open1.hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+	}
+	std::stringstream stream;
+	nano::ledger_snapshot exporter (*store);
+	ASSERT_FALSE (exporter.export_tables (stream));
+	ASSERT_NE (0, exporter.entries);
+	auto data (stream.str ());
+	ASSERT_EQ (data.size (), exporter.bytes);
+
+	auto store2 = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	nano::ledger_snapshot importer (*store2);
+	ASSERT_FALSE (importer.import_tables (stream));
+	ASSERT_EQ (exporter.entries, importer.entries);
+	ASSERT_EQ (exporter.bytes, importer.bytes);
+	{
+		auto transaction (store2->tx_begin_read ());
+		ASSERT_EQ (4, store2->block_count (transaction).sum ());
+		ASSERT_NE (nullptr, store2->block_get (transaction, send2.hash ()));
+		nano::account_info info;
+		ASSERT_FALSE (store2->account_get (transaction, key1.pub, info));
+		ASSERT_EQ (send2.hash (), info.head);
+		nano::pending_info pending;
+		ASSERT_FALSE (store2->pending_get (transaction, nano::pending_key (nano::genesis_account, send2.hash ()), pending));
+		ASSERT_EQ (50, pending.amount.number ());
+		ASSERT_EQ (store->version_get (store->tx_begin_read ()), store2->version_get (transaction));
+	}
+
+	// A flipped bit fails the frame checksum
+	data[data.size () / 2] ^= 1;
+	std::stringstream corrupted (data);
+	auto store3 = nano::make_store (logger, nano::unique_path ());
+	nano::ledger_snapshot importer2 (*store3);
+	ASSERT_TRUE (importer2.import_tables (corrupted));
+	ASSERT_FALSE (importer2.error_message.empty ());
+}
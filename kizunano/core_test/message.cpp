@@ -90,6 +90,30 @@ TEST (message, confirm_ack_serialization)
 	ASSERT_EQ (header.block_type (), nano::block_type::send);
 }
 
+TEST (message, block_announce_serialization)
+{
+	std::vector<nano::block_hash> hashes;
+	for (auto i (0); i < nano::block_announce::max_hashes; ++i)
+	{
+		hashes.push_back (nano::block_hash (i + 1));
+	}
+	nano::block_announce announce1 (hashes, true);
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream1 (bytes);
+		announce1.serialize (stream1, false);
+	}
+	ASSERT_LE (bytes.size (), nano::message_parser::max_safe_udp_message_size);
+	nano::bufferstream stream2 (bytes.data (), bytes.size ());
+	bool error (false);
+	nano::message_header header (error, stream2);
+	ASSERT_EQ (nano::message_header::size + header.payload_length_bytes (), bytes.size ());
+	ASSERT_TRUE (header.block_announce_is_pull ());
+	nano::block_announce announce2 (error, stream2, header);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (announce1, announce2);
+}
+
 TEST (message, confirm_ack_hash_serialization)
 {
 	std::vector<nano::block_hash> hashes;
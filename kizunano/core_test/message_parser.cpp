@@ -51,11 +51,16 @@ public:
 	{
 		ASSERT_FALSE (true);
 	}
+	void block_announce (nano::block_announce const &) override
+	{
+		++block_announce_count;
+	}
 
 	uint64_t keepalive_count{ 0 };
 	uint64_t publish_count{ 0 };
 	uint64_t confirm_req_count{ 0 };
 	uint64_t confirm_ack_count{ 0 };
+	uint64_t block_announce_count{ 0 };
 };
 }
 
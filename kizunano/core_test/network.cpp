@@ -356,6 +356,37 @@ TEST (network, send_valid_publish)
 	}
 }
 
+TEST (network, block_announce)
+{
+	nano::system system (2);
+	auto & node1 (*system.nodes[0]);
+	auto & node2 (*system.nodes[1]);
+	auto channel (node1.network.find_node_id (node2.node_id.pub));
+	ASSERT_NE (nullptr, channel);
+	// Capability negotiated in the node ID handshake
+	ASSERT_TRUE (node1.network.block_announcer.capable (*channel));
+	nano::genesis genesis;
+	auto send (std::make_shared<nano::send_block> (genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 1, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	ASSERT_EQ (nano::process_result::progress, node1.process (*send).code);
+	node1.network.block_announcer.announce (channel, send);
+	node1.network.block_announcer.flush ();
+	ASSERT_TIMELY (10s, node2.block (send->hash ()) != nullptr);
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::out));
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::in));
+	// Blocks which were not announced are not served, even if they are in the ledger
+	auto channel2 (node2.network.find_node_id (node1.node_id.pub));
+	ASSERT_NE (nullptr, channel2);
+	auto announces (node1.stats.count (nano::stat::type::message, nano::stat::detail::block_announce, nano::stat::dir::in));
+	channel2->send (nano::block_announce ({ genesis.hash () }, true));
+	ASSERT_TIMELY (10s, node1.stats.count (nano::stat::type::message, nano::stat::detail::block_announce, nano::stat::dir::in) > announces);
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::in));
+	// Known blocks are not pulled again
+	node1.network.block_announcer.announce (channel, send);
+	node1.network.block_announcer.flush ();
+	ASSERT_TIMELY (10s, node2.stats.count (nano::stat::type::message, nano::stat::detail::block_announce, nano::stat::dir::in) >= 2);
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::out));
+}
+
 TEST (network, send_insufficient_work)
 {
 	nano::system system;
@@ -1043,6 +1074,108 @@ TEST (network, bandwidth_limiter)
 	node.stop ();
 }
 
+TEST (network, bandwidth_limiter_inbound)
+{
+	nano::system system;
+	nano::genesis genesis;
+	nano::publish message (genesis.open);
+	auto message_size = message.to_bytes (false)->size ();
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.bandwidth_limit_inbound = message_size;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	auto & node = *system.add_node (node_config);
+	auto channel (node.network.udp_channels.create (node.network.endpoint ()));
+	node.network.process_message (message, channel);
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::in));
+	ASSERT_EQ (message_size, node.stats.count (nano::stat::type::bandwidth, nano::stat::detail::publish, nano::stat::dir::in));
+	node.network.process_message (message, channel);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::global_limit, nano::stat::dir::in));
+	ASSERT_EQ (message_size, node.stats.count (nano::stat::type::bandwidth, nano::stat::detail::publish, nano::stat::dir::in));
+}
+
+TEST (network, bandwidth_limiter_inbound_publish_filter)
+{
+	nano::system system;
+	nano::genesis genesis;
+	nano::keypair key;
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 1, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, nano::genesis_amount - 2, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (send1->hash ())));
+	nano::publish publish1 (send1);
+	nano::publish publish2 (send2);
+	auto message_size = publish2.to_bytes (false)->size ();
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.bandwidth_limit_inbound = message_size;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	auto & node = *system.add_node (node_config);
+	auto channel (node.network.udp_channels.create (node.network.endpoint ()));
+	node.network.process_message (publish1, channel);
+	// The parser records the digest before the limiter drops the message
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream (bytes);
+		send2->serialize (stream);
+	}
+	ASSERT_FALSE (node.network.publish_filter.apply (bytes.data (), bytes.size (), &publish2.digest));
+	node.network.process_message (publish2, channel);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::in));
+	// A later copy of the dropped block passes the filter and is processed once the limit allows it
+	ASSERT_FALSE (node.network.publish_filter.apply (bytes.data (), bytes.size (), &publish2.digest));
+	system.deadline_set (5s);
+	while (node.stats.count (nano::stat::type::bandwidth, nano::stat::detail::publish, nano::stat::dir::in) < 2 * message_size)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+		node.network.process_message (publish2, channel);
+	}
+	ASSERT_TIMELY (5s, node.ledger.block_exists (send2->hash ()));
+}
+
+TEST (bandwidth_limiter, vote_reserve)
+{
+	nano::endpoint endpoint (boost::asio::ip::address_v6::loopback (), nano::get_available_port ());
+	nano::bandwidth_limiter limiter (1.0, 1000, 0.2);
+	// Other traffic is limited to the shared 800 bytes
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (800, nano::stat::detail::publish, endpoint));
+	ASSERT_EQ (nano::bandwidth_limiter::level::global, limiter.should_drop (200, nano::stat::detail::bulk_pull, endpoint));
+	// Votes still get their reserve
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (200, nano::stat::detail::confirm_ack, endpoint));
+	ASSERT_EQ (nano::bandwidth_limiter::level::global, limiter.should_drop (200, nano::stat::detail::confirm_req, endpoint));
+}
+
+TEST (bandwidth_limiter, vote_borrow)
+{
+	nano::endpoint endpoint (boost::asio::ip::address_v6::loopback (), nano::get_available_port ());
+	nano::bandwidth_limiter limiter (1.0, 1000, 0.2);
+	// Votes exceeding their reserve borrow from the shared share
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (200, nano::stat::detail::confirm_ack, endpoint));
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (500, nano::stat::detail::confirm_ack, endpoint));
+	ASSERT_EQ (nano::bandwidth_limiter::level::global, limiter.should_drop (500, nano::stat::detail::publish, endpoint));
+}
+
+TEST (bandwidth_limiter, peer)
+{
+	nano::endpoint endpoint1 (boost::asio::ip::address_v6::loopback (), nano::get_available_port ());
+	nano::endpoint endpoint2 (boost::asio::ip::address_v6::loopback (), nano::get_available_port ());
+	nano::bandwidth_limiter limiter (1.0, 0, 0, 1000);
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (1000, nano::stat::detail::publish, endpoint1));
+	ASSERT_EQ (nano::bandwidth_limiter::level::peer, limiter.should_drop (500, nano::stat::detail::confirm_ack, endpoint1));
+	// A chatty peer does not affect the others
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (1000, nano::stat::detail::confirm_ack, endpoint2));
+	ASSERT_EQ (2, limiter.peer_count ());
+	limiter.purge (std::chrono::steady_clock::now ());
+	ASSERT_EQ (0, limiter.peer_count ());
+}
+
+TEST (bandwidth_limiter, peer_refund)
+{
+	nano::endpoint endpoint (boost::asio::ip::address_v6::loopback (), nano::get_available_port ());
+	nano::bandwidth_limiter limiter (1.0, 1000, 0.5, 1000);
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (500, nano::stat::detail::publish, endpoint));
+	ASSERT_EQ (nano::bandwidth_limiter::level::global, limiter.should_drop (500, nano::stat::detail::publish, endpoint));
+	// The dropped message was not charged to the peer, which has room left for a vote
+	ASSERT_EQ (nano::bandwidth_limiter::level::none, limiter.should_drop (500, nano::stat::detail::confirm_ack, endpoint));
+}
+
 namespace nano
 {
 TEST (peer_exclusion, validate)
@@ -1193,5 +1326,49 @@ TEST (network, tcp_message_manager)
 	{
 		t.join ();
 	}
+
+	// Queued messages are taken several at a time, up to the batch size
+	nano::tcp_message_manager manager3 (8);
+	for (size_t i (0); i <= manager3.max_batch_size; ++i)
+	{
+		manager3.put_message (item);
+	}
+	ASSERT_EQ (manager3.max_batch_size, manager3.get_messages ().size ());
+	ASSERT_EQ (1, manager3.get_messages ().size ());
+	manager3.stop ();
+	ASSERT_TRUE (manager3.get_messages ().empty ());
 }
 }
+
+TEST (network, tcp_filter_publishes)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::genesis genesis;
+	std::shared_ptr<nano::block> block (std::make_shared<nano::send_block> (1, 1, 20, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	nano::tcp_message_item item;
+	std::vector<nano::tcp_message_item> items;
+	item.message = std::make_shared<nano::publish> (genesis.open);
+	items.push_back (item);
+	item.message = std::make_shared<nano::keepalive> ();
+	items.push_back (item);
+	item.message = std::make_shared<nano::publish> (block);
+	items.push_back (item);
+	// A copy of the first publish within the same batch is a duplicate
+	item.message = std::make_shared<nano::publish> (genesis.open);
+	items.push_back (item);
+	node.network.tcp_channels.filter_publishes (items);
+	ASSERT_NE (nullptr, items[0].message);
+	ASSERT_NE (nullptr, items[1].message);
+	ASSERT_NE (nullptr, items[2].message);
+	ASSERT_EQ (nullptr, items[3].message);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::filter, nano::stat::detail::duplicate_publish));
+	// Digests are attached so that the filter can be cleared if the block is dropped later
+	ASSERT_EQ (node.network.publish_filter.hash (genesis.open), static_cast<nano::publish &> (*items[0].message).digest);
+	ASSERT_EQ (node.network.publish_filter.hash (block), static_cast<nano::publish &> (*items[2].message).digest);
+	// Publishes of a later batch are checked against the earlier ones
+	std::vector<nano::tcp_message_item> items2{ items[2] };
+	node.network.tcp_channels.filter_publishes (items2);
+	ASSERT_EQ (nullptr, items2[0].message);
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::filter, nano::stat::detail::duplicate_publish));
+}
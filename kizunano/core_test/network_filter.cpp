@@ -6,6 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 TEST (network_filter, unit)
 {
 	nano::genesis genesis;
@@ -109,3 +112,85 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+TEST (network_filter, check)
+{
+	nano::network_filter filter (4);
+	std::vector<uint8_t> bytes1{ 1, 2, 3 };
+	ASSERT_FALSE (filter.check (bytes1.data (), bytes1.size ()));
+	// Looking up does not insert
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_TRUE (filter.check (bytes1.data (), bytes1.size ()));
+}
+
+TEST (network_filter, batch)
+{
+	nano::network_filter filter (1024);
+	std::vector<std::vector<uint8_t>> messages;
+	for (uint8_t i (0); i < 11; ++i)
+	{
+		// Varying sizes exercise both the lockstep and the per-lane tail of the batch hash
+		messages.emplace_back (i * 7, i);
+	}
+	std::vector<std::pair<uint8_t const *, size_t>> items;
+	for (auto const & message : messages)
+	{
+		items.emplace_back (message.data (), message.size ());
+	}
+	// A repeated message is reported as a duplicate within the same batch
+	items.push_back (items[3]);
+	std::vector<nano::uint128_t> digests;
+	auto existed (filter.apply (items, &digests));
+	ASSERT_EQ (items.size (), existed.size ());
+	ASSERT_EQ (items.size (), digests.size ());
+	for (size_t i (0); i < messages.size (); ++i)
+	{
+		ASSERT_FALSE (existed[i]);
+		// Batch digests must match the single message path
+		nano::uint128_t digest{ 0 };
+		ASSERT_TRUE (filter.apply (messages[i].data (), messages[i].size (), &digest));
+		ASSERT_EQ (digest, digests[i]);
+	}
+	ASSERT_TRUE (existed.back ());
+	ASSERT_EQ (digests[3], digests.back ());
+	filter.clear (digests);
+	ASSERT_FALSE (filter.apply (messages[0].data (), messages[0].size ()));
+}
+
+TEST (network_filter, concurrent)
+{
+	nano::network_filter filter (64 * 1024, 16);
+	std::vector<std::vector<uint8_t>> messages;
+	for (uint32_t i (0); i < 256; ++i)
+	{
+		messages.emplace_back (reinterpret_cast<uint8_t const *> (&i), reinterpret_cast<uint8_t const *> (&i) + sizeof (i));
+	}
+	std::vector<std::atomic<unsigned>> unique (messages.size ());
+	std::vector<std::thread> threads;
+	for (auto i (0); i < 8; ++i)
+	{
+		threads.emplace_back ([&filter, &messages, &unique]() {
+			for (size_t j (0); j < messages.size (); ++j)
+			{
+				if (!filter.apply (messages[j].data (), messages[j].size ()))
+				{
+					++unique[j];
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	// The first insertion of each digest is always seen as unique
+	for (auto const & count : unique)
+	{
+		ASSERT_GE (count, 1);
+	}
+	filter.clear ();
+	for (auto const & message : messages)
+	{
+		ASSERT_FALSE (filter.apply (message.data (), message.size ()));
+	}
+}
@@ -2523,6 +2523,59 @@ TEST (node, bootstrap_connection_scaling)
 	ASSERT_EQ (1, node1.bootstrap_initiator.connections->target_connections (50000, 1));
 }
 
+TEST (node, bootstrap_throughput_target)
+{
+	nano::system system (1);
+	auto connections_l (std::make_shared<nano::bootstrap_connections> (*system.nodes[0]));
+	auto & connections (*connections_l);
+	auto window (nano::bootstrap_limits::bootstrap_throughput_window);
+	// Without blocks flowing the demand is the target
+	ASSERT_EQ (64, connections.throughput_target (64, 0.0));
+	connections.connections_count = 8;
+	for (auto i (0u); i < window * 4; ++i)
+	{
+		ASSERT_EQ (64, connections.throughput_target (64, 1000.0));
+	}
+	// Doubling the connections without raising the rate caps the target at the previous count
+	connections.connections_count = 16;
+	for (auto i (0u); i < window * 4; ++i)
+	{
+		connections.throughput_target (64, 1000.0);
+	}
+	ASSERT_EQ (8, connections.throughput_target (64, 1000.0));
+	// A rising rate lets the target grow again
+	connections.connections_count = 8;
+	for (auto i (0u); i < window * 4; ++i)
+	{
+		connections.throughput_target (64, 4000.0);
+	}
+	ASSERT_LT (8, connections.throughput_target (64, 4000.0));
+	// Demand still applies
+	ASSERT_EQ (4, connections.throughput_target (4, 4000.0));
+}
+
+TEST (node, bootstrap_peer_score)
+{
+	nano::system system (1);
+	auto connections_l (std::make_shared<nano::bootstrap_connections> (*system.nodes[0]));
+	auto & connections (*connections_l);
+	nano::tcp_endpoint endpoint1 (boost::asio::ip::address_v6::loopback (), 10000);
+	nano::tcp_endpoint endpoint2 (boost::asio::ip::address_v6::loopback (), 10001);
+	ASSERT_EQ (0.0, connections.peer_score (endpoint1));
+	{
+		nano::lock_guard<std::mutex> guard (connections.mutex);
+		connections.scores[endpoint1].rate = 500.0;
+		connections.scores[endpoint2].rate = 1000.0;
+	}
+	ASSERT_EQ ((std::vector<nano::tcp_endpoint>{ endpoint2, endpoint1 }), connections.best_peers (2, {}));
+	// Failures lower the ranking
+	connections.peer_failure (endpoint2);
+	connections.peer_failure (endpoint2);
+	ASSERT_DOUBLE_EQ (1000.0 / 3.0, connections.peer_score (endpoint2));
+	ASSERT_EQ ((std::vector<nano::tcp_endpoint>{ endpoint1 }), connections.best_peers (1, {}));
+	ASSERT_EQ ((std::vector<nano::tcp_endpoint>{ endpoint2 }), connections.best_peers (2, { endpoint1 }));
+}
+
 // Test stat counting at both type and detail levels
 TEST (node, stat_counting)
 {
@@ -117,6 +117,53 @@ TEST (channels, fill_random_part)
 	ASSERT_TRUE (std::all_of (target.begin () + half, target.end (), [](nano::endpoint const & endpoint_a) { return endpoint_a == nano::endpoint (boost::asio::ip::address_v6::any (), 0); }));
 }
 
+TEST (channels, random_set)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	for (auto i (0); i < 20; ++i)
+	{
+		ASSERT_NE (nullptr, node.network.udp_channels.insert (nano::endpoint (boost::asio::ip::address_v6::loopback (), 10000 + i), node.network_params.protocol.protocol_version));
+	}
+	// Distinct channels are sampled without retries, so the full amount is always returned
+	ASSERT_EQ (8, node.network.udp_channels.random_set (8).size ());
+	ASSERT_EQ (20, node.network.udp_channels.random_set (100).size ());
+	ASSERT_TRUE (node.network.udp_channels.random_set (100, node.network_params.protocol.protocol_version + 1).empty ());
+	for (auto i (0); i < 10; ++i)
+	{
+		node.network.udp_channels.erase (nano::endpoint (boost::asio::ip::address_v6::loopback (), 10000 + i));
+	}
+	auto remaining (node.network.udp_channels.random_set (100));
+	ASSERT_EQ (10, remaining.size ());
+	ASSERT_TRUE (std::all_of (remaining.begin (), remaining.end (), [](std::shared_ptr<nano::transport::channel> const & channel_a) { return channel_a->get_endpoint ().port () >= 10010; }));
+}
+
+TEST (channels, random_set_weighted)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	for (auto i (0); i < 10; ++i)
+	{
+		ASSERT_NE (nullptr, node.network.udp_channels.insert (nano::endpoint (boost::asio::ip::address_v6::loopback (), 10000 + i), node.network_params.protocol.protocol_version));
+	}
+	auto rep (node.network.udp_channels.channel (nano::endpoint (boost::asio::ip::address_v6::loopback (), 10000)));
+	ASSERT_NE (nullptr, rep);
+	node.network.set_sampling_weight (*rep, nano::genesis_amount, nano::genesis_amount);
+	auto rep_first (0);
+	for (auto i (0); i < 100; ++i)
+	{
+		auto sample (node.network.random_set_weighted (3));
+		ASSERT_EQ (3, sample.size ());
+		ASSERT_EQ (3, std::unordered_set<std::shared_ptr<nano::transport::channel>> (sample.begin (), sample.end ()).size ());
+		rep_first += sample.front () == rep;
+	}
+	ASSERT_GT (rep_first, 90);
+	node.network.udp_channels.erase (rep->get_endpoint ());
+	auto sample (node.network.random_set_weighted (20));
+	ASSERT_EQ (9, sample.size ());
+	ASSERT_EQ (sample.end (), std::find (sample.begin (), sample.end (), rep));
+}
+
 TEST (peer_container, list_fanout)
 {
 	nano::system system (1);
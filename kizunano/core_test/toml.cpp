@@ -143,6 +143,10 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.opencl.threads, defaults.opencl.threads);
 	ASSERT_EQ (conf.rpc_enable, defaults.rpc_enable);
 	ASSERT_EQ (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
+	ASSERT_EQ (conf.rpc.response_chunk_size, defaults.rpc.response_chunk_size);
+	ASSERT_EQ (conf.rpc.batch_max_requests, defaults.rpc.batch_max_requests);
+	ASSERT_EQ (conf.rpc.scan_time_budget, defaults.rpc.scan_time_budget);
+	ASSERT_EQ (conf.rpc.in_process_threads, defaults.rpc.in_process_threads);
 	ASSERT_EQ (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_EQ (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
@@ -151,10 +155,17 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_EQ (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_EQ (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_EQ (conf.node.bandwidth_limit_vote_ratio, defaults.node.bandwidth_limit_vote_ratio);
+	ASSERT_EQ (conf.node.bandwidth_limit_peer, defaults.node.bandwidth_limit_peer);
+	ASSERT_EQ (conf.node.bandwidth_limit_inbound, defaults.node.bandwidth_limit_inbound);
+	ASSERT_EQ (conf.node.bandwidth_limit_inbound_peer, defaults.node.bandwidth_limit_inbound_peer);
+	ASSERT_EQ (conf.node.block_announcements, defaults.node.block_announcements);
 	ASSERT_EQ (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_EQ (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_EQ (conf.node.bootstrap_initiator_threads, defaults.node.bootstrap_initiator_threads);
+	ASSERT_EQ (conf.node.bootstrap_compression, defaults.node.bootstrap_compression);
+	ASSERT_EQ (conf.node.bootstrap_pull_pipeline, defaults.node.bootstrap_pull_pipeline);
 	ASSERT_EQ (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_EQ (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_EQ (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
@@ -187,6 +198,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
+	ASSERT_EQ (conf.node.rpc_response_cache_size, defaults.node.rpc_response_cache_size);
 
 	ASSERT_EQ (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_EQ (conf.node.logging.flush, defaults.node.logging.flush);
@@ -397,10 +409,17 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	backup_before_upgrade = true
 	bandwidth_limit = 999
 	bandwidth_limit_burst_ratio = 999.9
+	bandwidth_limit_vote_ratio = 0.5
+	bandwidth_limit_peer = 999
+	bandwidth_limit_inbound = 999
+	bandwidth_limit_inbound_peer = 999
+	block_announcements = false
 	block_processor_batch_max_time = 999
 	bootstrap_connections = 999
 	bootstrap_connections_max = 999
 	bootstrap_initiator_threads = 999
+	bootstrap_compression = true
+	bootstrap_pull_pipeline = 16
 	bootstrap_fraction_numerator = 999
 	conf_height_processor_batch_min_time = 999
 	confirmation_history_size = 999
@@ -432,6 +451,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	work_watcher_period = 999
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
+	rpc_response_cache_size = 999
 	frontiers_confirmation = "always"
 	[node.diagnostics.txn_tracking]
 	enable = true
@@ -537,6 +557,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[rpc]
 	enable = true
 	enable_sign_hash = true
+	response_chunk_size = 999
+	batch_max_requests = 999
+	scan_time_budget = 999
+	in_process_threads = 999
 
 	[rpc.child_process]
 	enable = true
@@ -557,6 +581,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.opencl.threads, defaults.opencl.threads);
 	ASSERT_NE (conf.rpc_enable, defaults.rpc_enable);
 	ASSERT_NE (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
+	ASSERT_NE (conf.rpc.response_chunk_size, defaults.rpc.response_chunk_size);
+	ASSERT_NE (conf.rpc.batch_max_requests, defaults.rpc.batch_max_requests);
+	ASSERT_NE (conf.rpc.scan_time_budget, defaults.rpc.scan_time_budget);
+	ASSERT_NE (conf.rpc.in_process_threads, defaults.rpc.in_process_threads);
 	ASSERT_NE (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_NE (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
@@ -565,10 +593,17 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_NE (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_NE (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_NE (conf.node.bandwidth_limit_vote_ratio, defaults.node.bandwidth_limit_vote_ratio);
+	ASSERT_NE (conf.node.bandwidth_limit_peer, defaults.node.bandwidth_limit_peer);
+	ASSERT_NE (conf.node.bandwidth_limit_inbound, defaults.node.bandwidth_limit_inbound);
+	ASSERT_NE (conf.node.bandwidth_limit_inbound_peer, defaults.node.bandwidth_limit_inbound_peer);
+	ASSERT_NE (conf.node.block_announcements, defaults.node.block_announcements);
 	ASSERT_NE (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_NE (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_NE (conf.node.bootstrap_initiator_threads, defaults.node.bootstrap_initiator_threads);
+	ASSERT_NE (conf.node.bootstrap_compression, defaults.node.bootstrap_compression);
+	ASSERT_NE (conf.node.bootstrap_pull_pipeline, defaults.node.bootstrap_pull_pipeline);
 	ASSERT_NE (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_NE (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_NE (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
@@ -602,6 +637,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_NE (conf.node.max_queued_requests, defaults.node.max_queued_requests);
+	ASSERT_NE (conf.node.rpc_response_cache_size, defaults.node.rpc_response_cache_size);
 
 	ASSERT_NE (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_NE (conf.node.logging.flush, defaults.node.logging.flush);
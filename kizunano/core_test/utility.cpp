@@ -1,3 +1,5 @@
+#include <kizunano/lib/json_flat_object.hpp>
+#include <kizunano/lib/json_writer.hpp>
 #include <kizunano/lib/optional_ptr.hpp>
 #include <kizunano/lib/rate_limiting.hpp>
 #include <kizunano/lib/threading.hpp>
@@ -9,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
 
 using namespace std::chrono_literals;
 
@@ -230,4 +233,85 @@ TEST (relaxed_atomic_integral, many_threads)
 
 	// Check values
 	ASSERT_EQ (0, atomic);
-}
\ No newline at end of file
+}
+
+TEST (json_writer, write_json_compatible)
+{
+	boost::property_tree::ptree tree;
+	tree.put ("text", "quote \" slash / backslash \\ newline \n tab \t control \x01 high \xc3\xa9");
+	boost::property_tree::ptree empty;
+	tree.add_child ("empty", empty);
+	boost::property_tree::ptree object;
+	object.put ("a", "1");
+	boost::property_tree::ptree nested;
+	nested.put ("b", "2");
+	object.add_child ("nested", nested);
+	object.add_child ("empty", empty);
+	tree.add_child ("object", object);
+	boost::property_tree::ptree array;
+	array.push_back (std::make_pair ("", boost::property_tree::ptree ("x")));
+	array.push_back (std::make_pair ("", object));
+	tree.add_child ("array", array);
+	std::stringstream expected;
+	boost::property_tree::write_json (expected, tree);
+
+	nano::json_writer writer;
+	writer.put ("text", tree.get<std::string> ("text"));
+	writer.begin_object ("empty");
+	writer.end ();
+	auto first (writer.take ());
+	writer.begin_object ("object");
+	writer.put ("a", "1");
+	writer.begin_object ("nested");
+	writer.put ("b", "2");
+	writer.end ();
+	writer.put_child ("empty", empty);
+	writer.end ();
+	writer.begin_array ("array");
+	writer.put ("x");
+	writer.begin_object ();
+	writer.put ("a", "1");
+	writer.put_child ("nested", nested);
+	writer.begin_array ("empty");
+	writer.end ();
+	writer.finish ();
+	ASSERT_EQ (expected.str (), first + writer.take ());
+	ASSERT_EQ (0, writer.size ());
+
+	nano::json_writer empty_writer;
+	empty_writer.finish ();
+	std::stringstream expected_empty;
+	boost::property_tree::write_json (expected_empty, empty);
+	ASSERT_EQ (expected_empty.str (), empty_writer.take ());
+}
+
+TEST (json_flat_object, read_json_compatible)
+{
+	std::string text ("{ \"action\" : \"account_balance\",\n\"flag\": true, \"none\": null, \"number\": -12.5e+3, \"number\": 0 }");
+	nano::json_flat_object flat;
+	ASSERT_FALSE (flat.parse (text));
+	boost::property_tree::ptree tree;
+	std::stringstream istream (text);
+	boost::property_tree::read_json (istream, tree);
+	ASSERT_EQ (tree.size (), flat.size ());
+	for (auto const & member : tree)
+	{
+		auto value (flat.get (member.first));
+		ASSERT_TRUE (value.is_initialized ());
+		ASSERT_EQ (tree.get<std::string> (member.first), *value);
+	}
+	ASSERT_FALSE (flat.get ("missing").is_initialized ());
+	ASSERT_FALSE (flat.parse ("{}"));
+	ASSERT_EQ (0, flat.size ());
+	// Valid JSON that is left to read_json
+	ASSERT_TRUE (flat.parse ("{\"a\": \"\\\"\"}"));
+	ASSERT_TRUE (flat.parse ("{\"a\": {}}"));
+	ASSERT_TRUE (flat.parse ("{\"a\": [1]}"));
+	ASSERT_TRUE (flat.parse ("[]"));
+	// Invalid JSON
+	ASSERT_TRUE (flat.parse ("{\"a\": 01}"));
+	ASSERT_TRUE (flat.parse ("{\"a\": 1.}"));
+	ASSERT_TRUE (flat.parse ("{\"a\": 1,}"));
+	ASSERT_TRUE (flat.parse ("{\"a\": 1} x"));
+	ASSERT_TRUE (flat.parse (""));
+}
@@ -53,6 +53,9 @@ public:
 	virtual void telemetry_ack (nano::telemetry_ack const &) override
 	{
 	}
+	virtual void block_announce (nano::block_announce const &) override
+	{
+	}
 };
 }
 
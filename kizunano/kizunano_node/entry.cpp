@@ -1,4 +1,5 @@
 #include <kizunano/crypto_lib/random_pool.hpp>
+#include <kizunano/lib/threading.hpp>
 #include <kizunano/lib/utility.hpp>
 #include <kizunano/kizunano_node/daemon.hpp>
 #include <kizunano/node/cli.hpp>
@@ -7,6 +8,7 @@
 #include <kizunano/node/json_handler.hpp>
 #include <kizunano/node/node.hpp>
 #include <kizunano/node/testing.hpp>
+#include <kizunano/rpc/rpc_request_processor.hpp>
 
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -15,6 +17,7 @@
 #include <boost/program_options.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <future>
 #include <numeric>
 #include <sstream>
 
@@ -90,9 +93,12 @@ int main (int argc, char * const * argv)
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
 		("debug_profile_sign", "Profile signature generation")
+		("debug_profile_network_filter", "Profile the publish duplicate filter from many threads, with a single lock and with striped locks, one message and a batch at a time. Uses --threads and --count")
 		("debug_profile_process", "Profile active blocks processing (only for nano_test_network)")
 		("debug_profile_votes", "Profile votes processing (only for nano_test_network)")
 		("debug_profile_frontiers_confirmation", "Profile frontiers confirmation speed (only for nano_test_network)")
+		("debug_profile_rpc", "Profile the hottest RPC actions answered through property trees and directly, in a new ledger. Uses --count")
+		("debug_profile_rpc_dispatch", "Profile the latency of RPC requests forwarded over IPC, run in-process on the I/O thread and run in-process on an executor, in a new ledger. Uses --count")
 		("debug_random_feed", "Generates output to RNG test suites")
 		("debug_rpc", "Read an RPC command from stdin and invoke it. Network operations will have no effect.")
 		("debug_peers", "Display peer IPv6:port connections")
@@ -884,6 +890,77 @@ int main (int argc, char * const * argv)
 			auto end (std::chrono::high_resolution_clock::now ());
 			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
 		}
+		else if (vm.count ("debug_profile_network_filter"))
+		{
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			size_t count (256 * 1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			// Same size as the payload of a state block publish
+			size_t const message_size (nano::state_block::size);
+			size_t const batch_size (64);
+			std::vector<uint8_t> messages (count * message_size);
+			nano::random_pool::generate_block (messages.data (), messages.size ());
+			auto run = [&](std::string const & name_a, size_t stripes_a, bool batch_a) {
+				nano::network_filter filter (256 * 1024, stripes_a);
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (auto i (0u); i < threads_count; ++i)
+				{
+					threads.emplace_back ([&filter, &messages, count, message_size, batch_size, batch_a, i, threads_count]() {
+						// Each thread starts at a different offset so that threads insert and lookup concurrently
+						auto offset (count * i / threads_count);
+						std::vector<std::pair<uint8_t const *, size_t>> items;
+						for (size_t j (0); j < count; ++j)
+						{
+							auto data (messages.data () + ((offset + j) % count) * message_size);
+							if (batch_a)
+							{
+								items.emplace_back (data, message_size);
+								if (items.size () == batch_size || j + 1 == count)
+								{
+									filter.apply (items);
+									items.clear ();
+								}
+							}
+							else
+							{
+								filter.apply (data, message_size);
+							}
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+				auto total (count * threads_count);
+				std::cout << boost::str (boost::format ("%1%: %2% applies in %3% us, %4% applies/s\n") % name_a % total % elapsed % static_cast<uint64_t> (total * 1e6 / std::max<int64_t> (1, elapsed)));
+			};
+			std::cout << boost::str (boost::format ("Profiling network filter with %1% threads, %2% messages of %3% bytes\n") % threads_count % count % message_size);
+			run ("Single lock", 1, false);
+			run ("Striped", 64, false);
+			run ("Single lock, batch", 1, true);
+			run ("Striped, batch", 64, true);
+		}
 		else if (vm.count ("debug_profile_sign"))
 		{
 			std::cerr << "Starting blocks signing profiling\n";
@@ -901,6 +978,118 @@ int main (int argc, char * const * argv)
 				std::cerr << boost::str (boost::format ("%|1$ 12d|\n") % std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ());
 			}
 		}
+		else if (vm.count ("debug_profile_rpc"))
+		{
+			size_t count (100 * 1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			nano::update_flags (node_flags, vm);
+			node_flags.generate_cache.enable_all ();
+			nano::inactive_node inactive_node_l (nano::unique_path (), node_flags);
+			auto & node (*inactive_node_l.node);
+			nano::node_rpc_config config;
+			nano::network_params network_params;
+			auto account_text (network_params.ledger.genesis_account.to_account ());
+			auto hash_text (network_params.ledger.genesis_hash.to_string ());
+			std::vector<std::pair<std::string, std::string>> requests{
+				{ "account_balance", "{\"action\": \"account_balance\", \"account\": \"" + account_text + "\"}" },
+				{ "account_weight", "{\"action\": \"account_weight\", \"account\": \"" + account_text + "\"}" },
+				{ "block_account", "{\"action\": \"block_account\", \"hash\": \"" + hash_text + "\"}" },
+				{ "block_count", "{\"action\": \"block_count\"}" },
+				{ "work_validate", "{\"action\": \"work_validate\", \"hash\": \"" + hash_text + "\", \"work\": \"0000000000000000\"}" }
+			};
+			std::cout << boost::str (boost::format ("Profiling %1% requests of each action\n") % count);
+			for (auto const & request : requests)
+			{
+				std::array<std::string, 2> responses;
+				std::array<int64_t, 2> elapsed;
+				for (auto fast : { false, true })
+				{
+					auto begin (std::chrono::steady_clock::now ());
+					for (size_t i (0); i < count; ++i)
+					{
+						auto handler (std::make_shared<nano::json_handler> (node, config, request.second, [&responses, fast](std::string const & response_a) {
+							responses[fast] = response_a;
+						}));
+						handler->fast_path = fast;
+						handler->process_request ();
+					}
+					elapsed[fast] = std::max<int64_t> (1, std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+				}
+				std::cout << boost::str (boost::format ("%1%: %2% requests/s through property trees, %3% requests/s direct, %4$.2f times faster%5%\n") % request.first % static_cast<uint64_t> (count * 1e6 / elapsed[0]) % static_cast<uint64_t> (count * 1e6 / elapsed[1]) % (static_cast<double> (elapsed[0]) / elapsed[1]) % (responses[0] == responses[1] ? "" : ", responses differ"));
+			}
+		}
+		else if (vm.count ("debug_profile_rpc_dispatch"))
+		{
+			size_t count (10 * 1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count) || count == 0)
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			nano::update_flags (node_flags, vm);
+			node_flags.generate_cache.enable_all ();
+			nano::inactive_node inactive_node_l (nano::unique_path (), node_flags);
+			auto & node (*inactive_node_l.node);
+			node.config.ipc_config.transport_tcp.enabled = true;
+			nano::node_rpc_config config;
+			nano::node_rpc_config executor_config;
+			executor_config.in_process_threads = 2;
+			nano::ipc::ipc_server ipc_server (node, config);
+			nano::thread_runner runner (*inactive_node_l.io_context, 2);
+			nano::rpc_config rpc_config;
+			rpc_config.rpc_process.ipc_port = node.config.ipc_config.transport_tcp.port;
+			nano::ipc_rpc_processor ipc_processor (*inactive_node_l.io_context, rpc_config);
+			nano::inprocess_rpc_handler direct (node, ipc_server, config);
+			nano::inprocess_rpc_handler executor (node, ipc_server, executor_config);
+			std::vector<std::pair<std::string, nano::rpc_handler_interface *>> paths{ { "IPC", &ipc_processor }, { "in-process", &direct }, { "in-process executor", &executor } };
+			nano::network_params network_params;
+			std::vector<std::pair<std::string, std::string>> requests{
+				{ "account_balance", "{\"action\": \"account_balance\", \"account\": \"" + network_params.ledger.genesis_account.to_account () + "\"}" },
+				{ "block_count", "{\"action\": \"block_count\"}" }
+			};
+			std::cout << boost::str (boost::format ("Profiling %1% requests of each action, one at a time\n") % count);
+			for (auto const & request : requests)
+			{
+				for (auto const & path : paths)
+				{
+					std::vector<int64_t> latencies;
+					latencies.reserve (count);
+					// The first requests open the IPC connections and are not measured
+					for (size_t i (0); i < count + 100; ++i)
+					{
+						std::promise<void> promise;
+						auto begin (std::chrono::steady_clock::now ());
+						path.second->process_request (request.first, request.second, [&promise](std::string const &) { promise.set_value (); }, nullptr);
+						promise.get_future ().wait ();
+						if (i >= 100)
+						{
+							latencies.push_back (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+						}
+					}
+					std::sort (latencies.begin (), latencies.end ());
+					auto mean (std::accumulate (latencies.begin (), latencies.end (), int64_t (0)) / latencies.size ());
+					std::cout << boost::str (boost::format ("%1% %2%: mean %3$.1f us, median %4$.1f us, 99th percentile %5$.1f us\n") % request.first % path.first % (mean / 1e3) % (latencies[latencies.size () / 2] / 1e3) % (latencies[latencies.size () * 99 / 100] / 1e3));
+				}
+			}
+			ipc_processor.stop ();
+			ipc_server.stop ();
+			runner.stop_event_processing ();
+			runner.join ();
+		}
 		else if (vm.count ("debug_profile_process"))
 		{
 			nano::network_constants::set_active_network (nano::nano_networks::nano_test_network);
@@ -127,6 +127,8 @@ std::string nano::error_rpc_messages::message (int ev) const
 	{
 		case nano::error_rpc::generic:
 			return "Unknown error";
+		case nano::error_rpc::bad_cursor:
+			return "Bad cursor";
 		case nano::error_rpc::bad_destination:
 			return "Bad destination account";
 		case nano::error_rpc::bad_difficulty_format:
@@ -147,6 +149,10 @@ std::string nano::error_rpc_messages::message (int ev) const
 			return "Bad timeout number";
 		case nano::error_rpc::bad_work_version:
 			return "Bad work version";
+		case nano::error_rpc::batch_action_not_allowed:
+			return "Action is not allowed in a batch";
+		case nano::error_rpc::batch_too_large:
+			return "Batch has more requests than allowed";
 		case nano::error_rpc::block_create_balance_mismatch:
 			return "Balance mismatch for previous block";
 		case nano::error_rpc::block_create_key_required:
@@ -76,6 +76,7 @@ enum class error_blocks
 enum class error_rpc
 {
 	generic = 1,
+	bad_cursor,
 	bad_destination,
 	bad_difficulty_format,
 	bad_key,
@@ -86,6 +87,8 @@ enum class error_rpc
 	bad_source,
 	bad_timeout,
 	bad_work_version,
+	batch_action_not_allowed,
+	batch_too_large,
 	block_create_balance_mismatch,
 	block_create_key_required,
 	block_create_public_key_mismatch,
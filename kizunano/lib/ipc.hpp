@@ -70,7 +70,14 @@ namespace ipc
 		flatbuffers = 0x3,
 
 		/** JSON -> Flatbuffers -> JSON  */
-		flatbuffers_json = 0x4
+		flatbuffers_json = 0x4,
+
+		/**
+		 * Request is the same as json_v1.
+		 * Response is a sequence of 32-bit BE length prefixed parts ending with an empty part, the JSON being their concatenation.
+		 * Large responses are written as they are produced instead of being built in full first.
+		 */
+		json_v1_chunked = 0x5
 	};
 
 	/** IPC transport interface */
@@ -230,6 +230,20 @@ public:
 		return err;
 	}
 
+	void close ()
+	{
+		if (tcp_client)
+		{
+			tcp_client->close ();
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		else if (domain_client)
+		{
+			domain_client->close ();
+		}
+#endif
+	}
+
 	channel & get_channel ()
 	{
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
@@ -300,6 +314,14 @@ void nano::ipc::ipc_client::async_read_message (std::shared_ptr<std::vector<uint
 	});
 }
 
+void nano::ipc::ipc_client::close ()
+{
+	if (impl)
+	{
+		boost::polymorphic_downcast<client_impl *> (impl.get ())->close ();
+	}
+}
+
 std::vector<uint8_t> nano::ipc::get_preamble (nano::ipc::payload_encoding encoding_a)
 {
 	std::vector<uint8_t> buffer_l;
@@ -324,7 +346,7 @@ nano::shared_const_buffer nano::ipc::prepare_flatbuffers_request (std::shared_pt
 nano::shared_const_buffer nano::ipc::prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a)
 {
 	std::vector<uint8_t> buffer_l;
-	if (encoding_a == nano::ipc::payload_encoding::json_v1 || encoding_a == nano::ipc::payload_encoding::flatbuffers_json)
+	if (encoding_a == nano::ipc::payload_encoding::json_v1 || encoding_a == nano::ipc::payload_encoding::json_v1_chunked || encoding_a == nano::ipc::payload_encoding::flatbuffers_json)
 	{
 		buffer_l = get_preamble (encoding_a);
 		auto payload_length = static_cast<uint32_t> (payload_a.size ());
@@ -56,6 +56,9 @@ namespace ipc
 		 */
 		void async_read_message (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, std::chrono::seconds timeout_a, std::function<void(nano::error, size_t)> callback_a);
 
+		/** Shut down and close the connection, later reads and writes fail until it is connected again */
+		void close ();
+
 	private:
 		boost::asio::io_context & io_ctx;
 
@@ -0,0 +1,150 @@
+#include <kizunano/lib/json_flat_object.hpp>
+
+#include <cstring>
+
+bool nano::json_flat_object::parse (std::string const & text_a)
+{
+	members.clear ();
+	position = text_a.data ();
+	end = text_a.data () + text_a.size ();
+	whitespace ();
+	auto error (position == end || *position != '{');
+	if (!error)
+	{
+		++position;
+		whitespace ();
+		auto done (position != end && *position == '}');
+		while (!error && !done)
+		{
+			std::string key;
+			std::string value;
+			error = string (key);
+			whitespace ();
+			error = error || position == end || *position != ':';
+			if (!error)
+			{
+				++position;
+				whitespace ();
+				error = position == end || (*position == '"' ? string (value) : literal (value));
+				whitespace ();
+			}
+			if (!error)
+			{
+				members.emplace_back (std::move (key), std::move (value));
+				error = position == end || (*position != ',' && *position != '}');
+				done = !error && *position == '}';
+				if (!error && !done)
+				{
+					++position;
+					whitespace ();
+				}
+			}
+		}
+		if (!error)
+		{
+			++position;
+			whitespace ();
+			error = position != end;
+		}
+	}
+	return error;
+}
+
+boost::optional<std::string> nano::json_flat_object::get (std::string const & key_a) const
+{
+	boost::optional<std::string> result;
+	for (auto i (members.begin ()), n (members.end ()); i != n && !result; ++i)
+	{
+		if (i->first == key_a)
+		{
+			result = i->second;
+		}
+	}
+	return result;
+}
+
+size_t nano::json_flat_object::size () const
+{
+	return members.size ();
+}
+
+bool nano::json_flat_object::string (std::string & result_a)
+{
+	auto error (position == end || *position != '"');
+	if (!error)
+	{
+		auto begin (++position);
+		// Escapes and control characters are left to read_json
+		while (position != end && *position != '"' && *position != '\\' && static_cast<unsigned char> (*position) >= 0x20)
+		{
+			++position;
+		}
+		error = position == end || *position != '"';
+		if (!error)
+		{
+			result_a.assign (begin, position);
+			++position;
+		}
+	}
+	return error;
+}
+
+bool nano::json_flat_object::literal (std::string & result_a)
+{
+	auto begin (position);
+	auto error (false);
+	auto word ([this](char const * word_a) {
+		auto size (std::strlen (word_a));
+		auto result (static_cast<size_t> (end - position) >= size && std::equal (word_a, word_a + size, position));
+		if (result)
+		{
+			position += size;
+		}
+		return result;
+	});
+	auto digits ([this]() {
+		auto begin_l (position);
+		while (position != end && *position >= '0' && *position <= '9')
+		{
+			++position;
+		}
+		return position != begin_l;
+	});
+	if (!word ("true") && !word ("false") && !word ("null"))
+	{
+		// Number, as in the JSON grammar
+		if (position != end && *position == '-')
+		{
+			++position;
+		}
+		auto leading_zero (position != end && *position == '0');
+		error = !digits () || (leading_zero && position - begin > (*begin == '-' ? 2 : 1));
+		if (!error && position != end && *position == '.')
+		{
+			++position;
+			error = !digits ();
+		}
+		if (!error && position != end && (*position == 'e' || *position == 'E'))
+		{
+			++position;
+			if (position != end && (*position == '+' || *position == '-'))
+			{
+				++position;
+			}
+			error = !digits ();
+		}
+	}
+	if (!error)
+	{
+		result_a.assign (begin, position);
+	}
+	return error;
+}
+
+void nano::json_flat_object::whitespace ()
+{
+	while (position != end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r'))
+	{
+		++position;
+	}
+}
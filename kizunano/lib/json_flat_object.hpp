@@ -0,0 +1,35 @@
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nano
+{
+/**
+ * A JSON object whose members are all strings, numbers, booleans or null, parsed without building a property tree.
+ * Values are kept as read_json would store them: strings unquoted, other values as written.
+ */
+class json_flat_object final
+{
+public:
+	/**
+	 * Parses \p text_a, returns true if it is not a flat object or uses anything parse does not handle, such as escapes,
+	 * in which case the text should be given to read_json instead.
+	 */
+	bool parse (std::string const & text_a);
+	/** Value of the first member named \p key_a */
+	boost::optional<std::string> get (std::string const & key_a) const;
+	size_t size () const;
+
+private:
+	bool string (std::string &);
+	bool literal (std::string &);
+	void whitespace ();
+	std::vector<std::pair<std::string, std::string>> members;
+	char const * position{ nullptr };
+	char const * end{ nullptr };
+};
+}
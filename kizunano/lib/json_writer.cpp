@@ -0,0 +1,214 @@
+#include <kizunano/lib/json_writer.hpp>
+#include <kizunano/lib/utility.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+nano::json_writer::json_writer ()
+{
+	levels.push_back (level{ false, 0 });
+	buffer.push_back ('{');
+}
+
+void nano::json_writer::begin_object (std::string const & key_a)
+{
+	debug_assert (!levels.empty () && !levels.back ().array);
+	next ();
+	key (key_a);
+	levels.push_back (level{ false, 0 });
+}
+
+void nano::json_writer::begin_object ()
+{
+	debug_assert (!levels.empty () && levels.back ().array);
+	next ();
+	levels.push_back (level{ false, 0 });
+}
+
+void nano::json_writer::begin_array (std::string const & key_a)
+{
+	debug_assert (!levels.empty () && !levels.back ().array);
+	next ();
+	key (key_a);
+	levels.push_back (level{ true, 0 });
+}
+
+void nano::json_writer::end ()
+{
+	debug_assert (!levels.empty ());
+	auto level_l (levels.back ());
+	levels.pop_back ();
+	if (level_l.count == 0 && !levels.empty ())
+	{
+		// Nothing was opened, write_json gives empty children an empty value
+		buffer.append ("\"\"");
+	}
+	else
+	{
+		buffer.push_back ('\n');
+		buffer.append (4 * levels.size (), ' ');
+		buffer.push_back (level_l.array ? ']' : '}');
+	}
+}
+
+void nano::json_writer::put (std::string const & key_a, std::string const & value_a)
+{
+	debug_assert (!levels.empty () && !levels.back ().array);
+	next ();
+	key (key_a);
+	buffer.push_back ('"');
+	escape (value_a);
+	buffer.push_back ('"');
+}
+
+void nano::json_writer::put (std::string const & value_a)
+{
+	debug_assert (!levels.empty () && levels.back ().array);
+	next ();
+	buffer.push_back ('"');
+	escape (value_a);
+	buffer.push_back ('"');
+}
+
+void nano::json_writer::put_json (std::string const & json_a)
+{
+	debug_assert (!levels.empty () && levels.back ().array);
+	next ();
+	// Lines after the first are indented by the depth of the element, which gives what write_json writes for the same tree at this position
+	auto size (json_a.size ());
+	while (size > 0 && json_a[size - 1] == '\n')
+	{
+		--size;
+	}
+	for (size_t i (0); i < size; ++i)
+	{
+		buffer.push_back (json_a[i]);
+		if (json_a[i] == '\n')
+		{
+			buffer.append (4 * levels.size (), ' ');
+		}
+	}
+}
+
+void nano::json_writer::put_child (std::string const & key_a, boost::property_tree::ptree const & tree_a)
+{
+	debug_assert (!levels.empty () && !levels.back ().array);
+	next ();
+	key (key_a);
+	value (tree_a);
+}
+
+void nano::json_writer::finish ()
+{
+	while (!levels.empty ())
+	{
+		end ();
+	}
+	buffer.push_back ('\n');
+}
+
+size_t nano::json_writer::size () const
+{
+	return buffer.size ();
+}
+
+std::string nano::json_writer::take ()
+{
+	std::string result;
+	result.swap (buffer);
+	return result;
+}
+
+void nano::json_writer::next ()
+{
+	auto & level_l (levels.back ());
+	if (level_l.count == 0 && levels.size () > 1)
+	{
+		buffer.push_back (level_l.array ? '[' : '{');
+	}
+	buffer.append (level_l.count == 0 ? "\n" : ",\n");
+	buffer.append (4 * levels.size (), ' ');
+	++level_l.count;
+}
+
+void nano::json_writer::key (std::string const & key_a)
+{
+	buffer.push_back ('"');
+	escape (key_a);
+	buffer.append ("\": ");
+}
+
+void nano::json_writer::value (boost::property_tree::ptree const & tree_a)
+{
+	if (tree_a.empty ())
+	{
+		buffer.push_back ('"');
+		escape (tree_a.data ());
+		buffer.push_back ('"');
+	}
+	else
+	{
+		// Like write_json, children which all have empty keys are an array
+		auto array (std::all_of (tree_a.begin (), tree_a.end (), [](auto const & child_a) { return child_a.first.empty (); }));
+		levels.push_back (level{ array, 0 });
+		for (auto const & child : tree_a)
+		{
+			next ();
+			if (!array)
+			{
+				key (child.first);
+			}
+			value (child.second);
+		}
+		end ();
+	}
+}
+
+void nano::json_writer::escape (std::string const & text_a)
+{
+	// Same escapes as boost::property_tree::json_parser::create_escapes
+	for (auto c : text_a)
+	{
+		auto u (static_cast<unsigned char> (c));
+		if (u == 0x20 || u == 0x21 || (u >= 0x23 && u <= 0x2e) || (u >= 0x30 && u <= 0x5b) || u >= 0x5d)
+		{
+			buffer.push_back (c);
+		}
+		else
+		{
+			buffer.push_back ('\\');
+			switch (c)
+			{
+				case '\b':
+					buffer.push_back ('b');
+					break;
+				case '\f':
+					buffer.push_back ('f');
+					break;
+				case '\n':
+					buffer.push_back ('n');
+					break;
+				case '\r':
+					buffer.push_back ('r');
+					break;
+				case '\t':
+					buffer.push_back ('t');
+					break;
+				case '/':
+				case '"':
+				case '\\':
+					buffer.push_back (c);
+					break;
+				default:
+				{
+					char const * hexdigits = "0123456789ABCDEF";
+					buffer.append ("u00");
+					buffer.push_back (hexdigits[u >> 4]);
+					buffer.push_back (hexdigits[u & 0xf]);
+					break;
+				}
+			}
+		}
+	}
+}
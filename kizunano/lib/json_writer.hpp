@@ -0,0 +1,58 @@
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Writes JSON incrementally, producing the same text as boost::property_tree::write_json for the equivalent ptree:
+ * values are strings, members are indented by 4 spaces and empty objects or arrays below the root are written as "".
+ * Output accumulates until it is taken, so large responses can be sent in parts without building a ptree.
+ */
+class json_writer final
+{
+public:
+	/** Opens the root object */
+	json_writer ();
+	/** Opens an object as a member of the current object */
+	void begin_object (std::string const & key_a);
+	/** Opens an object as an element of the current array */
+	void begin_object ();
+	/** Opens an array as a member of the current object */
+	void begin_array (std::string const & key_a);
+	/** Closes the innermost object or array */
+	void end ();
+	/** Writes a member of the current object */
+	void put (std::string const & key_a, std::string const & value_a);
+	/** Writes an element of the current array */
+	void put (std::string const & value_a);
+	/** Writes an element of the current array from the text of a JSON object written by write_json or by a json_writer */
+	void put_json (std::string const & json_a);
+	/** Writes \p tree_a as a member of the current object, as write_json would write it */
+	void put_child (std::string const & key_a, boost::property_tree::ptree const & tree_a);
+	/** Closes every open object and array and ends the output with a newline */
+	void finish ();
+	/** Size of the output not taken yet */
+	size_t size () const;
+	/** Returns the output written since the last call and clears it */
+	std::string take ();
+
+private:
+	class level final
+	{
+	public:
+		bool array;
+		size_t count;
+	};
+	/** Writes the separator and indentation before the next member or element, opening the current level if it is the first one */
+	void next ();
+	void key (std::string const &);
+	void value (boost::property_tree::ptree const &);
+	void escape (std::string const &);
+	std::vector<level> levels;
+	std::string buffer;
+};
+}
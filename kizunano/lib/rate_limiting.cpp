@@ -38,6 +38,12 @@ bool nano::rate::token_bucket::try_consume (unsigned tokens_required_a)
 	return possible || refill_rate == 1e9;
 }
 
+void nano::rate::token_bucket::refund (unsigned tokens_a)
+{
+	nano::lock_guard<std::mutex> lk (bucket_mutex);
+	current_size = std::min (current_size + tokens_a, max_token_count);
+}
+
 void nano::rate::token_bucket::refill ()
 {
 	auto now (std::chrono::steady_clock::now ());
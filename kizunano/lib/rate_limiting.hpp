@@ -38,6 +38,9 @@ namespace rate
 		 */
 		bool try_consume (unsigned tokens_required_a = 1);
 
+		/** Returns \p tokens_a taken by try_consume for an operation which did not happen after all */
+		void refund (unsigned tokens_a);
+
 		/** Returns the largest burst observed */
 		size_t largest_burst () const;
 
@@ -52,12 +52,18 @@ public:
 	}
 };
 
+/**
+ * Receives a leading part of a response sent in parts and a continuation to call once the part is sent,
+ * with true if it could not be, which stops the producer. The response callback receives the last part.
+ */
+using rpc_response_part = std::function<void(std::string const &, std::function<void(bool)> const &)>;
+
 class rpc_handler_interface
 {
 public:
 	virtual ~rpc_handler_interface () = default;
-	/** Process RPC 1.0 request. */
-	virtual void process_request (std::string const & action, std::string const & body, std::function<void(std::string const &)> response) = 0;
+	/** Process RPC 1.0 request. Large responses may be sent in parts through \p response_part */
+	virtual void process_request (std::string const & action, std::string const & body, std::function<void(std::string const &)> response, nano::rpc_response_part response_part) = 0;
 	/** Process RPC 2.0 request. This is called via the IPC API */
 	virtual void process_request_v2 (rpc_handler_request_params const & params_a, std::string const & body, std::function<void(std::shared_ptr<std::string>)> response) = 0;
 	virtual void stop () = 0;
@@ -450,6 +450,12 @@ std::string nano::stat::type_to_string (uint32_t key)
 		case nano::stat::type::telemetry:
 			res = "telemetry";
 			break;
+		case nano::stat::type::bandwidth:
+			res = "bandwidth";
+			break;
+		case nano::stat::type::rpc:
+			res = "rpc";
+			break;
 	}
 	return res;
 }
@@ -502,6 +508,18 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::error_socket_close:
 			res = "error_socket_close";
 			break;
+		case nano::stat::detail::compression_raw:
+			res = "compression_raw";
+			break;
+		case nano::stat::detail::compression_compressed:
+			res = "compression_compressed";
+			break;
+		case nano::stat::detail::compression_time_us:
+			res = "compression_time_us";
+			break;
+		case nano::stat::detail::compression_error:
+			res = "compression_error";
+			break;
 		case nano::stat::detail::change:
 			res = "change";
 			break;
@@ -550,6 +568,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::initiate_wallet_lazy:
 			res = "initiate_wallet_lazy";
 			break;
+		case nano::stat::detail::initiate_priority:
+			res = "initiate_priority";
+			break;
 		case nano::stat::detail::insufficient_work:
 			res = "insufficient_work";
 			break;
@@ -580,6 +601,12 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::telemetry_ack:
 			res = "telemetry_ack";
 			break;
+		case nano::stat::detail::block_announce:
+			res = "block_announce";
+			break;
+		case nano::stat::detail::block_announce_pull:
+			res = "block_announce_pull";
+			break;
 		case nano::stat::detail::state_block:
 			res = "state_block";
 			break;
@@ -607,6 +634,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::vote_cached:
 			res = "vote_cached";
 			break;
+		case nano::stat::detail::lazy_spill:
+			res = "lazy_spill";
+			break;
 		case nano::stat::detail::late_block:
 			res = "late_block";
 			break;
@@ -688,6 +718,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::invalid_telemetry_ack_message:
 			res = "invalid_telemetry_ack_message";
 			break;
+		case nano::stat::detail::invalid_block_announce_message:
+			res = "invalid_block_announce_message";
+			break;
 		case nano::stat::detail::outdated_version:
 			res = "outdated_version";
 			break;
@@ -748,6 +781,18 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::failed_send_telemetry_req:
 			res = "failed_send_telemetry_req";
 			break;
+		case nano::stat::detail::peer_limit:
+			res = "peer_limit";
+			break;
+		case nano::stat::detail::global_limit:
+			res = "global_limit";
+			break;
+		case nano::stat::detail::cache_hit:
+			res = "cache_hit";
+			break;
+		case nano::stat::detail::cache_miss:
+			res = "cache_miss";
+			break;
 	}
 	return res;
 }
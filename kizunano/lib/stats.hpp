@@ -202,6 +202,8 @@ public:
 		requests,
 		filter,
 		telemetry,
+		bandwidth,
+		rpc,
 	};
 
 	/** Optional detail type */
@@ -241,11 +243,14 @@ public:
 		node_id_handshake,
 		telemetry_req,
 		telemetry_ack,
+		block_announce,
+		block_announce_pull,
 
 		// bootstrap, callback
 		initiate,
 		initiate_lazy,
 		initiate_wallet_lazy,
+		initiate_priority,
 
 		// bootstrap specific
 		bulk_pull,
@@ -260,6 +265,11 @@ public:
 		frontier_confirmation_failed,
 		frontier_confirmation_successful,
 		error_socket_close,
+		compression_raw,
+		compression_compressed,
+		compression_time_us,
+		compression_error,
+		lazy_spill,
 
 		// vote specific
 		vote_valid,
@@ -294,6 +304,7 @@ public:
 		invalid_node_id_handshake_message,
 		invalid_telemetry_req_message,
 		invalid_telemetry_ack_message,
+		invalid_block_announce_message,
 		outdated_version,
 
 		// tcp
@@ -336,7 +347,15 @@ public:
 		request_within_protection_cache_zone,
 		no_response_received,
 		unsolicited_telemetry_ack,
-		failed_send_telemetry_req
+		failed_send_telemetry_req,
+
+		// bandwidth limiter
+		peer_limit,
+		global_limit,
+
+		// rpc response cache
+		cache_hit,
+		cache_miss
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -81,6 +81,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::epoch_upgrader:
 			thread_role_name_string = "Epoch upgrader";
 			break;
+		case nano::thread_role::name::rpc_in_process:
+			thread_role_name_string = "RPC in-process";
+			break;
 	}
 
 	/*
@@ -963,7 +963,7 @@ bool nano::active_transactions::update_difficulty_impl (nano::active_transaction
 	return error;
 }
 
-bool nano::active_transactions::restart (std::shared_ptr<nano::block> const & block_a, nano::write_transaction const & transaction_a)
+bool nano::active_transactions::restart (std::shared_ptr<nano::block> const & block_a, nano::write_transaction const & transaction_a, nano::block_post_events & events_a)
 {
 	// Only guaranteed to restart the election if the new block is received within 2 minutes of its election being dropped
 	constexpr std::chrono::minutes recently_dropped_cutoff{ 2 };
@@ -983,6 +983,11 @@ bool nano::active_transactions::restart (std::shared_ptr<nano::block> const & bl
 				auto block_count = node.ledger.cache.block_count.load ();
 				node.store.block_put (transaction_a, hash, *ledger_block);
 				debug_assert (node.ledger.cache.block_count.load () == block_count);
+				// Cached responses hold the old work, dropped once the rewrite is committed
+				if (node.rpc_response_cache.enabled ())
+				{
+					events_a.events.emplace_back ([this, ledger_block]() { node.rpc_response_cache.invalidate (*ledger_block); });
+				}
 
 				// Restart election for the upgraded block, previously dropped from elections
 				auto previous_balance = node.ledger.balance (transaction_a, ledger_block->previous ());
@@ -27,6 +27,7 @@ namespace nano
 {
 class node;
 class block;
+class block_post_events;
 class block_sideband;
 class election;
 class vote;
@@ -187,8 +188,8 @@ public:
 	nano::election_insertion_result activate (nano::account const &);
 	// Returns false if the election difficulty was updated
 	bool update_difficulty (nano::block const &);
-	// Returns false if the election was restarted
-	bool restart (std::shared_ptr<nano::block> const &, nano::write_transaction const &);
+	// Returns false if the election was restarted, a rewrite of the ledger block queues its cache invalidation in \p events_a
+	bool restart (std::shared_ptr<nano::block> const &, nano::write_transaction const &, nano::block_post_events & events_a);
 	double normalized_multiplier (nano::block const &, boost::optional<roots_iterator> const & = boost::none) const;
 	void update_active_multiplier (nano::unique_lock<std::mutex> &);
 	uint64_t active_difficulty ();
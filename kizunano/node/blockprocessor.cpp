@@ -214,7 +214,7 @@ void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_
 {
 	auto scoped_write_guard = write_database_queue.wait (nano::writer::process_batch);
 	block_post_events post_events;
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, nano::tables::cached_counts, nano::tables::change_blocks, tables::frontiers, tables::open_blocks, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked }, { tables::confirmation_height }));
+	auto transaction (node.store.tx_begin_write ({ tables::accounts, nano::tables::cached_counts, nano::tables::change_blocks, tables::delegators, tables::frontiers, tables::heights, tables::open_blocks, tables::pending, tables::pending_amounts, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked }, { tables::confirmation_height }));
 	nano::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -263,6 +263,10 @@ void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_
 				// Deleting from votes cache & wallet work watcher, stop active transaction
 				for (auto & i : rollback_list)
 				{
+					if (node.rpc_response_cache.enabled ())
+					{
+						post_events.events.emplace_back ([this, block = i]() { node.rpc_response_cache.invalidate (*block); });
+					}
 					node.votes_cache.remove (i->hash ());
 					node.wallets.watcher->remove (*i);
 					// Stop all rolled back active transactions except initial
@@ -340,6 +344,10 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			{
 				events_a.events.emplace_back ([this, hash, block = info_a.block, result, watch_work_a, origin_a]() { process_live (hash, block, result, watch_work_a, origin_a); });
 			}
+			if (node.rpc_response_cache.enabled ())
+			{
+				events_a.events.emplace_back ([this, block = info_a.block]() { node.rpc_response_cache.invalidate (*block); });
+			}
 			queue_unchecked (transaction_a, hash);
 			break;
 		}
@@ -363,7 +371,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 				++node.ledger.cache.unchecked_count;
 			}
 
-			node.gap_cache.add (hash);
+			node.gap_cache.add (hash, info_a.block->account ().is_zero () ? info_a.account : info_a.block->account ());
 			node.stats.inc (nano::stat::type::ledger, nano::stat::detail::gap_previous);
 			break;
 		}
@@ -387,7 +395,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 				++node.ledger.cache.unchecked_count;
 			}
 
-			node.gap_cache.add (hash);
+			node.gap_cache.add (hash, info_a.block->account ().is_zero () ? info_a.account : info_a.block->account ());
 			node.stats.inc (nano::stat::type::ledger, nano::stat::detail::gap_source);
 			break;
 		}
@@ -397,7 +405,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			{
 				node.logger.try_log (boost::str (boost::format ("Old for: %1%") % hash.to_string ()));
 			}
-			process_old (transaction_a, info_a.block, origin_a);
+			process_old (transaction_a, events_a, info_a.block, origin_a);
 			node.stats.inc (nano::stat::type::ledger, nano::stat::detail::old);
 			break;
 		}
@@ -484,10 +492,10 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 	return result;
 }
 
-void nano::block_processor::process_old (nano::write_transaction const & transaction_a, std::shared_ptr<nano::block> const & block_a, nano::block_origin const origin_a)
+void nano::block_processor::process_old (nano::write_transaction const & transaction_a, block_post_events & events_a, std::shared_ptr<nano::block> const & block_a, nano::block_origin const origin_a)
 {
 	// First try to update election difficulty, then attempt to restart an election
-	if (!node.active.update_difficulty (*block_a) || !node.active.restart (block_a, transaction_a))
+	if (!node.active.update_difficulty (*block_a) || !node.active.restart (block_a, transaction_a, events_a))
 	{
 		// Let others know about the difficulty update
 		if (origin_a == nano::block_origin::local)
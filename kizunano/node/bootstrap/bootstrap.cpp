@@ -1,17 +1,33 @@
 #include <kizunano/lib/threading.hpp>
 #include <kizunano/node/bootstrap/bootstrap.hpp>
 #include <kizunano/node/bootstrap/bootstrap_attempt.hpp>
+#include <kizunano/node/bootstrap/bootstrap_checkpoint.hpp>
 #include <kizunano/node/bootstrap/bootstrap_lazy.hpp>
+#include <kizunano/node/bootstrap/bootstrap_priority.hpp>
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/node.hpp>
 
+#include <boost/filesystem/operations.hpp>
 #include <boost/format.hpp>
 
 #include <algorithm>
 
+constexpr std::chrono::minutes nano::bootstrap_limits::bootstrap_checkpoint_interval;
+constexpr double nano::bootstrap_limits::priority_wallet;
+constexpr double nano::bootstrap_limits::priority_gap;
+constexpr double nano::bootstrap_limits::priority_pending;
+constexpr size_t nano::bootstrap_limits::priority_accounts_max;
+constexpr size_t nano::bootstrap_limits::priority_pending_seed_max;
+constexpr unsigned nano::bootstrap_limits::priority_requests_max;
+constexpr std::chrono::seconds nano::bootstrap_limits::priority_backoff;
+constexpr std::chrono::minutes nano::bootstrap_limits::priority_max_time;
+
 nano::bootstrap_initiator::bootstrap_initiator (nano::node & node_a) :
 node (node_a)
 {
+	// Runs spilled by lazy attempts of a node which did not shut down cleanly
+	boost::system::error_code ec;
+	boost::filesystem::remove_all (nano::bootstrap_attempt_lazy::spill_root (node.application_path), ec);
 	connections = std::make_shared<nano::bootstrap_connections> (node);
 	bootstrap_initiator_threads.push_back (boost::thread ([this]() {
 		nano::thread_role::set (nano::thread_role::name::bootstrap_connections);
@@ -130,6 +146,107 @@ void nano::bootstrap_initiator::bootstrap_wallet (std::deque<nano::account> & ac
 	condition.notify_all ();
 }
 
+void nano::bootstrap_initiator::bootstrap_priority (nano::account const & account_a, double priority_a)
+{
+	if (!node.flags.disable_priority_bootstrap)
+	{
+		auto priority_attempt (current_priority_attempt ());
+		if (priority_attempt == nullptr)
+		{
+			node.stats.inc (nano::stat::type::bootstrap, nano::stat::detail::initiate_priority, nano::stat::dir::out);
+			nano::lock_guard<std::mutex> lock (mutex);
+			if (!stopped && find_attempt (nano::bootstrap_mode::priority) == nullptr)
+			{
+				priority_attempt = std::make_shared<nano::bootstrap_attempt_priority> (node.shared (), attempts.incremental++, account_a.to_account ());
+				attempts_list.push_back (priority_attempt);
+				attempts.add (priority_attempt);
+			}
+		}
+		auto priority_l (std::dynamic_pointer_cast<nano::bootstrap_attempt_priority> (priority_attempt));
+		if (priority_l != nullptr)
+		{
+			priority_l->priority_add (account_a, priority_a);
+		}
+		condition.notify_all ();
+	}
+}
+
+void nano::bootstrap_initiator::save_checkpoints ()
+{
+	std::vector<std::pair<uint64_t, std::vector<uint8_t>>> checkpoints;
+	std::vector<std::shared_ptr<nano::bootstrap_attempt>> attempts_l;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		attempts_l = attempts_list;
+	}
+	for (auto const & attempt : attempts_l)
+	{
+		nano::bootstrap_checkpoint checkpoint;
+		if (attempt->mode != nano::bootstrap_mode::wallet_lazy && attempt->started && !attempt->checkpoint (checkpoint))
+		{
+			std::vector<uint8_t> data;
+			{
+				nano::vectorstream stream (data);
+				checkpoint.serialize (stream);
+			}
+			checkpoints.emplace_back (static_cast<uint64_t> (attempt->mode), std::move (data));
+		}
+	}
+	if (!checkpoints.empty ())
+	{
+		auto transaction (node.store.tx_begin_write ({ tables::bootstrap_checkpoint }));
+		for (auto const & checkpoint : checkpoints)
+		{
+			node.store.bootstrap_checkpoint_put (transaction, checkpoint.first, checkpoint.second);
+		}
+	}
+}
+
+void nano::bootstrap_initiator::resume ()
+{
+	std::vector<std::pair<nano::bootstrap_mode, nano::bootstrap_checkpoint>> checkpoints;
+	{
+		auto transaction (node.store.tx_begin_read ());
+		for (auto mode : { nano::bootstrap_mode::legacy, nano::bootstrap_mode::lazy })
+		{
+			std::vector<uint8_t> data;
+			if (!node.store.bootstrap_checkpoint_get (transaction, static_cast<uint64_t> (mode), data))
+			{
+				nano::bufferstream stream (data.data (), data.size ());
+				nano::bootstrap_checkpoint checkpoint;
+				if (!checkpoint.deserialize (stream) && !checkpoint.empty ())
+				{
+					checkpoints.emplace_back (mode, std::move (checkpoint));
+				}
+			}
+		}
+	}
+	nano::unique_lock<std::mutex> lock (mutex);
+	for (auto const & checkpoint : checkpoints)
+	{
+		auto mode (checkpoint.first);
+		auto enabled (mode == nano::bootstrap_mode::legacy ? !node.flags.disable_legacy_bootstrap : !node.flags.disable_lazy_bootstrap);
+		if (!stopped && enabled && find_attempt (mode) == nullptr)
+		{
+			std::shared_ptr<nano::bootstrap_attempt> attempt;
+			if (mode == nano::bootstrap_mode::legacy)
+			{
+				attempt = std::make_shared<nano::bootstrap_attempt_legacy> (node.shared (), attempts.incremental++, "checkpoint");
+			}
+			else
+			{
+				attempt = std::make_shared<nano::bootstrap_attempt_lazy> (node.shared (), attempts.incremental++, "checkpoint");
+			}
+			attempt->restore (checkpoint.second);
+			attempts_list.push_back (attempt);
+			attempts.add (attempt);
+			node.logger.always_log (boost::str (boost::format ("Resuming %1% bootstrap from checkpoint, %2% pulls and %3% lazy pulls left") % attempt->mode_text () % checkpoint.second.pulls.size () % checkpoint.second.lazy_pulls.size ()));
+		}
+	}
+	lock.unlock ();
+	condition.notify_all ();
+}
+
 void nano::bootstrap_initiator::run_bootstrap ()
 {
 	nano::unique_lock<std::mutex> lock (mutex);
@@ -142,6 +259,12 @@ void nano::bootstrap_initiator::run_bootstrap ()
 			if (attempt != nullptr)
 			{
 				attempt->run ();
+				if (!stopped)
+				{
+					// Finished or replaced, nothing left to resume
+					auto transaction (node.store.tx_begin_write ({ tables::bootstrap_checkpoint }));
+					node.store.bootstrap_checkpoint_del (transaction, static_cast<uint64_t> (attempt->mode));
+				}
 				remove_attempt (attempt);
 			}
 			lock.lock ();
@@ -242,6 +365,12 @@ std::shared_ptr<nano::bootstrap_attempt> nano::bootstrap_initiator::current_wall
 	return find_attempt (nano::bootstrap_mode::wallet_lazy);
 }
 
+std::shared_ptr<nano::bootstrap_attempt> nano::bootstrap_initiator::current_priority_attempt ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return find_attempt (nano::bootstrap_mode::priority);
+}
+
 void nano::bootstrap_initiator::stop_attempts ()
 {
 	nano::unique_lock<std::mutex> lock (mutex);
@@ -259,6 +388,7 @@ void nano::bootstrap_initiator::stop ()
 {
 	if (!stopped.exchange (true))
 	{
+		save_checkpoints ();
 		stop_attempts ();
 		connections->stop ();
 		condition.notify_all ();
@@ -300,6 +430,11 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (bo
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "observers", count, sizeof_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pulls_cache", cache_count, sizeof_cache_element }));
+	auto lazy_attempt (std::dynamic_pointer_cast<nano::bootstrap_attempt_lazy> (bootstrap_initiator.current_lazy_attempt ()));
+	if (lazy_attempt != nullptr)
+	{
+		composite->add_component (collect_container_info (*lazy_attempt, "lazy_attempt"));
+	}
 	return composite;
 }
 
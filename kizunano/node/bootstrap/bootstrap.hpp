@@ -28,7 +28,8 @@ enum class bootstrap_mode
 {
 	legacy,
 	lazy,
-	wallet_lazy
+	wallet_lazy,
+	priority
 };
 enum class sync_result
 {
@@ -86,6 +87,8 @@ public:
 	void bootstrap (bool force = false, std::string id_a = "");
 	void bootstrap_lazy (nano::hash_or_account const &, bool force = false, bool confirmed = true, std::string id_a = "");
 	void bootstrap_wallet (std::deque<nano::account> &);
+	/** Queues \p account_a in the priority attempt, starting one if needed. Ignored when priority bootstrap is disabled */
+	void bootstrap_priority (nano::account const & account_a, double priority_a);
 	void run_bootstrap ();
 	void lazy_requeue (nano::block_hash const &, nano::block_hash const &, bool);
 	void notify_listeners (bool);
@@ -97,6 +100,11 @@ public:
 	std::shared_ptr<nano::bootstrap_attempt> current_attempt ();
 	std::shared_ptr<nano::bootstrap_attempt> current_lazy_attempt ();
 	std::shared_ptr<nano::bootstrap_attempt> current_wallet_attempt ();
+	std::shared_ptr<nano::bootstrap_attempt> current_priority_attempt ();
+	/** Stores the work left in the running legacy and lazy attempts */
+	void save_checkpoints ();
+	/** Starts attempts from the stored checkpoints, called on start-up */
+	void resume ();
 	nano::pulls_cache cache;
 	nano::bootstrap_attempts attempts;
 	void stop ();
@@ -135,10 +143,32 @@ public:
 	static constexpr unsigned requeued_pulls_limit_test = 2;
 	static constexpr unsigned requeued_pulls_processed_blocks_factor = 4096;
 	static constexpr unsigned bulk_push_cost_limit = 200;
+	/** Weight of the latest sample in smoothed peer and aggregate block rates */
+	static constexpr double bootstrap_rate_smoothing = 0.25;
+	/** Populate ticks between adjustments of the connection target to the aggregate block rate */
+	static constexpr unsigned bootstrap_throughput_window = 5;
+	/** Relative aggregate rate increase over a window for the added connections to be considered useful */
+	static constexpr double bootstrap_throughput_gain = 0.1;
+	static constexpr size_t bootstrap_peer_scores_max = 4096;
+	/** Maximum number of peers scanning parts of the account space for frontiers at once */
+	static constexpr unsigned frontier_req_ranges = 4;
 	static constexpr std::chrono::seconds lazy_flush_delay_sec = std::chrono::seconds (5);
+	static constexpr std::chrono::minutes bootstrap_checkpoint_interval = std::chrono::minutes (5);
 	static constexpr unsigned lazy_destinations_request_limit = 256 * 1024;
 	static constexpr uint64_t lazy_batch_pull_count_resize_blocks_limit = 4 * 1024 * 1024;
 	static constexpr double lazy_batch_pull_count_resize_ratio = 2.0;
 	static constexpr size_t lazy_blocks_restart_limit = 1024 * 1024;
+	/** lazy_blocks is only spilled once its in-memory part is at least this fraction of the memory budget */
+	static constexpr size_t lazy_spill_budget_fraction = 4;
+	/** Priority added to an account for each source */
+	static constexpr double priority_wallet = 4.0;
+	static constexpr double priority_gap = 2.0;
+	static constexpr double priority_pending = 1.0;
+	static constexpr size_t priority_accounts_max = 64 * 1024;
+	static constexpr size_t priority_pending_seed_max = 16 * 1024;
+	static constexpr unsigned priority_requests_max = 4;
+	/** Doubled with each request made for an account */
+	static constexpr std::chrono::seconds priority_backoff = std::chrono::seconds (1);
+	static constexpr std::chrono::minutes priority_max_time = std::chrono::minutes (30);
 };
 }
@@ -2,6 +2,7 @@
 #include <kizunano/node/bootstrap/bootstrap.hpp>
 #include <kizunano/node/bootstrap/bootstrap_attempt.hpp>
 #include <kizunano/node/bootstrap/bootstrap_bulk_push.hpp>
+#include <kizunano/node/bootstrap/bootstrap_checkpoint.hpp>
 #include <kizunano/node/bootstrap/bootstrap_frontier.hpp>
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/node.hpp>
@@ -113,6 +114,10 @@ std::string nano::bootstrap_attempt::mode_text ()
 	{
 		mode_text = "wallet_lazy";
 	}
+	else if (mode == nano::bootstrap_mode::priority)
+	{
+		mode_text = "priority";
+	}
 	return mode_text;
 }
 
@@ -187,6 +192,10 @@ void nano::bootstrap_attempt::requeue_pending (nano::account const &)
 	debug_assert (mode == nano::bootstrap_mode::wallet_lazy);
 }
 
+void nano::bootstrap_attempt::account_pulled (nano::account const &)
+{
+}
+
 void nano::bootstrap_attempt::wallet_start (std::deque<nano::account> &)
 {
 	debug_assert (mode == nano::bootstrap_mode::wallet_lazy);
@@ -198,6 +207,16 @@ size_t nano::bootstrap_attempt::wallet_size ()
 	return 0;
 }
 
+bool nano::bootstrap_attempt::checkpoint (nano::bootstrap_checkpoint &)
+{
+	return true;
+}
+
+void nano::bootstrap_attempt::restore (nano::bootstrap_checkpoint const &)
+{
+	debug_assert (mode == nano::bootstrap_mode::wallet_lazy);
+}
+
 nano::bootstrap_attempt_legacy::bootstrap_attempt_legacy (std::shared_ptr<nano::node> node_a, uint64_t incremental_id_a, std::string id_a) :
 nano::bootstrap_attempt (node_a, nano::bootstrap_mode::legacy, incremental_id_a, id_a)
 {
@@ -225,14 +244,17 @@ void nano::bootstrap_attempt_legacy::stop ()
 	lock.unlock ();
 	condition.notify_all ();
 	lock.lock ();
-	if (auto i = frontiers.lock ())
+	for (auto const & frontiers_w : frontiers)
 	{
-		try
-		{
-			i->promise.set_value (true);
-		}
-		catch (std::future_error &)
+		if (auto i = frontiers_w.lock ())
 		{
+			try
+			{
+				i->promise.set_value (true);
+			}
+			catch (std::future_error &)
+			{
+			}
 		}
 	}
 	if (auto i = push.lock ())
@@ -505,61 +527,202 @@ bool nano::bootstrap_attempt_legacy::request_frontier (nano::unique_lock<std::mu
 	lock_a.lock ();
 	if (connection_l && !stopped)
 	{
-		endpoint_frontier_request = connection_l->channel->get_tcp_endpoint ();
-		std::future<bool> future;
+		class frontier_range final
 		{
-			auto this_l (shared_from_this ());
-			auto client (std::make_shared<nano::frontier_req_client> (connection_l, this_l));
+		public:
+			std::weak_ptr<nano::frontier_req_client> client;
+			std::future<bool> future;
+			nano::account start;
+			nano::account end;
+			bool bulk_push_peer;
+		};
+		std::vector<frontier_range> running;
+		std::deque<frontier_range> pending;
+		auto start_range = [this, &running](std::shared_ptr<nano::bootstrap_client> const & connection_a, frontier_range range_a) {
+			if (range_a.bulk_push_peer)
+			{
+				endpoint_frontier_request = connection_a->channel->get_tcp_endpoint ();
+			}
+			auto client (std::make_shared<nano::frontier_req_client> (connection_a, shared_from_this (), range_a.start, range_a.end, range_a.bulk_push_peer));
 			client->run ();
-			frontiers = client;
-			future = client->promise.get_future ();
-		}
-		lock_a.unlock ();
-		result = consume_future (future); // This is out of scope of `client' so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
-		lock_a.lock ();
-		if (result)
-		{
-			frontier_pulls.clear ();
-		}
-		else
+			frontiers.push_back (client);
+			range_a.client = client;
+			range_a.future = client->promise.get_future ();
+			running.push_back (std::move (range_a));
+		};
+		frontiers.clear ();
+		account_count = 0;
+		// The whole account space is requested from the first peer, ranges are split off to other peers as their connections become idle
+		start_range (connection_l, frontier_range{ {}, {}, nano::account (0), nano::account (0), true });
+		auto ready = [](frontier_range const & range_a) { return range_a.future.wait_for (std::chrono::seconds (0)) == std::future_status::ready; };
+		while (!stopped && (!running.empty () || !pending.empty ()))
 		{
-			account_count = frontier_pulls.size ();
-			// Shuffle pulls
-			release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
-			if (!frontier_pulls.empty ())
+			condition.wait_for (lock_a, std::chrono::milliseconds (50), [this, &running, &ready] { return stopped || std::any_of (running.begin (), running.end (), ready); });
+			for (auto i (running.begin ()); i != running.end ();)
 			{
-				for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
+				if (ready (*i))
+				{
+					lock_a.unlock ();
+					auto error (consume_future (i->future));
+					lock_a.lock ();
+					if (error)
+					{
+						// Retry the rest of the range with another peer
+						if (auto client_l = i->client.lock ())
+						{
+							i->start = client_l->resume_point ();
+							i->end = client_l->end ();
+						}
+						node->stats.inc (nano::stat::type::error, nano::stat::detail::frontier_req, nano::stat::dir::out);
+						pending.push_back (std::move (*i));
+					}
+					i = running.erase (i);
+				}
+				else
 				{
-					auto k = nano::random_pool::generate_word32 (0, i);
-					std::swap (frontier_pulls[i], frontier_pulls[k]);
+					++i;
 				}
 			}
-			// Add to regular pulls
-			while (!frontier_pulls.empty ())
+			add_frontier_pulls (lock_a);
+			auto more (!stopped);
+			while (more && running.size () < nano::bootstrap_limits::frontier_req_ranges)
 			{
-				auto pull (frontier_pulls.front ());
+				std::unordered_set<nano::tcp_endpoint> endpoints;
+				for (auto const & range : running)
+				{
+					if (auto client_l = range.client.lock ())
+					{
+						endpoints.insert (client_l->connection->channel->get_tcp_endpoint ());
+					}
+				}
 				lock_a.unlock ();
-				node->bootstrap_initiator.connections->add_pull (pull);
+				auto idle (node->bootstrap_initiator.connections->idle_connection (endpoints));
 				lock_a.lock ();
-				++pulling;
-				frontier_pulls.pop_front ();
-			}
-		}
-		if (node->config.logging.network_logging ())
-		{
-			if (!result)
-			{
-				node->logger.try_log (boost::str (boost::format ("Completed frontier request, %1% out of sync accounts according to %2%") % account_count % connection_l->channel->to_string ()));
+				more = idle != nullptr;
+				if (more && !pending.empty ())
+				{
+					start_range (idle, std::move (pending.front ()));
+					pending.pop_front ();
+				}
+				else if (more)
+				{
+					// Split the upper half of the widest remaining range off to the new peer
+					std::shared_ptr<nano::frontier_req_client> widest;
+					nano::uint512_t widest_size (0);
+					for (auto const & range : running)
+					{
+						if (auto client_l = range.client.lock ())
+						{
+							auto end_l (client_l->end ());
+							nano::uint512_t size ((end_l.is_zero () ? nano::uint512_t (1) << 256 : nano::uint512_t (end_l.number ())) - client_l->resume_point ().number ());
+							if (size > widest_size)
+							{
+								widest = client_l;
+								widest_size = size;
+							}
+						}
+					}
+					frontier_range range{ {}, {}, nano::account (0), nano::account (0), false };
+					if (widest != nullptr && !widest->split (range.start, range.end))
+					{
+						for (auto & running_range : running)
+						{
+							if (running_range.client.lock () == widest)
+							{
+								running_range.end = range.start;
+							}
+						}
+						start_range (idle, std::move (range));
+					}
+					else
+					{
+						lock_a.unlock ();
+						node->bootstrap_initiator.connections->pool_connection (idle);
+						lock_a.lock ();
+						more = false;
+					}
+				}
 			}
-			else
+			if (running.empty () && !pending.empty () && !stopped)
 			{
-				node->stats.inc (nano::stat::type::error, nano::stat::detail::frontier_req, nano::stat::dir::out);
+				// No other peer is idle, wait for any connection
+				lock_a.unlock ();
+				auto connection_retry (node->bootstrap_initiator.connections->connection (shared_from_this ()));
+				lock_a.lock ();
+				if (connection_retry != nullptr && !stopped)
+				{
+					start_range (connection_retry, std::move (pending.front ()));
+					pending.pop_front ();
+				}
 			}
 		}
+		result = stopped;
+		if (result)
+		{
+			frontier_pulls.clear ();
+		}
+		else
+		{
+			add_frontier_pulls (lock_a);
+		}
+		if (node->config.logging.network_logging () && !result)
+		{
+			node->logger.try_log (boost::str (boost::format ("Completed frontier request, %1% out of sync accounts") % account_count));
+		}
 	}
 	return result;
 }
 
+void nano::bootstrap_attempt_legacy::add_frontier_pulls (nano::unique_lock<std::mutex> & lock_a)
+{
+	account_count += frontier_pulls.size ();
+	// Shuffle pulls
+	release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
+	if (!frontier_pulls.empty ())
+	{
+		for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
+		{
+			auto k = nano::random_pool::generate_word32 (0, i);
+			std::swap (frontier_pulls[i], frontier_pulls[k]);
+		}
+	}
+	// Add to regular pulls
+	while (!frontier_pulls.empty ())
+	{
+		auto pull (frontier_pulls.front ());
+		lock_a.unlock ();
+		node->bootstrap_initiator.connections->add_pull (pull);
+		lock_a.lock ();
+		++pulling;
+		frontier_pulls.pop_front ();
+	}
+}
+
+bool nano::bootstrap_attempt_legacy::checkpoint (nano::bootstrap_checkpoint & checkpoint_a)
+{
+	// Pulls are only worth resuming once the frontier scan is complete
+	auto result (!frontiers_received || stopped);
+	if (!result)
+	{
+		checkpoint_a.pulls = node->bootstrap_initiator.connections->attempt_pulls (incremental_id);
+		nano::lock_guard<std::mutex> lock (mutex);
+		checkpoint_a.pulls.insert (checkpoint_a.pulls.end (), frontier_pulls.begin (), frontier_pulls.end ());
+		result = checkpoint_a.empty ();
+	}
+	return result;
+}
+
+void nano::bootstrap_attempt_legacy::restore (nano::bootstrap_checkpoint const & checkpoint_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	debug_assert (!started);
+	for (auto pull : checkpoint_a.pulls)
+	{
+		pull.bootstrap_id = incremental_id;
+		restored_pulls.push_back (pull);
+	}
+}
+
 void nano::bootstrap_attempt_legacy::run_start (nano::unique_lock<std::mutex> & lock_a)
 {
 	frontiers_received = false;
@@ -583,7 +746,18 @@ void nano::bootstrap_attempt_legacy::run ()
 	debug_assert (!node->flags.disable_legacy_bootstrap);
 	node->bootstrap_initiator.connections->populate_connections (false);
 	nano::unique_lock<std::mutex> lock (mutex);
-	run_start (lock);
+	if (restored_pulls.empty ())
+	{
+		run_start (lock);
+	}
+	else
+	{
+		// Frontiers were scanned before the node restarted
+		frontier_pulls.insert (frontier_pulls.end (), restored_pulls.begin (), restored_pulls.end ());
+		restored_pulls.clear ();
+		add_frontier_pulls (lock);
+		frontiers_received = true;
+	}
 	while (still_pulling ())
 	{
 		while (still_pulling ())
@@ -12,6 +12,7 @@ class node;
 
 class frontier_req_client;
 class bulk_push_client;
+class bootstrap_checkpoint;
 class bootstrap_attempt : public std::enable_shared_from_this<bootstrap_attempt>
 {
 public:
@@ -37,9 +38,15 @@ public:
 	virtual bool lazy_processed_or_exists (nano::block_hash const &);
 	virtual bool process_block (std::shared_ptr<nano::block>, nano::account const &, uint64_t, nano::bulk_pull::count_t, bool, unsigned);
 	virtual void requeue_pending (nano::account const &);
+	/** Called when a chain or pending pull for the account completed */
+	virtual void account_pulled (nano::account const &);
 	virtual void wallet_start (std::deque<nano::account> &);
 	virtual size_t wallet_size ();
 	virtual void get_information (boost::property_tree::ptree &) = 0;
+	/** Copies the work left into \p checkpoint_a, returns true if there is nothing worth resuming */
+	virtual bool checkpoint (nano::bootstrap_checkpoint & checkpoint_a);
+	/** Seeds a new attempt with the work left by an interrupted one, before it runs */
+	virtual void restore (nano::bootstrap_checkpoint const &);
 	std::mutex next_log_mutex;
 	std::chrono::steady_clock::time_point next_log{ std::chrono::steady_clock::now () };
 	std::atomic<unsigned> pulling{ 0 };
@@ -65,6 +72,7 @@ public:
 	bool consume_future (std::future<bool> &);
 	void stop () override;
 	bool request_frontier (nano::unique_lock<std::mutex> &, bool = false);
+	void add_frontier_pulls (nano::unique_lock<std::mutex> &);
 	void request_pull (nano::unique_lock<std::mutex> &);
 	void request_push (nano::unique_lock<std::mutex> &);
 	void add_frontier (nano::pull_info const &) override;
@@ -76,10 +84,14 @@ public:
 	void attempt_restart_check (nano::unique_lock<std::mutex> &);
 	bool confirm_frontiers (nano::unique_lock<std::mutex> &);
 	void get_information (boost::property_tree::ptree &) override;
+	bool checkpoint (nano::bootstrap_checkpoint &) override;
+	void restore (nano::bootstrap_checkpoint const &) override;
 	nano::tcp_endpoint endpoint_frontier_request;
-	std::weak_ptr<nano::frontier_req_client> frontiers;
+	std::vector<std::weak_ptr<nano::frontier_req_client>> frontiers;
 	std::weak_ptr<nano::bulk_push_client> push;
 	std::deque<nano::pull_info> frontier_pulls;
+	/** Pulls of an interrupted attempt, requested instead of scanning frontiers */
+	std::vector<nano::pull_info> restored_pulls;
 	std::deque<nano::block_hash> recent_pulls_head;
 	std::vector<std::pair<nano::block_hash, nano::block_hash>> bulk_push_targets;
 	std::atomic<unsigned> account_count{ 0 };
@@ -7,6 +7,8 @@
 
 #include <boost/format.hpp>
 
+constexpr size_t nano::bulk_pull_server::send_batch_size;
+
 nano::pull_info::pull_info (nano::hash_or_account const & account_or_head_a, nano::block_hash const & head_a, nano::block_hash const & end_a, uint64_t bootstrap_id_a, count_t count_a, unsigned retry_limit_a) :
 account_or_head (account_or_head_a),
 head (head_a),
@@ -31,16 +33,26 @@ unexpected_count (0)
 
 nano::bulk_pull_client::~bulk_pull_client ()
 {
+	// Priority pulls start from the account without knowing the remote frontier, an empty reply means it has nothing newer
+	auto priority_up_to_date (attempt->mode == nano::bootstrap_mode::priority && pull_blocks == 0 && !network_error);
 	// If received end block is not expected end block
-	if (expected != pull.end)
+	if (expected != pull.end && !priority_up_to_date)
 	{
 		pull.head = expected;
-		if (attempt->mode != nano::bootstrap_mode::legacy)
+		if (attempt->mode == nano::bootstrap_mode::lazy || attempt->mode == nano::bootstrap_mode::wallet_lazy)
 		{
 			pull.account_or_head = expected;
 		}
 		pull.processed += pull_blocks - unexpected_count;
-		connection->node->bootstrap_initiator.connections->requeue_pull (pull, network_error);
+		// Pipelined pulls that never started are not a failed attempt
+		auto not_started (pipelined && receive_ready < 2);
+		// Neither are pulls cut short by the attempt or by stopping the connection, which charges the peer itself if it was at fault
+		auto stopped_locally (pull_stopped || attempt->stopped || connection->pending_stop || connection->hard_stop);
+		if (!not_started && !stopped_locally)
+		{
+			connection->node->bootstrap_initiator.connections->peer_failure (connection->channel->get_tcp_endpoint ());
+		}
+		connection->node->bootstrap_initiator.connections->requeue_pull (pull, network_error || not_started);
 		if (connection->node->config.logging.bulk_pull_logging ())
 		{
 			connection->node->logger.try_log (boost::str (boost::format ("Bulk pull end block is not expected %1% for account %2%") % pull.end.to_string () % pull.account_or_head.to_account ()));
@@ -49,6 +61,7 @@ nano::bulk_pull_client::~bulk_pull_client ()
 	else
 	{
 		connection->node->bootstrap_initiator.cache.remove (pull);
+		attempt->account_pulled (pull.account_or_head.account);
 	}
 	attempt->pull_finished ();
 }
@@ -71,6 +84,11 @@ void nano::bulk_pull_client::request ()
 	req.end = pull.end;
 	req.count = pull.count;
 	req.set_count_present (pull.count != 0);
+	if (connection->node->config.bootstrap_compression && nano::bootstrap_compression::available ())
+	{
+		req.set_compressed (true);
+		decompressor = std::make_unique<nano::bootstrap_decompressor> ();
+	}
 
 	if (connection->node->config.logging.bulk_pull_logging ())
 	{
@@ -80,12 +98,16 @@ void nano::bulk_pull_client::request ()
 	{
 		connection->node->logger.always_log (boost::str (boost::format ("%1% accounts in pull queue") % attempt->pulling));
 	}
+	if (!pipelined)
+	{
+		++receive_ready;
+	}
 	auto this_l (shared_from_this ());
 	connection->channel->send (
 	req, [this_l](boost::system::error_code const & ec, size_t size_a) {
 		if (!ec)
 		{
-			this_l->throttled_receive_block ();
+			this_l->ready_to_receive ();
 		}
 		else
 		{
@@ -99,6 +121,14 @@ void nano::bulk_pull_client::request ()
 	nano::buffer_drop_policy::no_limiter_drop);
 }
 
+void nano::bulk_pull_client::ready_to_receive ()
+{
+	if (++receive_ready == 2)
+	{
+		throttled_receive_block ();
+	}
+}
+
 void nano::bulk_pull_client::throttled_receive_block ()
 {
 	debug_assert (!network_error);
@@ -121,7 +151,14 @@ void nano::bulk_pull_client::throttled_receive_block ()
 void nano::bulk_pull_client::receive_block ()
 {
 	auto this_l (shared_from_this ());
-	if (auto socket_l = connection->channel->socket.lock ())
+	if (compressed)
+	{
+		// Blocks of a frame are already in memory, avoid recursing through the whole frame
+		connection->node->background ([this_l]() {
+			this_l->receive_decoded ();
+		});
+	}
+	else if (auto socket_l = connection->channel->socket.lock ())
 	{
 		socket_l->async_read (connection->receive_buffer, 1, [this_l](boost::system::error_code const & ec, size_t size_a) {
 			if (!ec)
@@ -146,7 +183,12 @@ void nano::bulk_pull_client::received_type ()
 	auto this_l (shared_from_this ());
 	nano::block_type type (static_cast<nano::block_type> (connection->receive_buffer->data ()[0]));
 
-	if (auto socket_l = connection->channel->socket.lock ())
+	if (decompressor != nullptr && !compressed && connection->receive_buffer->data ()[0] == nano::bootstrap_compression::marker)
+	{
+		compressed = true;
+		receive_frame ();
+	}
+	else if (auto socket_l = connection->channel->socket.lock ())
 	{
 		switch (type)
 		{
@@ -187,11 +229,7 @@ void nano::bulk_pull_client::received_type ()
 			}
 			case nano::block_type::not_a_block:
 			{
-				// Avoid re-using slow peers, or peers that sent the wrong blocks.
-				if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks)))
-				{
-					connection->connections->pool_connection (connection);
-				}
+				received_end ();
 				break;
 			}
 			default:
@@ -208,7 +246,14 @@ void nano::bulk_pull_client::received_type ()
 
 void nano::bulk_pull_client::received_block (boost::system::error_code const & ec, size_t size_a, nano::block_type type_a)
 {
-	if (!ec)
+	if (!ec && draining)
+	{
+		if (++pull_blocks <= pull.count)
+		{
+			throttled_receive_block ();
+		}
+	}
+	else if (!ec)
 	{
 		nano::bufferstream stream (connection->receive_buffer->data (), size_a);
 		std::shared_ptr<nano::block> block (nano::deserialize_block (stream, type_a));
@@ -223,8 +268,8 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 			}
 			// Is block expected?
 			bool block_expected (false);
-			// Unconfirmed head is used only for lazy destinations if legacy bootstrap is not available, see nano::bootstrap_attempt::lazy_destinations_increment (...)
-			bool unconfirmed_account_head (connection->node->flags.disable_legacy_bootstrap && pull_blocks == 0 && pull.retry_limit != std::numeric_limits<unsigned>::max () && expected == pull.account_or_head && block->account () == pull.account_or_head);
+			// Unconfirmed head is used for lazy destinations if legacy bootstrap is not available, see nano::bootstrap_attempt::lazy_destinations_increment (...), and for priority pulls
+			bool unconfirmed_account_head ((connection->node->flags.disable_legacy_bootstrap || attempt->mode == nano::bootstrap_mode::priority) && pull_blocks == 0 && pull.retry_limit != std::numeric_limits<unsigned>::max () && expected == pull.account_or_head && block->account () == pull.account_or_head);
 			if (hash == expected || unconfirmed_account_head)
 			{
 				expected = block->previous ();
@@ -245,6 +290,7 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 			attempt->total_blocks++;
 			bool stop_pull (attempt->process_block (block, known_account, pull_blocks, pull.count, block_expected, pull.retry_limit));
 			pull_blocks++;
+			pull_stopped = pull_stopped || stop_pull;
 			if (!stop_pull && !connection->hard_stop.load ())
 			{
 				/* Process block in lazy pull if not stopped
@@ -257,7 +303,16 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 			}
 			else if (stop_pull && block_expected)
 			{
-				connection->connections->pool_connection (connection);
+				if (next == nullptr)
+				{
+					connection->connections->pool_connection (connection);
+				}
+				else if (pull.count != 0 && !connection->hard_stop.load ())
+				{
+					// A pipelined response follows, skip the rest of this one which is bounded by the count
+					draining = true;
+					throttled_receive_block ();
+				}
 			}
 		}
 		else
@@ -280,6 +335,151 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 	}
 }
 
+void nano::bulk_pull_client::received_end ()
+{
+	// Avoid re-using slow peers, or peers that sent the wrong blocks.
+	if (!connection->pending_stop && (draining || expected == pull.end || (pull.count != 0 && pull.count == pull_blocks)))
+	{
+		if (next != nullptr)
+		{
+			std::shared_ptr<nano::bulk_pull_client> next_l;
+			next_l.swap (next);
+			next_l->ready_to_receive ();
+		}
+		else
+		{
+			connection->connections->pool_connection (connection);
+		}
+	}
+}
+
+void nano::bulk_pull_client::receive_frame ()
+{
+	auto this_l (shared_from_this ());
+	if (auto socket_l = connection->channel->socket.lock ())
+	{
+		socket_l->async_read (connection->receive_buffer, nano::bootstrap_compression::frame_header_size, [this_l](boost::system::error_code const & ec, size_t size_a) {
+			uint32_t compressed_size (0);
+			uint32_t raw_size (0);
+			if (!ec && !nano::bootstrap_decompressor::header (this_l->connection->receive_buffer->data (), compressed_size, raw_size))
+			{
+				this_l->received_frame (compressed_size, raw_size);
+			}
+			else if (!ec)
+			{
+				if (this_l->connection->node->config.logging.bulk_pull_logging ())
+				{
+					this_l->connection->node->logger.try_log (boost::str (boost::format ("Invalid compressed frame size %1% (%2% uncompressed)") % compressed_size % raw_size));
+				}
+				this_l->compression_error ();
+			}
+			else
+			{
+				if (this_l->connection->node->config.logging.bulk_pull_logging ())
+				{
+					this_l->connection->node->logger.try_log (boost::str (boost::format ("Error receiving compressed frame header: %1%") % ec.message ()));
+				}
+				this_l->connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_receive_block_failure, nano::stat::dir::in);
+				this_l->network_error = true;
+			}
+		});
+	}
+}
+
+void nano::bulk_pull_client::received_frame (uint32_t compressed_size_a, uint32_t raw_size_a)
+{
+	auto this_l (shared_from_this ());
+	if (frame_buffer == nullptr)
+	{
+		frame_buffer = std::make_shared<std::vector<uint8_t>> ();
+	}
+	frame_buffer->resize (compressed_size_a);
+	if (auto socket_l = connection->channel->socket.lock ())
+	{
+		socket_l->async_read (frame_buffer, compressed_size_a, [this_l, compressed_size_a, raw_size_a](boost::system::error_code const & ec, size_t size_a) {
+			auto & node (*this_l->connection->node);
+			if (!ec)
+			{
+				auto start (std::chrono::steady_clock::now ());
+				auto error (this_l->decompressor->decompress (this_l->frame_buffer->data (), compressed_size_a, raw_size_a, this_l->decoded));
+				if (!error)
+				{
+					auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start));
+					node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_raw, nano::stat::dir::in, raw_size_a, true);
+					node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_compressed, nano::stat::dir::in, nano::bootstrap_compression::frame_header_size + compressed_size_a, true);
+					node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_time_us, nano::stat::dir::in, elapsed.count (), true);
+					this_l->decoded_offset = 0;
+					this_l->receive_decoded ();
+				}
+				else
+				{
+					if (node.config.logging.bulk_pull_logging ())
+					{
+						node.logger.try_log (boost::str (boost::format ("Error decompressing frame from %1%") % this_l->connection->channel->to_string ()));
+					}
+					this_l->compression_error ();
+				}
+			}
+			else
+			{
+				if (node.config.logging.bulk_pull_logging ())
+				{
+					node.logger.try_log (boost::str (boost::format ("Error receiving compressed frame: %1%") % ec.message ()));
+				}
+				node.stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_receive_block_failure, nano::stat::dir::in);
+				this_l->network_error = true;
+			}
+		});
+	}
+}
+
+void nano::bulk_pull_client::receive_decoded ()
+{
+	if (decoded_offset < decoded.size ())
+	{
+		nano::block_type type (static_cast<nano::block_type> (decoded[decoded_offset]));
+		if (type == nano::block_type::not_a_block)
+		{
+			decoded_offset = decoded.size ();
+			received_end ();
+		}
+		else
+		{
+			auto size (type != nano::block_type::invalid ? nano::block::size (type) : 0);
+			if (size != 0 && decoded.size () - decoded_offset > size)
+			{
+				auto begin (decoded.begin () + decoded_offset + 1);
+				std::copy (begin, begin + size, connection->receive_buffer->begin ());
+				decoded_offset += 1 + size;
+				received_block (boost::system::error_code{}, size, type);
+			}
+			else
+			{
+				if (connection->node->config.logging.network_packet_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Unknown or truncated block type in compressed frame: %1%") % static_cast<int> (type)));
+				}
+				compression_error ();
+			}
+		}
+	}
+	else
+	{
+		receive_frame ();
+	}
+}
+
+void nano::bulk_pull_client::compression_error ()
+{
+	connection->node->stats.inc_detail_only (nano::stat::type::bootstrap, nano::stat::detail::compression_error, nano::stat::dir::in);
+	connection->node->bootstrap_initiator.connections->peer_failure (connection->channel->get_tcp_endpoint ());
+	connection->stop (true);
+	if (auto socket_l = connection->channel->socket.lock ())
+	{
+		socket_l->close ();
+	}
+}
+
 nano::bulk_pull_account_client::bulk_pull_account_client (std::shared_ptr<nano::bootstrap_client> connection_a, std::shared_ptr<nano::bootstrap_attempt> attempt_a, nano::account const & account_a) :
 connection (connection_a),
 attempt (attempt_a),
@@ -353,27 +553,21 @@ void nano::bulk_pull_account_client::receive_pending ()
 					debug_assert (!error2);
 					if (this_l->pull_blocks == 0 || !pending.is_zero ())
 					{
-						if (this_l->pull_blocks == 0 || balance.number () >= this_l->connection->node->config.receive_minimum.number ())
+						// Entries below receive_minimum are skipped, they would not be received anyway
+						auto wanted (this_l->pull_blocks == 0 || balance.number () >= this_l->connection->node->config.receive_minimum.number ());
+						this_l->pull_blocks++;
+						if (wanted && !pending.is_zero ())
 						{
-							this_l->pull_blocks++;
+							if (!this_l->connection->node->ledger.block_exists (pending))
 							{
-								if (!pending.is_zero ())
-								{
-									if (!this_l->connection->node->ledger.block_exists (pending))
-									{
-										this_l->connection->node->bootstrap_initiator.bootstrap_lazy (pending, false, false);
-									}
-								}
+								this_l->connection->node->bootstrap_initiator.bootstrap_lazy (pending, false, false);
 							}
-							this_l->receive_pending ();
-						}
-						else
-						{
-							this_l->attempt->requeue_pending (this_l->account);
 						}
+						this_l->receive_pending ();
 					}
 					else
 					{
+						this_l->attempt->account_pulled (this_l->account);
 						this_l->connection->connections->pool_connection (this_l->connection);
 					}
 				}
@@ -478,39 +672,143 @@ void nano::bulk_pull_server::set_current_end ()
 	}
 }
 
+/**
+ * Send the next batch of blocks, copied from the store without deserializing them. The last batch includes not_a_block
+ */
 void nano::bulk_pull_server::send_next ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	if (compressor != nullptr)
 	{
-		std::vector<uint8_t> send_buffer;
+		send_frame ();
+	}
+	else
+	{
+		auto send_buffer (connection->send_buffer ());
+		auto finished (false);
 		{
-			nano::vectorstream stream (send_buffer);
-			nano::serialize_block (stream, *block);
+			auto transaction (connection->node->store.tx_begin_read ());
+			while (!finished && send_buffer->size () < send_batch_size)
+			{
+				finished = !serialize_next (transaction, *send_buffer);
+			}
+		}
+		if (finished)
+		{
+			send_buffer->push_back (static_cast<uint8_t> (nano::block_type::not_a_block));
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log ("Bulk sending finished");
+			}
 		}
 		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
+		connection->socket->async_write (nano::shared_const_buffer (send_buffer), [this_l, finished](boost::system::error_code const & ec, size_t size_a) {
+			if (!finished)
+			{
+				this_l->sent_action (ec, size_a);
+			}
+			else
+			{
+				this_l->no_block_sent (ec, size_a);
+			}
+		});
+	}
+}
+
+/**
+ * Send the next run of blocks as a compressed frame, the last one includes not_a_block
+ */
+void nano::bulk_pull_server::send_frame ()
+{
+	auto start (std::chrono::steady_clock::now ());
+	std::vector<uint8_t> raw;
+	auto finished (false);
+	{
+		auto transaction (connection->node->store.tx_begin_read ());
+		while (!finished && raw.size () < nano::bootstrap_compression::frame_raw_target)
 		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+			finished = !serialize_next (transaction, raw);
 		}
-		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l](boost::system::error_code const & ec, size_t size_a) {
-			this_l->sent_action (ec, size_a);
+	}
+	if (finished)
+	{
+		raw.push_back (static_cast<uint8_t> (nano::block_type::not_a_block));
+	}
+	std::vector<uint8_t> send_buffer;
+	if (!marker_sent)
+	{
+		send_buffer.push_back (nano::bootstrap_compression::marker);
+		marker_sent = true;
+	}
+	auto header_size (send_buffer.size ());
+	auto & node (*connection->node);
+	if (!compressor->compress (raw, send_buffer))
+	{
+		auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start));
+		node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_raw, nano::stat::dir::out, raw.size (), true);
+		node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_compressed, nano::stat::dir::out, send_buffer.size () - header_size, true);
+		node.stats.add (nano::stat::type::bootstrap, nano::stat::detail::compression_time_us, nano::stat::dir::out, elapsed.count (), true);
+		if (finished && node.config.logging.bulk_pull_logging ())
+		{
+			node.logger.try_log ("Bulk sending finished");
+		}
+		auto this_l (shared_from_this ());
+		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l, finished](boost::system::error_code const & ec, size_t size_a) {
+			if (!finished)
+			{
+				this_l->sent_action (ec, size_a);
+			}
+			else if (!ec)
+			{
+				this_l->connection->finish_request ();
+			}
 		});
 	}
 	else
 	{
-		send_finished ();
+		// The client already expects compressed frames and cannot be sent anything else, close the connection
+		if (node.config.logging.bulk_pull_logging ())
+		{
+			node.logger.try_log ("Unable to compress bulk pull frame");
+		}
+		node.stats.inc_detail_only (nano::stat::type::bootstrap, nano::stat::detail::compression_error, nano::stat::dir::out);
+		connection->stop ();
 	}
 }
 
 std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 {
 	std::shared_ptr<nano::block> result;
-	bool send_current = false, set_current_to_end = false;
+	auto last (false);
+	if (send_current (last))
+	{
+		result = connection->node->block (current);
+		advance (result != nullptr && !last, result != nullptr ? result->previous () : nano::block_hash (0));
+	}
+	return result;
+}
+
+bool nano::bulk_pull_server::serialize_next (nano::transaction const & transaction_a, std::vector<uint8_t> & buffer_a)
+{
+	auto result (false);
+	auto last (false);
+	if (send_current (last))
+	{
+		nano::block_hash previous (0);
+		result = !connection->node->store.block_serialized (transaction_a, current, buffer_a, previous);
+		advance (result && !last, previous);
+	}
+	return result;
+}
+
+/**
+ * Determine if we should reply with a block, \p last_a is set if the block at the cursor is the final one
+ */
+bool nano::bulk_pull_server::send_current (bool & last_a)
+{
+	auto result (false);
+	last_a = false;
 
 	/*
-	 * Determine if we should reply with a block
-	 *
 	 * If our cursor is on the final block, we should signal that we
 	 * are done by returning a null result.
 	 *
@@ -519,17 +817,17 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 	 */
 	if (current != request->end)
 	{
-		send_current = true;
+		result = true;
 	}
 	else if (current == request->end && include_start == true)
 	{
-		send_current = true;
+		result = true;
 
 		/*
 		 * We also need to ensure that the next time
 		 * are invoked that we return a null result
 		 */
-		set_current_to_end = true;
+		last_a = true;
 	}
 
 	/*
@@ -539,30 +837,7 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 	 */
 	if (max_count != 0 && sent_count >= max_count)
 	{
-		send_current = false;
-	}
-
-	if (send_current)
-	{
-		result = connection->node->block (current);
-		if (result != nullptr && set_current_to_end == false)
-		{
-			auto previous (result->previous ());
-			if (!previous.is_zero ())
-			{
-				current = previous;
-			}
-			else
-			{
-				current = request->end;
-			}
-		}
-		else
-		{
-			current = request->end;
-		}
-
-		sent_count++;
+		result = false;
 	}
 
 	/*
@@ -574,6 +849,19 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 	return result;
 }
 
+void nano::bulk_pull_server::advance (bool follow_previous_a, nano::block_hash const & previous_a)
+{
+	if (follow_previous_a && !previous_a.is_zero ())
+	{
+		current = previous_a;
+	}
+	else
+	{
+		current = request->end;
+	}
+	sent_count++;
+}
+
 void nano::bulk_pull_server::sent_action (boost::system::error_code const & ec, size_t size_a)
 {
 	if (!ec)
@@ -589,24 +877,10 @@ void nano::bulk_pull_server::sent_action (boost::system::error_code const & ec,
 	}
 }
 
-void nano::bulk_pull_server::send_finished ()
-{
-	nano::shared_const_buffer send_buffer (static_cast<uint8_t> (nano::block_type::not_a_block));
-	auto this_l (shared_from_this ());
-	if (connection->node->config.logging.bulk_pull_logging ())
-	{
-		connection->node->logger.try_log ("Bulk sending finished");
-	}
-	connection->socket->async_write (send_buffer, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		this_l->no_block_sent (ec, size_a);
-	});
-}
-
 void nano::bulk_pull_server::no_block_sent (boost::system::error_code const & ec, size_t size_a)
 {
 	if (!ec)
 	{
-		debug_assert (size_a == 1);
 		connection->finish_request ();
 	}
 	else
@@ -622,6 +896,10 @@ nano::bulk_pull_server::bulk_pull_server (std::shared_ptr<nano::bootstrap_server
 connection (connection_a),
 request (std::move (request_a))
 {
+	if (request->is_compressed () && connection->node->config.bootstrap_compression && nano::bootstrap_compression::available ())
+	{
+		compressor = std::make_unique<nano::bootstrap_compressor> ();
+	}
 	set_current_end ();
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <kizunano/node/bootstrap/bootstrap_compression.hpp>
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/socket.hpp>
 
+#include <atomic>
 #include <unordered_set>
 
 namespace nano
@@ -35,6 +37,13 @@ public:
 	void throttled_receive_block ();
 	void received_type ();
 	void received_block (boost::system::error_code const &, size_t, nano::block_type);
+	void received_end ();
+	void ready_to_receive ();
+	void receive_frame ();
+	void received_frame (uint32_t, uint32_t);
+	void receive_decoded ();
+	/** Closes the connection after an invalid compressed response, as the stream cannot be resynchronized */
+	void compression_error ();
 	nano::block_hash first ();
 	std::shared_ptr<nano::bootstrap_client> connection;
 	std::shared_ptr<nano::bootstrap_attempt> attempt;
@@ -44,6 +53,24 @@ public:
 	uint64_t pull_blocks;
 	uint64_t unexpected_count;
 	bool network_error{ false };
+	/** Set once the attempt asked to stop receiving this pull */
+	bool pull_stopped{ false };
+	/** Set if the pull waits for the response to a previous pull on the same connection */
+	bool pipelined{ false };
+	/** Pull requested after this one on the same connection, started once this response ended */
+	std::shared_ptr<nano::bulk_pull_client> next;
+	/** Counts the request being sent and the previous response having ended, receiving starts once both happened */
+	std::atomic<unsigned> receive_ready{ 0 };
+	/** Remaining blocks of a stopped pull are skipped to reach the pipelined response */
+	bool draining{ false };
+	/** Set if a compressed response was requested */
+	std::unique_ptr<nano::bootstrap_decompressor> decompressor;
+	/** Set once the server answered with a compressed response */
+	bool compressed{ false };
+	std::shared_ptr<std::vector<uint8_t>> frame_buffer;
+	/** Blocks of the current frame, consumed from decoded_offset */
+	std::vector<uint8_t> decoded;
+	size_t decoded_offset{ 0 };
 };
 class bulk_pull_account_client final : public std::enable_shared_from_this<nano::bulk_pull_account_client>
 {
@@ -65,16 +92,27 @@ public:
 	bulk_pull_server (std::shared_ptr<nano::bootstrap_server> const &, std::unique_ptr<nano::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<nano::block> get_next ();
+	/** Appends the next block to \p buffer_a straight from the store, returns false when there is none left */
+	bool serialize_next (nano::transaction const &, std::vector<uint8_t> & buffer_a);
 	void send_next ();
+	void send_frame ();
 	void sent_action (boost::system::error_code const &, size_t);
-	void send_finished ();
 	void no_block_sent (boost::system::error_code const &, size_t);
 	std::shared_ptr<nano::bootstrap_server> connection;
 	std::unique_ptr<nano::bulk_pull> request;
+	/** Set if the response is compressed */
+	std::unique_ptr<nano::bootstrap_compressor> compressor;
+	bool marker_sent{ false };
 	nano::block_hash current;
 	bool include_start;
 	nano::bulk_pull::count_t max_count;
 	nano::bulk_pull::count_t sent_count;
+	/** Serialized bytes after which a batch of blocks is written */
+	static size_t constexpr send_batch_size = 64 * 1024;
+
+private:
+	bool send_current (bool &);
+	void advance (bool, nano::block_hash const &);
 };
 class bulk_pull_account;
 class bulk_pull_account_server final : public std::enable_shared_from_this<nano::bulk_pull_account_server>
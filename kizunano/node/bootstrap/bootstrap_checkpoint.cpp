@@ -0,0 +1,88 @@
+#include <kizunano/node/bootstrap/bootstrap_checkpoint.hpp>
+
+constexpr uint8_t nano::bootstrap_checkpoint::version;
+
+namespace
+{
+template <typename T, typename F>
+void write_vector (nano::stream & stream_a, std::vector<T> const & items_a, F const & write_item_a)
+{
+	nano::write (stream_a, static_cast<uint64_t> (items_a.size ()));
+	for (auto const & item : items_a)
+	{
+		write_item_a (item);
+	}
+}
+
+template <typename T, typename F>
+bool read_vector (nano::stream & stream_a, std::vector<T> & items_a, F const & read_item_a)
+{
+	uint64_t size;
+	auto error (nano::try_read (stream_a, size));
+	items_a.clear ();
+	for (uint64_t i (0); !error && i < size; ++i)
+	{
+		T item;
+		error = read_item_a (item);
+		if (!error)
+		{
+			items_a.push_back (std::move (item));
+		}
+	}
+	return error;
+}
+}
+
+void nano::bootstrap_checkpoint::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, version);
+	write_vector (stream_a, pulls, [&stream_a](nano::pull_info const & pull_a) {
+		nano::write (stream_a, pull_a.account_or_head.bytes);
+		nano::write (stream_a, pull_a.head.bytes);
+		nano::write (stream_a, pull_a.head_original.bytes);
+		nano::write (stream_a, pull_a.end.bytes);
+		nano::write (stream_a, pull_a.count);
+		nano::write (stream_a, pull_a.processed);
+		nano::write (stream_a, pull_a.retry_limit);
+	});
+	write_vector (stream_a, lazy_pulls, [&stream_a](std::pair<nano::hash_or_account, unsigned> const & pull_a) {
+		nano::write (stream_a, pull_a.first.bytes);
+		nano::write (stream_a, pull_a.second);
+	});
+	write_vector (stream_a, lazy_keys, [&stream_a](nano::block_hash const & key_a) {
+		nano::write (stream_a, key_a.bytes);
+	});
+	write_vector (stream_a, lazy_state_backlog, [&stream_a](std::pair<nano::block_hash, nano::lazy_state_backlog_item> const & item_a) {
+		nano::write (stream_a, item_a.first.bytes);
+		nano::write (stream_a, item_a.second.link.bytes);
+		nano::write (stream_a, nano::amount (item_a.second.balance).bytes);
+		nano::write (stream_a, item_a.second.retry_limit);
+	});
+}
+
+bool nano::bootstrap_checkpoint::deserialize (nano::stream & stream_a)
+{
+	uint8_t version_l;
+	auto error (nano::try_read (stream_a, version_l) || version_l != version);
+	error = error || read_vector (stream_a, pulls, [&stream_a](nano::pull_info & pull_a) {
+		return nano::try_read (stream_a, pull_a.account_or_head.bytes) || nano::try_read (stream_a, pull_a.head.bytes) || nano::try_read (stream_a, pull_a.head_original.bytes) || nano::try_read (stream_a, pull_a.end.bytes) || nano::try_read (stream_a, pull_a.count) || nano::try_read (stream_a, pull_a.processed) || nano::try_read (stream_a, pull_a.retry_limit);
+	});
+	error = error || read_vector (stream_a, lazy_pulls, [&stream_a](std::pair<nano::hash_or_account, unsigned> & pull_a) {
+		return nano::try_read (stream_a, pull_a.first.bytes) || nano::try_read (stream_a, pull_a.second);
+	});
+	error = error || read_vector (stream_a, lazy_keys, [&stream_a](nano::block_hash & key_a) {
+		return nano::try_read (stream_a, key_a.bytes);
+	});
+	error = error || read_vector (stream_a, lazy_state_backlog, [&stream_a](std::pair<nano::block_hash, nano::lazy_state_backlog_item> & item_a) {
+		nano::amount balance;
+		auto error_l (nano::try_read (stream_a, item_a.first.bytes) || nano::try_read (stream_a, item_a.second.link.bytes) || nano::try_read (stream_a, balance.bytes) || nano::try_read (stream_a, item_a.second.retry_limit));
+		item_a.second.balance = balance.number ();
+		return error_l;
+	});
+	return error;
+}
+
+bool nano::bootstrap_checkpoint::empty () const
+{
+	return pulls.empty () && lazy_pulls.empty () && lazy_keys.empty () && lazy_state_backlog.empty ();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <kizunano/node/bootstrap/bootstrap_lazy.hpp>
+
+#include <vector>
+
+namespace nano
+{
+/**
+ * Work left in a legacy or lazy attempt, stored periodically in the bootstrap_checkpoint table under the
+ * attempt mode so that a restarted node resumes it instead of starting over. Pulls in flight when the
+ * checkpoint is taken are not included, the following legacy attempt covers them.
+ */
+class bootstrap_checkpoint final
+{
+public:
+	void serialize (nano::stream &) const;
+	bool deserialize (nano::stream &);
+	bool empty () const;
+	/** Queued pulls of a legacy attempt, starting after its frontier scan */
+	std::vector<nano::pull_info> pulls;
+	std::vector<std::pair<nano::hash_or_account, unsigned>> lazy_pulls;
+	std::vector<nano::block_hash> lazy_keys;
+	std::vector<std::pair<nano::block_hash, nano::lazy_state_backlog_item>> lazy_state_backlog;
+	/** Changing the layout requires a new version, older checkpoints are then dropped */
+	static uint8_t constexpr version = 1;
+};
+}
@@ -0,0 +1,169 @@
+#include <kizunano/lib/blocks.hpp>
+#include <kizunano/lib/utility.hpp>
+#include <kizunano/node/bootstrap/bootstrap_compression.hpp>
+
+#include <cstring>
+
+#if NANO_ZSTD
+#include <zstd.h>
+#endif
+
+constexpr uint8_t nano::bootstrap_compression::marker;
+constexpr size_t nano::bootstrap_compression::frame_header_size;
+constexpr size_t nano::bootstrap_compression::frame_raw_target;
+constexpr size_t nano::bootstrap_compression::frame_max;
+constexpr int nano::bootstrap_compression::level;
+
+namespace
+{
+uint32_t read_u32 (uint8_t const * data_a)
+{
+	return static_cast<uint32_t> (data_a[0]) | (static_cast<uint32_t> (data_a[1]) << 8) | (static_cast<uint32_t> (data_a[2]) << 16) | (static_cast<uint32_t> (data_a[3]) << 24);
+}
+
+std::vector<uint8_t> make_dictionary ()
+{
+	// Offset of the link field within a serialized state block: account, previous, representative, balance
+	size_t constexpr state_link_offset (3 * 32 + 16);
+	std::vector<uint8_t> result;
+	auto append_template = [&result](nano::block_type type_a, char const * link_a) {
+		result.push_back (static_cast<uint8_t> (type_a));
+		auto begin (result.size ());
+		result.resize (begin + nano::block::size (type_a), 0);
+		if (link_a != nullptr)
+		{
+			std::memcpy (result.data () + begin + state_link_offset, link_a, std::strlen (link_a));
+		}
+	};
+	// Zstd favours the end of a raw content dictionary, so the most frequent layouts come last
+	append_template (nano::block_type::change, nullptr);
+	append_template (nano::block_type::open, nullptr);
+	append_template (nano::block_type::receive, nullptr);
+	append_template (nano::block_type::send, nullptr);
+	append_template (nano::block_type::state, "epoch v1 block");
+	append_template (nano::block_type::state, "epoch v2 block");
+	append_template (nano::block_type::state, nullptr);
+	result.push_back (static_cast<uint8_t> (nano::block_type::not_a_block));
+	return result;
+}
+
+#if NANO_ZSTD
+void write_u32 (uint8_t * data_a, uint32_t value_a)
+{
+	data_a[0] = static_cast<uint8_t> (value_a);
+	data_a[1] = static_cast<uint8_t> (value_a >> 8);
+	data_a[2] = static_cast<uint8_t> (value_a >> 16);
+	data_a[3] = static_cast<uint8_t> (value_a >> 24);
+}
+
+class dictionaries final
+{
+public:
+	dictionaries () :
+	compress (ZSTD_createCDict (nano::bootstrap_compression::dictionary ().data (), nano::bootstrap_compression::dictionary ().size (), nano::bootstrap_compression::level)),
+	decompress (ZSTD_createDDict (nano::bootstrap_compression::dictionary ().data (), nano::bootstrap_compression::dictionary ().size ()))
+	{
+		release_assert (compress != nullptr && decompress != nullptr);
+	}
+	~dictionaries ()
+	{
+		ZSTD_freeCDict (compress);
+		ZSTD_freeDDict (decompress);
+	}
+	ZSTD_CDict * compress;
+	ZSTD_DDict * decompress;
+};
+
+dictionaries const & shared_dictionaries ()
+{
+	static dictionaries result;
+	return result;
+}
+#endif
+}
+
+bool nano::bootstrap_compression::available ()
+{
+	return NANO_ZSTD;
+}
+
+std::vector<uint8_t> const & nano::bootstrap_compression::dictionary ()
+{
+	static std::vector<uint8_t> const result (make_dictionary ());
+	return result;
+}
+
+nano::bootstrap_compressor::bootstrap_compressor ()
+{
+#if NANO_ZSTD
+	context = ZSTD_createCCtx ();
+#endif
+}
+
+nano::bootstrap_compressor::~bootstrap_compressor ()
+{
+#if NANO_ZSTD
+	ZSTD_freeCCtx (context);
+#endif
+}
+
+bool nano::bootstrap_compressor::compress (std::vector<uint8_t> const & raw_a, std::vector<uint8_t> & frame_a)
+{
+	auto error (true);
+#if NANO_ZSTD
+	if (context != nullptr && raw_a.size () <= nano::bootstrap_compression::frame_max)
+	{
+		auto begin (frame_a.size ());
+		frame_a.resize (begin + nano::bootstrap_compression::frame_header_size + ZSTD_compressBound (raw_a.size ()));
+		auto payload (frame_a.data () + begin + nano::bootstrap_compression::frame_header_size);
+		auto size (ZSTD_compress_usingCDict (context, payload, frame_a.size () - begin - nano::bootstrap_compression::frame_header_size, raw_a.data (), raw_a.size (), shared_dictionaries ().compress));
+		error = ZSTD_isError (size) || size > nano::bootstrap_compression::frame_max;
+		if (!error)
+		{
+			write_u32 (frame_a.data () + begin, static_cast<uint32_t> (size));
+			write_u32 (frame_a.data () + begin + sizeof (uint32_t), static_cast<uint32_t> (raw_a.size ()));
+			frame_a.resize (begin + nano::bootstrap_compression::frame_header_size + size);
+		}
+		else
+		{
+			frame_a.resize (begin);
+		}
+	}
+#endif
+	return error;
+}
+
+nano::bootstrap_decompressor::bootstrap_decompressor ()
+{
+#if NANO_ZSTD
+	context = ZSTD_createDCtx ();
+#endif
+}
+
+nano::bootstrap_decompressor::~bootstrap_decompressor ()
+{
+#if NANO_ZSTD
+	ZSTD_freeDCtx (context);
+#endif
+}
+
+bool nano::bootstrap_decompressor::header (uint8_t const * data_a, uint32_t & compressed_a, uint32_t & raw_a)
+{
+	compressed_a = read_u32 (data_a);
+	raw_a = read_u32 (data_a + sizeof (uint32_t));
+	return compressed_a == 0 || raw_a == 0 || compressed_a > nano::bootstrap_compression::frame_max || raw_a > nano::bootstrap_compression::frame_max;
+}
+
+bool nano::bootstrap_decompressor::decompress (uint8_t const * data_a, size_t size_a, uint32_t raw_size_a, std::vector<uint8_t> & raw_a)
+{
+	auto error (true);
+#if NANO_ZSTD
+	if (context != nullptr && raw_size_a <= nano::bootstrap_compression::frame_max)
+	{
+		raw_a.resize (raw_size_a);
+		auto size (ZSTD_decompress_usingDDict (context, raw_a.data (), raw_a.size (), data_a, size_a, shared_dictionaries ().decompress));
+		error = ZSTD_isError (size) || size != raw_size_a;
+	}
+#endif
+	return error;
+}
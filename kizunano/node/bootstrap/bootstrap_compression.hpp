@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace nano
+{
+/**
+ * Optional zstd compression of bulk_pull responses, requested by setting the bulk_pull compressed flag.
+ * A server able and willing to compress replies with `marker`, followed by frames of
+ * [uint32 compressed size][uint32 raw size][zstd frame], each holding a run of serialized blocks
+ * and the final one ending with not_a_block. Frames are compressed against a content dictionary both
+ * ends derive from the block layouts, so small frames still benefit from the shared structure.
+ * Servers without support ignore the flag and stream raw blocks, which the client tells from the first byte.
+ */
+class bootstrap_compression final
+{
+public:
+	/** True if the node was built with NANO_ZSTD */
+	static bool available ();
+	/** Deterministic content dictionary shared by both ends, changing it requires a new marker */
+	static std::vector<uint8_t> const & dictionary ();
+	/** First byte of a compressed response, not a valid block type */
+	static uint8_t constexpr marker = 0xf1;
+	static size_t constexpr frame_header_size = 2 * sizeof (uint32_t);
+	/** Uncompressed bytes after which the server closes a frame */
+	static size_t constexpr frame_raw_target = 32 * 1024;
+	/** Upper bound accepted by the client for either size of a frame */
+	static size_t constexpr frame_max = 256 * 1024;
+	static int constexpr level = 3;
+};
+class bootstrap_compressor final
+{
+public:
+	bootstrap_compressor ();
+	~bootstrap_compressor ();
+	bootstrap_compressor (bootstrap_compressor const &) = delete;
+	bootstrap_compressor & operator= (bootstrap_compressor const &) = delete;
+	/** Appends a frame with header holding \p raw_a to \p frame_a, returns true on error */
+	bool compress (std::vector<uint8_t> const & raw_a, std::vector<uint8_t> & frame_a);
+
+private:
+	ZSTD_CCtx_s * context{ nullptr };
+};
+class bootstrap_decompressor final
+{
+public:
+	bootstrap_decompressor ();
+	~bootstrap_decompressor ();
+	bootstrap_decompressor (bootstrap_decompressor const &) = delete;
+	bootstrap_decompressor & operator= (bootstrap_decompressor const &) = delete;
+	/** Reads a frame header, returns true if either size is out of bounds */
+	static bool header (uint8_t const * data_a, uint32_t & compressed_a, uint32_t & raw_a);
+	/** Replaces \p raw_a with the decompressed frame payload, returns true on error or size mismatch */
+	bool decompress (uint8_t const * data_a, size_t size_a, uint32_t raw_size_a, std::vector<uint8_t> & raw_a);
+
+private:
+	ZSTD_DCtx_s * context{ nullptr };
+};
+}
@@ -12,6 +12,10 @@ constexpr double nano::bootstrap_limits::bootstrap_minimum_blocks_per_sec;
 constexpr double nano::bootstrap_limits::bootstrap_minimum_termination_time_sec;
 constexpr unsigned nano::bootstrap_limits::bootstrap_max_new_connections;
 constexpr unsigned nano::bootstrap_limits::requeued_pulls_processed_blocks_factor;
+constexpr double nano::bootstrap_limits::bootstrap_rate_smoothing;
+constexpr unsigned nano::bootstrap_limits::bootstrap_throughput_window;
+constexpr double nano::bootstrap_limits::bootstrap_throughput_gain;
+constexpr size_t nano::bootstrap_limits::bootstrap_peer_scores_max;
 
 nano::bootstrap_client::bootstrap_client (std::shared_ptr<nano::node> node_a, std::shared_ptr<nano::bootstrap_connections> connections_a, std::shared_ptr<nano::transport::channel_tcp> channel_a, std::shared_ptr<nano::socket> socket_a) :
 node (node_a),
@@ -57,6 +61,11 @@ void nano::bootstrap_client::stop (bool force)
 	}
 }
 
+double nano::bootstrap_peer_score::score () const
+{
+	return rate / (1.0 + failures);
+}
+
 nano::bootstrap_connections::bootstrap_connections (nano::node & node_a) :
 node (node_a)
 {
@@ -145,6 +154,22 @@ std::shared_ptr<nano::bootstrap_client> nano::bootstrap_connections::find_connec
 	return result;
 }
 
+std::shared_ptr<nano::bootstrap_client> nano::bootstrap_connections::idle_connection (std::unordered_set<nano::tcp_endpoint> const & exclude_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	std::shared_ptr<nano::bootstrap_client> result;
+	for (auto i (idle.begin ()), end (idle.end ()); i != end && !stopped; ++i)
+	{
+		if (exclude_a.find ((*i)->channel->get_tcp_endpoint ()) == exclude_a.end ())
+		{
+			result = *i;
+			idle.erase (i);
+			break;
+		}
+	}
+	return result;
+}
+
 void nano::bootstrap_connections::connect_client (nano::tcp_endpoint const & endpoint_a, bool push_front)
 {
 	++connections_count;
@@ -163,6 +188,7 @@ void nano::bootstrap_connections::connect_client (nano::tcp_endpoint const & end
 		}
 		else
 		{
+			this_l->peer_failure (endpoint_a);
 			if (this_l->node.config.logging.network_logging ())
 			{
 				switch (ec.value ())
@@ -197,20 +223,142 @@ unsigned nano::bootstrap_connections::target_connections (size_t pulls_remaining
 	return std::max (1U, (unsigned)(target + 0.5f));
 }
 
-struct block_rate_cmp
+unsigned nano::bootstrap_connections::throughput_target (unsigned demand_a, double rate_a)
+{
+	auto constexpr smoothing (nano::bootstrap_limits::bootstrap_rate_smoothing);
+	if (rate_a > 0.0)
+	{
+		rate_smoothed = rate_smoothed * (1.0 - smoothing) + rate_a * smoothing;
+		if (++ticks % nano::bootstrap_limits::bootstrap_throughput_window == 0)
+		{
+			unsigned connections (connections_count);
+			auto gained (rate_smoothed > rate_window * (1.0 + nano::bootstrap_limits::bootstrap_throughput_gain));
+			if (connections > connections_window && !gained)
+			{
+				// The connections added during the window did not raise the aggregate rate, peers or our own processing are the limit
+				throughput_cap = std::max ({ 1U, connections_window, node.config.bootstrap_connections });
+			}
+			else if (gained && connections >= throughput_cap)
+			{
+				// Still scaling, allow another quarter
+				throughput_cap = connections + std::max (1U, connections / 4);
+			}
+			rate_window = rate_smoothed;
+			connections_window = connections;
+		}
+	}
+	else
+	{
+		// Nothing to learn from while no blocks flow, new attempts start at the full demand
+		rate_smoothed = 0.0;
+		rate_window = 0.0;
+		connections_window = 0;
+		throughput_cap = std::numeric_limits<unsigned>::max ();
+		ticks = 0;
+	}
+	return std::max (1U, std::min (demand_a, throughput_cap));
+}
+
+void nano::bootstrap_connections::peer_sample (nano::tcp_endpoint const & endpoint_a, double rate_a)
 {
-	bool operator() (const std::shared_ptr<nano::bootstrap_client> & lhs, const std::shared_ptr<nano::bootstrap_client> & rhs) const
+	debug_assert (!mutex.try_lock ());
+	auto existing (scores.find (endpoint_a));
+	if (existing == scores.end ())
 	{
-		return lhs->block_rate () > rhs->block_rate ();
+		trim_scores ();
+		scores[endpoint_a].rate = rate_a;
 	}
-};
+	else
+	{
+		auto constexpr smoothing (nano::bootstrap_limits::bootstrap_rate_smoothing);
+		auto & score (existing->second);
+		score.rate = score.rate * (1.0 - smoothing) + rate_a * smoothing;
+		score.failures *= 1.0 - smoothing;
+		score.last_update = std::chrono::steady_clock::now ();
+	}
+}
+
+void nano::bootstrap_connections::peer_failure (nano::tcp_endpoint const & endpoint_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	if (scores.find (endpoint_a) == scores.end ())
+	{
+		trim_scores ();
+	}
+	auto & score (scores[endpoint_a]);
+	score.failures += 1.0;
+	score.last_update = std::chrono::steady_clock::now ();
+}
+
+double nano::bootstrap_connections::peer_score (nano::tcp_endpoint const & endpoint_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (scores.find (endpoint_a));
+	return existing != scores.end () ? existing->second.score () : 0.0;
+}
+
+nano::peer_info nano::bootstrap_connections::peer_info (nano::tcp_endpoint const & endpoint_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (scores.find (endpoint_a));
+	return existing != scores.end () ? nano::peer_info (existing->second.rate, existing->second.failures) : nano::peer_info ();
+}
+
+void nano::bootstrap_connections::peer_restore (nano::tcp_endpoint const & endpoint_a, nano::peer_info const & info_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	if (!(info_a == nano::peer_info ()) && scores.find (endpoint_a) == scores.end ())
+	{
+		trim_scores ();
+		auto & score (scores[endpoint_a]);
+		score.rate = info_a.rate;
+		score.failures = info_a.failures;
+	}
+}
+
+std::vector<nano::tcp_endpoint> nano::bootstrap_connections::best_peers (size_t count_a, std::unordered_set<nano::tcp_endpoint> const & exclude_a)
+{
+	std::vector<std::pair<double, nano::tcp_endpoint>> candidates;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		for (auto const & score : scores)
+		{
+			if (score.second.score () >= nano::bootstrap_limits::bootstrap_minimum_blocks_per_sec && exclude_a.find (score.first) == exclude_a.end ())
+			{
+				candidates.emplace_back (score.second.score (), score.first);
+			}
+		}
+	}
+	auto count_l (std::min (count_a, candidates.size ()));
+	std::partial_sort (candidates.begin (), candidates.begin () + count_l, candidates.end (), [](auto const & lhs, auto const & rhs) { return lhs.first > rhs.first; });
+	std::vector<nano::tcp_endpoint> result;
+	for (auto i (candidates.begin ()), n (candidates.begin () + count_l); i != n; ++i)
+	{
+		if (!node.network.excluded_peers.check (i->second))
+		{
+			result.push_back (i->second);
+		}
+	}
+	return result;
+}
+
+void nano::bootstrap_connections::trim_scores ()
+{
+	debug_assert (!mutex.try_lock ());
+	if (scores.size () >= nano::bootstrap_limits::bootstrap_peer_scores_max)
+	{
+		auto oldest (std::min_element (scores.begin (), scores.end (), [](auto const & lhs, auto const & rhs) { return lhs.second.last_update < rhs.second.last_update; }));
+		scores.erase (oldest);
+	}
+}
 
 void nano::bootstrap_connections::populate_connections (bool repeat)
 {
 	double rate_sum = 0.0;
 	size_t num_pulls = 0;
 	size_t attempts_count = node.bootstrap_initiator.attempts.size ();
-	std::priority_queue<std::shared_ptr<nano::bootstrap_client>, std::vector<std::shared_ptr<nano::bootstrap_client>>, block_rate_cmp> sorted_connections;
+	// Warmed up connections with their peer score, the lowest are dropped first
+	std::vector<std::pair<double, std::shared_ptr<nano::bootstrap_client>>> sorted_connections;
 	std::unordered_set<nano::tcp_endpoint> endpoints;
 	{
 		nano::unique_lock<std::mutex> lock (mutex);
@@ -227,9 +375,13 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 					double elapsed_sec = client->elapsed_seconds ();
 					auto blocks_per_sec = client->block_rate ();
 					rate_sum += blocks_per_sec;
-					if (client->elapsed_seconds () > nano::bootstrap_limits::bootstrap_connection_warmup_time_sec && client->block_count > 0)
+					if (elapsed_sec > nano::bootstrap_limits::bootstrap_connection_warmup_time_sec)
 					{
-						sorted_connections.push (client);
+						peer_sample (client->channel->get_tcp_endpoint (), blocks_per_sec);
+						if (client->block_count > 0)
+						{
+							sorted_connections.emplace_back (scores[client->channel->get_tcp_endpoint ()].score (), client);
+						}
 					}
 					// Force-stop the slowest peers, since they can take the whole bootstrap hostage by dribbling out blocks on the last remaining pull.
 					// This is ~1.5kilobits/sec.
@@ -241,6 +393,7 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 						}
 
 						client->stop (true);
+						scores[client->channel->get_tcp_endpoint ()].failures += 1.0;
 						new_clients.pop_back ();
 					}
 				}
@@ -250,7 +403,8 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 		clients.swap (new_clients);
 	}
 
-	auto target = target_connections (num_pulls, attempts_count);
+	auto target = throughput_target (target_connections (num_pulls, attempts_count), rate_sum);
+	std::sort (sorted_connections.begin (), sorted_connections.end (), [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
 
 	// We only want to drop slow peers when more than 2/3 are active. 2/3 because 1/2 is too aggressive, and 100% rarely happens.
 	// Probably needs more tuning.
@@ -266,15 +420,14 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 
 		for (int i = 0; i < drop; i++)
 		{
-			auto client = sorted_connections.top ();
+			auto client = sorted_connections[i].second;
 
 			if (node.config.logging.bulk_pull_logging ())
 			{
-				node.logger.try_log (boost::str (boost::format ("Dropping peer with block rate %1%, block count %2% (%3%) ") % client->block_rate () % client->block_count % client->channel->to_string ()));
+				node.logger.try_log (boost::str (boost::format ("Dropping peer with score %1%, block rate %2%, block count %3% (%4%) ") % sorted_connections[i].first % client->block_rate () % client->block_count % client->channel->to_string ()));
 			}
 
 			client->stop (false);
-			sorted_connections.pop ();
 		}
 	}
 
@@ -288,9 +441,11 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 		auto delta = std::min ((target - connections_count) * 2, nano::bootstrap_limits::bootstrap_max_new_connections);
 		// TODO - tune this better
 		// Not many peers respond, need to try to make more connections than we need.
+		// Peers that served well before are tried first
+		auto preferred (best_peers (delta, endpoints));
 		for (auto i = 0u; i < delta; i++)
 		{
-			auto endpoint (node.network.bootstrap_peer (true));
+			auto endpoint (i < preferred.size () ? preferred[i] : node.network.bootstrap_peer (true));
 			if (endpoint != nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0) && (node.flags.allow_bootstrap_peers_duplicates || endpoints.find (endpoint) == endpoints.end ()) && !node.network.excluded_peers.check (endpoint))
 			{
 				connect_client (endpoint);
@@ -346,34 +501,63 @@ void nano::bootstrap_connections::request_pull (nano::unique_lock<std::mutex> &
 	lock_a.lock ();
 	if (connection_l != nullptr && !pulls.empty ())
 	{
-		std::shared_ptr<nano::bootstrap_attempt> attempt_l;
-		nano::pull_info pull;
-		// Search pulls with existing attempts
-		while (attempt_l == nullptr && !pulls.empty ())
+		// Up to bootstrap_pull_pipeline pulls are requested at once, the server answers them in order
+		std::vector<std::pair<std::shared_ptr<nano::bootstrap_attempt>, nano::pull_info>> batch;
+		while (batch.size () < node.config.bootstrap_pull_pipeline && !pulls.empty ())
 		{
-			pull = pulls.front ();
-			pulls.pop_front ();
-			attempt_l = node.bootstrap_initiator.attempts.find (pull.bootstrap_id);
-			// Check if lazy pull is obsolete (head was processed or head is 0 for destinations requests)
-			if (attempt_l != nullptr && attempt_l->mode == nano::bootstrap_mode::lazy && !pull.head.is_zero () && attempt_l->lazy_processed_or_exists (pull.head))
+			std::shared_ptr<nano::bootstrap_attempt> attempt_l;
+			nano::pull_info pull;
+			// Search pulls with existing attempts
+			while (attempt_l == nullptr && !pulls.empty ())
 			{
-				attempt_l->pull_finished ();
-				attempt_l = nullptr;
+				pull = pulls.front ();
+				pulls.pop_front ();
+				attempt_l = node.bootstrap_initiator.attempts.find (pull.bootstrap_id);
+				// Check if lazy pull is obsolete (head was processed or head is 0 for destinations requests)
+				if (attempt_l != nullptr && attempt_l->mode == nano::bootstrap_mode::lazy && !pull.head.is_zero () && attempt_l->lazy_processed_or_exists (pull.head))
+				{
+					attempt_l->pull_finished ();
+					attempt_l = nullptr;
+				}
 			}
-		}
-		if (attempt_l != nullptr)
-		{
-			if (attempt_l->mode == nano::bootstrap_mode::legacy)
+			if (attempt_l != nullptr)
 			{
-				attempt_l->add_recent_pull (pull.head);
+				if (attempt_l->mode == nano::bootstrap_mode::legacy)
+				{
+					attempt_l->add_recent_pull (pull.head);
+				}
+				batch.emplace_back (attempt_l, pull);
 			}
+		}
+		if (!batch.empty ())
+		{
 			// The bulk_pull_client destructor attempt to requeue_pull which can cause a deadlock if this is the last reference
 			// Dispatch request in an external thread in case it needs to be destroyed
-			node.background ([connection_l, attempt_l, pull]() {
-				auto client (std::make_shared<nano::bulk_pull_client> (connection_l, attempt_l, pull));
-				client->request ();
+			node.background ([connection_l, batch]() {
+				// Each client holds the one following it, which starts receiving once the previous response ended
+				std::vector<std::shared_ptr<nano::bulk_pull_client>> clients_l;
+				std::shared_ptr<nano::bulk_pull_client> next;
+				for (auto i (batch.rbegin ()), n (batch.rend ()); i != n; ++i)
+				{
+					auto client (std::make_shared<nano::bulk_pull_client> (connection_l, i->first, i->second));
+					client->pipelined = i + 1 != n;
+					client->next = next;
+					next = client;
+					clients_l.push_back (client);
+				}
+				for (auto i (clients_l.rbegin ()), n (clients_l.rend ()); i != n; ++i)
+				{
+					(*i)->request ();
+				}
 			});
 		}
+		else
+		{
+			// Reuse connection if no pull is left to request
+			lock_a.unlock ();
+			pool_connection (connection_l);
+			lock_a.lock ();
+		}
 	}
 	else if (connection_l != nullptr)
 	{
@@ -441,6 +625,11 @@ void nano::bootstrap_connections::requeue_pull (nano::pull_info const & pull_a,
 			{
 				node.bootstrap_initiator.cache.add (pull);
 			}
+			else if (attempt_l->mode == nano::bootstrap_mode::priority)
+			{
+				// Retried by the attempt with a per account backoff
+				attempt_l->requeue_pending (pull.account_or_head.account);
+			}
 		}
 	}
 }
@@ -465,6 +654,14 @@ void nano::bootstrap_connections::clear_pulls (uint64_t bootstrap_id_a)
 	condition.notify_all ();
 }
 
+std::vector<nano::pull_info> nano::bootstrap_connections::attempt_pulls (uint64_t bootstrap_id_a)
+{
+	std::vector<nano::pull_info> result;
+	nano::lock_guard<std::mutex> lock (mutex);
+	std::copy_if (pulls.begin (), pulls.end (), std::back_inserter (result), [bootstrap_id_a](nano::pull_info const & pull_a) { return pull_a.bootstrap_id == bootstrap_id_a; });
+	return result;
+}
+
 void nano::bootstrap_connections::run ()
 {
 	start_populate_connections ();
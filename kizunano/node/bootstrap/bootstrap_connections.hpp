@@ -4,6 +4,8 @@
 #include <kizunano/node/socket.hpp>
 
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace nano
 {
@@ -41,6 +43,20 @@ private:
 	std::chrono::steady_clock::time_point start_time_m;
 };
 
+/**
+ * Smoothed record of how a peer served bulk pulls, kept across attempts
+ */
+class bootstrap_peer_score final
+{
+public:
+	/** Blocks per second while connected */
+	double rate{ 0.0 };
+	/** Failed connections and pulls, decaying with every successful sample */
+	double failures{ 0.0 };
+	std::chrono::steady_clock::time_point last_update{ std::chrono::steady_clock::now () };
+	double score () const;
+};
+
 class bootstrap_connections final : public std::enable_shared_from_this<bootstrap_connections>
 {
 public:
@@ -50,14 +66,28 @@ public:
 	void pool_connection (std::shared_ptr<nano::bootstrap_client> client_a, bool new_client = false, bool push_front = false);
 	void add_connection (nano::endpoint const & endpoint_a);
 	std::shared_ptr<nano::bootstrap_client> find_connection (nano::tcp_endpoint const & endpoint_a);
+	/** Takes an idle connection to any peer not in \p exclude_a without waiting, nullptr if there is none */
+	std::shared_ptr<nano::bootstrap_client> idle_connection (std::unordered_set<nano::tcp_endpoint> const & exclude_a);
 	void connect_client (nano::tcp_endpoint const & endpoint_a, bool push_front = false);
 	unsigned target_connections (size_t pulls_remaining, size_t attempts_count);
+	/** Caps \p demand_a to the connections that still raised the aggregate block rate \p rate_a, called once per populate tick */
+	unsigned throughput_target (unsigned demand_a, double rate_a);
+	void peer_failure (nano::tcp_endpoint const &);
+	double peer_score (nano::tcp_endpoint const &);
+	/** Score to be stored with the peer, unscored peers are stored as zero */
+	nano::peer_info peer_info (nano::tcp_endpoint const &);
+	/** Restores a score stored with the peer by a previous run, scores sampled since are kept */
+	void peer_restore (nano::tcp_endpoint const &, nano::peer_info const &);
+	/** Best scoring peers not in \p exclude_a, to be connected before random ones */
+	std::vector<nano::tcp_endpoint> best_peers (size_t count_a, std::unordered_set<nano::tcp_endpoint> const & exclude_a);
 	void populate_connections (bool repeat = true);
 	void start_populate_connections ();
 	void add_pull (nano::pull_info const & pull_a);
 	void request_pull (nano::unique_lock<std::mutex> & lock_a);
 	void requeue_pull (nano::pull_info const & pull_a, bool network_error = false);
 	void clear_pulls (uint64_t);
+	/** Copy of the queued pulls of an attempt */
+	std::vector<nano::pull_info> attempt_pulls (uint64_t);
 	void run ();
 	void stop ();
 	std::deque<std::weak_ptr<nano::bootstrap_client>> clients;
@@ -65,10 +95,20 @@ public:
 	nano::node & node;
 	std::deque<std::shared_ptr<nano::bootstrap_client>> idle;
 	std::deque<nano::pull_info> pulls;
+	std::unordered_map<nano::tcp_endpoint, nano::bootstrap_peer_score> scores;
 	std::atomic<bool> populate_connections_started{ false };
 	std::atomic<bool> new_connections_empty{ false };
 	std::atomic<bool> stopped{ false };
 	std::mutex mutex;
 	nano::condition_variable condition;
+
+private:
+	void peer_sample (nano::tcp_endpoint const &, double);
+	void trim_scores ();
+	double rate_smoothed{ 0.0 };
+	double rate_window{ 0.0 };
+	unsigned connections_window{ 0 };
+	unsigned throughput_cap{ std::numeric_limits<unsigned>::max () };
+	unsigned ticks{ 0 };
 };
 }
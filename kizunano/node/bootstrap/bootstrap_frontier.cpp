@@ -9,13 +9,14 @@ constexpr double nano::bootstrap_limits::bootstrap_connection_warmup_time_sec;
 constexpr double nano::bootstrap_limits::bootstrap_minimum_elapsed_seconds_blockrate;
 constexpr double nano::bootstrap_limits::bootstrap_minimum_frontier_blocks_per_sec;
 constexpr unsigned nano::bootstrap_limits::bulk_push_cost_limit;
+constexpr unsigned nano::bootstrap_limits::frontier_req_ranges;
 
 constexpr size_t nano::frontier_req_client::size_frontier;
 
 void nano::frontier_req_client::run ()
 {
 	nano::frontier_req request;
-	request.start.clear ();
+	request.start = range_start;
 	request.age = std::numeric_limits<decltype (request.age)>::max ();
 	request.count = std::numeric_limits<decltype (request.count)>::max ();
 	auto this_l (shared_from_this ());
@@ -31,17 +32,22 @@ void nano::frontier_req_client::run ()
 			{
 				this_l->connection->node->logger.try_log (boost::str (boost::format ("Error while sending bootstrap request %1%") % ec.message ()));
 			}
+			this_l->finish (true);
 		}
 	},
 	nano::buffer_drop_policy::no_limiter_drop);
 }
 
-nano::frontier_req_client::frontier_req_client (std::shared_ptr<nano::bootstrap_client> connection_a, std::shared_ptr<nano::bootstrap_attempt> attempt_a) :
+nano::frontier_req_client::frontier_req_client (std::shared_ptr<nano::bootstrap_client> connection_a, std::shared_ptr<nano::bootstrap_attempt> attempt_a, nano::account const & start_a, nano::account const & end_a, bool bulk_push_peer_a) :
 connection (connection_a),
 attempt (attempt_a),
-current (0),
+current (start_a.is_zero () ? 0 : start_a.number () - 1),
 count (0),
-bulk_push_cost (0)
+bulk_push_cost (0),
+bulk_push_peer (bulk_push_peer_a),
+range_start (start_a),
+range_end (end_a),
+received (0)
 {
 	next ();
 }
@@ -50,6 +56,58 @@ nano::frontier_req_client::~frontier_req_client ()
 {
 }
 
+void nano::frontier_req_client::finish (bool error_a)
+{
+	{
+		nano::lock_guard<std::mutex> guard (range_mutex);
+		finished = true;
+	}
+	try
+	{
+		promise.set_value (error_a);
+	}
+	catch (std::future_error &)
+	{
+	}
+	{
+		// Synchronize with the attempt waiting for its ranges
+		nano::lock_guard<std::mutex> guard (attempt->mutex);
+	}
+	attempt->condition.notify_all ();
+}
+
+bool nano::frontier_req_client::split (nano::account & start_a, nano::account & end_a)
+{
+	nano::lock_guard<std::mutex> guard (range_mutex);
+	auto error (true);
+	if (!finished)
+	{
+		nano::uint512_t from (received.is_zero () ? range_start.number () : received.number ());
+		nano::uint512_t to (range_end.is_zero () ? nano::uint512_t (1) << 256 : nano::uint512_t (range_end.number ()));
+		// Not worth another connection below 1/1024th of the account space
+		if (to > from && to - from > (nano::uint512_t (1) << 246))
+		{
+			start_a = nano::account (static_cast<nano::uint256_t> (from + (to - from) / 2));
+			end_a = range_end;
+			range_end = start_a;
+			error = false;
+		}
+	}
+	return error;
+}
+
+nano::account nano::frontier_req_client::resume_point ()
+{
+	nano::lock_guard<std::mutex> guard (range_mutex);
+	return received.is_zero () ? range_start : nano::account (received.number () + 1);
+}
+
+nano::account nano::frontier_req_client::end ()
+{
+	nano::lock_guard<std::mutex> guard (range_mutex);
+	return range_end;
+}
+
 void nano::frontier_req_client::receive_frontier ()
 {
 	auto this_l (shared_from_this ());
@@ -68,14 +126,19 @@ void nano::frontier_req_client::receive_frontier ()
 				{
 					this_l->connection->node->logger.try_log (boost::str (boost::format ("Invalid size: expected %1%, got %2%") % nano::frontier_req_client::size_frontier % size_a));
 				}
+				this_l->finish (true);
 			}
 		});
 	}
+	else
+	{
+		finish (true);
+	}
 }
 
 void nano::frontier_req_client::unsynced (nano::block_hash const & head, nano::block_hash const & end)
 {
-	if (bulk_push_cost < nano::bootstrap_limits::bulk_push_cost_limit)
+	if (bulk_push_peer && bulk_push_cost < nano::bootstrap_limits::bulk_push_cost_limit)
 	{
 		attempt->add_bulk_push_target (head, end);
 		if (end.is_zero ())
@@ -116,14 +179,30 @@ void nano::frontier_req_client::received_frontier (boost::system::error_code con
 		if (elapsed_sec > nano::bootstrap_limits::bootstrap_connection_warmup_time_sec && blocks_per_sec < nano::bootstrap_limits::bootstrap_minimum_frontier_blocks_per_sec)
 		{
 			connection->node->logger.try_log (boost::str (boost::format ("Aborting frontier req because it was too slow")));
-			promise.set_value (true);
+			finish (true);
 			return;
 		}
 		if (attempt->should_log ())
 		{
 			connection->node->logger.always_log (boost::str (boost::format ("Received %1% frontiers from %2%") % std::to_string (count) % connection->channel->to_string ()));
 		}
-		if (!account.is_zero ())
+		nano::account end_l;
+		auto in_range (false);
+		{
+			nano::lock_guard<std::mutex> guard (range_mutex);
+			end_l = range_end;
+			in_range = !account.is_zero () && (end_l.is_zero () || account < end_l);
+			if (in_range)
+			{
+				received = account;
+			}
+			else
+			{
+				// The range can no longer be split once its end is reached
+				finished = true;
+			}
+		}
+		if (in_range)
 		{
 			while (!current.is_zero () && current < account)
 			{
@@ -170,7 +249,7 @@ void nano::frontier_req_client::received_frontier (boost::system::error_code con
 		}
 		else
 		{
-			while (!current.is_zero ())
+			while (!current.is_zero () && (end_l.is_zero () || current < end_l))
 			{
 				// We know about an account they don't.
 				unsynced (frontier, 0);
@@ -180,16 +259,16 @@ void nano::frontier_req_client::received_frontier (boost::system::error_code con
 			{
 				connection->node->logger.try_log ("Bulk push cost: ", bulk_push_cost);
 			}
+			finish (false);
+			if (account.is_zero ())
 			{
-				try
-				{
-					promise.set_value (false);
-				}
-				catch (std::future_error &)
-				{
-				}
 				connection->connections->pool_connection (connection);
 			}
+			else if (auto socket_l = connection->channel->socket.lock ())
+			{
+				// The peer keeps sending frontiers past the end of a split range
+				socket_l->close ();
+			}
 		}
 	}
 	else
@@ -198,6 +277,7 @@ void nano::frontier_req_client::received_frontier (boost::system::error_code con
 		{
 			connection->node->logger.try_log (boost::str (boost::format ("Error while receiving frontier %1%") % ec.message ()));
 		}
+		finish (true);
 	}
 }
 
@@ -9,16 +9,26 @@ namespace nano
 {
 class bootstrap_attempt;
 class bootstrap_client;
+/**
+ * Requests the frontiers of the accounts in [range_start, range_end) from a peer, range_end 0 meaning the end of the account space.
+ * A running range can be split to let another peer request its upper part, the client then stops when it reaches the new end.
+ */
 class frontier_req_client final : public std::enable_shared_from_this<nano::frontier_req_client>
 {
 public:
-	explicit frontier_req_client (std::shared_ptr<nano::bootstrap_client>, std::shared_ptr<nano::bootstrap_attempt>);
+	frontier_req_client (std::shared_ptr<nano::bootstrap_client>, std::shared_ptr<nano::bootstrap_attempt>, nano::account const & = nano::account (0), nano::account const & = nano::account (0), bool = true);
 	~frontier_req_client ();
 	void run ();
 	void receive_frontier ();
 	void received_frontier (boost::system::error_code const &, size_t);
 	void unsynced (nano::block_hash const &, nano::block_hash const &);
 	void next ();
+	void finish (bool);
+	/** Moves the upper half of the remaining range into [start_a, end_a), returns true if the range is too small or finished */
+	bool split (nano::account & start_a, nano::account & end_a);
+	/** Start of the part of the range not received yet */
+	nano::account resume_point ();
+	nano::account end ();
 	std::shared_ptr<nano::bootstrap_client> connection;
 	std::shared_ptr<nano::bootstrap_attempt> attempt;
 	nano::account current;
@@ -31,7 +41,17 @@ public:
 	/** A very rough estimate of the cost of `bulk_push`ing missing blocks */
 	uint64_t bulk_push_cost;
 	std::deque<std::pair<nano::account, nano::block_hash>> accounts;
+	/** Set for the client of the first range, whose peer is the bulk push target */
+	bool bulk_push_peer;
 	static size_t constexpr size_frontier = sizeof (nano::account) + sizeof (nano::block_hash);
+
+private:
+	std::mutex range_mutex;
+	nano::account range_start;
+	nano::account range_end;
+	/** Last account received, 0 if none */
+	nano::account received;
+	bool finished{ false };
 };
 class bootstrap_server;
 class frontier_req;
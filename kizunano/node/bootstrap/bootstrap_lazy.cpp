@@ -1,4 +1,5 @@
 #include <kizunano/node/bootstrap/bootstrap.hpp>
+#include <kizunano/node/bootstrap/bootstrap_checkpoint.hpp>
 #include <kizunano/node/bootstrap/bootstrap_lazy.hpp>
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/node.hpp>
@@ -13,9 +14,11 @@ constexpr unsigned nano::bootstrap_limits::lazy_destinations_request_limit;
 constexpr uint64_t nano::bootstrap_limits::lazy_batch_pull_count_resize_blocks_limit;
 constexpr double nano::bootstrap_limits::lazy_batch_pull_count_resize_ratio;
 constexpr size_t nano::bootstrap_limits::lazy_blocks_restart_limit;
+constexpr size_t nano::bootstrap_limits::lazy_spill_budget_fraction;
 
 nano::bootstrap_attempt_lazy::bootstrap_attempt_lazy (std::shared_ptr<nano::node> node_a, uint64_t incremental_id_a, std::string id_a) :
-nano::bootstrap_attempt (node_a, nano::bootstrap_mode::lazy, incremental_id_a, id_a)
+nano::bootstrap_attempt (node_a, nano::bootstrap_mode::lazy, incremental_id_a, id_a),
+lazy_blocks (spill_root (node_a->application_path) / std::to_string (incremental_id_a))
 {
 	node->bootstrap_initiator.notify_listeners (true);
 }
@@ -271,14 +274,15 @@ bool nano::bootstrap_attempt_lazy::process_block_lazy (std::shared_ptr<nano::blo
 		// Adding lazy balances for first processed block in pull
 		if (pull_blocks == 0 && (block_a->type () == nano::block_type::state || block_a->type () == nano::block_type::send))
 		{
-			lazy_balances.emplace (hash, block_a->balance ().number ());
+			lazy_balances.insert (lazy_balances.fingerprint (hash), block_a->balance ().number ());
 		}
 		// Clearing lazy balances for previous block
-		if (!block_a->previous ().is_zero () && lazy_balances.find (block_a->previous ()) != lazy_balances.end ())
+		if (!block_a->previous ().is_zero ())
 		{
-			lazy_balances.erase (block_a->previous ());
+			lazy_balances.erase (lazy_balances.fingerprint (block_a->previous ()));
 		}
 		lazy_block_state_backlog_check (block_a, hash);
+		lazy_memory_check ();
 		lock.unlock ();
 		nano::unchecked_info info (block_a, known_account_a, 0, nano::signature_verification::unknown, retry_limit == std::numeric_limits<unsigned>::max ());
 		node->block_processor.add (info);
@@ -323,10 +327,11 @@ void nano::bootstrap_attempt_lazy::lazy_block_state (std::shared_ptr<nano::block
 			// Search balance of already processed previous blocks
 			else if (lazy_blocks_processed (previous))
 			{
-				auto previous_balance (lazy_balances.find (previous));
-				if (previous_balance != lazy_balances.end ())
+				auto previous_key (lazy_balances.fingerprint (previous));
+				auto previous_balance (lazy_balances.find (previous_key));
+				if (previous_balance != nullptr)
 				{
-					if (previous_balance->second <= balance)
+					if (*previous_balance <= balance)
 					{
 						lazy_add (link, retry_limit);
 					}
@@ -334,7 +339,7 @@ void nano::bootstrap_attempt_lazy::lazy_block_state (std::shared_ptr<nano::block
 					{
 						lazy_destinations_increment (link);
 					}
-					lazy_balances.erase (previous_balance);
+					lazy_balances.erase (previous_key);
 				}
 			}
 			// Insert in backlog state blocks if previous wasn't already processed
@@ -366,10 +371,9 @@ void nano::bootstrap_attempt_lazy::lazy_block_state_backlog_check (std::shared_p
 			}
 		}
 		// Assumption for other legacy block types
-		else if (lazy_undefined_links.find (next_block.link) == lazy_undefined_links.end ())
+		else if (lazy_undefined_links.insert (next_block.link))
 		{
 			lazy_add (next_block.link, node->network_params.bootstrap.lazy_retry_limit); // Head is not confirmed. It can be account or hash or non-existing
-			lazy_undefined_links.insert (next_block.link);
 		}
 		lazy_state_backlog.erase (find_state);
 	}
@@ -444,8 +448,7 @@ void nano::bootstrap_attempt_lazy::lazy_destinations_flush ()
 void nano::bootstrap_attempt_lazy::lazy_blocks_insert (nano::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto inserted (lazy_blocks.insert (std::hash<::nano::block_hash> () (hash_a)));
-	if (inserted.second)
+	if (lazy_blocks.insert (hash_a))
 	{
 		++lazy_blocks_count;
 		debug_assert (lazy_blocks_count > 0);
@@ -455,8 +458,7 @@ void nano::bootstrap_attempt_lazy::lazy_blocks_insert (nano::block_hash const &
 void nano::bootstrap_attempt_lazy::lazy_blocks_erase (nano::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto erased (lazy_blocks.erase (std::hash<::nano::block_hash> () (hash_a)));
-	if (erased)
+	if (lazy_blocks.erase (hash_a))
 	{
 		--lazy_blocks_count;
 		debug_assert (lazy_blocks_count != std::numeric_limits<size_t>::max ());
@@ -465,7 +467,7 @@ void nano::bootstrap_attempt_lazy::lazy_blocks_erase (nano::block_hash const & h
 
 bool nano::bootstrap_attempt_lazy::lazy_blocks_processed (nano::block_hash const & hash_a)
 {
-	return lazy_blocks.find (std::hash<::nano::block_hash> () (hash_a)) != lazy_blocks.end ();
+	return lazy_blocks.contains (hash_a);
 }
 
 bool nano::bootstrap_attempt_lazy::lazy_processed_or_exists (nano::block_hash const & hash_a)
@@ -487,10 +489,37 @@ bool nano::bootstrap_attempt_lazy::lazy_processed_or_exists (nano::block_hash co
 	return result;
 }
 
+boost::filesystem::path nano::bootstrap_attempt_lazy::spill_root (boost::filesystem::path const & application_path_a)
+{
+	return application_path_a / "lazy_bootstrap";
+}
+
+size_t nano::bootstrap_attempt_lazy::lazy_memory () const
+{
+	return lazy_blocks.memory () + lazy_undefined_links.memory () + lazy_balances.memory ();
+}
+
+void nano::bootstrap_attempt_lazy::lazy_memory_check ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto budget (node->flags.lazy_bootstrap_memory_budget);
+	if (lazy_memory () > budget)
+	{
+		lazy_undefined_links.clear ();
+		// Spilling only pays off once the in-memory blocks are a good share of the budget, otherwise every processed block would write a tiny run
+		if (lazy_memory () > budget && lazy_blocks.spillable () * nano::bootstrap_limits::lazy_spill_budget_fraction >= budget && lazy_blocks.spill ())
+		{
+			node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::lazy_spill, nano::stat::dir::out);
+		}
+	}
+}
+
 void nano::bootstrap_attempt_lazy::get_information (boost::property_tree::ptree & tree_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
 	tree_a.put ("lazy_blocks", std::to_string (lazy_blocks.size ()));
+	tree_a.put ("lazy_blocks_spilled", std::to_string (lazy_blocks.spilled ()));
+	tree_a.put ("lazy_memory", std::to_string (lazy_memory ()));
 	tree_a.put ("lazy_state_backlog", std::to_string (lazy_state_backlog.size ()));
 	tree_a.put ("lazy_balances", std::to_string (lazy_balances.size ()));
 	tree_a.put ("lazy_destinations", std::to_string (lazy_destinations.size ()));
@@ -503,6 +532,46 @@ void nano::bootstrap_attempt_lazy::get_information (boost::property_tree::ptree
 	}
 }
 
+bool nano::bootstrap_attempt_lazy::checkpoint (nano::bootstrap_checkpoint & checkpoint_a)
+{
+	auto queued (node->bootstrap_initiator.connections->attempt_pulls (incremental_id));
+	nano::lock_guard<std::mutex> lock (mutex);
+	for (auto const & pull : queued)
+	{
+		checkpoint_a.lazy_pulls.emplace_back (pull.account_or_head, pull.retry_limit);
+	}
+	checkpoint_a.lazy_pulls.insert (checkpoint_a.lazy_pulls.end (), lazy_pulls.begin (), lazy_pulls.end ());
+	checkpoint_a.lazy_keys.assign (lazy_keys.begin (), lazy_keys.end ());
+	checkpoint_a.lazy_state_backlog.assign (lazy_state_backlog.begin (), lazy_state_backlog.end ());
+	return stopped || checkpoint_a.empty ();
+}
+
+void nano::bootstrap_attempt_lazy::restore (nano::bootstrap_checkpoint const & checkpoint_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	debug_assert (!started);
+	lazy_keys.insert (checkpoint_a.lazy_keys.begin (), checkpoint_a.lazy_keys.end ());
+	lazy_pulls.insert (lazy_pulls.end (), checkpoint_a.lazy_pulls.begin (), checkpoint_a.lazy_pulls.end ());
+	lazy_state_backlog.insert (checkpoint_a.lazy_state_backlog.begin (), checkpoint_a.lazy_state_backlog.end ());
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (bootstrap_attempt_lazy & attempt, const std::string & name)
+{
+	// Open addressing containers report their average footprint per element, including empty slots
+	auto leaf = [](std::string const & name_a, size_t count_a, size_t memory_a) {
+		return std::make_unique<nano::container_info_leaf> (nano::container_info{ name_a, count_a, count_a == 0 ? 0 : memory_a / count_a });
+	};
+	auto composite = std::make_unique<container_info_composite> (name);
+	nano::lock_guard<std::mutex> guard (attempt.mutex);
+	composite->add_component (leaf ("lazy_blocks", attempt.lazy_blocks.size (), attempt.lazy_blocks.memory ()));
+	composite->add_component (leaf ("lazy_undefined_links", attempt.lazy_undefined_links.size (), attempt.lazy_undefined_links.memory ()));
+	composite->add_component (leaf ("lazy_balances", attempt.lazy_balances.size (), attempt.lazy_balances.memory ()));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_state_backlog", attempt.lazy_state_backlog.size (), sizeof (decltype (attempt.lazy_state_backlog)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_keys", attempt.lazy_keys.size (), sizeof (decltype (attempt.lazy_keys)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_pulls", attempt.lazy_pulls.size (), sizeof (decltype (attempt.lazy_pulls)::value_type) }));
+	return composite;
+}
+
 nano::bootstrap_attempt_wallet::bootstrap_attempt_wallet (std::shared_ptr<nano::node> node_a, uint64_t incremental_id_a, std::string id_a) :
 nano::bootstrap_attempt (node_a, nano::bootstrap_mode::wallet_lazy, incremental_id_a, id_a)
 {
@@ -2,6 +2,7 @@
 
 #include <kizunano/node/bootstrap/bootstrap_attempt.hpp>
 #include <kizunano/node/bootstrap/bootstrap_bulk_pull.hpp>
+#include <kizunano/node/bootstrap/bootstrap_lazy_containers.hpp>
 
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
@@ -55,11 +56,21 @@ public:
 	void lazy_blocks_erase (nano::block_hash const &);
 	bool lazy_blocks_processed (nano::block_hash const &);
 	bool lazy_processed_or_exists (nano::block_hash const &) override;
+	/** Bytes held by the lazy tracking containers */
+	size_t lazy_memory () const;
+	/** Directory holding the spilled lazy_blocks of every attempt */
+	static boost::filesystem::path spill_root (boost::filesystem::path const &);
+	/** Keeps lazy_memory () within the node_flags budget by dropping undefined links, then spilling lazy_blocks */
+	void lazy_memory_check ();
 	void get_information (boost::property_tree::ptree &) override;
-	std::unordered_set<size_t> lazy_blocks;
+	bool checkpoint (nano::bootstrap_checkpoint &) override;
+	void restore (nano::bootstrap_checkpoint const &) override;
+	nano::lazy_fingerprint_set lazy_blocks;
 	std::unordered_map<nano::block_hash, nano::lazy_state_backlog_item> lazy_state_backlog;
-	std::unordered_set<nano::block_hash> lazy_undefined_links;
-	std::unordered_map<nano::block_hash, nano::uint128_t> lazy_balances;
+	/** Only used to avoid requesting the same link twice, so it is dropped first when over budget */
+	nano::lazy_fingerprint_set lazy_undefined_links;
+	nano::lazy_fingerprint_map<nano::uint128_t> lazy_balances;
+	/** Bounded by lazy_start, hashes are kept to check them against the ledger */
 	std::unordered_set<nano::block_hash> lazy_keys;
 	std::deque<std::pair<nano::hash_or_account, unsigned>> lazy_pulls;
 	std::chrono::steady_clock::time_point lazy_start_time;
@@ -98,4 +109,5 @@ public:
 	void get_information (boost::property_tree::ptree &) override;
 	std::deque<nano::account> wallet_accounts;
 };
+std::unique_ptr<container_info_component> collect_container_info (bootstrap_attempt_lazy & attempt, const std::string & name);
 }
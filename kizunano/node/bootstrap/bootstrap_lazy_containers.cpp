@@ -0,0 +1,298 @@
+#include <kizunano/node/bootstrap/bootstrap_lazy_containers.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+constexpr size_t nano::lazy_fingerprint_set::run_index_interval;
+
+nano::lazy_fingerprint_set::lazy_fingerprint_set (boost::filesystem::path const & spill_path_a) :
+spill_path (spill_path_a)
+{
+	if (!spill_path.empty ())
+	{
+		// Runs left behind by a node which did not shut down cleanly
+		boost::system::error_code ec;
+		boost::filesystem::remove_all (spill_path, ec);
+	}
+}
+
+nano::lazy_fingerprint_set::~lazy_fingerprint_set ()
+{
+	clear ();
+}
+
+bool nano::lazy_fingerprint_set::contains (nano::uint256_union const & hash_a)
+{
+	auto key (nano::lazy_fingerprint_map<uint8_t>::fingerprint (hash_a));
+	return memory_keys.find (key) != nullptr || spilled_contains (key);
+}
+
+bool nano::lazy_fingerprint_set::insert (nano::uint256_union const & hash_a)
+{
+	auto key (nano::lazy_fingerprint_map<uint8_t>::fingerprint (hash_a));
+	auto result (false);
+	if (erased.erase (key))
+	{
+		// Still present in a run
+		result = true;
+	}
+	else if (!runs.empty () && spilled_contains (key))
+	{
+		result = false;
+	}
+	else
+	{
+		result = memory_keys.insert (key, 0);
+	}
+	return result;
+}
+
+bool nano::lazy_fingerprint_set::erase (nano::uint256_union const & hash_a)
+{
+	auto key (nano::lazy_fingerprint_map<uint8_t>::fingerprint (hash_a));
+	auto result (memory_keys.erase (key));
+	if (!result && spilled_contains (key))
+	{
+		result = erased.insert (key, 0);
+	}
+	return result;
+}
+
+void nano::lazy_fingerprint_set::clear ()
+{
+	memory_keys.clear ();
+	erased.clear ();
+	spilled_count = 0;
+	if (!runs.empty ())
+	{
+		runs.clear ();
+		boost::system::error_code ec;
+		boost::filesystem::remove_all (spill_path, ec);
+	}
+}
+
+size_t nano::lazy_fingerprint_set::size () const
+{
+	return memory_keys.size () + spilled_count - erased.size ();
+}
+
+size_t nano::lazy_fingerprint_set::memory () const
+{
+	size_t result (memory_keys.memory () + erased.memory () + read_buffer.capacity () * sizeof (uint64_t));
+	for (auto const & run_l : runs)
+	{
+		result += run_l.index.capacity () * sizeof (uint64_t);
+	}
+	return result;
+}
+
+size_t nano::lazy_fingerprint_set::spillable () const
+{
+	return memory_keys.memory ();
+}
+
+bool nano::lazy_fingerprint_set::spill ()
+{
+	auto result (false);
+	if (!spill_path.empty () && memory_keys.size () != 0)
+	{
+		std::vector<uint64_t> keys;
+		keys.reserve (memory_keys.size ());
+		memory_keys.for_each ([&keys](uint64_t key_a) {
+			keys.push_back (key_a);
+		});
+		std::sort (keys.begin (), keys.end ());
+		run run_l;
+		run_l.path = spill_path / ("run_" + std::to_string (next_run++));
+		boost::system::error_code ec;
+		boost::filesystem::create_directories (spill_path, ec);
+		{
+			std::ofstream stream (run_l.path.string (), std::ios::binary | std::ios::trunc);
+			stream.write (reinterpret_cast<char const *> (keys.data ()), keys.size () * sizeof (uint64_t));
+			result = !ec && stream.good ();
+		}
+		if (result)
+		{
+			run_l.stream.open (run_l.path.string (), std::ios::binary);
+			result = run_l.stream.is_open ();
+		}
+		if (result)
+		{
+			run_l.size = keys.size ();
+			run_l.last = keys.back ();
+			for (size_t i (0); i < keys.size (); i += run_index_interval)
+			{
+				run_l.index.push_back (keys[i]);
+			}
+			spilled_count += keys.size ();
+			runs.push_back (std::move (run_l));
+			memory_keys.clear ();
+			merge_runs ();
+		}
+		else
+		{
+			boost::filesystem::remove (run_l.path, ec);
+		}
+	}
+	return result;
+}
+
+namespace
+{
+/** Reads the keys of a run file front to back, one index interval at a time */
+class run_reader final
+{
+public:
+	run_reader (std::ifstream & stream_a, size_t size_a) :
+	stream (stream_a),
+	size (size_a)
+	{
+		stream.clear ();
+		stream.seekg (0);
+		fill ();
+	}
+	bool done () const
+	{
+		return position == buffer.size ();
+	}
+	uint64_t key () const
+	{
+		return buffer[position];
+	}
+	void next ()
+	{
+		if (++position == buffer.size ())
+		{
+			fill ();
+		}
+	}
+	bool error{ false };
+
+private:
+	void fill ()
+	{
+		auto count (std::min (nano::lazy_fingerprint_set::run_index_interval, size - read));
+		buffer.resize (count);
+		position = 0;
+		if (count != 0)
+		{
+			stream.read (reinterpret_cast<char *> (buffer.data ()), count * sizeof (uint64_t));
+			read += count;
+			if (!stream.good ())
+			{
+				error = true;
+				buffer.clear ();
+			}
+		}
+	}
+	std::ifstream & stream;
+	size_t size;
+	size_t read{ 0 };
+	size_t position{ 0 };
+	std::vector<uint64_t> buffer;
+};
+}
+
+void nano::lazy_fingerprint_set::merge_runs ()
+{
+	auto error (false);
+	while (!error && runs.size () > 1 && runs.back ().size * 2 >= runs[runs.size () - 2].size)
+	{
+		auto & older (runs[runs.size () - 2]);
+		auto & newer (runs.back ());
+		run merged;
+		merged.path = spill_path / ("run_" + std::to_string (next_run++));
+		// Erased fingerprints are dropped from the merged run, which makes their erased entry redundant
+		std::vector<uint64_t> dropped;
+		{
+			std::ofstream output (merged.path.string (), std::ios::binary | std::ios::trunc);
+			run_reader first (older.stream, older.size);
+			run_reader second (newer.stream, newer.size);
+			while (!first.done () || !second.done ())
+			{
+				auto & source (second.done () || (!first.done () && first.key () < second.key ()) ? first : second);
+				auto key (source.key ());
+				source.next ();
+				if (erased.find (key) != nullptr)
+				{
+					dropped.push_back (key);
+				}
+				else
+				{
+					if (merged.size % run_index_interval == 0)
+					{
+						merged.index.push_back (key);
+					}
+					output.write (reinterpret_cast<char const *> (&key), sizeof (key));
+					merged.last = key;
+					++merged.size;
+				}
+			}
+			error = first.error || second.error || !output.good ();
+		}
+		if (!error)
+		{
+			merged.stream.open (merged.path.string (), std::ios::binary);
+			error = !merged.stream.is_open ();
+		}
+		boost::system::error_code ec;
+		if (!error)
+		{
+			for (auto key : dropped)
+			{
+				erased.erase (key);
+			}
+			spilled_count -= dropped.size ();
+			older.stream.close ();
+			newer.stream.close ();
+			boost::filesystem::remove (older.path, ec);
+			boost::filesystem::remove (newer.path, ec);
+			runs.pop_back ();
+			runs.back () = std::move (merged);
+		}
+		else
+		{
+			// The runs being merged are left as they are
+			boost::filesystem::remove (merged.path, ec);
+		}
+	}
+}
+
+size_t nano::lazy_fingerprint_set::spilled () const
+{
+	return spilled_count;
+}
+
+size_t nano::lazy_fingerprint_set::runs_count () const
+{
+	return runs.size ();
+}
+
+bool nano::lazy_fingerprint_set::spilled_contains (uint64_t key_a)
+{
+	auto result (false);
+	if (erased.find (key_a) == nullptr)
+	{
+		for (auto i (runs.begin ()), n (runs.end ()); i != n && !result; ++i)
+		{
+			result = run_contains (*i, key_a);
+		}
+	}
+	return result;
+}
+
+bool nano::lazy_fingerprint_set::run_contains (run & run_a, uint64_t key_a)
+{
+	auto result (false);
+	auto block (std::upper_bound (run_a.index.begin (), run_a.index.end (), key_a));
+	if (block != run_a.index.begin () && key_a <= run_a.last)
+	{
+		auto begin (static_cast<size_t> (block - run_a.index.begin () - 1) * run_index_interval);
+		auto count (std::min (run_index_interval, run_a.size - begin));
+		read_buffer.resize (count);
+		run_a.stream.clear ();
+		run_a.stream.seekg (begin * sizeof (uint64_t));
+		run_a.stream.read (reinterpret_cast<char *> (read_buffer.data ()), count * sizeof (uint64_t));
+		result = run_a.stream.good () && std::binary_search (read_buffer.begin (), read_buffer.end (), key_a);
+	}
+	return result;
+}
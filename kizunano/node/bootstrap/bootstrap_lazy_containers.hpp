@@ -0,0 +1,210 @@
+#pragma once
+
+#include <kizunano/lib/numbers.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Open addressing table keyed by 64-bit fingerprints of hashes, replacing node based unordered containers
+ * in lazy bootstrap. Hashes are uniformly distributed so the first 8 bytes are used as they are, a collision
+ * between two different hashes is possible but only makes lazy bootstrap skip or repeat a pull.
+ * Uses linear probing with backward shift deletion, so no tombstones are left behind.
+ */
+template <typename Value>
+class lazy_fingerprint_map final
+{
+public:
+	static uint64_t fingerprint (nano::uint256_union const & hash_a)
+	{
+		// 0 marks an empty slot
+		return std::max<uint64_t> (hash_a.qwords[0], 1);
+	}
+	/** Returns a pointer to the stored value or nullptr */
+	Value * find (uint64_t key_a)
+	{
+		Value * result (nullptr);
+		if (count != 0)
+		{
+			auto slot (probe (key_a));
+			if (keys[slot] == key_a)
+			{
+				result = &values[slot];
+			}
+		}
+		return result;
+	}
+	/** Returns true if the key was inserted, an existing value is left unchanged */
+	bool insert (uint64_t key_a, Value const & value_a)
+	{
+		if ((count + 1) * 4 > keys.size () * 3)
+		{
+			grow ();
+		}
+		auto slot (probe (key_a));
+		auto result (keys[slot] != key_a);
+		if (result)
+		{
+			keys[slot] = key_a;
+			values[slot] = value_a;
+			++count;
+		}
+		return result;
+	}
+	bool erase (uint64_t key_a)
+	{
+		auto result (false);
+		if (count != 0)
+		{
+			auto slot (probe (key_a));
+			result = keys[slot] == key_a;
+			if (result)
+			{
+				shift (slot);
+				--count;
+			}
+		}
+		return result;
+	}
+	void clear ()
+	{
+		keys.clear ();
+		keys.shrink_to_fit ();
+		values.clear ();
+		values.shrink_to_fit ();
+		count = 0;
+	}
+	size_t size () const
+	{
+		return count;
+	}
+	size_t memory () const
+	{
+		return keys.capacity () * sizeof (uint64_t) + values.capacity () * sizeof (Value);
+	}
+	/** Calls \p action_a with each stored key, in table order */
+	template <typename Action>
+	void for_each (Action const & action_a) const
+	{
+		for (auto key : keys)
+		{
+			if (key != 0)
+			{
+				action_a (key);
+			}
+		}
+	}
+
+private:
+	/** Slot holding \p key_a, or the empty slot ending its probe sequence */
+	size_t probe (uint64_t key_a) const
+	{
+		auto mask (keys.size () - 1);
+		auto slot (static_cast<size_t> (key_a) & mask);
+		while (keys[slot] != 0 && keys[slot] != key_a)
+		{
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+	void shift (size_t slot_a)
+	{
+		auto mask (keys.size () - 1);
+		auto hole (slot_a);
+		for (auto next ((hole + 1) & mask); keys[next] != 0; next = (next + 1) & mask)
+		{
+			auto home (static_cast<size_t> (keys[next]) & mask);
+			// Move the entry back if its home slot does not lie cyclically in (hole, next]
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				keys[hole] = keys[next];
+				values[hole] = std::move (values[next]);
+				hole = next;
+			}
+		}
+		keys[hole] = 0;
+	}
+	void grow ()
+	{
+		std::vector<uint64_t> old_keys (keys.size () == 0 ? 16 : keys.size () * 2, 0);
+		std::vector<Value> old_values (old_keys.size ());
+		old_keys.swap (keys);
+		old_values.swap (values);
+		for (size_t i (0), n (old_keys.size ()); i < n; ++i)
+		{
+			if (old_keys[i] != 0)
+			{
+				auto slot (probe (old_keys[i]));
+				keys[slot] = old_keys[i];
+				values[slot] = std::move (old_values[i]);
+			}
+		}
+	}
+	std::vector<uint64_t> keys;
+	std::vector<Value> values;
+	size_t count{ 0 };
+};
+
+/**
+ * Fingerprint set which can spill its contents to sorted run files once a byte budget is reached.
+ * Spilled fingerprints are looked up through an in-memory index holding every `run_index_interval`th key
+ * of each run, so a lookup reads at most one block from disk per run. The newest runs are merged while they
+ * are comparable in size, which keeps the number of runs and open files logarithmic in the spilled
+ * fingerprints. Erasing a spilled fingerprint records it in memory until the run holding it is merged or
+ * the set is destroyed, which also deletes the run files.
+ */
+class lazy_fingerprint_set final
+{
+public:
+	explicit lazy_fingerprint_set (boost::filesystem::path const & spill_path_a = boost::filesystem::path ());
+	~lazy_fingerprint_set ();
+	lazy_fingerprint_set (lazy_fingerprint_set const &) = delete;
+	lazy_fingerprint_set & operator= (lazy_fingerprint_set const &) = delete;
+	bool contains (nano::uint256_union const &);
+	/** Returns true if the hash was not already in the set */
+	bool insert (nano::uint256_union const &);
+	/** Returns true if the hash was in the set */
+	bool erase (nano::uint256_union const &);
+	/** Drops every fingerprint, including spilled ones */
+	void clear ();
+	size_t size () const;
+	/** Bytes held in memory, excluding run files */
+	size_t memory () const;
+	/** Bytes a spill would release */
+	size_t spillable () const;
+	/** Moves the in-memory fingerprints to a new run file, returns true if a run was written */
+	bool spill ();
+	size_t spilled () const;
+	size_t runs_count () const;
+	static size_t constexpr run_index_interval = 512;
+
+private:
+	class run final
+	{
+	public:
+		boost::filesystem::path path;
+		std::ifstream stream;
+		/** Every run_index_interval'th key, starting with the first one */
+		std::vector<uint64_t> index;
+		uint64_t last{ 0 };
+		size_t size{ 0 };
+	};
+	bool spilled_contains (uint64_t);
+	bool run_contains (run &, uint64_t);
+	/** Merges the two newest runs while the newest is at least half the size of the one before */
+	void merge_runs ();
+	nano::lazy_fingerprint_map<uint8_t> memory_keys;
+	nano::lazy_fingerprint_map<uint8_t> erased;
+	std::vector<run> runs;
+	boost::filesystem::path spill_path;
+	size_t spilled_count{ 0 };
+	uint64_t next_run{ 0 };
+	std::vector<uint64_t> read_buffer;
+};
+}
@@ -0,0 +1,195 @@
+#include <kizunano/node/bootstrap/bootstrap.hpp>
+#include <kizunano/node/bootstrap/bootstrap_priority.hpp>
+#include <kizunano/node/node.hpp>
+
+#include <boost/format.hpp>
+
+nano::bootstrap_attempt_priority::bootstrap_attempt_priority (std::shared_ptr<nano::node> node_a, uint64_t incremental_id_a, std::string id_a) :
+nano::bootstrap_attempt (node_a, nano::bootstrap_mode::priority, incremental_id_a, id_a)
+{
+	node->bootstrap_initiator.notify_listeners (true);
+}
+
+nano::bootstrap_attempt_priority::~bootstrap_attempt_priority ()
+{
+	node->bootstrap_initiator.notify_listeners (false);
+}
+
+void nano::bootstrap_attempt_priority::priority_add (nano::account const & account_a, double priority_a)
+{
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto existing (accounts.get<account_tag> ().find (account_a));
+		if (existing != accounts.get<account_tag> ().end ())
+		{
+			accounts.get<account_tag> ().modify (existing, [priority_a](nano::priority_account_item & item_a) {
+				item_a.priority += priority_a;
+			});
+		}
+		else if (requested.find (account_a) == requested.end ())
+		{
+			accounts.get<account_tag> ().insert ({ account_a, priority_a, 0, std::chrono::steady_clock::now () });
+			// Drop the lowest priority account when full
+			if (accounts.size () > nano::bootstrap_limits::priority_accounts_max)
+			{
+				accounts.get<priority_tag> ().erase (std::prev (accounts.get<priority_tag> ().end ()));
+			}
+		}
+	}
+	condition.notify_all ();
+}
+
+void nano::bootstrap_attempt_priority::priority_seed_pending ()
+{
+	std::vector<nano::account> seeds;
+	{
+		auto transaction (node->store.tx_begin_read ());
+		auto i (node->store.pending_begin (transaction));
+		for (auto n (node->store.pending_end ()); i != n && seeds.size () < nano::bootstrap_limits::priority_pending_seed_max && !stopped;)
+		{
+			nano::account account (i->first.account);
+			seeds.push_back (account);
+			if (account.number () == std::numeric_limits<nano::uint256_t>::max ())
+			{
+				break;
+			}
+			// Skip the remaining entries of the account
+			i = node->store.pending_begin (transaction, nano::pending_key (account.number () + 1, 0));
+		}
+	}
+	for (auto const & account : seeds)
+	{
+		priority_add (account, nano::bootstrap_limits::priority_pending);
+	}
+}
+
+nano::account nano::bootstrap_attempt_priority::priority_next ()
+{
+	debug_assert (!mutex.try_lock ());
+	nano::account result (0);
+	auto now (std::chrono::steady_clock::now ());
+	auto & by_priority (accounts.get<priority_tag> ());
+	for (auto i (by_priority.begin ()), n (by_priority.end ()); i != n && result.is_zero (); ++i)
+	{
+		if (i->next_request <= now)
+		{
+			result = i->account;
+		}
+	}
+	return result;
+}
+
+void nano::bootstrap_attempt_priority::request (nano::unique_lock<std::mutex> & lock_a, nano::account const & account_a)
+{
+	lock_a.unlock ();
+	auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this ()));
+	lock_a.lock ();
+	auto existing (accounts.get<account_tag> ().find (account_a));
+	if (connection_l && !stopped && existing != accounts.get<account_tag> ().end ())
+	{
+		auto item (*existing);
+		accounts.get<account_tag> ().erase (existing);
+		++item.requests;
+		item.next_request = std::chrono::steady_clock::now () + nano::bootstrap_limits::priority_backoff * (1 << item.requests);
+		// The chain pull and the pending pull
+		item.in_flight = 2;
+		requested[account_a] = item;
+		pulling += 2;
+		lock_a.unlock ();
+		// Chain from the remote frontier down to the local one
+		nano::hash_or_account account_l (account_a);
+		nano::block_hash latest (node->ledger.latest (node->store.tx_begin_read (), account_a));
+		node->bootstrap_initiator.connections->add_pull (nano::pull_info (account_l, account_l, latest, incremental_id, 0, node->network_params.bootstrap.frontier_retry_limit));
+		// Receivable entries, missing sources are pulled by lazy bootstrap
+		auto this_l (shared_from_this ());
+		node->background ([connection_l, this_l, account_a]() {
+			auto client (std::make_shared<nano::bulk_pull_account_client> (connection_l, this_l, account_a));
+			client->request ();
+		});
+		lock_a.lock ();
+	}
+	else if (connection_l)
+	{
+		node->bootstrap_initiator.connections->pool_connection (connection_l);
+	}
+}
+
+void nano::bootstrap_attempt_priority::requeue_pending (nano::account const & account_a)
+{
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto existing (requested.find (account_a));
+		if (existing != requested.end ())
+		{
+			auto item (existing->second);
+			requested.erase (existing);
+			if (item.requests < nano::bootstrap_limits::priority_requests_max && !stopped)
+			{
+				accounts.get<account_tag> ().insert (item);
+			}
+		}
+	}
+	condition.notify_all ();
+}
+
+void nano::bootstrap_attempt_priority::account_pulled (nano::account const & account_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (requested.find (account_a));
+	if (existing != requested.end () && --existing->second.in_flight == 0)
+	{
+		requested.erase (existing);
+	}
+}
+
+bool nano::bootstrap_attempt_priority::priority_finished ()
+{
+	debug_assert (!mutex.try_lock ());
+	return stopped || (accounts.empty () && pulling == 0);
+}
+
+void nano::bootstrap_attempt_priority::run ()
+{
+	debug_assert (started);
+	debug_assert (!node->flags.disable_priority_bootstrap);
+	node->bootstrap_initiator.connections->populate_connections (false);
+	priority_seed_pending ();
+	auto start_time (std::chrono::steady_clock::now ());
+	nano::unique_lock<std::mutex> lock (mutex);
+	while (!priority_finished () && std::chrono::steady_clock::now () - start_time < nano::bootstrap_limits::priority_max_time)
+	{
+		auto account (priority_next ());
+		if (!account.is_zero ())
+		{
+			request (lock, account);
+		}
+		else
+		{
+			condition.wait_for (lock, std::chrono::seconds (1));
+		}
+	}
+	if (!stopped)
+	{
+		node->logger.try_log ("Completed priority pulls");
+	}
+	lock.unlock ();
+	stop ();
+	condition.notify_all ();
+}
+
+size_t nano::bootstrap_attempt_priority::wallet_size ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return accounts.size ();
+}
+
+void nano::bootstrap_attempt_priority::get_information (boost::property_tree::ptree & tree_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	tree_a.put ("priority_accounts", std::to_string (accounts.size ()));
+	tree_a.put ("requested_accounts", std::to_string (requested.size ()));
+	if (!accounts.empty ())
+	{
+		tree_a.put ("priority_account_1", accounts.get<priority_tag> ().begin ()->account.to_account ());
+	}
+}
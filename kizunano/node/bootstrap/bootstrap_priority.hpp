@@ -0,0 +1,76 @@
+#pragma once
+
+#include <kizunano/node/bootstrap/bootstrap_attempt.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <unordered_map>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+class node;
+class priority_account_item final
+{
+public:
+	nano::account account{ 0 };
+	double priority{ 0 };
+	/** Requests already sent for the account, each one doubling the backoff before the next */
+	unsigned requests{ 0 };
+	std::chrono::steady_clock::time_point next_request;
+	/** Pulls of the latest request still running */
+	unsigned in_flight{ 0 };
+};
+/**
+ * Pulls the chain and the pending entries of selected accounts, highest priority first, so that the state
+ * of the accounts a node cares about converges before the rest of the ledger.
+ * Accounts are seeded from wallets, gaps with enough votes and receivable entries of the local ledger.
+ * A requested account is retried after a failed request, with an exponential backoff, until
+ * bootstrap_limits::priority_requests_max requests have been made for it.
+ */
+class bootstrap_attempt_priority final : public bootstrap_attempt
+{
+public:
+	explicit bootstrap_attempt_priority (std::shared_ptr<nano::node> node_a, uint64_t incremental_id_a, std::string id_a = "");
+	~bootstrap_attempt_priority ();
+	void run () override;
+	/** Adds \p priority_a to the priority of an account, queueing it if needed */
+	void priority_add (nano::account const &, double);
+	/** Queues accounts with receivable entries in the ledger */
+	void priority_seed_pending ();
+	/** Called when a chain or pending pull for the account failed */
+	void requeue_pending (nano::account const &) override;
+	/** Forgets the account once both its pulls completed */
+	void account_pulled (nano::account const &) override;
+	size_t wallet_size () override;
+	void get_information (boost::property_tree::ptree &) override;
+	class account_tag
+	{
+	};
+	class priority_tag
+	{
+	};
+	// clang-format off
+	boost::multi_index_container<nano::priority_account_item,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<account_tag>,
+			mi::member<nano::priority_account_item, nano::account, &nano::priority_account_item::account>>,
+		mi::ordered_non_unique<mi::tag<priority_tag>,
+			mi::member<nano::priority_account_item, double, &nano::priority_account_item::priority>,
+			std::greater<double>>>>
+	accounts;
+	// clang-format on
+	/** Accounts with requests in flight, moved back to accounts if one of them fails and dropped once all of them completed */
+	std::unordered_map<nano::account, nano::priority_account_item> requested;
+
+private:
+	/** Highest priority queued account whose backoff expired, zero if none */
+	nano::account priority_next ();
+	void request (nano::unique_lock<std::mutex> &, nano::account const &);
+	bool priority_finished ();
+};
+}
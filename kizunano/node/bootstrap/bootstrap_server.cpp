@@ -273,6 +273,13 @@ void nano::bootstrap_server::receive_header_action (boost::system::error_code co
 					});
 					break;
 				}
+				case nano::message_type::block_announce:
+				{
+					socket->async_read (receive_buffer, header.payload_length_bytes (), [this_l, header](boost::system::error_code const & ec, size_t size_a) {
+						this_l->receive_block_announce_action (ec, size_a, header);
+					});
+					break;
+				}
 				default:
 				{
 					if (node->config.logging.network_logging ())
@@ -417,28 +424,42 @@ void nano::bootstrap_server::receive_telemetry_ack_action (boost::system::error_
 	}
 }
 
-void nano::bootstrap_server::receive_publish_action (boost::system::error_code const & ec, size_t size_a, nano::message_header const & header_a)
+void nano::bootstrap_server::receive_block_announce_action (boost::system::error_code const & ec, size_t size_a, nano::message_header const & header_a)
 {
 	if (!ec)
 	{
-		nano::uint128_t digest;
-		if (!node->network.publish_filter.apply (receive_buffer->data (), size_a, &digest))
+		auto error (false);
+		nano::bufferstream stream (receive_buffer->data (), size_a);
+		auto request (std::make_unique<nano::block_announce> (error, stream, header_a));
+		if (!error)
 		{
-			auto error (false);
-			nano::bufferstream stream (receive_buffer->data (), size_a);
-			auto request (std::make_unique<nano::publish> (error, stream, header_a, digest));
-			if (!error)
+			if (is_realtime_connection ())
 			{
-				if (is_realtime_connection ())
-				{
-					add_request (std::unique_ptr<nano::message> (request.release ()));
-				}
-				receive ();
+				add_request (std::unique_ptr<nano::message> (request.release ()));
 			}
+			receive ();
 		}
-		else
+	}
+	else if (node->config.logging.network_message_logging ())
+	{
+		node->logger.try_log (boost::str (boost::format ("Error receiving block_announce: %1%") % ec.message ()));
+	}
+}
+
+void nano::bootstrap_server::receive_publish_action (boost::system::error_code const & ec, size_t size_a, nano::message_header const & header_a)
+{
+	if (!ec)
+	{
+		auto error (false);
+		nano::bufferstream stream (receive_buffer->data (), size_a);
+		// The publish filter is applied once the message is dequeued, several publishes at a time
+		auto request (std::make_unique<nano::publish> (error, stream, header_a));
+		if (!error)
 		{
-			node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish);
+			if (is_realtime_connection ())
+			{
+				add_request (std::unique_ptr<nano::message> (request.release ()));
+			}
 			receive ();
 		}
 	}
@@ -637,6 +658,10 @@ public:
 	{
 		connection->node->network.tcp_message_manager.put_message (nano::tcp_message_item{ std::make_shared<nano::telemetry_ack> (message_a), connection->remote_endpoint, connection->remote_node_id, connection->socket, connection->type });
 	}
+	void block_announce (nano::block_announce const & message_a) override
+	{
+		connection->node->network.tcp_message_manager.put_message (nano::tcp_message_item{ std::make_shared<nano::block_announce> (message_a), connection->remote_endpoint, connection->remote_node_id, connection->socket, connection->type });
+	}
 	void node_id_handshake (nano::node_id_handshake const & message_a) override
 	{
 		if (connection->node->config.logging.network_node_id_handshake_logging ())
@@ -677,6 +702,10 @@ public:
 			{
 				connection->remote_node_id = node_id;
 				connection->type = nano::bootstrap_server_type::realtime;
+				if (message_a.header.node_id_handshake_is_block_announce_capable ())
+				{
+					connection->node->network.block_announcer.set_capable (node_id);
+				}
 				++connection->node->bootstrap.realtime_count;
 				connection->finish_request_async ();
 			}
@@ -745,3 +774,15 @@ bool nano::bootstrap_server::is_realtime_connection ()
 {
 	return type == nano::bootstrap_server_type::realtime || type == nano::bootstrap_server_type::realtime_response_server;
 }
+
+std::shared_ptr<std::vector<uint8_t>> nano::bootstrap_server::send_buffer ()
+{
+	// Responses are written one at a time, so the previous buffer is normally released by the time the next one is built
+	if (send_buffer_m == nullptr || send_buffer_m.use_count () != 1)
+	{
+		send_buffer_m = std::make_shared<std::vector<uint8_t>> ();
+		send_buffer_m->reserve (nano::bulk_pull_server::send_batch_size + nano::block::size (nano::block_type::state) + 1);
+	}
+	send_buffer_m->clear ();
+	return send_buffer_m;
+}
@@ -58,6 +58,7 @@ public:
 	void receive_confirm_ack_action (boost::system::error_code const &, size_t, nano::message_header const &);
 	void receive_node_id_handshake_action (boost::system::error_code const &, size_t, nano::message_header const &);
 	void receive_telemetry_ack_action (boost::system::error_code const & ec, size_t size_a, nano::message_header const & header_a);
+	void receive_block_announce_action (boost::system::error_code const &, size_t, nano::message_header const &);
 	void add_request (std::unique_ptr<nano::message>);
 	void finish_request ();
 	void finish_request_async ();
@@ -65,6 +66,8 @@ public:
 	void run_next (nano::unique_lock<std::mutex> & lock_a);
 	bool is_bootstrap_connection ();
 	bool is_realtime_connection ();
+	/** Empty buffer for the next response, reusing the previous one once its write has completed */
+	std::shared_ptr<std::vector<uint8_t>> send_buffer ();
 	std::shared_ptr<std::vector<uint8_t>> receive_buffer;
 	std::shared_ptr<nano::socket> socket;
 	std::shared_ptr<nano::node> node;
@@ -76,5 +79,8 @@ public:
 	nano::tcp_endpoint remote_endpoint{ boost::asio::ip::address_v6::any (), 0 };
 	nano::account remote_node_id{ 0 };
 	std::chrono::steady_clock::time_point last_telemetry_req{ std::chrono::steady_clock::time_point () };
+
+private:
+	std::shared_ptr<std::vector<uint8_t>> send_buffer_m;
 };
 }
@@ -2,10 +2,14 @@
 #include <kizunano/node/cli.hpp>
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/daemonconfig.hpp>
+#include <kizunano/node/ledger_snapshot.hpp>
 #include <kizunano/node/node.hpp>
+#include <kizunano/secure/ledger_stream.hpp>
 
 #include <boost/format.hpp>
 
+#include <fstream>
+
 namespace
 {
 void reset_confirmation_heights (nano::block_store & store);
@@ -54,6 +58,10 @@ void nano::add_node_options (boost::program_options::options_description & descr
 	("unchecked_clear", "Clear unchecked blocks")
 	("confirmation_height_clear", "Clear confirmation height")
 	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
+	("ledger_export", "Write all ledger blocks in dependency order to <file>, for use with ledger_import")
+	("ledger_import", "Process blocks from a ledger_export <file> into the ledger, checking work and signatures")
+	("snapshot_export", "Write the ledger tables to <file> in a backend neutral format, compressed if available")
+	("snapshot_import", "Load the ledger tables of a snapshot_export <file> into an empty ledger of either backend")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node or rpc. See also use_defaults.")
 	("key_create", "Generates a adhoc random keypair and prints it to stdout")
@@ -88,6 +96,7 @@ void nano::add_node_flag_options (boost::program_options::options_description &
 		("disable_lazy_bootstrap", "Disables lazy bootstrap")
 		("disable_legacy_bootstrap", "Disables legacy bootstrap")
 		("disable_wallet_bootstrap", "Disables wallet lazy bootstrap")
+		("enable_priority_bootstrap", "Enables bootstrap of wallet, gapped and receivable accounts ahead of the rest of the ledger")
 		("disable_bootstrap_listener", "Disables bootstrap processing for TCP listener (not including realtime network TCP connections)")
 		("disable_tcp_realtime", "Disables TCP realtime network")
 		("disable_udp", "(Deprecated) UDP is disabled by default")
@@ -104,6 +113,7 @@ void nano::add_node_flag_options (boost::program_options::options_description &
 		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap")
 		("inactive_votes_cache_size", boost::program_options::value<std::size_t>(), "Increase cached votes without active elections size, default 16384")
 		("vote_processor_capacity", boost::program_options::value<std::size_t>(), "Vote processor queue size before dropping votes, default 144k")
+		("lazy_bootstrap_memory_budget", boost::program_options::value<std::size_t>(), "Bytes of lazy bootstrap block tracking kept in memory before spilling to disk, default 256MB")
 		;
 	// clang-format on
 }
@@ -120,6 +130,7 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	flags_a.disable_lazy_bootstrap = (vm.count ("disable_lazy_bootstrap") > 0);
 	flags_a.disable_legacy_bootstrap = (vm.count ("disable_legacy_bootstrap") > 0);
 	flags_a.disable_wallet_bootstrap = (vm.count ("disable_wallet_bootstrap") > 0);
+	flags_a.disable_priority_bootstrap = (vm.count ("enable_priority_bootstrap") == 0);
 	if (!flags_a.inactive_node)
 	{
 		flags_a.disable_bootstrap_listener = (vm.count ("disable_bootstrap_listener") > 0);
@@ -172,6 +183,11 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	{
 		flags_a.vote_processor_capacity = vote_processor_capacity_it->second.as<size_t> ();
 	}
+	auto lazy_bootstrap_memory_budget_it = vm.find ("lazy_bootstrap_memory_budget");
+	if (lazy_bootstrap_memory_budget_it != vm.end ())
+	{
+		flags_a.lazy_bootstrap_memory_budget = lazy_bootstrap_memory_budget_it->second.as<size_t> ();
+	}
 	// Config overriding
 	auto config (vm.find ("config"));
 	if (config != vm.end ())
@@ -566,6 +582,133 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 			database_write_lock_error (ec);
 		}
 	}
+	else if (vm.count ("ledger_export"))
+	{
+		auto file_it = vm.find ("file");
+		if (file_it != vm.end ())
+		{
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			nano::update_flags (node_flags, vm);
+			nano::inactive_node node (data_path, node_flags);
+			std::ofstream stream (file_it->second.as<std::string> (), std::ios::binary | std::ios::trunc);
+			nano::ledger_stream ledger_stream (node.node->ledger);
+			if (stream.is_open () && !ledger_stream.export_blocks (stream))
+			{
+				stream.close ();
+				std::cout << boost::str (boost::format ("Exported %1% blocks") % ledger_stream.blocks) << std::endl;
+			}
+			else
+			{
+				std::cerr << "Ledger export failed: " << (stream.is_open () ? ledger_stream.error_message : "cannot open file") << std::endl;
+				ec = nano::error_cli::generic;
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_export requires --file" << std::endl;
+			ec = nano::error_cli::invalid_arguments;
+		}
+	}
+	else if (vm.count ("ledger_import"))
+	{
+		auto file_it = vm.find ("file");
+		if (file_it != vm.end ())
+		{
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			node_flags.read_only = false;
+			nano::update_flags (node_flags, vm);
+			nano::inactive_node node (data_path, node_flags);
+			if (!node.node->init_error ())
+			{
+				std::ifstream stream (file_it->second.as<std::string> (), std::ios::binary);
+				nano::ledger_stream ledger_stream (node.node->ledger);
+				auto error (!stream.is_open () || ledger_stream.import_blocks (stream));
+				std::cout << boost::str (boost::format ("Imported %1% blocks, %2% already present") % ledger_stream.blocks % ledger_stream.skipped) << std::endl;
+				if (error)
+				{
+					std::cerr << "Ledger import failed: " << (stream.is_open () ? ledger_stream.error_message : "cannot open file") << std::endl;
+					ec = nano::error_cli::generic;
+				}
+			}
+			else
+			{
+				database_write_lock_error (ec);
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_import requires --file" << std::endl;
+			ec = nano::error_cli::invalid_arguments;
+		}
+	}
+	else if (vm.count ("snapshot_export"))
+	{
+		auto file_it = vm.find ("file");
+		if (file_it != vm.end ())
+		{
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			nano::update_flags (node_flags, vm);
+			nano::inactive_node node (data_path, node_flags);
+			std::ofstream stream (file_it->second.as<std::string> (), std::ios::binary | std::ios::trunc);
+			nano::ledger_snapshot snapshot (node.node->store);
+			if (stream.is_open () && !snapshot.export_tables (stream))
+			{
+				stream.close ();
+				std::cout << boost::str (boost::format ("Exported %1% entries, %2% bytes") % snapshot.entries % snapshot.bytes) << std::endl;
+			}
+			else
+			{
+				std::cerr << "Snapshot export failed: " << (stream.is_open () ? snapshot.error_message : "cannot open file") << std::endl;
+				ec = nano::error_cli::generic;
+			}
+		}
+		else
+		{
+			std::cerr << "snapshot_export requires --file" << std::endl;
+			ec = nano::error_cli::invalid_arguments;
+		}
+	}
+	else if (vm.count ("snapshot_import"))
+	{
+		auto file_it = vm.find ("file");
+		if (file_it != vm.end ())
+		{
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			node_flags.read_only = false;
+			nano::update_flags (node_flags, vm);
+			nano::inactive_node node (data_path, node_flags);
+			if (!node.node->init_error ())
+			{
+				std::ifstream stream (file_it->second.as<std::string> (), std::ios::binary);
+				nano::ledger_snapshot snapshot (node.node->store);
+				// Only the genesis block is expected, tables are replaced rather than merged
+				if (node.node->ledger.cache.block_count > 1)
+				{
+					std::cerr << "snapshot_import requires an empty ledger" << std::endl;
+					ec = nano::error_cli::generic;
+				}
+				else if (!stream.is_open () || snapshot.import_tables (stream))
+				{
+					std::cerr << "Snapshot import failed: " << (stream.is_open () ? snapshot.error_message : "cannot open file") << std::endl;
+					ec = nano::error_cli::generic;
+				}
+				else
+				{
+					auto seconds (std::chrono::duration<double> (snapshot.load_elapsed).count ());
+					std::cout << boost::str (boost::format ("Imported %1% entries, %2% bytes, %3% entries per second loading") % snapshot.entries % snapshot.bytes % static_cast<uint64_t> (seconds > 0 ? snapshot.entries / seconds : 0)) << std::endl;
+				}
+			}
+			else
+			{
+				database_write_lock_error (ec);
+			}
+		}
+		else
+		{
+			std::cerr << "snapshot_import requires --file" << std::endl;
+			ec = nano::error_cli::invalid_arguments;
+		}
+	}
 	else if (vm.count ("generate_config"))
 	{
 		auto type = vm["generate_config"].as<std::string> ();
@@ -175,6 +175,11 @@ bool nano::message_header::bulk_pull_is_count_present () const
 	return result;
 }
 
+bool nano::message_header::bulk_pull_is_compressed () const
+{
+	return type == nano::message_type::bulk_pull && extensions.test (bulk_pull_compressed_flag);
+}
+
 bool nano::message_header::node_id_handshake_is_query () const
 {
 	auto result (false);
@@ -188,6 +193,16 @@ bool nano::message_header::node_id_handshake_is_query () const
 	return result;
 }
 
+bool nano::message_header::node_id_handshake_is_block_announce_capable () const
+{
+	return type == nano::message_type::node_id_handshake && extensions.test (node_id_handshake_block_announce_flag);
+}
+
+bool nano::message_header::block_announce_is_pull () const
+{
+	return type == nano::message_type::block_announce && extensions.test (block_announce_pull_flag);
+}
+
 bool nano::message_header::node_id_handshake_is_response () const
 {
 	auto result (false);
@@ -247,6 +262,10 @@ size_t nano::message_header::payload_length_bytes () const
 		{
 			return nano::telemetry_ack::size (*this);
 		}
+		case nano::message_type::block_announce:
+		{
+			return nano::block_announce::size (count_get ());
+		}
 		default:
 		{
 			debug_assert (false);
@@ -306,6 +325,10 @@ std::string nano::message_parser::status_string ()
 		{
 			return "invalid_telemetry_ack_message";
 		}
+		case nano::message_parser::parse_status::invalid_block_announce_message:
+		{
+			return "invalid_block_announce_message";
+		}
 		case nano::message_parser::parse_status::outdated_version:
 		{
 			return "outdated_version";
@@ -403,6 +426,11 @@ void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 						deserialize_telemetry_ack (stream, header);
 						break;
 					}
+					case nano::message_type::block_announce:
+					{
+						deserialize_block_announce (stream, header);
+						break;
+					}
 					default:
 					{
 						status = parse_status::invalid_message_type;
@@ -545,6 +573,20 @@ void nano::message_parser::deserialize_telemetry_ack (nano::stream & stream_a, n
 	}
 }
 
+void nano::message_parser::deserialize_block_announce (nano::stream & stream_a, nano::message_header const & header_a)
+{
+	bool error_l (false);
+	nano::block_announce incoming (error_l, stream_a, header_a);
+	if (!error_l && at_end (stream_a))
+	{
+		visitor.block_announce (incoming);
+	}
+	else
+	{
+		status = parse_status::invalid_block_announce_message;
+	}
+}
+
 bool nano::message_parser::at_end (nano::stream & stream_a)
 {
 	uint8_t junk;
@@ -1001,6 +1043,16 @@ void nano::bulk_pull::set_count_present (bool value_a)
 	header.extensions.set (count_present_flag, value_a);
 }
 
+bool nano::bulk_pull::is_compressed () const
+{
+	return header.extensions.test (compressed_flag);
+}
+
+void nano::bulk_pull::set_compressed (bool value_a)
+{
+	header.extensions.set (compressed_flag, value_a);
+}
+
 nano::bulk_pull_account::bulk_pull_account () :
 message (nano::message_type::bulk_pull_account)
 {
@@ -1367,6 +1419,7 @@ response (response)
 	{
 		header.flag_set (nano::message_header::node_id_handshake_response_flag);
 	}
+	header.flag_set (nano::message_header::node_id_handshake_block_announce_flag);
 }
 
 void nano::node_id_handshake::serialize (nano::stream & stream_a, bool use_epoch_2_min_version_a) const
@@ -1551,3 +1604,74 @@ nano::node_singleton_memory_pool_purge_guard::node_singleton_memory_pool_purge_g
 cleanup_guard ({ nano::block_memory_pool_purge, nano::purge_singleton_pool_memory<nano::vote>, nano::purge_singleton_pool_memory<nano::election> })
 {
 }
+
+nano::block_announce::block_announce (bool & error_a, nano::stream & stream_a, nano::message_header const & header_a) :
+message (header_a)
+{
+	if (!error_a)
+	{
+		error_a = deserialize (stream_a);
+	}
+}
+
+nano::block_announce::block_announce (std::vector<nano::block_hash> const & hashes_a, bool pull_a) :
+message (nano::message_type::block_announce),
+hashes (hashes_a)
+{
+	debug_assert (!hashes.empty () && hashes.size () <= max_hashes);
+	header.count_set (static_cast<uint8_t> (hashes.size ()));
+	if (pull_a)
+	{
+		header.flag_set (nano::message_header::block_announce_pull_flag);
+	}
+}
+
+void nano::block_announce::serialize (nano::stream & stream_a, bool use_epoch_2_min_version_a) const
+{
+	header.serialize (stream_a, use_epoch_2_min_version_a);
+	for (auto const & hash : hashes)
+	{
+		write (stream_a, hash);
+	}
+}
+
+bool nano::block_announce::deserialize (nano::stream & stream_a)
+{
+	debug_assert (header.type == nano::message_type::block_announce);
+	auto count (header.count_get ());
+	auto error (count == 0);
+	try
+	{
+		for (auto i (0); i < count && !error; ++i)
+		{
+			nano::block_hash hash;
+			read (stream_a, hash);
+			hashes.push_back (hash);
+		}
+	}
+	catch (std::runtime_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+
+void nano::block_announce::visit (nano::message_visitor & visitor_a) const
+{
+	visitor_a.block_announce (*this);
+}
+
+bool nano::block_announce::operator== (nano::block_announce const & other_a) const
+{
+	return hashes == other_a.hashes && is_pull () == other_a.is_pull ();
+}
+
+bool nano::block_announce::is_pull () const
+{
+	return header.block_announce_is_pull ();
+}
+
+size_t nano::block_announce::size (size_t count_a)
+{
+	return count_a * sizeof (nano::block_hash);
+}
@@ -174,7 +174,8 @@ enum class message_type : uint8_t
 	node_id_handshake = 0x0a,
 	bulk_pull_account = 0x0b,
 	telemetry_req = 0x0c,
-	telemetry_ack = 0x0d
+	telemetry_ack = 0x0d,
+	block_announce = 0x0e
 };
 
 enum class bulk_pull_account_flags : uint8_t
@@ -209,10 +210,18 @@ public:
 	void flag_set (uint8_t);
 	static uint8_t constexpr bulk_pull_count_present_flag = 0;
 	bool bulk_pull_is_count_present () const;
+	/** Requests a zstd compressed response, see nano::bootstrap_compression */
+	static uint8_t constexpr bulk_pull_compressed_flag = 1;
+	bool bulk_pull_is_compressed () const;
 	static uint8_t constexpr node_id_handshake_query_flag = 0;
 	static uint8_t constexpr node_id_handshake_response_flag = 1;
+	/** Set by nodes which understand block_announce messages */
+	static uint8_t constexpr node_id_handshake_block_announce_flag = 2;
 	bool node_id_handshake_is_query () const;
 	bool node_id_handshake_is_response () const;
+	bool node_id_handshake_is_block_announce_capable () const;
+	static uint8_t constexpr block_announce_pull_flag = 0;
+	bool block_announce_is_pull () const;
 	uint8_t version_min () const;
 
 	/** Size of the payload in bytes. For some messages, the payload size is based on header flags. */
@@ -252,6 +261,7 @@ public:
 		invalid_node_id_handshake_message,
 		invalid_telemetry_req_message,
 		invalid_telemetry_ack_message,
+		invalid_block_announce_message,
 		outdated_version,
 		invalid_magic,
 		invalid_network,
@@ -266,6 +276,7 @@ public:
 	void deserialize_node_id_handshake (nano::stream &, nano::message_header const &);
 	void deserialize_telemetry_req (nano::stream &, nano::message_header const &);
 	void deserialize_telemetry_ack (nano::stream &, nano::message_header const &);
+	void deserialize_block_announce (nano::stream &, nano::message_header const &);
 	bool at_end (nano::stream &);
 	nano::network_filter & publish_filter;
 	nano::block_uniquer & block_uniquer;
@@ -417,7 +428,10 @@ public:
 	count_t count{ 0 };
 	bool is_count_present () const;
 	void set_count_present (bool);
+	bool is_compressed () const;
+	void set_compressed (bool);
 	static size_t constexpr count_present_flag = nano::message_header::bulk_pull_count_present_flag;
+	static size_t constexpr compressed_flag = nano::message_header::bulk_pull_compressed_flag;
 	static size_t constexpr extended_parameters_size = 8;
 	static size_t constexpr size = sizeof (start) + sizeof (end);
 };
@@ -457,6 +471,25 @@ public:
 	size_t size () const;
 	static size_t size (nano::message_header const &);
 };
+/**
+ * Batch of block hashes a peer has, sent instead of the full blocks to peers which negotiated it in node_id_handshake.
+ * With the pull flag set it instead requests the listed blocks, which are answered with publish messages.
+ */
+class block_announce final : public message
+{
+public:
+	block_announce (bool &, nano::stream &, nano::message_header const &);
+	explicit block_announce (std::vector<nano::block_hash> const &, bool = false);
+	void serialize (nano::stream &, bool) const override;
+	bool deserialize (nano::stream &);
+	void visit (nano::message_visitor &) const override;
+	bool operator== (nano::block_announce const &) const;
+	bool is_pull () const;
+	std::vector<nano::block_hash> hashes;
+	static size_t size (size_t);
+	/** Limited by the header count field, which also keeps a full batch within a safe UDP message size */
+	static size_t constexpr max_hashes = 15;
+};
 class message_visitor
 {
 public:
@@ -471,6 +504,7 @@ public:
 	virtual void node_id_handshake (nano::node_id_handshake const &) = 0;
 	virtual void telemetry_req (nano::telemetry_req const &) = 0;
 	virtual void telemetry_ack (nano::telemetry_ack const &) = 0;
+	virtual void block_announce (nano::block_announce const &) = 0;
 	virtual ~message_visitor ();
 };
 
@@ -9,19 +9,23 @@ node (node_a)
 {
 }
 
-void nano::gap_cache::add (nano::block_hash const & hash_a, std::chrono::steady_clock::time_point time_point_a)
+void nano::gap_cache::add (nano::block_hash const & hash_a, nano::account const & account_a, std::chrono::steady_clock::time_point time_point_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
 	auto existing (blocks.get<tag_hash> ().find (hash_a));
 	if (existing != blocks.get<tag_hash> ().end ())
 	{
-		blocks.get<tag_hash> ().modify (existing, [time_point_a](nano::gap_information & info) {
+		blocks.get<tag_hash> ().modify (existing, [time_point_a, &account_a](nano::gap_information & info) {
 			info.arrival = time_point_a;
+			if (!account_a.is_zero ())
+			{
+				info.account = account_a;
+			}
 		});
 	}
 	else
 	{
-		blocks.get<tag_arrival> ().emplace (nano::gap_information{ time_point_a, hash_a, std::vector<nano::account> () });
+		blocks.get<tag_arrival> ().emplace (nano::gap_information{ time_point_a, hash_a, account_a, std::vector<nano::account> () });
 		if (blocks.get<tag_arrival> ().size () > max)
 		{
 			blocks.get<tag_arrival> ().erase (blocks.get<tag_arrival> ().begin ());
@@ -56,7 +60,7 @@ void nano::gap_cache::vote (std::shared_ptr<nano::vote> vote_a)
 
 			if (is_new)
 			{
-				if (bootstrap_check (existing->voters, hash))
+				if (bootstrap_check (existing->voters, hash, existing->account))
 				{
 					gap_blocks_by_hash.modify (existing, [](nano::gap_information & info) {
 						info.bootstrap_started = true;
@@ -67,7 +71,7 @@ void nano::gap_cache::vote (std::shared_ptr<nano::vote> vote_a)
 	}
 }
 
-bool nano::gap_cache::bootstrap_check (std::vector<nano::account> const & voters_a, nano::block_hash const & hash_a)
+bool nano::gap_cache::bootstrap_check (std::vector<nano::account> const & voters_a, nano::block_hash const & hash_a, nano::account const & account_a)
 {
 	nano::uint128_t tally;
 	for (auto const & voter : voters_a)
@@ -88,15 +92,15 @@ bool nano::gap_cache::bootstrap_check (std::vector<nano::account> const & voters
 	}
 	if (start_bootstrap && !node.ledger.block_exists (hash_a))
 	{
-		bootstrap_start (hash_a);
+		bootstrap_start (hash_a, account_a);
 	}
 	return start_bootstrap;
 }
 
-void nano::gap_cache::bootstrap_start (nano::block_hash const & hash_a)
+void nano::gap_cache::bootstrap_start (nano::block_hash const & hash_a, nano::account const & account_a)
 {
 	auto node_l (node.shared ());
-	node.alarm.add (std::chrono::steady_clock::now () + node.network_params.bootstrap.gap_cache_bootstrap_start_interval, [node_l, hash_a]() {
+	node.alarm.add (std::chrono::steady_clock::now () + node.network_params.bootstrap.gap_cache_bootstrap_start_interval, [node_l, hash_a, account_a]() {
 		auto transaction (node_l->store.tx_begin_read ());
 		if (!node_l->store.block_exists (transaction, hash_a))
 		{
@@ -112,6 +116,10 @@ void nano::gap_cache::bootstrap_start (nano::block_hash const & hash_a)
 			{
 				node_l->bootstrap_initiator.bootstrap ();
 			}
+			if (!account_a.is_zero ())
+			{
+				node_l->bootstrap_initiator.bootstrap_priority (account_a, nano::bootstrap_limits::priority_gap);
+			}
 		}
 	});
 }
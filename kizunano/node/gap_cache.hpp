@@ -26,6 +26,8 @@ class gap_information final
 public:
 	std::chrono::steady_clock::time_point arrival;
 	nano::block_hash hash;
+	/** Account of the gapped block if known, prioritized when bootstrapping the gap */
+	nano::account account{ 0 };
 	std::vector<nano::account> voters;
 	bool bootstrap_started{ false };
 };
@@ -35,11 +37,11 @@ class gap_cache final
 {
 public:
 	explicit gap_cache (nano::node &);
-	void add (nano::block_hash const &, std::chrono::steady_clock::time_point = std::chrono::steady_clock::now ());
+	void add (nano::block_hash const &, nano::account const & = nano::account (0), std::chrono::steady_clock::time_point = std::chrono::steady_clock::now ());
 	void erase (nano::block_hash const & hash_a);
 	void vote (std::shared_ptr<nano::vote>);
-	bool bootstrap_check (std::vector<nano::account> const &, nano::block_hash const &);
-	void bootstrap_start (nano::block_hash const & hash_a);
+	bool bootstrap_check (std::vector<nano::account> const &, nano::block_hash const &, nano::account const & = nano::account (0));
+	void bootstrap_start (nano::block_hash const & hash_a, nano::account const & account_a = nano::account (0));
 	nano::uint128_t bootstrap_threshold ();
 	size_t size ();
 	// clang-format off
@@ -1,10 +1,13 @@
 #include <kizunano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
+#include <kizunano/lib/epoch.hpp>
 #include <kizunano/lib/errors.hpp>
 #include <kizunano/lib/numbers.hpp>
 #include <kizunano/node/ipc/action_handler.hpp>
+#include <kizunano/node/ipc/flatbuffers_util.hpp>
 #include <kizunano/node/ipc/ipc_server.hpp>
 #include <kizunano/node/node.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace
@@ -27,6 +30,62 @@ nano::account parse_account (std::string const & account, bool & out_is_deprecat
 
 	return result;
 }
+/** Most accounts or hashes accepted by a bulk query, and most entries returned by one */
+size_t constexpr bulk_max (64 * 1024);
+
+/** Decodes the accounts of a bulk query before anything is added to the response */
+std::vector<nano::account> parse_accounts (flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> const * accounts_a)
+{
+	std::vector<nano::account> result;
+	if (accounts_a != nullptr)
+	{
+		if (accounts_a->size () > bulk_max)
+		{
+			throw nano::error (nano::error_common::invalid_count);
+		}
+		result.reserve (accounts_a->size ());
+		for (auto account : *accounts_a)
+		{
+			bool is_deprecated_format{ false };
+			result.push_back (parse_account (account->str (), is_deprecated_format));
+		}
+	}
+	return result;
+}
+
+/**
+ * Adds a BlockInfo table for \p hash_a to the builder, only the hash is set if \p block_a is null.
+ * The table is built in place so that large responses need no object API allocation.
+ */
+flatbuffers::Offset<nanoapi::BlockInfo> create_block_info (flatbuffers::FlatBufferBuilder & fbb_a, nano::ledger & ledger_a, nano::transaction const & transaction_a, nano::block_hash const & hash_a, std::shared_ptr<nano::block> const & block_a)
+{
+	auto hash (fbb_a.CreateString (hash_a.to_string ()));
+	if (block_a == nullptr)
+	{
+		nanoapi::BlockInfoBuilder builder (fbb_a);
+		builder.add_hash (hash);
+		return builder.Finish ();
+	}
+	auto const & sideband (block_a->sideband ());
+	nano::amount amount (ledger_a.amount (transaction_a, hash_a));
+	auto block (nano::ipc::flatbuffers_builder::create_block (fbb_a, *block_a, amount, sideband.details.is_send));
+	auto account (fbb_a.CreateString ((block_a->account ().is_zero () ? sideband.account : block_a->account ()).to_account ()));
+	auto amount_string (fbb_a.CreateString (amount.to_string_dec ()));
+	auto balance (fbb_a.CreateString (nano::amount (ledger_a.balance (transaction_a, hash_a)).to_string_dec ()));
+	auto confirmed (ledger_a.block_confirmed (transaction_a, hash_a));
+	nanoapi::BlockInfoBuilder builder (fbb_a);
+	builder.add_block_type (block.first);
+	builder.add_block (block.second);
+	builder.add_hash (hash);
+	builder.add_account (account);
+	builder.add_amount (amount_string);
+	builder.add_balance (balance);
+	builder.add_height (sideband.height);
+	builder.add_local_timestamp (sideband.timestamp);
+	builder.add_confirmed (confirmed);
+	return builder.Finish ();
+}
+
 /** Returns the message as a Flatbuffers ObjectAPI type, managed by a unique_ptr */
 template <typename T>
 auto get_message (nanoapi::Envelope const & envelope)
@@ -48,6 +107,10 @@ auto nano::ipc::action_handler::handler_map () -> std::unordered_map<nanoapi::Me
 		handlers.emplace (nanoapi::Message::Message_IsAlive, &nano::ipc::action_handler::on_is_alive);
 		handlers.emplace (nanoapi::Message::Message_TopicConfirmation, &nano::ipc::action_handler::on_topic_confirmation);
 		handlers.emplace (nanoapi::Message::Message_AccountWeight, &nano::ipc::action_handler::on_account_weight);
+		handlers.emplace (nanoapi::Message::Message_AccountsInfo, &nano::ipc::action_handler::on_accounts_info);
+		handlers.emplace (nanoapi::Message::Message_BlocksInfo, &nano::ipc::action_handler::on_blocks_info);
+		handlers.emplace (nanoapi::Message::Message_Pending, &nano::ipc::action_handler::on_pending);
+		handlers.emplace (nanoapi::Message::Message_AccountHistory, &nano::ipc::action_handler::on_account_history);
 		handlers.emplace (nanoapi::Message::Message_ServiceRegister, &nano::ipc::action_handler::on_service_register);
 		handlers.emplace (nanoapi::Message::Message_ServiceStop, &nano::ipc::action_handler::on_service_stop);
 		handlers.emplace (nanoapi::Message::Message_TopicServiceStop, &nano::ipc::action_handler::on_topic_service_stop);
@@ -116,6 +179,206 @@ void nano::ipc::action_handler::on_account_weight (nanoapi::Envelope const & env
 	create_response (response);
 }
 
+void nano::ipc::action_handler::on_accounts_info (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_accounts_info, nano::ipc::access_permission::account_query });
+	auto query (envelope_a.message_as<nanoapi::AccountsInfo> ());
+	auto accounts (parse_accounts (query->accounts ()));
+
+	auto & fbb (*get_shared_flatbuffer ());
+	std::vector<flatbuffers::Offset<nanoapi::AccountInfo>> infos;
+	infos.reserve (accounts.size ());
+	auto transaction (node.store.tx_begin_read ());
+	for (size_t i (0); i < accounts.size (); ++i)
+	{
+		auto account (fbb.CreateString (query->accounts ()->Get (i)));
+		nano::account_info info;
+		if (!node.store.account_get (transaction, accounts[i], info))
+		{
+			nano::confirmation_height_info confirmation_height_info;
+			node.store.confirmation_height_get (transaction, accounts[i], confirmation_height_info);
+			auto frontier (fbb.CreateString (info.head.to_string ()));
+			auto open_block (fbb.CreateString (info.open_block.to_string ()));
+			auto representative_block (fbb.CreateString (node.ledger.representative (transaction, info.head).to_string ()));
+			auto representative (fbb.CreateString (info.representative.to_account ()));
+			auto balance (fbb.CreateString (info.balance.to_string_dec ()));
+			auto confirmation_height_frontier (fbb.CreateString (confirmation_height_info.frontier.to_string ()));
+			nanoapi::AccountInfoBuilder builder (fbb);
+			builder.add_account (account);
+			builder.add_frontier (frontier);
+			builder.add_open_block (open_block);
+			builder.add_representative_block (representative_block);
+			builder.add_representative (representative);
+			builder.add_balance (balance);
+			builder.add_modified_timestamp (info.modified);
+			builder.add_block_count (info.block_count);
+			builder.add_confirmation_height (confirmation_height_info.height);
+			builder.add_confirmation_height_frontier (confirmation_height_frontier);
+			builder.add_account_version (nano::normalized_epoch (info.epoch ()));
+			infos.push_back (builder.Finish ());
+		}
+		else
+		{
+			nanoapi::AccountInfoBuilder builder (fbb);
+			builder.add_account (account);
+			infos.push_back (builder.Finish ());
+		}
+	}
+	auto infos_vector (fbb.CreateVector (infos));
+	nanoapi::AccountsInfoResponseBuilder response (fbb);
+	response.add_accounts (infos_vector);
+	create_builder_response (response);
+}
+
+void nano::ipc::action_handler::on_blocks_info (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_blocks_info, nano::ipc::access_permission::account_query });
+	auto query (envelope_a.message_as<nanoapi::BlocksInfo> ());
+	std::vector<nano::block_hash> hashes;
+	if (query->hashes () != nullptr)
+	{
+		if (query->hashes ()->size () > bulk_max)
+		{
+			throw nano::error (nano::error_common::invalid_count);
+		}
+		hashes.reserve (query->hashes ()->size ());
+		for (auto hash_text : *query->hashes ())
+		{
+			nano::block_hash hash;
+			if (hash.decode_hex (hash_text->str ()))
+			{
+				throw nano::error (nano::error_blocks::bad_hash_number);
+			}
+			hashes.push_back (hash);
+		}
+	}
+
+	auto & fbb (*get_shared_flatbuffer ());
+	std::vector<flatbuffers::Offset<nanoapi::BlockInfo>> blocks;
+	blocks.reserve (hashes.size ());
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & hash : hashes)
+	{
+		blocks.push_back (create_block_info (fbb, node.ledger, transaction, hash, node.store.block_get (transaction, hash)));
+	}
+	auto blocks_vector (fbb.CreateVector (blocks));
+	nanoapi::BlocksInfoResponseBuilder response (fbb);
+	response.add_blocks (blocks_vector);
+	create_builder_response (response);
+}
+
+void nano::ipc::action_handler::on_pending (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_pending, nano::ipc::access_permission::account_query });
+	auto query (envelope_a.message_as<nanoapi::Pending> ());
+	auto accounts (parse_accounts (query->accounts ()));
+	nano::amount threshold (0);
+	if (query->threshold () != nullptr && threshold.decode_dec (query->threshold ()->str ()))
+	{
+		throw nano::error (nano::error_common::bad_threshold);
+	}
+	std::vector<nano::block_hash> starts (accounts.size (), nano::block_hash (0));
+	if (query->starts () != nullptr)
+	{
+		if (query->starts ()->size () > accounts.size ())
+		{
+			throw nano::error (nano::error_common::invalid_count);
+		}
+		for (size_t i (0); i < query->starts ()->size (); ++i)
+		{
+			auto start_text (query->starts ()->Get (i)->str ());
+			if (!start_text.empty () && starts[i].decode_hex (start_text))
+			{
+				throw nano::error (nano::error_blocks::bad_hash_number);
+			}
+		}
+	}
+
+	auto & fbb (*get_shared_flatbuffer ());
+	std::vector<flatbuffers::Offset<nanoapi::AccountPending>> pending;
+	pending.reserve (accounts.size ());
+	std::vector<flatbuffers::Offset<nanoapi::PendingEntry>> entries;
+	// Entries are limited across the whole response, later accounts get a next hash to continue from
+	auto entries_left (bulk_max);
+	auto transaction (node.store.tx_begin_read ());
+	for (size_t i (0); i < accounts.size (); ++i)
+	{
+		entries.clear ();
+		auto limit (std::min<uint64_t> (query->count (), entries_left));
+		flatbuffers::Offset<flatbuffers::String> next;
+		auto more (false);
+		for (auto j (node.store.pending_begin (transaction, nano::pending_key (accounts[i], starts[i]))), n (node.store.pending_end ()); j != n && j->first.account == accounts[i] && !more; ++j)
+		{
+			nano::pending_info const & info (j->second);
+			if (info.amount.number () >= threshold.number ())
+			{
+				more = entries.size () >= limit;
+				if (more)
+				{
+					next = fbb.CreateString (j->first.hash.to_string ());
+				}
+				else
+				{
+					auto hash (fbb.CreateString (j->first.hash.to_string ()));
+					auto amount (fbb.CreateString (info.amount.to_string_dec ()));
+					auto source (fbb.CreateString (info.source.to_account ()));
+					entries.push_back (nanoapi::CreatePendingEntry (fbb, hash, amount, source));
+				}
+			}
+		}
+		entries_left -= entries.size ();
+		auto account (fbb.CreateString (query->accounts ()->Get (i)));
+		auto entries_vector (fbb.CreateVector (entries));
+		nanoapi::AccountPendingBuilder builder (fbb);
+		builder.add_account (account);
+		builder.add_entries (entries_vector);
+		if (more)
+		{
+			builder.add_next (next);
+		}
+		pending.push_back (builder.Finish ());
+	}
+	auto pending_vector (fbb.CreateVector (pending));
+	nanoapi::PendingResponseBuilder response (fbb);
+	response.add_accounts (pending_vector);
+	create_builder_response (response);
+}
+
+void nano::ipc::action_handler::on_account_history (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_account_history, nano::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (envelope_a.message_as<nanoapi::AccountHistory> ());
+	auto account (parse_account (query->account () != nullptr ? query->account ()->str () : "", is_deprecated_format));
+	auto height (std::max<uint64_t> (query->height (), 1));
+	auto count (std::min<uint64_t> (query->count (), bulk_max));
+
+	auto & fbb (*get_shared_flatbuffer ());
+	std::vector<flatbuffers::Offset<nanoapi::BlockInfo>> blocks;
+	uint64_t next_height (0);
+	auto transaction (node.store.tx_begin_read ());
+	// Blocks of an account are adjacent in the heights index, ordered by height
+	for (auto i (node.store.heights_begin (transaction, nano::account_height_key (account, height))), n (node.store.heights_end ()); i != n && i->first.account == account && next_height == 0; ++i)
+	{
+		if (blocks.size () < count)
+		{
+			nano::block_hash hash (i->second);
+			blocks.push_back (create_block_info (fbb, node.ledger, transaction, hash, node.store.block_get (transaction, hash)));
+		}
+		else
+		{
+			next_height = i->first.height ();
+		}
+	}
+	auto account_string (fbb.CreateString (query->account ()));
+	auto blocks_vector (fbb.CreateVector (blocks));
+	nanoapi::AccountHistoryResponseBuilder response (fbb);
+	response.add_account (account_string);
+	response.add_blocks (blocks_vector);
+	response.add_next_height (next_height);
+	create_builder_response (response);
+}
+
 void nano::ipc::action_handler::on_is_alive (nanoapi::Envelope const & envelope)
 {
 	nanoapi::IsAliveT alive;
@@ -40,6 +40,10 @@ namespace ipc
 		action_handler (nano::node & node, nano::ipc::ipc_server & server, std::weak_ptr<nano::ipc::subscriber> const & subscriber, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder);
 
 		void on_account_weight (nanoapi::Envelope const & envelope);
+		void on_accounts_info (nanoapi::Envelope const & envelope);
+		void on_blocks_info (nanoapi::Envelope const & envelope);
+		void on_pending (nanoapi::Envelope const & envelope);
+		void on_account_history (nanoapi::Envelope const & envelope);
 		void on_is_alive (nanoapi::Envelope const & envelope);
 		void on_topic_confirmation (nanoapi::Envelope const & envelope);
 
@@ -3,9 +3,37 @@
 #include <kizunano/node/ipc/flatbuffers_util.hpp>
 #include <kizunano/secure/common.hpp>
 
-std::unique_ptr<nanoapi::BlockStateT> nano::ipc::flatbuffers_builder::from (nano::state_block const & block_a, nano::amount const & amount_a, bool is_state_send_a)
+namespace
+{
+nanoapi::BlockSubType state_subtype (nano::state_block const & block_a, nano::amount const & amount_a, bool is_state_send_a)
 {
 	static nano::network_params params;
+	auto result (nanoapi::BlockSubType::BlockSubType_receive);
+	if (is_state_send_a)
+	{
+		result = nanoapi::BlockSubType::BlockSubType_send;
+	}
+	else if (block_a.link ().is_zero ())
+	{
+		result = nanoapi::BlockSubType::BlockSubType_change;
+	}
+	else if (amount_a == 0 && params.ledger.epochs.is_epoch_link (block_a.link ()))
+	{
+		result = nanoapi::BlockSubType::BlockSubType_epoch;
+	}
+	return result;
+}
+
+std::string signature_hex (nano::block const & block_a)
+{
+	std::string result;
+	block_a.block_signature ().encode_hex (result);
+	return result;
+}
+}
+
+std::unique_ptr<nanoapi::BlockStateT> nano::ipc::flatbuffers_builder::from (nano::state_block const & block_a, nano::amount const & amount_a, bool is_state_send_a)
+{
 	auto block (std::make_unique<nanoapi::BlockStateT> ());
 	block->account = block_a.account ().to_account ();
 	block->hash = block_a.hash ().to_string ();
@@ -16,23 +44,7 @@ std::unique_ptr<nanoapi::BlockStateT> nano::ipc::flatbuffers_builder::from (nano
 	block->link_as_account = block_a.link ().to_account ();
 	block_a.signature.encode_hex (block->signature);
 	block->work = nano::to_string_hex (block_a.work);
-
-	if (is_state_send_a)
-	{
-		block->subtype = nanoapi::BlockSubType::BlockSubType_send;
-	}
-	else if (block_a.link ().is_zero ())
-	{
-		block->subtype = nanoapi::BlockSubType::BlockSubType_change;
-	}
-	else if (amount_a == 0 && params.ledger.epochs.is_epoch_link (block_a.link ()))
-	{
-		block->subtype = nanoapi::BlockSubType::BlockSubType_epoch;
-	}
-	else
-	{
-		block->subtype = nanoapi::BlockSubType::BlockSubType_receive;
-	}
+	block->subtype = state_subtype (block_a, amount_a, is_state_send_a);
 	return block;
 }
 
@@ -118,3 +130,65 @@ nanoapi::BlockUnion nano::ipc::flatbuffers_builder::block_to_union (nano::block
 	}
 	return u;
 }
+
+std::pair<nanoapi::Block, flatbuffers::Offset<void>> nano::ipc::flatbuffers_builder::create_block (flatbuffers::FlatBufferBuilder & fbb_a, nano::block const & block_a, nano::amount const & amount_a, bool is_state_send_a)
+{
+	// Strings are created before the table which refers to them
+	auto hash (fbb_a.CreateString (block_a.hash ().to_string ()));
+	auto signature (fbb_a.CreateString (signature_hex (block_a)));
+	auto work (fbb_a.CreateString (nano::to_string_hex (block_a.block_work ())));
+	std::pair<nanoapi::Block, flatbuffers::Offset<void>> result (nanoapi::Block::Block_NONE, 0);
+	switch (block_a.type ())
+	{
+		case nano::block_type::state:
+		{
+			auto const & block (static_cast<nano::state_block const &> (block_a));
+			auto account (fbb_a.CreateString (block.account ().to_account ()));
+			auto previous (fbb_a.CreateString (block.previous ().to_string ()));
+			auto representative (fbb_a.CreateString (block.representative ().to_account ()));
+			auto balance (fbb_a.CreateString (block.balance ().to_string_dec ()));
+			auto link (fbb_a.CreateString (block.link ().to_string ()));
+			auto link_as_account (fbb_a.CreateString (block.link ().to_account ()));
+			result = std::make_pair (nanoapi::Block::Block_BlockState, nanoapi::CreateBlockState (fbb_a, hash, account, previous, representative, balance, link, link_as_account, signature, work, state_subtype (block, amount_a, is_state_send_a)).Union ());
+			break;
+		}
+		case nano::block_type::send:
+		{
+			auto const & block (static_cast<nano::send_block const &> (block_a));
+			auto previous (fbb_a.CreateString (block.previous ().to_string ()));
+			auto destination (fbb_a.CreateString (block.hashables.destination.to_account ()));
+			auto balance (fbb_a.CreateString (block.balance ().to_string_dec ()));
+			result = std::make_pair (nanoapi::Block::Block_BlockSend, nanoapi::CreateBlockSend (fbb_a, hash, previous, destination, balance, signature, work).Union ());
+			break;
+		}
+		case nano::block_type::receive:
+		{
+			auto const & block (static_cast<nano::receive_block const &> (block_a));
+			auto previous (fbb_a.CreateString (block.previous ().to_string ()));
+			auto source (fbb_a.CreateString (block.source ().to_string ()));
+			result = std::make_pair (nanoapi::Block::Block_BlockReceive, nanoapi::CreateBlockReceive (fbb_a, hash, previous, source, signature, work).Union ());
+			break;
+		}
+		case nano::block_type::open:
+		{
+			auto const & block (static_cast<nano::open_block const &> (block_a));
+			auto account (fbb_a.CreateString (block.account ().to_account ()));
+			auto source (fbb_a.CreateString (block.source ().to_string ()));
+			auto representative (fbb_a.CreateString (block.representative ().to_account ()));
+			result = std::make_pair (nanoapi::Block::Block_BlockOpen, nanoapi::CreateBlockOpen (fbb_a, hash, account, source, representative, signature, work).Union ());
+			break;
+		}
+		case nano::block_type::change:
+		{
+			auto const & block (static_cast<nano::change_block const &> (block_a));
+			auto previous (fbb_a.CreateString (block.previous ().to_string ()));
+			auto representative (fbb_a.CreateString (block.representative ().to_account ()));
+			result = std::make_pair (nanoapi::Block::Block_BlockChange, nanoapi::CreateBlockChange (fbb_a, hash, previous, representative, signature, work).Union ());
+			break;
+		}
+
+		default:
+			debug_assert (false);
+	}
+	return result;
+}
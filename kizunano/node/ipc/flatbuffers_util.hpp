@@ -3,6 +3,7 @@
 #include <kizunano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
 
 #include <memory>
+#include <utility>
 
 namespace nano
 {
@@ -27,6 +28,8 @@ namespace ipc
 		static std::unique_ptr<nanoapi::BlockReceiveT> from (nano::receive_block const & block_a);
 		static std::unique_ptr<nanoapi::BlockOpenT> from (nano::open_block const & block_a);
 		static std::unique_ptr<nanoapi::BlockChangeT> from (nano::change_block const & block_a);
+		/** Adds the table of \p block_a to \p fbb_a without creating object API types, returns its union type and offset */
+		static std::pair<nanoapi::Block, flatbuffers::Offset<void>> create_block (flatbuffers::FlatBufferBuilder & fbb_a, nano::block const & block_a, nano::amount const & amount_a, bool is_state_send_a = false);
 	};
 }
 }
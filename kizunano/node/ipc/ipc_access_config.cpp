@@ -20,6 +20,14 @@ nano::ipc::access_permission from_string (std::string permission)
 		return nano::ipc::access_permission::api_topic_service_stop;
 	if (permission == "api_topic_confirmation")
 		return nano::ipc::access_permission::api_topic_confirmation;
+	if (permission == "api_accounts_info")
+		return nano::ipc::access_permission::api_accounts_info;
+	if (permission == "api_blocks_info")
+		return nano::ipc::access_permission::api_blocks_info;
+	if (permission == "api_pending")
+		return nano::ipc::access_permission::api_pending;
+	if (permission == "api_account_history")
+		return nano::ipc::access_permission::api_account_history;
 	if (permission == "account_query")
 		return nano::ipc::access_permission::account_query;
 	if (permission == "epoch_upgrade")
@@ -88,6 +96,10 @@ void nano::ipc::access::clear ()
 	// The default set of permissions. A new insert should be made as new safe
 	// api's or resource permissions are made.
 	default_user.permissions.insert (nano::ipc::access_permission::api_account_weight);
+	default_user.permissions.insert (nano::ipc::access_permission::api_accounts_info);
+	default_user.permissions.insert (nano::ipc::access_permission::api_blocks_info);
+	default_user.permissions.insert (nano::ipc::access_permission::api_pending);
+	default_user.permissions.insert (nano::ipc::access_permission::api_account_history);
 }
 
 nano::error nano::ipc::access::deserialize_toml (nano::tomlconfig & toml)
@@ -54,6 +54,10 @@ namespace ipc
 		api_service_stop,
 		api_topic_service_stop,
 		api_topic_confirmation,
+		api_accounts_info,
+		api_blocks_info,
+		api_pending,
+		api_account_history,
 		/** Query account information */
 		account_query,
 		/** Epoch upgrade */
@@ -248,8 +248,8 @@ public:
 		}));
 	}
 
-	/** Handler for payload_encoding::json_legacy */
-	void handle_json_query (bool allow_unsafe)
+	/** Handler for payload_encoding::json_v1, json_v1_unsafe and json_v1_chunked */
+	void handle_json_query (bool allow_unsafe, bool chunked)
 	{
 		session_timer.restart ();
 		auto request_id_l (std::to_string (server.id_dispenser.fetch_add (1)));
@@ -257,11 +257,14 @@ public:
 		// This is called when nano::rpc_handler#process_request is done. We convert to
 		// json and write the response to the ipc socket with a length prefix.
 		auto this_l (this->shared_from_this ());
-		auto response_handler_l ([this_l, request_id_l](std::string const & body) {
-			auto big = boost::endian::native_to_big (static_cast<uint32_t> (body.size ()));
+		auto response_handler_l ([this_l, request_id_l, chunked](std::string const & body) {
 			auto buffer (std::make_shared<std::vector<uint8_t>> ());
-			buffer->insert (buffer->end (), reinterpret_cast<std::uint8_t *> (&big), reinterpret_cast<std::uint8_t *> (&big) + sizeof (std::uint32_t));
-			buffer->insert (buffer->end (), body.begin (), body.end ());
+			append_part (*buffer, body);
+			if (chunked)
+			{
+				// The last part is followed by an empty one
+				append_part (*buffer, std::string ());
+			}
 			if (this_l->node.config.logging.log_ipc ())
 			{
 				this_l->node.logger.always_log (boost::str (boost::format ("IPC/RPC request %1% completed in: %2% %3%") % request_id_l % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
@@ -293,10 +296,35 @@ public:
 				io_ctx.stop ();
 			});
 		}));
+		if (chunked)
+		{
+			// Leading parts are written as they are produced, the next one is only produced once this one is written
+			handler->response_part = [this_l](std::string const & part_a, std::function<void(bool)> const & next_a) {
+				auto buffer (std::make_shared<std::vector<uint8_t>> ());
+				append_part (*buffer, part_a);
+				this_l->timer_start (std::chrono::seconds (this_l->config_transport.io_timeout));
+				this_l->queued_write (boost::asio::buffer (buffer->data (), buffer->size ()), [this_l, buffer, next_a](boost::system::error_code const & error_a, size_t size_a) {
+					this_l->timer_cancel ();
+					if (error_a && this_l->node.config.logging.log_ipc ())
+					{
+						this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+					}
+					next_a (!!error_a);
+				});
+			};
+		}
 		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
 		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
 	}
 
+	/** Appends \p part_a to \p buffer_a with a big endian length prefix */
+	static void append_part (std::vector<uint8_t> & buffer_a, std::string const & part_a)
+	{
+		auto big = boost::endian::native_to_big (static_cast<uint32_t> (part_a.size ()));
+		buffer_a.insert (buffer_a.end (), reinterpret_cast<std::uint8_t *> (&big), reinterpret_cast<std::uint8_t *> (&big) + sizeof (std::uint32_t));
+		buffer_a.insert (buffer_a.end (), part_a.begin (), part_a.end ());
+	}
+
 	/** Async request reader */
 	void read_next_request ()
 	{
@@ -314,16 +342,17 @@ public:
 					this_l->node.logger.always_log ("IPC: Invalid preamble");
 				}
 			}
-			else if (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1) || encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1_unsafe))
+			else if (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1) || encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1_unsafe) || encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1_chunked))
 			{
 				auto allow_unsafe (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1_unsafe));
+				auto chunked (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::json_v1_chunked));
 				// Length of payload
-				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l, allow_unsafe]() {
+				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l, allow_unsafe, chunked]() {
 					boost::endian::big_to_native_inplace (this_l->buffer_size);
 					this_l->buffer.resize (this_l->buffer_size);
 					// Payload (ptree compliant JSON string)
-					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l, allow_unsafe]() {
-						this_l->handle_json_query (allow_unsafe);
+					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l, allow_unsafe, chunked]() {
+						this_l->handle_json_query (allow_unsafe, chunked);
 					});
 				});
 			}
@@ -1,5 +1,8 @@
 #include <kizunano/lib/config.hpp>
 #include <kizunano/lib/json_error_response.hpp>
+#include <kizunano/lib/json_flat_object.hpp>
+#include <kizunano/lib/json_writer.hpp>
+#include <kizunano/lib/threading.hpp>
 #include <kizunano/lib/timer.hpp>
 #include <kizunano/node/bootstrap/bootstrap_lazy.hpp>
 #include <kizunano/node/common.hpp>
@@ -10,11 +13,14 @@
 #include <kizunano/node/node_rpc_config.hpp>
 #include <kizunano/node/telemetry.hpp>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <unordered_set>
 
 namespace
 {
@@ -24,6 +30,8 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ();
 auto ipc_json_handler_no_arg_funcs = create_ipc_json_handler_no_arg_func_map ();
 bool block_confirmed (nano::node & node, nano::transaction & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed);
 const char * epoch_as_string (nano::epoch);
+void pending_for_each (nano::node & node, nano::transaction const & transaction, nano::account const & account, bool by_amount, nano::uint128_t const & threshold, std::function<bool(nano::pending_key const &, nano::pending_info const &)> const & action);
+nano::block_hash chain_offset (nano::node & node, nano::transaction const & transaction, nano::block const & block, uint64_t offset, bool successors);
 }
 
 nano::json_handler::json_handler (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a, std::string const & body_a, std::function<void(std::string const &)> const & response_a, std::function<void()> stop_callback_a) :
@@ -57,6 +65,10 @@ void nano::json_handler::process_request (bool unsafe_a)
 {
 	try
 	{
+		if (response_fast ())
+		{
+			return;
+		}
 		std::stringstream istream (body);
 		boost::property_tree::read_json (istream, request);
 		if (node_rpc_config.request_callback)
@@ -65,6 +77,10 @@ void nano::json_handler::process_request (bool unsafe_a)
 			node_rpc_config.request_callback (request);
 		}
 		action = request.get<std::string> ("action");
+		if (node.rpc_response_cache.enabled () && response_cached ())
+		{
+			return;
+		}
 		auto no_arg_func_iter = ipc_json_handler_no_arg_funcs.find (action);
 		if (no_arg_func_iter != ipc_json_handler_no_arg_funcs.cend ())
 		{
@@ -160,10 +176,340 @@ void nano::json_handler::response_errors ()
 	{
 		std::stringstream ostream;
 		boost::property_tree::write_json (ostream, response_l);
+		if (!cache_key.empty () && !cache_accounts.empty ())
+		{
+			node.rpc_response_cache.put (cache_key, ostream.str (), cache_accounts, cache_generation);
+		}
 		response (ostream.str ());
 	}
 }
 
+namespace
+{
+/** Reads through the transaction of a batch, which outlives the sub-requests using it */
+class batch_transaction_impl final : public nano::read_transaction_impl
+{
+public:
+	batch_transaction_impl (nano::read_transaction const & transaction_a) :
+	transaction (transaction_a)
+	{
+	}
+	void * get_handle () const override
+	{
+		return transaction.get_handle ();
+	}
+	void reset () override
+	{
+	}
+	void renew () override
+	{
+	}
+	nano::read_transaction const & transaction;
+};
+}
+
+nano::read_transaction nano::json_handler::tx_begin_read ()
+{
+	return batch_transaction ? nano::read_transaction (std::make_unique<batch_transaction_impl> (*batch_transaction)) : node.store.tx_begin_read ();
+}
+
+namespace
+{
+/**
+ * Where a ledger scan stopped and the filters it ran with, given to clients as an opaque hex string.
+ * A request passing it back as "cursor" resumes the scan there, filters given with that request are ignored.
+ */
+class scan_cursor final
+{
+public:
+	enum class scan : uint8_t
+	{
+		ledger = 1,
+		frontiers,
+		delegators,
+		unchecked_keys,
+		unopened
+	};
+	scan_cursor (scan type_a) :
+	type (type_a)
+	{
+	}
+	std::string encode () const
+	{
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream (bytes);
+			uint8_t version_l (version);
+			nano::write (stream, version_l);
+			nano::write (stream, type);
+			nano::write (stream, first.bytes);
+			nano::write (stream, second.bytes);
+			nano::write (stream, threshold.bytes);
+			nano::write (stream, boost::endian::native_to_big (modified_since));
+			nano::write (stream, flags);
+		}
+		std::string result;
+		char const * hexdigits = "0123456789ABCDEF";
+		for (auto byte : bytes)
+		{
+			result.push_back (hexdigits[byte >> 4]);
+			result.push_back (hexdigits[byte & 0xf]);
+		}
+		return result;
+	}
+	/** Returns true if \p text_a is not a cursor of the same scan */
+	bool decode (std::string const & text_a)
+	{
+		std::vector<uint8_t> bytes;
+		auto digit ([](char c_a) {
+			return std::isdigit (static_cast<unsigned char> (c_a)) ? c_a - '0' : std::toupper (static_cast<unsigned char> (c_a)) - 'A' + 10;
+		});
+		auto error (text_a.size () != 2 * size || !std::all_of (text_a.begin (), text_a.end (), [](char c_a) { return std::isxdigit (static_cast<unsigned char> (c_a)) != 0; }));
+		for (size_t i (0); !error && i < text_a.size (); i += 2)
+		{
+			bytes.push_back (static_cast<uint8_t> (digit (text_a[i]) << 4 | digit (text_a[i + 1])));
+		}
+		if (!error)
+		{
+			nano::bufferstream stream (bytes.data (), bytes.size ());
+			uint8_t version_l (0);
+			scan type_l;
+			error = nano::try_read (stream, version_l) || nano::try_read (stream, type_l) || nano::try_read (stream, first.bytes) || nano::try_read (stream, second.bytes) || nano::try_read (stream, threshold.bytes) || nano::try_read (stream, modified_since) || nano::try_read (stream, flags);
+			boost::endian::big_to_native_inplace (modified_since);
+			error = error || version_l != version || type_l != type;
+		}
+		return error;
+	}
+	scan type;
+	/** Key the scan resumes at, keys made of one number leave second zero */
+	nano::hash_or_account first{ 0 };
+	nano::hash_or_account second{ 0 };
+	nano::amount threshold{ 0 };
+	uint64_t modified_since{ 0 };
+	uint8_t flags{ 0 };
+	static uint8_t constexpr version = 1;
+	static size_t constexpr size = 2 + 2 * sizeof (nano::hash_or_account) + sizeof (nano::amount) + sizeof (uint64_t) + sizeof (uint8_t);
+};
+
+/**
+ * Time one call may spend scanning, the first entry is always looked at so every call makes progress.
+ * Streamed scans time each step between start and stop, so waiting for a part to be sent is not counted.
+ */
+class scan_budget final
+{
+public:
+	scan_budget (std::chrono::milliseconds const & budget_a) :
+	budget (budget_a),
+	step_start (std::chrono::steady_clock::now ())
+	{
+	}
+	void start ()
+	{
+		step_start = std::chrono::steady_clock::now ();
+	}
+	void stop ()
+	{
+		used += std::chrono::steady_clock::now () - step_start;
+	}
+	/** Checked before looking at each entry, returns true from the moment the time is up */
+	bool spent ()
+	{
+		expired = expired || (++checks > 1 && budget.count () != 0 && used + (std::chrono::steady_clock::now () - step_start) >= budget);
+		return expired;
+	}
+	std::chrono::steady_clock::duration budget;
+	std::chrono::steady_clock::duration used{ 0 };
+	std::chrono::steady_clock::time_point step_start;
+	uint64_t checks{ 0 };
+	bool expired{ false };
+};
+
+/** Closes the member a streamed scan writes into and adds the cursor resuming it */
+void put_cursor (nano::json_writer & writer_a, scan_cursor const & cursor_a)
+{
+	writer_a.end ();
+	writer_a.put ("cursor", cursor_a.encode ());
+}
+}
+
+void nano::json_handler::response_stream (std::string const & name_a, std::function<bool(nano::json_writer &)> const & step_a, bool array_a)
+{
+	auto writer (std::make_shared<nano::json_writer> ());
+	auto step (std::make_shared<std::function<bool(nano::json_writer &)>> (step_a));
+	if (array_a)
+	{
+		writer->begin_array (name_a);
+	}
+	else
+	{
+		writer->begin_object (name_a);
+	}
+	if (response_part)
+	{
+		response_stream_part (writer, step);
+	}
+	else
+	{
+		while (!(*step) (*writer))
+		{
+		}
+		writer->finish ();
+		response (writer->take ());
+	}
+}
+
+void nano::json_handler::response_stream_part (std::shared_ptr<nano::json_writer> const & writer_a, std::shared_ptr<std::function<bool(nano::json_writer &)>> const & step_a)
+{
+	auto done ((*step_a) (*writer_a));
+	// An empty part ends the response, steps which found nothing to write are followed by the next one
+	while (!done && writer_a->size () == 0)
+	{
+		done = (*step_a) (*writer_a);
+	}
+	if (done)
+	{
+		writer_a->finish ();
+		response (writer_a->take ());
+	}
+	else
+	{
+		auto this_l (shared_from_this ());
+		// Parts which could not be sent stop the response, releasing the handler
+		response_part (writer_a->take (), [this_l, writer_a, step_a](bool error_a) {
+			if (!error_a)
+			{
+				this_l->response_stream_part (writer_a, step_a);
+			}
+		});
+	}
+}
+
+bool nano::json_handler::response_fast ()
+{
+	// Hot actions with the usual parameters are answered without property trees, anything else including errors takes the general path
+	auto result (false);
+	nano::json_flat_object request_l;
+	boost::optional<std::string> action_l;
+	if (fast_path && !node_rpc_config.request_callback && !request_l.parse (body))
+	{
+		action_l = request_l.get ("action");
+	}
+	if (action_l)
+	{
+		nano::json_writer writer;
+		if (*action_l == "block_count" && request_l.size () == 1)
+		{
+			writer.put ("count", std::to_string (node.ledger.cache.block_count));
+			writer.put ("unchecked", std::to_string (node.ledger.cache.unchecked_count));
+			writer.put ("cemented", std::to_string (node.ledger.cache.cemented_count));
+			result = true;
+		}
+		else if ((*action_l == "account_weight" || (*action_l == "account_balance" && !node.rpc_response_cache.enabled ())) && request_l.size () == 2)
+		{
+			auto account_text (request_l.get ("account"));
+			nano::account account;
+			if (account_text && !account.decode_account (*account_text))
+			{
+				if ((*account_text)[3] == '-' || (*account_text)[4] == '-')
+				{
+					// nano- and xrb- prefixes are deprecated
+					writer.put ("deprecated_account_format", "1");
+				}
+				if (*action_l == "account_balance")
+				{
+					auto balance (node.balance_pending (account));
+					writer.put ("balance", balance.first.convert_to<std::string> ());
+					writer.put ("pending", balance.second.convert_to<std::string> ());
+				}
+				else
+				{
+					writer.put ("weight", node.weight (account).convert_to<std::string> ());
+				}
+				result = true;
+			}
+		}
+		else if (*action_l == "block_account" && request_l.size () == 2)
+		{
+			auto hash_text (request_l.get ("hash"));
+			nano::block_hash hash;
+			if (hash_text && !hash.decode_hex (*hash_text))
+			{
+				auto transaction (node.store.tx_begin_read ());
+				if (node.store.block_exists (transaction, hash))
+				{
+					writer.put ("account", node.ledger.account (transaction, hash).to_account ());
+					result = true;
+				}
+			}
+		}
+		else if (*action_l == "work_validate" && request_l.size () == 3)
+		{
+			// Work version, difficulty and multiplier are left at their defaults, see work_validate
+			auto hash_text (request_l.get ("hash"));
+			auto work_text (request_l.get ("work"));
+			nano::block_hash hash;
+			uint64_t work (0);
+			if (hash_text && work_text && !hash.decode_hex (*hash_text) && !nano::from_string_hex (*work_text, work))
+			{
+				auto work_version (nano::work_version::work_1);
+				auto result_difficulty (nano::work_difficulty (work_version, hash, work));
+				writer.put ("valid_all", (result_difficulty >= node.default_difficulty (work_version)) ? "1" : "0");
+				writer.put ("valid_receive", (result_difficulty >= nano::work_threshold (work_version, nano::block_details (nano::epoch::epoch_2, false, true, false))) ? "1" : "0");
+				writer.put ("difficulty", nano::to_string_hex (result_difficulty));
+				auto result_multiplier = nano::difficulty::to_multiplier (result_difficulty, node.default_difficulty (work_version));
+				writer.put ("multiplier", nano::to_string (result_multiplier));
+				result = true;
+			}
+		}
+		if (result)
+		{
+			action = *action_l;
+			writer.finish ();
+			response (writer.take ());
+		}
+	}
+	return result;
+}
+
+bool nano::json_handler::response_cached ()
+{
+	static std::unordered_set<std::string> const cacheable{ "account_balance", "account_info", "block_info", "pending_exists" };
+	auto result (false);
+	if (cacheable.find (action) != cacheable.end ())
+	{
+		// Canonical key of the action and its parameters in name order, requests with nested parameters are not cached
+		std::vector<std::pair<std::string, std::string>> parameters;
+		auto scalar (true);
+		for (auto const & parameter : request)
+		{
+			scalar = scalar && parameter.second.empty ();
+			parameters.emplace_back (parameter.first, parameter.second.data ());
+		}
+		if (scalar)
+		{
+			std::sort (parameters.begin (), parameters.end ());
+			std::string key;
+			for (auto const & parameter : parameters)
+			{
+				key.append (parameter.first).append (1, '=').append (parameter.second).append (1, '\n');
+			}
+			// Read before the action opens its transaction so a response built from a ledger state changed meanwhile is not cached
+			cache_generation = node.rpc_response_cache.generation ();
+			std::string cached_response;
+			result = node.rpc_response_cache.get (key, cached_response);
+			if (result)
+			{
+				response (cached_response);
+			}
+			else
+			{
+				cache_key = key;
+			}
+		}
+	}
+	return result;
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -511,9 +857,10 @@ void nano::json_handler::account_balance ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto balance (node.balance_pending (account));
-		response_l.put ("balance", balance.first.convert_to<std::string> ());
-		response_l.put ("pending", balance.second.convert_to<std::string> ());
+		auto transaction (tx_begin_read ());
+		response_l.put ("balance", node.ledger.account_balance (transaction, account).convert_to<std::string> ());
+		response_l.put ("pending", node.ledger.account_pending (transaction, account).convert_to<std::string> ());
+		cache_accounts.push_back (account);
 	}
 	response_errors ();
 }
@@ -523,7 +870,7 @@ void nano::json_handler::account_block_count ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -598,7 +945,7 @@ void nano::json_handler::account_info ()
 		const bool representative = request.get<bool> ("representative", false);
 		const bool weight = request.get<bool> ("weight", false);
 		const bool pending = request.get<bool> ("pending", false);
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		auto info (account_info_impl (transaction, account));
 		nano::confirmation_height_info confirmation_height_info;
 		if (node.store.confirmation_height_get (transaction, account, confirmation_height_info))
@@ -632,6 +979,11 @@ void nano::json_handler::account_info ()
 				auto account_pending (node.ledger.account_pending (transaction, account));
 				response_l.put ("pending", account_pending.convert_to<std::string> ());
 			}
+			if (!weight)
+			{
+				// Weights change with the accounts delegating to this one
+				cache_accounts.push_back (account);
+			}
 		}
 	}
 	response_errors ();
@@ -729,7 +1081,7 @@ void nano::json_handler::account_representative ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -897,10 +1249,9 @@ void nano::json_handler::accounts_pending ()
 		if (!ec)
 		{
 			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending_begin (transaction, nano::pending_key (account, 0))), n (node.store.pending_end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
-			{
-				nano::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+			// Sorted and threshold queries read the pending amounts index, largest amounts first
+			pending_for_each (node, transaction, account, sorting || !threshold.is_zero (), threshold.number (), [&](nano::pending_key const & key, nano::pending_info const & info) {
+				if (peers_l.size () < count && block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 				{
 					if (simple)
 					{
@@ -908,41 +1259,20 @@ void nano::json_handler::accounts_pending ()
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
+					else if (source)
+					{
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						pending_tree.put ("source", info.source.to_account ());
+						peers_l.add_child (key.hash.to_string (), pending_tree);
+					}
 					else
 					{
-						nano::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
-						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
-						}
+						peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 					}
 				}
-			}
-			if (sorting && !simple)
-			{
-				if (source)
-				{
-					peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
-					});
-				}
-				else
-				{
-					peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
-					});
-				}
-			}
+				return peers_l.size () < count;
+			});
 			pending.add_child (account.to_account (), peers_l);
 		}
 	}
@@ -986,12 +1316,91 @@ void nano::json_handler::available_supply ()
 	response_errors ();
 }
 
+void nano::json_handler::batch ()
+{
+	auto const & requests_l (request.get_child ("requests"));
+	if (requests_l.size () > node_rpc_config.batch_max_requests)
+	{
+		ec = nano::error_rpc::batch_too_large;
+	}
+	if (!ec)
+	{
+		// Sub-requests all read this snapshot, which is released before the responses are written so a slow client does not hold it open
+		auto responses (std::make_shared<std::vector<std::string>> ());
+		responses->reserve (requests_l.size ());
+		{
+			auto transaction (std::make_shared<nano::read_transaction> (node.store.tx_begin_read ()));
+			for (auto const & request_l : requests_l)
+			{
+				responses->push_back (batch_response (request_l.second, transaction));
+			}
+		}
+		size_t index (0);
+		response_stream ("responses", [this, responses, index](nano::json_writer & writer_a) mutable {
+			for (; index < responses->size () && writer_a.size () < node_rpc_config.response_chunk_size; ++index)
+			{
+				writer_a.put_json ((*responses)[index]);
+			}
+			return index == responses->size ();
+		},
+		true);
+	}
+	else
+	{
+		response_errors ();
+	}
+}
+
+std::string nano::json_handler::batch_response (boost::property_tree::ptree const & request_a, std::shared_ptr<nano::read_transaction> const & transaction_a)
+{
+	// Read-only actions which respond before returning and read the ledger only through tx_begin_read.
+	// account_weight and block_count are left out, they read cached totals of the live ledger rather than the snapshot
+	static std::unordered_set<std::string> const allowed{ "account_balance", "account_block_count", "account_info", "account_representative", "block", "block_account", "block_info", "blocks", "blocks_info", "pending_exists" };
+	std::string result;
+	auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, "", [&result](std::string const & response_a) {
+		result = response_a;
+	}));
+	handler->request = request_a;
+	handler->action = request_a.get<std::string> ("action", "");
+	handler->batch_transaction = transaction_a;
+	if (allowed.find (handler->action) != allowed.end ())
+	{
+		try
+		{
+			// The weight of account_info also comes from the cache
+			if (handler->action == "account_info" && request_a.get<bool> ("weight", false))
+			{
+				handler->ec = nano::error_rpc::batch_action_not_allowed;
+				handler->response_errors ();
+			}
+			else
+			{
+				ipc_json_handler_no_arg_funcs.find (handler->action)->second (handler.get ());
+			}
+		}
+		catch (std::runtime_error const &)
+		{
+			json_error_response (handler->response, "Unable to parse JSON");
+		}
+		catch (...)
+		{
+			json_error_response (handler->response, "Internal server error in RPC");
+		}
+	}
+	else
+	{
+		handler->ec = nano::error_rpc::batch_action_not_allowed;
+		handler->response_errors ();
+	}
+	return result;
+}
+
 void nano::json_handler::block_info ()
 {
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		auto block (node.store.block_get (transaction, hash));
 		if (block != nullptr)
 		{
@@ -1024,6 +1433,7 @@ void nano::json_handler::block_info ()
 				auto subtype (nano::state_subtype (block->sideband ().details));
 				response_l.put ("subtype", subtype);
 			}
+			cache_accounts.push_back (account);
 		}
 		else
 		{
@@ -1083,7 +1493,7 @@ void nano::json_handler::blocks ()
 {
 	const bool json_block_l = request.get<bool> ("json_block", false);
 	boost::property_tree::ptree blocks;
-	auto transaction (node.store.tx_begin_read ());
+	auto transaction (tx_begin_read ());
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
 		if (!ec)
@@ -1132,7 +1542,7 @@ void nano::json_handler::blocks_info ()
 
 	boost::property_tree::ptree blocks;
 	boost::property_tree::ptree blocks_not_found;
-	auto transaction (node.store.tx_begin_read ());
+	auto transaction (tx_begin_read ());
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
 		if (!ec)
@@ -1232,7 +1642,7 @@ void nano::json_handler::block_account ()
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		if (node.store.block_exists (transaction, hash))
 		{
 			auto account (node.ledger.account (transaction, hash));
@@ -1743,26 +2153,36 @@ void nano::json_handler::chain (bool successors)
 	{
 		boost::property_tree::ptree blocks;
 		auto transaction (node.store.tx_begin_read ());
-		while (!hash.is_zero () && blocks.size () < count)
+		auto block (node.store.block_get (transaction, hash));
+		if (block != nullptr && successors)
 		{
-			auto block_l (node.store.block_get (transaction, hash));
-			if (block_l != nullptr)
+			// Successors are adjacent in the heights index, no block needs reading
+			auto account (block->account ().is_zero () ? block->sideband ().account : block->account ());
+			auto height (block->sideband ().height);
+			if (offset < std::numeric_limits<uint64_t>::max () - height)
 			{
-				if (offset > 0)
-				{
-					--offset;
-				}
-				else
+				for (auto i (node.store.heights_begin (transaction, nano::account_height_key (account, height + offset))), n (node.store.heights_end ()); i != n && i->first.account == account && blocks.size () < count; ++i)
 				{
 					boost::property_tree::ptree entry;
-					entry.put ("", hash.to_string ());
+					entry.put ("", nano::block_hash (i->second).to_string ());
 					blocks.push_back (std::make_pair ("", entry));
 				}
-				hash = successors ? node.store.block_successor (transaction, hash) : block_l->previous ();
 			}
-			else
+		}
+		else if (block != nullptr)
+		{
+			if (offset > 0)
+			{
+				hash = chain_offset (node, transaction, *block, offset, false);
+				block = node.store.block_get (transaction, hash);
+			}
+			while (block != nullptr && blocks.size () < count)
 			{
-				hash.clear ();
+				boost::property_tree::ptree entry;
+				entry.put ("", hash.to_string ());
+				blocks.push_back (std::make_pair ("", entry));
+				hash = block->previous ();
+				block = node.store.block_get (transaction, hash);
 			}
 		}
 		response_l.add_child ("blocks", blocks);
@@ -2007,25 +2427,72 @@ void nano::json_handler::database_txn_tracker ()
 
 void nano::json_handler::delegators ()
 {
-	auto account (account_impl ());
-	if (!ec)
+	// The cursor holds the representative and the first delegator not looked at
+	scan_cursor cursor (scan_cursor::scan::delegators);
+	boost::optional<std::string> cursor_text (request.get_optional<std::string> ("cursor"));
+	boost::optional<std::string> start_text;
+	if (cursor_text.is_initialized ())
 	{
-		boost::property_tree::ptree delegators;
-		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction)), n (node.store.latest_end ()); i != n; ++i)
+		if (cursor.decode (cursor_text.get ()))
 		{
-			nano::account_info const & info (i->second);
-			if (info.representative == account)
-			{
+			ec = nano::error_rpc::bad_cursor;
+		}
+	}
+	else
+	{
+		cursor.first.account = account_impl ();
+		start_text = request.get_optional<std::string> ("start");
+		if (!ec && start_text.is_initialized ())
+		{
+			cursor.second.account = account_impl (start_text.get ());
+		}
+	}
+	auto count (count_optional_impl ());
+	if (!ec)
+	{
+		auto skip_start (start_text.is_initialized ());
+		uint64_t written (0);
+		scan_budget budget (node_rpc_config.scan_time_budget);
+		response_stream ("delegators", [this, cursor, count, skip_start, written, budget](nano::json_writer & writer_a) mutable {
+			budget.start ();
+			auto transaction (node.store.tx_begin_read ());
+			nano::account const & account (cursor.first.account);
+			// Delegators follow their representative in the index, paging resumes after the last account returned
+			auto i (node.store.delegators_begin (transaction, nano::delegator_key (account, cursor.second.account)));
+			auto n (node.store.delegators_end ());
+			for (; i != n && i->first.representative == account && written < count && writer_a.size () < node_rpc_config.response_chunk_size && !budget.spent (); ++i)
+			{
+				nano::account const & delegator (i->first.account);
+				nano::account_info info;
+				if ((skip_start && delegator == cursor.second.account) || node.store.account_get (transaction, delegator, info))
+				{
+					continue;
+				}
 				std::string balance;
 				nano::uint128_union (info.balance).encode_dec (balance);
-				nano::account const & account (i->first);
-				delegators.put (account.to_account (), balance);
+				writer_a.put (delegator.to_account (), balance);
+				++written;
 			}
-		}
-		response_l.add_child ("delegators", delegators);
+			budget.stop ();
+			auto finished (i == n || i->first.representative != account);
+			if (!finished)
+			{
+				// Resume at the first delegator not looked at
+				cursor.second.account = i->first.account;
+				skip_start = false;
+			}
+			auto done (finished || written >= count || budget.expired);
+			if (done && !finished)
+			{
+				put_cursor (writer_a, cursor);
+			}
+			return done;
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::delegators_count ()
@@ -2035,13 +2502,9 @@ void nano::json_handler::delegators_count ()
 	{
 		uint64_t count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction)), n (node.store.latest_end ()); i != n; ++i)
+		for (auto i (node.store.delegators_begin (transaction, nano::delegator_key (account, 0))), n (node.store.delegators_end ()); i != n && i->first.representative == account; ++i)
 		{
-			nano::account_info const & info (i->second);
-			if (info.representative == account)
-			{
-				++count;
-			}
+			++count;
 		}
 		response_l.put ("count", std::to_string (count));
 	}
@@ -2140,19 +2603,50 @@ void nano::json_handler::epoch_upgrade ()
 
 void nano::json_handler::frontiers ()
 {
-	auto start (account_impl ());
-	auto count (count_impl ());
-	if (!ec)
+	scan_cursor cursor (scan_cursor::scan::frontiers);
+	boost::optional<std::string> cursor_text (request.get_optional<std::string> ("cursor"));
+	if (cursor_text.is_initialized ())
 	{
-		boost::property_tree::ptree frontiers;
-		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && frontiers.size () < count; ++i)
+		if (cursor.decode (cursor_text.get ()))
 		{
-			frontiers.put (i->first.to_account (), i->second.head.to_string ());
+			ec = nano::error_rpc::bad_cursor;
 		}
-		response_l.add_child ("frontiers", frontiers);
 	}
-	response_errors ();
+	else
+	{
+		cursor.first.account = account_impl ();
+	}
+	auto count (count_impl ());
+	if (!ec)
+	{
+		uint64_t written (0);
+		scan_budget budget (node_rpc_config.scan_time_budget);
+		response_stream ("frontiers", [this, cursor, count, written, budget](nano::json_writer & writer_a) mutable {
+			budget.start ();
+			auto transaction (node.store.tx_begin_read ());
+			auto i (node.store.latest_begin (transaction, cursor.first.account));
+			auto n (node.store.latest_end ());
+			for (; i != n && written < count && writer_a.size () < node_rpc_config.response_chunk_size && !budget.spent (); ++i, ++written)
+			{
+				writer_a.put (i->first.to_account (), i->second.head.to_string ());
+			}
+			budget.stop ();
+			auto done (i == n || written >= count || budget.expired);
+			if (i != n)
+			{
+				cursor.first.account = i->first;
+			}
+			if (done && i != n)
+			{
+				put_cursor (writer_a, cursor);
+			}
+			return done;
+		});
+	}
+	else
+	{
+		response_errors ();
+	}
 }
 
 void nano::json_handler::account_count ()
@@ -2401,30 +2895,28 @@ void nano::json_handler::account_history ()
 		bool output_raw (request.get_optional<bool> ("raw") == true);
 		response_l.put ("account", account.to_account ());
 		auto block (node.store.block_get (transaction, hash));
+		if (block != nullptr && offset > 0)
+		{
+			hash = chain_offset (node, transaction, *block, offset, reverse);
+			block = node.store.block_get (transaction, hash);
+		}
 		while (block != nullptr && count > 0)
 		{
-			if (offset > 0)
-			{
-				--offset;
-			}
-			else
-			{
-				boost::property_tree::ptree entry;
-				history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter);
-				block->visit (visitor);
-				if (!entry.empty ())
+			boost::property_tree::ptree entry;
+			history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter);
+			block->visit (visitor);
+			if (!entry.empty ())
+			{
+				entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
+				entry.put ("height", std::to_string (block->sideband ().height));
+				entry.put ("hash", hash.to_string ());
+				if (output_raw)
 				{
-					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
-					entry.put ("height", std::to_string (block->sideband ().height));
-					entry.put ("hash", hash.to_string ());
-					if (output_raw)
-					{
-						entry.put ("work", nano::to_string_hex (block->block_work ()));
-						entry.put ("signature", block->block_signature ().to_string ());
-					}
-					history.push_back (std::make_pair ("", entry));
-					--count;
+					entry.put ("work", nano::to_string_hex (block->block_work ()));
+					entry.put ("signature", block->block_signature ().to_string ());
 				}
+				history.push_back (std::make_pair ("", entry));
+				--count;
 			}
 			hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
 			block = node.store.block_get (transaction, hash);
@@ -2487,125 +2979,153 @@ void nano::json_handler::key_expand ()
 
 void nano::json_handler::ledger ()
 {
+	uint8_t constexpr representative_flag = 1;
+	uint8_t constexpr weight_flag = 2;
+	uint8_t constexpr pending_flag = 4;
 	auto count (count_optional_impl ());
-	auto threshold (threshold_optional_impl ());
-	if (!ec)
+	scan_cursor cursor (scan_cursor::scan::ledger);
+	auto sorting (false);
+	boost::optional<std::string> cursor_text (request.get_optional<std::string> ("cursor"));
+	if (cursor_text.is_initialized ())
+	{
+		if (!ec && cursor.decode (cursor_text.get ()))
+		{
+			ec = nano::error_rpc::bad_cursor;
+		}
+	}
+	else
 	{
-		nano::account start (0);
+		cursor.threshold = threshold_optional_impl ();
 		boost::optional<std::string> account_text (request.get_optional<std::string> ("account"));
-		if (account_text.is_initialized ())
+		if (!ec && account_text.is_initialized ())
 		{
-			start = account_impl (account_text.get ());
+			cursor.first.account = account_impl (account_text.get ());
 		}
-		uint64_t modified_since (0);
 		boost::optional<std::string> modified_since_text (request.get_optional<std::string> ("modified_since"));
-		if (modified_since_text.is_initialized ())
+		if (!ec && modified_since_text.is_initialized ())
 		{
-			if (decode_unsigned (modified_since_text.get (), modified_since))
+			if (decode_unsigned (modified_since_text.get (), cursor.modified_since))
+			{
+				ec = nano::error_rpc::invalid_timestamp;
+			}
+		}
+		// Sorted scans collect every account before writing and give no cursor
+		sorting = request.get<bool> ("sorting", false);
+		cursor.flags |= request.get<bool> ("representative", false) ? representative_flag : 0;
+		cursor.flags |= request.get<bool> ("weight", false) ? weight_flag : 0;
+		cursor.flags |= request.get<bool> ("pending", false) ? pending_flag : 0;
+	}
+	if (!ec)
+	{
+		const bool representative = (cursor.flags & representative_flag) != 0;
+		const bool weight = (cursor.flags & weight_flag) != 0;
+		const bool pending = (cursor.flags & pending_flag) != 0;
+		auto const threshold (cursor.threshold);
+		auto const start (cursor.first.account);
+		auto const modified_since (cursor.modified_since);
+		// Writes the entry of an account if it meets the threshold, returns true if it was written
+		auto entry ([this, threshold, representative, weight, pending](nano::json_writer & writer_a, nano::transaction const & transaction_a, nano::account const & account_a, nano::account_info const & info_a) {
+			boost::optional<nano::uint128_t> account_pending;
+			if (pending)
+			{
+				account_pending = node.ledger.account_pending (transaction_a, account_a);
+			}
+			auto result (info_a.balance.number () + account_pending.value_or (0) >= threshold.number ());
+			if (result)
 			{
-				ec = nano::error_rpc::invalid_timestamp;
+				writer_a.begin_object (account_a.to_account ());
+				if (pending)
+				{
+					writer_a.put ("pending", account_pending->convert_to<std::string> ());
+				}
+				writer_a.put ("frontier", info_a.head.to_string ());
+				writer_a.put ("open_block", info_a.open_block.to_string ());
+				writer_a.put ("representative_block", node.ledger.representative (transaction_a, info_a.head).to_string ());
+				std::string balance;
+				nano::uint128_union (info_a.balance).encode_dec (balance);
+				writer_a.put ("balance", balance);
+				writer_a.put ("modified_timestamp", std::to_string (info_a.modified));
+				writer_a.put ("block_count", std::to_string (info_a.block_count));
+				if (representative)
+				{
+					writer_a.put ("representative", info_a.representative.to_account ());
+				}
+				if (weight)
+				{
+					auto account_weight (node.ledger.weight (account_a));
+					writer_a.put ("weight", account_weight.convert_to<std::string> ());
+				}
+				writer_a.end ();
 			}
-		}
-		const bool sorting = request.get<bool> ("sorting", false);
-		const bool representative = request.get<bool> ("representative", false);
-		const bool weight = request.get<bool> ("weight", false);
-		const bool pending = request.get<bool> ("pending", false);
-		boost::property_tree::ptree accounts;
-		auto transaction (node.store.tx_begin_read ());
-		if (!ec && !sorting) // Simple
+			return result;
+		});
+		uint64_t written (0);
+		if (!sorting) // Simple
 		{
-			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && accounts.size () < count; ++i)
-			{
-				nano::account_info const & info (i->second);
-				if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
+			scan_budget budget (node_rpc_config.scan_time_budget);
+			response_stream ("accounts", [this, entry, cursor, count, written, budget](nano::json_writer & writer_a) mutable {
+				budget.start ();
+				auto transaction (node.store.tx_begin_read ());
+				auto i (node.store.latest_begin (transaction, cursor.first.account));
+				auto n (node.store.latest_end ());
+				for (; i != n && written < count && writer_a.size () < node_rpc_config.response_chunk_size && !budget.spent (); ++i)
 				{
-					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
-					if (pending)
-					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
+					nano::account_info const & info (i->second);
+					if (info.modified >= cursor.modified_since && entry (writer_a, transaction, i->first, info))
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						++written;
 					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
 				}
-			}
+				budget.stop ();
+				auto done (i == n || written >= count || budget.expired);
+				if (i != n)
+				{
+					cursor.first.account = i->first;
+				}
+				if (done && i != n)
+				{
+					put_cursor (writer_a, cursor);
+				}
+				return done;
+			});
 		}
-		else if (!ec) // Sorting
+		else // Sorting
 		{
-			std::vector<std::pair<nano::uint128_union, nano::account>> ledger_l;
-			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n; ++i)
+			// Sort keys are collected up front, entries are then written in parts
+			auto ledger_l (std::make_shared<std::vector<std::pair<nano::uint128_union, nano::account>>> ());
 			{
-				nano::account_info const & info (i->second);
-				nano::uint128_union balance (info.balance);
-				if (info.modified >= modified_since)
+				auto transaction (node.store.tx_begin_read ());
+				for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n; ++i)
 				{
-					ledger_l.emplace_back (balance, i->first);
+					nano::account_info const & info (i->second);
+					nano::uint128_union balance (info.balance);
+					if (info.modified >= modified_since)
+					{
+						ledger_l->emplace_back (balance, i->first);
+					}
 				}
 			}
-			std::sort (ledger_l.begin (), ledger_l.end ());
-			std::reverse (ledger_l.begin (), ledger_l.end ());
-			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
-			{
-				node.store.account_get (transaction, i->second, info);
-				if (pending || info.balance.number () >= threshold.number ())
+			std::sort (ledger_l->begin (), ledger_l->end ());
+			std::reverse (ledger_l->begin (), ledger_l->end ());
+			size_t index (0);
+			response_stream ("accounts", [this, entry, ledger_l, count, index, written](nano::json_writer & writer_a) mutable {
+				auto transaction (node.store.tx_begin_read ());
+				for (; index < ledger_l->size () && written < count && writer_a.size () < node_rpc_config.response_chunk_size; ++index)
 				{
-					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
-					if (pending)
-					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						response_a.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
+					nano::account_info info;
+					if (!node.store.account_get (transaction, (*ledger_l)[index].second, info) && entry (writer_a, transaction, (*ledger_l)[index].second, info))
 					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						++written;
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
 				}
-			}
+				return index == ledger_l->size () || written >= count;
+			});
 		}
-		response_l.add_child ("accounts", accounts);
 	}
-	response_errors ();
+	else
+	{
+		response_errors ();
+	}
 }
 
 void nano::json_handler::mnano_from_raw (nano::uint128_t ratio)
@@ -2771,10 +3291,8 @@ void nano::json_handler::pending ()
 	{
 		boost::property_tree::ptree peers_l;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.pending_begin (transaction, nano::pending_key (account, 0))), n (node.store.pending_end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
-		{
-			nano::pending_key const & key (i->first);
-			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+		pending_for_each (node, transaction, account, sorting || !threshold.is_zero (), threshold.number (), [&](nano::pending_key const & key, nano::pending_info const & info) {
+			if (peers_l.size () < count && block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 			{
 				if (simple)
 				{
@@ -2782,48 +3300,27 @@ void nano::json_handler::pending ()
 					entry.put ("", key.hash.to_string ());
 					peers_l.push_back (std::make_pair ("", entry));
 				}
-				else
+				else if (source || min_version)
 				{
-					nano::pending_info const & info (i->second);
-					if (info.amount.number () >= threshold.number ())
+					boost::property_tree::ptree pending_tree;
+					pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+					if (source)
 					{
-						if (source || min_version)
-						{
-							boost::property_tree::ptree pending_tree;
-							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-							if (source)
-							{
-								pending_tree.put ("source", info.source.to_account ());
-							}
-							if (min_version)
-							{
-								pending_tree.put ("min_version", epoch_as_string (info.epoch));
-							}
-							peers_l.add_child (key.hash.to_string (), pending_tree);
-						}
-						else
-						{
-							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-						}
+						pending_tree.put ("source", info.source.to_account ());
 					}
+					if (min_version)
+					{
+						pending_tree.put ("min_version", epoch_as_string (info.epoch));
+					}
+					peers_l.add_child (key.hash.to_string (), pending_tree);
+				}
+				else
+				{
+					peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 				}
 			}
-		}
-		if (sorting && !simple)
-		{
-			if (source || min_version)
-			{
-				peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-					return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
-				});
-			}
-			else
-			{
-				peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-					return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
-				});
-			}
-		}
+			return peers_l.size () < count;
+		});
 		response_l.add_child ("blocks", peers_l);
 	}
 	response_errors ();
@@ -2836,7 +3333,7 @@ void nano::json_handler::pending_exists ()
 	const bool include_only_confirmed = request.get<bool> ("include_only_confirmed", false);
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (tx_begin_read ());
 		auto block (node.store.block_get (transaction, hash));
 		if (block != nullptr)
 		{
@@ -2848,6 +3345,12 @@ void nano::json_handler::pending_exists ()
 			}
 			exists = exists && (block_confirmed (node, transaction, block->hash (), include_active, include_only_confirmed));
 			response_l.put ("exists", exists ? "1" : "0");
+			if (include_active || include_only_confirmed)
+			{
+				// Otherwise the response depends on active elections
+				cache_accounts.push_back (block->account ().is_zero () ? block->sideband ().account : block->account ());
+				cache_accounts.push_back (destination);
+			}
 		}
 		else
 		{
@@ -3282,43 +3785,40 @@ void nano::json_handler::representatives ()
 	if (!ec)
 	{
 		const bool sorting = request.get<bool> ("sorting", false);
-		boost::property_tree::ptree representatives;
 		auto rep_amounts = node.ledger.cache.rep_weights.get_rep_amounts ();
+		auto representation (std::make_shared<std::vector<std::pair<nano::uint128_t, nano::account>>> ());
+		representation->reserve (rep_amounts.size ());
 		if (!sorting) // Simple
 		{
 			std::map<nano::account, nano::uint128_t> ordered (rep_amounts.begin (), rep_amounts.end ());
-			for (auto & rep_amount : rep_amounts)
+			for (auto & rep_amount : ordered)
 			{
-				auto const & account (rep_amount.first);
-				auto const & amount (rep_amount.second);
-				representatives.put (account.to_account (), amount.convert_to<std::string> ());
-
-				if (representatives.size () > count)
-				{
-					break;
-				}
+				representation->emplace_back (rep_amount.second, rep_amount.first);
 			}
 		}
 		else // Sorting
 		{
-			std::vector<std::pair<nano::uint128_t, std::string>> representation;
-
 			for (auto & rep_amount : rep_amounts)
 			{
-				auto const & account (rep_amount.first);
-				auto const & amount (rep_amount.second);
-				representation.emplace_back (amount, account.to_account ());
+				representation->emplace_back (rep_amount.second, rep_amount.first);
 			}
-			std::sort (representation.begin (), representation.end ());
-			std::reverse (representation.begin (), representation.end ());
-			for (auto i (representation.begin ()), n (representation.end ()); i != n && representatives.size () < count; ++i)
+			std::sort (representation->begin (), representation->end ());
+			std::reverse (representation->begin (), representation->end ());
+		}
+		size_t index (0);
+		response_stream ("representatives", [this, representation, count, index](nano::json_writer & writer_a) mutable {
+			for (; index < representation->size () && index < count && writer_a.size () < node_rpc_config.response_chunk_size; ++index)
 			{
-				representatives.put (i->second, (i->first).convert_to<std::string> ());
+				auto const & rep ((*representation)[index]);
+				writer_a.put (rep.second.to_account (), rep.first.convert_to<std::string> ());
 			}
-		}
-		response_l.add_child ("representatives", representatives);
+			return index >= representation->size () || index >= count;
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::representatives_online ()
@@ -3912,27 +4412,57 @@ void nano::json_handler::unchecked ()
 	auto count (count_optional_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree unchecked;
-		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
-			nano::unchecked_info const & info (i->second);
-			if (json_block_l)
+		boost::optional<nano::unchecked_key> next;
+		uint64_t written_count (0);
+		// Blocks unchecked under several dependencies are written once as text, at their lowest key, as ptree::put replaced them
+		response_stream ("blocks", [this, json_block_l, count, next, written_count](nano::json_writer & writer_a) mutable {
+			auto transaction (node.store.tx_begin_read ());
+			auto i (next ? node.store.unchecked_begin (transaction, *next) : node.store.unchecked_begin (transaction));
+			auto n (node.store.unchecked_end ());
+			for (; i != n && written_count < count && writer_a.size () < node_rpc_config.response_chunk_size; ++i)
 			{
-				boost::property_tree::ptree block_node_l;
-				info.block->serialize_json (block_node_l);
-				unchecked.add_child (info.block->hash ().to_string (), block_node_l);
+				nano::unchecked_info const & info (i->second);
+				auto hash (info.block->hash ());
+				if (json_block_l)
+				{
+					boost::property_tree::ptree block_node_l;
+					info.block->serialize_json (block_node_l);
+					writer_a.put_child (hash.to_string (), block_node_l);
+					++written_count;
+				}
+				else if (!unchecked_seen (transaction, i->first, *info.block))
+				{
+					std::string contents;
+					info.block->serialize_json (contents);
+					writer_a.put (hash.to_string (), contents);
+					++written_count;
+				}
 			}
-			else
+			auto done (i == n || written_count >= count);
+			if (!done)
 			{
-				std::string contents;
-				info.block->serialize_json (contents);
-				unchecked.put (info.block->hash ().to_string (), contents);
+				next = i->first;
 			}
+			return done;
+		});
+	}
+	else
+	{
+		response_errors ();
+	}
+}
+
+bool nano::json_handler::unchecked_seen (nano::transaction const & transaction_a, nano::unchecked_key const & key_a, nano::block const & block_a)
+{
+	auto seen (false);
+	for (auto const & dependency : { block_a.previous (), node.ledger.block_source (transaction_a, block_a) })
+	{
+		if (!seen && !dependency.is_zero () && dependency < key_a.previous)
+		{
+			seen = node.store.unchecked_exists (transaction_a, nano::unchecked_key (dependency, key_a.hash));
 		}
-		response_l.add_child ("blocks", unchecked);
 	}
-	response_errors ();
+	return seen;
 }
 
 void nano::json_handler::unchecked_clear ()
@@ -3986,22 +4516,39 @@ void nano::json_handler::unchecked_get ()
 
 void nano::json_handler::unchecked_keys ()
 {
-	const bool json_block_l = request.get<bool> ("json_block", false);
+	uint8_t constexpr json_block_flag = 1;
 	auto count (count_optional_impl ());
-	nano::block_hash key (0);
-	boost::optional<std::string> hash_text (request.get_optional<std::string> ("key"));
-	if (!ec && hash_text.is_initialized ())
+	// The cursor holds the unchecked key to resume at
+	scan_cursor cursor (scan_cursor::scan::unchecked_keys);
+	boost::optional<std::string> cursor_text (request.get_optional<std::string> ("cursor"));
+	if (cursor_text.is_initialized ())
+	{
+		if (!ec && cursor.decode (cursor_text.get ()))
+		{
+			ec = nano::error_rpc::bad_cursor;
+		}
+	}
+	else
 	{
-		if (key.decode_hex (hash_text.get ()))
+		cursor.flags = request.get<bool> ("json_block", false) ? json_block_flag : 0;
+		boost::optional<std::string> hash_text (request.get_optional<std::string> ("key"));
+		if (!ec && hash_text.is_initialized ())
 		{
-			ec = nano::error_rpc::bad_key;
+			if (cursor.first.hash.decode_hex (hash_text.get ()))
+			{
+				ec = nano::error_rpc::bad_key;
+			}
 		}
 	}
 	if (!ec)
 	{
+		const bool json_block_l = (cursor.flags & json_block_flag) != 0;
 		boost::property_tree::ptree unchecked;
+		scan_budget budget (node_rpc_config.scan_time_budget);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction, nano::unchecked_key (key, 0))), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
+		auto i (node.store.unchecked_begin (transaction, nano::unchecked_key (cursor.first.hash, cursor.second.hash)));
+		auto n (node.store.unchecked_end ());
+		for (; i != n && unchecked.size () < count && !budget.spent (); ++i)
 		{
 			boost::property_tree::ptree entry;
 			nano::unchecked_info const & info (i->second);
@@ -4023,6 +4570,12 @@ void nano::json_handler::unchecked_keys ()
 			unchecked.push_back (std::make_pair ("", entry));
 		}
 		response_l.add_child ("unchecked", unchecked);
+		if (i != n)
+		{
+			cursor.first.hash = i->first.previous;
+			cursor.second.hash = i->first.hash;
+			response_l.put ("cursor", cursor.encode ());
+		}
 	}
 	response_errors ();
 }
@@ -4030,30 +4583,55 @@ void nano::json_handler::unchecked_keys ()
 void nano::json_handler::unopened ()
 {
 	auto count (count_optional_impl ());
-	auto threshold (threshold_optional_impl ());
-	nano::account start (1); // exclude burn account by default
-	boost::optional<std::string> account_text (request.get_optional<std::string> ("account"));
-	if (account_text.is_initialized ())
+	// The cursor holds the first account not summed up and the threshold
+	scan_cursor cursor (scan_cursor::scan::unopened);
+	boost::optional<std::string> cursor_text (request.get_optional<std::string> ("cursor"));
+	if (cursor_text.is_initialized ())
+	{
+		if (!ec && cursor.decode (cursor_text.get ()))
+		{
+			ec = nano::error_rpc::bad_cursor;
+		}
+	}
+	else
 	{
-		start = account_impl (account_text.get ());
+		cursor.threshold = threshold_optional_impl ();
+		cursor.first.account = 1; // exclude burn account by default
+		boost::optional<std::string> account_text (request.get_optional<std::string> ("account"));
+		if (account_text.is_initialized ())
+		{
+			cursor.first.account = account_impl (account_text.get ());
+		}
 	}
 	if (!ec)
 	{
+		auto const & threshold (cursor.threshold);
+		auto const start (cursor.first.account);
+		scan_budget budget (node_rpc_config.scan_time_budget);
 		auto transaction (node.store.tx_begin_read ());
 		auto iterator (node.store.pending_begin (transaction, nano::pending_key (start, 0)));
 		auto end (node.store.pending_end ());
 		nano::account current_account (start);
 		nano::uint128_t current_account_sum{ 0 };
+		auto last (false);
+		auto stopped (false);
 		boost::property_tree::ptree accounts;
 		while (iterator != end && accounts.size () < count)
 		{
 			nano::pending_key key (iterator->first);
 			nano::account account (key.account);
 			nano::pending_info info (iterator->second);
+			// Time is only checked between accounts, every account is added up within one call
+			if (account != current_account && budget.spent ())
+			{
+				stopped = true;
+				break;
+			}
 			if (node.store.account_exists (transaction, account))
 			{
 				if (account.number () == std::numeric_limits<nano::uint256_t>::max ())
 				{
+					last = true;
 					break;
 				}
 				// Skip existing accounts
@@ -4077,12 +4655,31 @@ void nano::json_handler::unopened ()
 				++iterator;
 			}
 		}
-		// last one after iterator reaches end
-		if (accounts.size () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
+		auto finished (iterator == end || last);
+		// last one after iterator reaches end or after the time ran out, without room for it the next call starts with it
+		if ((finished || stopped) && current_account_sum > 0)
 		{
-			accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+			if (current_account_sum < threshold.number ())
+			{
+				current_account_sum = 0;
+			}
+			else if (accounts.size () < count)
+			{
+				accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+				current_account_sum = 0;
+			}
+			else
+			{
+				finished = false;
+			}
 		}
 		response_l.add_child ("accounts", accounts);
+		if (!finished)
+		{
+			// A partial sum is dropped, the next call adds up all pending entries of that account
+			cursor.first.account = current_account_sum > 0 ? current_account : nano::account (iterator->first.account);
+			response_l.put ("cursor", cursor.encode ());
+		}
 	}
 	response_errors ();
 }
@@ -4478,47 +5075,59 @@ void nano::json_handler::wallet_ledger ()
 	auto wallet (wallet_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree accounts;
-		auto transaction (node.wallets.tx_begin_read ());
-		auto block_transaction (node.store.tx_begin_read ());
-		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
-		{
-			nano::account const & account (i->first);
-			nano::account_info info;
-			if (!node.store.account_get (block_transaction, account, info))
+		boost::optional<nano::account> next;
+		response_stream ("accounts", [this, wallet, representative, weight, pending, modified_since, next](nano::json_writer & writer_a) mutable {
+			auto transaction (node.wallets.tx_begin_read ());
+			auto block_transaction (node.store.tx_begin_read ());
+			auto i (next ? wallet->store.begin (transaction, *next) : wallet->store.begin (transaction));
+			auto n (wallet->store.end ());
+			for (; i != n && writer_a.size () < node_rpc_config.response_chunk_size; ++i)
 			{
-				if (info.modified >= modified_since)
+				nano::account const & account (i->first);
+				nano::account_info info;
+				if (!node.store.account_get (block_transaction, account, info))
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("frontier", info.head.to_string ());
-					entry.put ("open_block", info.open_block.to_string ());
-					entry.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					entry.put ("balance", balance);
-					entry.put ("modified_timestamp", std::to_string (info.modified));
-					entry.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						entry.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						entry.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					if (pending)
+					if (info.modified >= modified_since)
 					{
-						auto account_pending (node.ledger.account_pending (block_transaction, account));
-						entry.put ("pending", account_pending.convert_to<std::string> ());
+						writer_a.begin_object (account.to_account ());
+						writer_a.put ("frontier", info.head.to_string ());
+						writer_a.put ("open_block", info.open_block.to_string ());
+						writer_a.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
+						std::string balance;
+						nano::uint128_union (info.balance).encode_dec (balance);
+						writer_a.put ("balance", balance);
+						writer_a.put ("modified_timestamp", std::to_string (info.modified));
+						writer_a.put ("block_count", std::to_string (info.block_count));
+						if (representative)
+						{
+							writer_a.put ("representative", info.representative.to_account ());
+						}
+						if (weight)
+						{
+							auto account_weight (node.ledger.weight (account));
+							writer_a.put ("weight", account_weight.convert_to<std::string> ());
+						}
+						if (pending)
+						{
+							auto account_pending (node.ledger.account_pending (block_transaction, account));
+							writer_a.put ("pending", account_pending.convert_to<std::string> ());
+						}
+						writer_a.end ();
 					}
-					accounts.push_back (std::make_pair (account.to_account (), entry));
 				}
 			}
-		}
-		response_l.add_child ("accounts", accounts);
+			auto done (i == n);
+			if (!done)
+			{
+				next = i->first;
+			}
+			return done;
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::wallet_lock ()
@@ -4553,10 +5162,8 @@ void nano::json_handler::wallet_pending ()
 		{
 			nano::account const & account (i->first);
 			boost::property_tree::ptree peers_l;
-			for (auto ii (node.store.pending_begin (block_transaction, nano::pending_key (account, 0))), nn (node.store.pending_end ()); ii != nn && nano::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
-			{
-				nano::pending_key key (ii->first);
-				if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
+			pending_for_each (node, block_transaction, account, !threshold.is_zero (), threshold.number (), [&](nano::pending_key const & key, nano::pending_info const & info) {
+				if (peers_l.size () < count && block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
 				{
 					if (threshold.is_zero () && !source)
 					{
@@ -4564,33 +5171,27 @@ void nano::json_handler::wallet_pending ()
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
-					else
+					else if (source || min_version)
 					{
-						nano::pending_info info (ii->second);
-						if (info.amount.number () >= threshold.number ())
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						if (source)
 						{
-							if (source || min_version)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								if (source)
-								{
-									pending_tree.put ("source", info.source.to_account ());
-								}
-								if (min_version)
-								{
-									pending_tree.put ("min_version", epoch_as_string (info.epoch));
-								}
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							pending_tree.put ("source", info.source.to_account ());
 						}
+						if (min_version)
+						{
+							pending_tree.put ("min_version", epoch_as_string (info.epoch));
+						}
+						peers_l.add_child (key.hash.to_string (), pending_tree);
+					}
+					else
+					{
+						peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 					}
 				}
-			}
+				return peers_l.size () < count;
+			});
 			if (!peers_l.empty ())
 			{
 				pending.add_child (account.to_account (), peers_l);
@@ -4980,14 +5581,62 @@ void nano::json_handler::work_peers_clear ()
 	response_errors ();
 }
 
-void nano::inprocess_rpc_handler::process_request (std::string const &, std::string const & body_a, std::function<void(std::string const &)> response_a)
+nano::inprocess_rpc_handler::inprocess_rpc_handler (nano::node & node_a, nano::ipc::ipc_server & ipc_server_a, nano::node_rpc_config const & node_rpc_config_a, std::function<void()> stop_callback_a) :
+node (node_a),
+ipc_server (ipc_server_a),
+stop_callback (stop_callback_a),
+node_rpc_config (node_rpc_config_a),
+executor_guard (boost::asio::make_work_guard (executor))
+{
+	for (auto i (0u); i < node_rpc_config.in_process_threads; ++i)
+	{
+		threads.emplace_back ([this]() {
+			nano::thread_role::set (nano::thread_role::name::rpc_in_process);
+			executor.run ();
+		});
+	}
+}
+
+nano::inprocess_rpc_handler::~inprocess_rpc_handler ()
+{
+	// Requests already queued are run before the threads exit
+	executor_guard.reset ();
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+}
+
+void nano::inprocess_rpc_handler::process_request (std::string const &, std::string const & body_a, std::function<void(std::string const &)> response_a, nano::rpc_response_part response_part_a)
 {
 	// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
 	auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, body_a, response_a, [this]() {
 		this->stop_callback ();
 		this->stop ();
 	}));
-	handler->process_request ();
+	if (threads.empty ())
+	{
+		handler->response_part = response_part_a;
+		handler->process_request ();
+	}
+	else
+	{
+		// Requests are handed to the executor directly, without the serialization and connection pool of the IPC path.
+		// Parts after the first are also produced by the executor rather than by the I/O thread which sent the previous one
+		if (response_part_a)
+		{
+			handler->response_part = [this, response_part_a](std::string const & part_a, std::function<void(bool)> const & next_a) {
+				response_part_a (part_a, [this, next_a](bool error_a) {
+					boost::asio::post (executor, [next_a, error_a]() {
+						next_a (error_a);
+					});
+				});
+			};
+		}
+		boost::asio::post (executor, [handler]() {
+			handler->process_request ();
+		});
+	}
 }
 
 void nano::inprocess_rpc_handler::process_request_v2 (rpc_handler_request_params const & params_a, std::string const & body_a, std::function<void(std::shared_ptr<std::string>)> response_a)
@@ -5048,6 +5697,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("accounts_pending", &nano::json_handler::accounts_pending);
 	no_arg_funcs.emplace ("active_difficulty", &nano::json_handler::active_difficulty);
 	no_arg_funcs.emplace ("available_supply", &nano::json_handler::available_supply);
+	no_arg_funcs.emplace ("batch", &nano::json_handler::batch);
 	no_arg_funcs.emplace ("block_info", &nano::json_handler::block_info);
 	no_arg_funcs.emplace ("block", &nano::json_handler::block_info);
 	no_arg_funcs.emplace ("block_confirm", &nano::json_handler::block_confirm);
@@ -5144,6 +5794,53 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	return no_arg_funcs;
 }
 
+/**
+ * Calls \p action for the pending entries of \p account with at least \p threshold until it returns false.
+ * Entries come in hash order, or from the pending amounts index largest amount first if \p by_amount is set,
+ * which ends the scan at the first entry below the threshold.
+ */
+void pending_for_each (nano::node & node, nano::transaction const & transaction, nano::account const & account, bool by_amount, nano::uint128_t const & threshold, std::function<bool(nano::pending_key const &, nano::pending_info const &)> const & action)
+{
+	if (by_amount)
+	{
+		auto more (true);
+		for (auto i (node.store.pending_amounts_begin (transaction, nano::pending_amount_key (account, std::numeric_limits<nano::uint128_t>::max (), 0))), n (node.store.pending_amounts_end ()); more && i != n && i->first.account == account && i->first.amount ().number () >= threshold; ++i)
+		{
+			nano::pending_key key (account, i->first.hash);
+			nano::pending_info info;
+			if (!node.store.pending_get (transaction, key, info))
+			{
+				more = action (key, info);
+			}
+		}
+	}
+	else
+	{
+		auto more (true);
+		for (auto i (node.store.pending_begin (transaction, nano::pending_key (account, 0))), n (node.store.pending_end ()); more && i != n && nano::pending_key (i->first).account == account; ++i)
+		{
+			nano::pending_info const & info (i->second);
+			if (info.amount.number () >= threshold)
+			{
+				more = action (i->first, info);
+			}
+		}
+	}
+}
+
+/** Hash of the block \p offset places after (\p successors) or before \p block in its account chain, zero past either end of the chain */
+nano::block_hash chain_offset (nano::node & node, nano::transaction const & transaction, nano::block const & block, uint64_t offset, bool successors)
+{
+	auto account (block.account ().is_zero () ? block.sideband ().account : block.account ());
+	auto height (block.sideband ().height);
+	nano::block_hash result (0);
+	if (successors ? offset < std::numeric_limits<uint64_t>::max () - height : offset < height)
+	{
+		result = node.store.block_at_height (transaction, account, successors ? height + offset : height - offset);
+	}
+	return result;
+}
+
 /** Due to the asynchronous nature of updating confirmation heights, it can also be necessary to check active roots */
 bool block_confirmed (nano::node & node, nano::transaction & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed)
 {
@@ -9,6 +9,8 @@
 
 #include <functional>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace nano
 {
@@ -16,6 +18,7 @@ namespace ipc
 {
 	class ipc_server;
 }
+class json_writer;
 class node;
 class node_rpc_config;
 
@@ -45,6 +48,7 @@ public:
 	void accounts_pending ();
 	void active_difficulty ();
 	void available_supply ();
+	void batch ();
 	void block_info ();
 	void block_confirm ();
 	void blocks ();
@@ -143,10 +147,35 @@ public:
 	nano::node & node;
 	boost::property_tree::ptree request;
 	std::function<void(std::string const &)> response;
+	/** Set when the response can be sent in parts, see response_stream */
+	nano::rpc_response_part response_part;
 	void response_errors ();
+	/**
+	 * Writes a response made of the object, or array if \p array_a, \p name_a, filled by calling \p step_a until it returns true.
+	 * Each step opens its own read transaction and stops once the writer holds response_chunk_size bytes,
+	 * which are sent as a part before the next step if response_part is set.
+	 */
+	void response_stream (std::string const & name_a, std::function<bool(nano::json_writer &)> const & step_a, bool array_a = false);
+	void response_stream_part (std::shared_ptr<nano::json_writer> const &, std::shared_ptr<std::function<bool(nano::json_writer &)>> const &);
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
+	/** Set for cacheable requests, the response is cached by response_errors if the action filled cache_accounts */
+	std::string cache_key;
+	uint64_t cache_generation{ 0 };
+	/** Accounts the response depends on, leave empty if it depends on more than the ledger entries of these accounts */
+	std::vector<nano::account> cache_accounts;
+	bool response_cached ();
+	/** Set for the sub-requests of a batch, which all read through it */
+	std::shared_ptr<nano::read_transaction> batch_transaction;
+	/** Read transaction for actions allowed in a batch, reading through batch_transaction if set */
+	nano::read_transaction tx_begin_read ();
+	/** Runs a sub-request of a batch and returns its response */
+	std::string batch_response (boost::property_tree::ptree const &, std::shared_ptr<nano::read_transaction> const &);
+	/** Answers the hottest actions from the request text without property trees, returns true if it responded */
+	bool response_fast ();
+	/** Cleared to always use the general path, to compare both */
+	bool fast_path{ true };
 	std::shared_ptr<nano::wallet> wallet_impl ();
 	bool wallet_locked_impl (nano::transaction const &, std::shared_ptr<nano::wallet>);
 	bool wallet_account_impl (nano::transaction const &, std::shared_ptr<nano::wallet>, nano::account const &);
@@ -162,6 +191,8 @@ public:
 	uint64_t offset_optional_impl (uint64_t = 0);
 	uint64_t difficulty_optional_impl (nano::work_version const);
 	uint64_t difficulty_ledger (nano::block const &);
+	/** True if the block is also unchecked under a dependency ordered before \p key_a, so unchecked writes it once */
+	bool unchecked_seen (nano::transaction const &, nano::unchecked_key const & key_a, nano::block const &);
 	double multiplier_optional_impl (nano::work_version const, uint64_t &);
 	nano::work_version work_version_optional_impl (nano::work_version const default_a);
 	bool enable_sign_hash{ false };
@@ -174,15 +205,10 @@ class inprocess_rpc_handler final : public nano::rpc_handler_interface
 {
 public:
 	inprocess_rpc_handler (
-	nano::node & node_a, nano::ipc::ipc_server & ipc_server_a, nano::node_rpc_config const & node_rpc_config_a, std::function<void()> stop_callback_a = []() {}) :
-	node (node_a),
-	ipc_server (ipc_server_a),
-	stop_callback (stop_callback_a),
-	node_rpc_config (node_rpc_config_a)
-	{
-	}
+	nano::node & node_a, nano::ipc::ipc_server & ipc_server_a, nano::node_rpc_config const & node_rpc_config_a, std::function<void()> stop_callback_a = []() {});
+	~inprocess_rpc_handler ();
 
-	void process_request (std::string const &, std::string const & body_a, std::function<void(std::string const &)> response_a) override;
+	void process_request (std::string const &, std::string const & body_a, std::function<void(std::string const &)> response_a, nano::rpc_response_part response_part_a) override;
 	void process_request_v2 (rpc_handler_request_params const & params_a, std::string const & body_a, std::function<void(std::shared_ptr<std::string>)> response_a) override;
 
 	void stop () override
@@ -204,5 +230,9 @@ private:
 	boost::optional<nano::rpc &> rpc;
 	std::function<void()> stop_callback;
 	nano::node_rpc_config const & node_rpc_config;
+	/** Runs requests when node_rpc_config.in_process_threads is set */
+	boost::asio::io_context executor;
+	boost::asio::executor_work_guard<boost::asio::io_context::executor_type> executor_guard;
+	std::vector<std::thread> threads;
 };
 }
@@ -0,0 +1,306 @@
+#include <kizunano/node/ledger_snapshot.hpp>
+#include <kizunano/secure/bulk_writer.hpp>
+#include <kizunano/secure/common.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <istream>
+#include <ostream>
+
+#if NANO_ZSTD
+#include <zstd.h>
+#endif
+
+std::array<nano::tables, 15> const nano::ledger_snapshot::tables{ { nano::tables::meta, nano::tables::accounts, nano::tables::frontiers, nano::tables::send_blocks, nano::tables::receive_blocks, nano::tables::open_blocks, nano::tables::change_blocks, nano::tables::state_blocks, nano::tables::pending, nano::tables::confirmation_height, nano::tables::online_weight, nano::tables::vote, nano::tables::delegators, nano::tables::pending_amounts, nano::tables::heights } };
+std::array<uint8_t, 4> const nano::ledger_snapshot::magic{ { 'k', 'l', 's', 's' } };
+constexpr uint8_t nano::ledger_snapshot::version;
+constexpr uint8_t nano::ledger_snapshot::flag_compressed;
+constexpr uint8_t nano::ledger_snapshot::end_of_tables;
+constexpr size_t nano::ledger_snapshot::frame_size;
+constexpr size_t nano::ledger_snapshot::frame_max;
+constexpr size_t nano::ledger_snapshot::load_size;
+
+namespace
+{
+uint64_t checksum (uint8_t const * data_a, size_t size_a)
+{
+	uint64_t result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result));
+	blake2b_update (&state, data_a, size_a);
+	blake2b_final (&state, &result, sizeof (result));
+	return result;
+}
+
+void write_u32 (std::ostream & stream_a, uint32_t value_a)
+{
+	boost::endian::native_to_little_inplace (value_a);
+	stream_a.write (reinterpret_cast<char const *> (&value_a), sizeof (value_a));
+}
+
+bool read_u32 (std::istream & stream_a, uint32_t & value_a)
+{
+	stream_a.read (reinterpret_cast<char *> (&value_a), sizeof (value_a));
+	boost::endian::little_to_native_inplace (value_a);
+	return !stream_a.good ();
+}
+
+void append_field (std::vector<uint8_t> & frame_a, uint8_t const * data_a, size_t size_a)
+{
+	auto size_l (boost::endian::native_to_little (static_cast<uint32_t> (size_a)));
+	auto size_bytes (reinterpret_cast<uint8_t const *> (&size_l));
+	frame_a.insert (frame_a.end (), size_bytes, size_bytes + sizeof (size_l));
+	frame_a.insert (frame_a.end (), data_a, data_a + size_a);
+}
+
+/** Points \p data_a into \p frame_a at the field starting at \p offset_a and moves past it, returns true if the field overruns the frame */
+bool read_field (std::vector<uint8_t> const & frame_a, size_t & offset_a, uint8_t const *& data_a, size_t & size_a)
+{
+	uint32_t size_l (0);
+	auto error (frame_a.size () - offset_a < sizeof (size_l));
+	if (!error)
+	{
+		std::copy (frame_a.data () + offset_a, frame_a.data () + offset_a + sizeof (size_l), reinterpret_cast<uint8_t *> (&size_l));
+		boost::endian::little_to_native_inplace (size_l);
+		offset_a += sizeof (size_l);
+		error = frame_a.size () - offset_a < size_l;
+		if (!error)
+		{
+			data_a = frame_a.data () + offset_a;
+			size_a = size_l;
+			offset_a += size_l;
+		}
+	}
+	return error;
+}
+
+int constexpr compression_level = 3;
+}
+
+nano::ledger_snapshot::ledger_snapshot (nano::block_store & store_a) :
+store (store_a)
+{
+#if NANO_ZSTD
+	compress_context = ZSTD_createCCtx ();
+	decompress_context = ZSTD_createDCtx ();
+#endif
+}
+
+nano::ledger_snapshot::~ledger_snapshot ()
+{
+#if NANO_ZSTD
+	ZSTD_freeCCtx (compress_context);
+	ZSTD_freeDCtx (decompress_context);
+#endif
+}
+
+bool nano::ledger_snapshot::export_tables (std::ostream & stream_a, bool compress_a)
+{
+	compressed = compress_a && compress_context != nullptr;
+	nano::network_params network_params;
+	auto transaction (store.tx_begin_read ());
+	stream_a.write (reinterpret_cast<char const *> (magic.data ()), magic.size ());
+	stream_a.put (static_cast<char> (version));
+	stream_a.put (static_cast<char> (compressed ? flag_compressed : 0));
+	write_u32 (stream_a, static_cast<uint32_t> (store.version_get (transaction)));
+	auto const & genesis_hash (network_params.ledger.genesis_hash);
+	stream_a.write (reinterpret_cast<char const *> (genesis_hash.bytes.data ()), genesis_hash.bytes.size ());
+	auto error (!stream_a.good ());
+	std::vector<uint8_t> frame;
+	for (uint8_t id (0); id < tables.size () && !error; ++id)
+	{
+		stream_a.put (static_cast<char> (id));
+		uint32_t count (0);
+		store.table_for_each (transaction, tables[id], [this, &stream_a, &frame, &count, &error](nano::store_entry_view const & entry_a) {
+			if (!error)
+			{
+				append_field (frame, entry_a.key, entry_a.key_size);
+				append_field (frame, entry_a.value, entry_a.value_size);
+				++count;
+				++entries;
+				if (frame.size () >= frame_size)
+				{
+					error = write_frame (stream_a, frame, count);
+					frame.clear ();
+					count = 0;
+				}
+			}
+		});
+		if (!error && count != 0)
+		{
+			error = write_frame (stream_a, frame, count);
+			frame.clear ();
+		}
+		if (!error)
+		{
+			error = write_frame (stream_a, frame, 0);
+		}
+	}
+	if (!error)
+	{
+		stream_a.put (static_cast<char> (end_of_tables));
+		error = !stream_a.good ();
+	}
+	if (error && error_message.empty ())
+	{
+		error_message = "Write error";
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::write_frame (std::ostream & stream_a, std::vector<uint8_t> const & frame_a, uint32_t count_a)
+{
+	auto error (false);
+	auto payload (frame_a.data ());
+	auto payload_size (frame_a.size ());
+#if NANO_ZSTD
+	if (compressed && !frame_a.empty ())
+	{
+		stored.resize (ZSTD_compressBound (frame_a.size ()));
+		auto size (ZSTD_compressCCtx (compress_context, stored.data (), stored.size (), frame_a.data (), frame_a.size (), compression_level));
+		error = ZSTD_isError (size);
+		payload = stored.data ();
+		payload_size = size;
+	}
+#endif
+	if (!error)
+	{
+		write_u32 (stream_a, count_a);
+		write_u32 (stream_a, static_cast<uint32_t> (frame_a.size ()));
+		write_u32 (stream_a, static_cast<uint32_t> (payload_size));
+		stream_a.write (reinterpret_cast<char const *> (payload), payload_size);
+		auto checksum_l (boost::endian::native_to_little (checksum (payload, payload_size)));
+		stream_a.write (reinterpret_cast<char const *> (&checksum_l), sizeof (checksum_l));
+		bytes += 3 * sizeof (uint32_t) + payload_size + sizeof (checksum_l);
+		error = !stream_a.good ();
+	}
+	else
+	{
+		error_message = "Compression error";
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::import_tables (std::istream & stream_a)
+{
+	nano::network_params network_params;
+	std::array<uint8_t, 4> magic_l;
+	uint8_t version_l (0);
+	uint8_t flags (0);
+	uint32_t store_version (0);
+	nano::block_hash genesis_hash;
+	stream_a.read (reinterpret_cast<char *> (magic_l.data ()), magic_l.size ());
+	stream_a.read (reinterpret_cast<char *> (&version_l), sizeof (version_l));
+	stream_a.read (reinterpret_cast<char *> (&flags), sizeof (flags));
+	auto error (read_u32 (stream_a, store_version));
+	stream_a.read (reinterpret_cast<char *> (genesis_hash.bytes.data ()), genesis_hash.bytes.size ());
+	error = error || !stream_a.good () || magic_l != magic || version_l != version;
+	compressed = (flags & flag_compressed) != 0;
+	auto current_version (store.version_get (store.tx_begin_read ()));
+	if (error)
+	{
+		error_message = "Not a ledger snapshot or unsupported version";
+	}
+	else if (genesis_hash != network_params.ledger.genesis_hash)
+	{
+		error = true;
+		error_message = "Ledger snapshot belongs to a different network";
+	}
+	else if (store_version != static_cast<uint32_t> (current_version))
+	{
+		error = true;
+		error_message = "Ledger snapshot of store version " + std::to_string (store_version) + ", this node uses version " + std::to_string (current_version);
+	}
+	else if (compressed && decompress_context == nullptr)
+	{
+		error = true;
+		error_message = "Ledger snapshot is compressed and the node was built without NANO_ZSTD";
+	}
+	bytes = magic.size () + 2 + sizeof (store_version) + genesis_hash.bytes.size ();
+	for (auto finished (false); !error && !finished;)
+	{
+		auto id (stream_a.get ());
+		finished = id == end_of_tables;
+		error = !stream_a.good () || (!finished && static_cast<size_t> (id) >= tables.size ());
+		++bytes;
+		if (error)
+		{
+			error_message = "Truncated snapshot or unknown table";
+		}
+		else if (!finished)
+		{
+			error = read_table (stream_a, tables[id]);
+		}
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::read_table (std::istream & stream_a, nano::tables table_a)
+{
+	auto error (store.table_clear (table_a));
+	if (error)
+	{
+		error_message = "Cannot clear store table";
+	}
+	nano::bulk_writer writer (store, table_a, load_size);
+	std::vector<uint8_t> frame;
+	for (auto finished (false); !error && !finished;)
+	{
+		uint32_t count (0);
+		uint32_t raw_size (0);
+		uint32_t stored_size (0);
+		uint64_t checksum_l (0);
+		error = read_u32 (stream_a, count) || read_u32 (stream_a, raw_size) || read_u32 (stream_a, stored_size) || raw_size > frame_max || stored_size > frame_max;
+		if (!error)
+		{
+			stored.resize (stored_size);
+			stream_a.read (reinterpret_cast<char *> (stored.data ()), stored_size);
+			stream_a.read (reinterpret_cast<char *> (&checksum_l), sizeof (checksum_l));
+			error = !stream_a.good () || boost::endian::little_to_native (checksum_l) != checksum (stored.data (), stored.size ());
+			bytes += 3 * sizeof (uint32_t) + stored_size + sizeof (checksum_l);
+		}
+		finished = count == 0;
+		if (!error && !finished)
+		{
+			if (compressed)
+			{
+#if NANO_ZSTD
+				frame.resize (raw_size);
+				auto size (ZSTD_decompressDCtx (decompress_context, frame.data (), frame.size (), stored.data (), stored.size ()));
+				error = ZSTD_isError (size) || size != raw_size;
+#endif
+			}
+			else
+			{
+				error = stored_size != raw_size;
+				frame.swap (stored);
+			}
+			size_t offset (0);
+			for (uint32_t i (0); i < count && !error; ++i)
+			{
+				nano::store_entry_view view;
+				error = read_field (frame, offset, view.key, view.key_size) || read_field (frame, offset, view.value, view.value_size);
+				if (!error)
+				{
+					writer.put (view.key, view.key_size, view.value, view.value_size);
+				}
+			}
+			error = error || offset != frame.size ();
+		}
+		if (error)
+		{
+			error_message = "Truncated or corrupted frame after " + std::to_string (entries + writer.rows) + " entries";
+		}
+		else if (finished || writer.error)
+		{
+			error = writer.flush ();
+			if (error)
+			{
+				error_message = "Cannot load entries into the store, the disk may be full";
+			}
+		}
+	}
+	entries += writer.rows;
+	load_elapsed += writer.elapsed;
+	return error;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <kizunano/secure/blockstore.hpp>
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace nano
+{
+/**
+ * Backend neutral copy of the ledger tables, written from a single read transaction and loaded into an
+ * empty store of either backend through block_store::table_load.
+ * Layout: magic, version, flags, store version and genesis hash, followed by one section per table of
+ * [uint8 table id] and frames of [uint32 entry count][uint32 raw size][uint32 stored size][payload][uint64 blake2b checksum of the payload],
+ * a frame with no entries closing the section and table id 0xff closing the snapshot. Raw frames hold entries
+ * as [uint32 key size][key][uint32 value size][value], stored zstd compressed if the compressed flag is set.
+ * Integers are little endian.
+ */
+class ledger_snapshot final
+{
+public:
+	explicit ledger_snapshot (nano::block_store &);
+	~ledger_snapshot ();
+	ledger_snapshot (ledger_snapshot const &) = delete;
+	ledger_snapshot & operator= (ledger_snapshot const &) = delete;
+	/** Writes every snapshot table, compressing frames if the node was built with NANO_ZSTD, returns true on error */
+	bool export_tables (std::ostream &, bool compress_a = true);
+	/** Replaces the snapshot tables of the store with the ones in \p stream_a, returns true on error */
+	bool import_tables (std::istream &);
+	/** Entries written or loaded */
+	uint64_t entries{ 0 };
+	/** Snapshot bytes written or read */
+	uint64_t bytes{ 0 };
+	/** Time import_tables spent loading entries into the store */
+	std::chrono::steady_clock::duration load_elapsed{ 0 };
+	std::string error_message;
+	/** Tables holding the ledger, indexed by their id in the stream. Unchecked blocks, peers and checkpoints are left out */
+	static std::array<nano::tables, 15> const tables;
+	static std::array<uint8_t, 4> const magic;
+	static uint8_t constexpr version = 1;
+	static uint8_t constexpr flag_compressed = 1;
+	static uint8_t constexpr end_of_tables = 0xff;
+	/** Raw bytes after which a frame is closed, also the upper bound accepted when importing */
+	static size_t constexpr frame_size = 4 * 1024 * 1024;
+	static size_t constexpr frame_max = 2 * frame_size;
+	/** Raw bytes buffered by the bulk_writer of each table */
+	static size_t constexpr load_size = 64 * 1024 * 1024;
+
+private:
+	bool write_frame (std::ostream &, std::vector<uint8_t> const &, uint32_t);
+	bool read_table (std::istream &, nano::tables);
+	nano::block_store & store;
+	bool compressed{ false };
+	std::vector<uint8_t> stored;
+	ZSTD_CCtx_s * compress_context{ nullptr };
+	ZSTD_DCtx_s * decompress_context{ nullptr };
+};
+}
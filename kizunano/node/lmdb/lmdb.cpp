@@ -11,6 +11,7 @@
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <cstring>
 #include <queue>
 
 namespace nano
@@ -186,6 +187,10 @@ void nano::mdb_store::open_databases (bool & error_a, nano::transaction const &
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "meta", flags, &meta) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "peers", flags, &peers) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "confirmation_height", flags, &confirmation_height) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "delegators", flags, &delegators) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_amounts", flags, &pending_amounts) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "heights", flags, &heights) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "bootstrap_checkpoint", flags, &bootstrap_checkpoint) != 0;
 	if (!full_sideband (transaction_a))
 	{
 		// The blocks_info database is no longer used, but need opening so that it can be deleted during an upgrade
@@ -261,6 +266,12 @@ bool nano::mdb_store::do_upgrades (nano::write_transaction & transaction_a, bool
 			upgrade_v17_to_v18 (transaction_a);
 			needs_vacuuming = true;
 		case 18:
+			upgrade_v18_to_v19 (transaction_a);
+		case 19:
+			upgrade_v19_to_v20 (transaction_a);
+		case 20:
+			upgrade_v20_to_v21 (transaction_a);
+		case 21:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -848,6 +859,89 @@ void nano::mdb_store::upgrade_v17_to_v18 (nano::write_transaction const & transa
 	logger.always_log ("Finished upgrading the sideband");
 }
 
+void nano::mdb_store::upgrade_v18_to_v19 (nano::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v18 to v19 database upgrade...");
+
+	std::vector<nano::delegator_key> keys;
+	keys.reserve (count (transaction_a, accounts));
+	for (auto i (latest_begin (transaction_a)), n (latest_end ()); i != n; ++i)
+	{
+		keys.emplace_back (i->second.representative, i->first);
+	}
+	// Bytewise order of the whole key so every entry can be appended
+	std::sort (keys.begin (), keys.end (), [](nano::delegator_key const & first_a, nano::delegator_key const & second_a) {
+		return std::memcmp (&first_a, &second_a, sizeof (first_a)) < 0;
+	});
+	auto status (mdb_drop (env.tx (transaction_a), delegators, 0));
+	release_assert (status == MDB_SUCCESS);
+	uint64_t zero (0);
+	for (auto const & key : keys)
+	{
+		auto s = mdb_put (env.tx (transaction_a), delegators, nano::mdb_val (key), nano::mdb_val (zero), MDB_APPEND);
+		release_assert (success (s));
+	}
+
+	version_put (transaction_a, 19);
+	logger.always_log (boost::str (boost::format ("Finished indexing delegators of %1% accounts") % keys.size ()));
+}
+
+void nano::mdb_store::upgrade_v19_to_v20 (nano::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v19 to v20 database upgrade...");
+
+	std::vector<nano::pending_amount_key> keys;
+	keys.reserve (count (transaction_a, pending));
+	for (auto i (pending_begin (transaction_a)), n (pending_end ()); i != n; ++i)
+	{
+		nano::pending_key const & key (i->first);
+		keys.emplace_back (key.account, i->second.amount, key.hash);
+	}
+	std::sort (keys.begin (), keys.end (), [](nano::pending_amount_key const & first_a, nano::pending_amount_key const & second_a) {
+		return std::memcmp (&first_a, &second_a, sizeof (first_a)) < 0;
+	});
+	auto status (mdb_drop (env.tx (transaction_a), pending_amounts, 0));
+	release_assert (status == MDB_SUCCESS);
+	uint64_t zero (0);
+	for (auto const & key : keys)
+	{
+		auto s = mdb_put (env.tx (transaction_a), pending_amounts, nano::mdb_val (key), nano::mdb_val (zero), MDB_APPEND);
+		release_assert (success (s));
+	}
+
+	version_put (transaction_a, 20);
+	logger.always_log (boost::str (boost::format ("Finished indexing %1% pending entries by amount") % keys.size ()));
+}
+
+void nano::mdb_store::upgrade_v20_to_v21 (nano::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v20 to v21 database upgrade...");
+
+	auto status (mdb_drop (env.tx (transaction_a), heights, 0));
+	release_assert (status == MDB_SUCCESS);
+	// Accounts in key order, each chain walked up from its open block, produce the keys in order
+	uint64_t num (0);
+	for (auto i (latest_begin (transaction_a)), n (latest_end ()); i != n; ++i)
+	{
+		nano::account const & account (i->first);
+		uint64_t height (1);
+		for (auto hash (i->second.open_block); !hash.is_zero (); hash = block_successor (transaction_a, hash), ++height, ++num)
+		{
+			auto s = mdb_put (env.tx (transaction_a), heights, nano::mdb_val (nano::account_height_key (account, height)), nano::mdb_val (hash), MDB_APPEND);
+			release_assert (success (s));
+
+			constexpr auto output_cutoff = 1000000;
+			if (num > 0 && num % output_cutoff == 0)
+			{
+				logger.always_log (boost::str (boost::format ("Database heights upgrade %1% million blocks indexed") % (num / output_cutoff)));
+			}
+		}
+	}
+
+	version_put (transaction_a, 21);
+	logger.always_log ("Finished indexing block heights");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::mdb_store::create_backup_file (nano::mdb_env & env_a, boost::filesystem::path const & filepath_a, nano::logger_mt & logger_a)
 {
@@ -1000,6 +1094,14 @@ MDB_dbi nano::mdb_store::table_to_dbi (tables table_a) const
 			return peers;
 		case tables::confirmation_height:
 			return confirmation_height;
+		case tables::delegators:
+			return delegators;
+		case tables::pending_amounts:
+			return pending_amounts;
+		case tables::heights:
+			return heights;
+		case tables::bootstrap_checkpoint:
+			return bootstrap_checkpoint;
 		default:
 			release_assert (false);
 			return peers;
@@ -1076,6 +1178,47 @@ void nano::mdb_store::rebuild_db (nano::write_transaction const & transaction_a)
 	}
 }
 
+void nano::mdb_store::table_for_each (nano::transaction const & transaction_a, nano::tables table_a, std::function<void (nano::store_entry_view const &)> const & action_a) const
+{
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert (status == MDB_SUCCESS);
+	MDB_val key;
+	MDB_val value;
+	for (status = mdb_cursor_get (cursor, &key, &value, MDB_FIRST); status == MDB_SUCCESS; status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+	{
+		action_a (nano::store_entry_view{ static_cast<uint8_t const *> (key.mv_data), key.mv_size, static_cast<uint8_t const *> (value.mv_data), value.mv_size });
+	}
+	release_assert (status == MDB_NOTFOUND);
+	mdb_cursor_close (cursor);
+}
+
+bool nano::mdb_store::table_clear (nano::tables table_a)
+{
+	auto transaction (tx_begin_write ({ table_a }));
+	return !success (drop (transaction, table_a));
+}
+
+bool nano::mdb_store::table_load (nano::tables table_a, std::vector<nano::store_entry_view> const & entries_a)
+{
+	auto transaction (tx_begin_write ({ table_a }));
+	auto handle (table_to_dbi (table_a));
+	auto status (MDB_SUCCESS);
+	for (auto i (entries_a.begin ()), n (entries_a.end ()); i != n && status == MDB_SUCCESS; ++i)
+	{
+		MDB_val key{ i->key_size, const_cast<uint8_t *> (i->key) };
+		MDB_val value{ i->value_size, const_cast<uint8_t *> (i->value) };
+		// Appending fills pages in order instead of searching the tree. It fails for keys not above the last key of the table,
+		// from an earlier batch or already stored, which need an ordinary put
+		status = mdb_put (env.tx (transaction), handle, &key, &value, MDB_APPEND);
+		if (status == MDB_KEYEXIST)
+		{
+			status = mdb_put (env.tx (transaction), handle, &key, &value, 0);
+		}
+	}
+	return !success (status);
+}
+
 bool nano::mdb_store::init_error () const
 {
 	return error;
@@ -190,6 +190,30 @@ public:
 	 */
 	MDB_dbi confirmation_height{ 0 };
 
+	/*
+	 * Accounts delegating to a representative, kept in step with the representative in the accounts table
+	 * nano::account (representative), nano::account -> uint64_t (0)
+	 */
+	MDB_dbi delegators{ 0 };
+
+	/*
+	 * Pending entries ordered by amount, largest first, kept in step with the pending table
+	 * nano::account, nano::amount (complement), nano::block_hash -> uint64_t (0)
+	 */
+	MDB_dbi pending_amounts{ 0 };
+
+	/*
+	 * Blocks of an account chain by height
+	 * nano::account, uint64_t (big endian height) -> nano::block_hash
+	 */
+	MDB_dbi heights{ 0 };
+
+	/*
+	 * Work left in an interrupted bootstrap attempt
+	 * uint64_t (bootstrap mode) -> blob
+	 */
+	MDB_dbi bootstrap_checkpoint{ 0 };
+
 	bool exists (nano::transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a) const;
 
 	int get (nano::transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a, nano::mdb_val & value_a) const;
@@ -199,6 +223,10 @@ public:
 	bool copy_db (boost::filesystem::path const & destination_file) override;
 	void rebuild_db (nano::write_transaction const & transaction_a) override;
 
+	void table_for_each (nano::transaction const &, nano::tables, std::function<void (nano::store_entry_view const &)> const &) const override;
+	bool table_clear (nano::tables) override;
+	bool table_load (nano::tables, std::vector<nano::store_entry_view> const &) override;
+
 	template <typename Key, typename Value>
 	nano::store_iterator<Key, Value> make_iterator (nano::transaction const & transaction_a, tables table_a) const
 	{
@@ -244,6 +272,9 @@ private:
 	void upgrade_v15_to_v16 (nano::write_transaction const &);
 	void upgrade_v16_to_v17 (nano::write_transaction const &);
 	void upgrade_v17_to_v18 (nano::write_transaction const &);
+	void upgrade_v18_to_v19 (nano::write_transaction const &);
+	void upgrade_v19_to_v20 (nano::write_transaction const &);
+	void upgrade_v20_to_v21 (nano::write_transaction const &);
 
 	void open_databases (bool &, nano::transaction const &, unsigned);
 
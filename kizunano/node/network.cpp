@@ -14,10 +14,12 @@ nano::network::network (nano::node & node_a, uint16_t port_a) :
 syn_cookies (node_a.network_params.node.max_peers_per_ip),
 buffer_container (node_a.stats, nano::network::buffer_size, 4096), // 2Mb receive buffer
 resolver (node_a.io_ctx),
-limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit),
+limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit, node_a.config.bandwidth_limit_vote_ratio, node_a.config.bandwidth_limit_peer),
+inbound_limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit_inbound, node_a.config.bandwidth_limit_vote_ratio, node_a.config.bandwidth_limit_inbound_peer),
 tcp_message_manager (node_a.config.tcp_incoming_connections_max),
 node (node_a),
 publish_filter (256 * 1024),
+block_announcer (node_a),
 udp_channels (node_a, port_a),
 tcp_channels (node_a),
 port (port_a),
@@ -106,6 +108,7 @@ void nano::network::start ()
 {
 	ongoing_cleanup ();
 	ongoing_syn_cookie_cleanup ();
+	block_announcer.ongoing_flush ();
 	if (!node.flags.disable_udp)
 	{
 		udp_channels.start ();
@@ -176,7 +179,26 @@ void nano::network::flood_message (nano::message const & message_a, nano::buffer
 void nano::network::flood_block (std::shared_ptr<nano::block> const & block_a, nano::buffer_drop_policy const drop_policy_a)
 {
 	nano::publish message (block_a);
-	flood_message (message, drop_policy_a);
+	if (!node.config.block_announcements)
+	{
+		flood_message (message, drop_policy_a);
+	}
+	else
+	{
+		auto channels (list (fanout ()));
+		size_t eager (0);
+		for (auto & i : channels)
+		{
+			if (eager++ % nano::block_announcer::eager_divisor == 0 || !block_announcer.capable (*i))
+			{
+				i->send (message, nullptr, drop_policy_a);
+			}
+			else
+			{
+				block_announcer.announce (i, block_a);
+			}
+		}
+	}
 }
 
 void nano::network::flood_block_initial (std::shared_ptr<nano::block> const & block_a)
@@ -243,8 +265,8 @@ void nano::network::broadcast_confirm_req (std::shared_ptr<nano::block> block_a)
 	auto list (std::make_shared<std::vector<std::shared_ptr<nano::transport::channel>>> (node.rep_crawler.representative_endpoints (std::numeric_limits<size_t>::max ())));
 	if (list->empty () || node.rep_crawler.total_weight () < node.config.online_weight_minimum.number ())
 	{
-		// broadcast request to all peers (with max limit 2 * sqrt (peers count))
-		auto peers (node.network.list (std::min<size_t> (100, node.network.fanout (2.0))));
+		// broadcast request to peers (with max limit 2 * sqrt (peers count)), preferring any representatives seen so far
+		auto peers (node.network.random_set_weighted (std::min<size_t> (100, node.network.fanout (2.0))));
 		list->clear ();
 		list->insert (list->end (), peers.begin (), peers.end ());
 	}
@@ -401,6 +423,7 @@ public:
 			node.logger.try_log (boost::str (boost::format ("Publish message from %1% for %2%") % channel->to_string () % message_a.block->hash ().to_string ()));
 		}
 		node.stats.inc (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::in);
+		node.network.block_announcer.seen (message_a.block->hash ());
 		if (!node.block_processor.full ())
 		{
 			node.process_active (message_a.block);
@@ -515,6 +538,15 @@ public:
 			node.telemetry->set (message_a, *channel);
 		}
 	}
+	void block_announce (nano::block_announce const & message_a) override
+	{
+		if (node.config.logging.network_message_logging ())
+		{
+			node.logger.try_log (boost::str (boost::format ("Block_announce message from %1% with %2% hashes%3%") % channel->to_string () % message_a.hashes.size () % (message_a.is_pull () ? " (pull)" : "")));
+		}
+		node.stats.inc (nano::stat::type::message, nano::stat::detail::block_announce, nano::stat::dir::in);
+		node.network.block_announcer.process (message_a, channel);
+	}
 	nano::node & node;
 	std::shared_ptr<nano::transport::channel> channel;
 };
@@ -522,8 +554,25 @@ public:
 
 void nano::network::process_message (nano::message const & message_a, std::shared_ptr<nano::transport::channel> channel_a)
 {
-	network_message_visitor visitor (node, channel_a);
-	message_a.visit (visitor);
+	auto detail (nano::transport::message_detail (message_a));
+	auto size (nano::message_header::size + message_a.header.payload_length_bytes ());
+	auto limited (inbound_limiter.should_drop (size, detail, channel_a->get_endpoint ()));
+	if (limited == nano::bandwidth_limiter::level::none)
+	{
+		node.stats.add (nano::stat::type::bandwidth, detail, nano::stat::dir::in, size);
+		network_message_visitor visitor (node, channel_a);
+		message_a.visit (visitor);
+	}
+	else
+	{
+		if (message_a.header.type == nano::message_type::publish)
+		{
+			// The parser already recorded the digest, a later copy of the block must not be discarded as a duplicate
+			publish_filter.clear (static_cast<nano::publish const &> (message_a).digest);
+		}
+		node.stats.inc (nano::stat::type::drop, detail, nano::stat::dir::in);
+		node.stats.inc_detail_only (nano::stat::type::drop, limited == nano::bandwidth_limiter::level::peer ? nano::stat::detail::peer_limit : nano::stat::detail::global_limit, nano::stat::dir::in);
+	}
 }
 
 // Send keepalives to all the peers we've been notified of
@@ -630,6 +679,35 @@ std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::network::ran
 	return result;
 }
 
+std::vector<std::shared_ptr<nano::transport::channel>> nano::network::random_set_weighted (size_t count_a, uint8_t min_version_a) const
+{
+	auto result (tcp_channels.random_set_weighted (count_a, min_version_a));
+	if (result.size () < count_a)
+	{
+		auto udp_random (udp_channels.random_set_weighted (count_a - result.size (), min_version_a));
+		result.insert (result.end (), udp_random.begin (), udp_random.end ());
+	}
+	return result;
+}
+
+void nano::network::set_sampling_weight (nano::transport::channel const & channel_a, nano::uint128_t const & weight_a, nano::uint128_t const & online_stake_a)
+{
+	// Scaled to roughly parts per million of online stake so the sum over all channels stays small
+	uint64_t weight (nano::transport::channel_sampler::base_weight);
+	if (online_stake_a > 0)
+	{
+		weight += static_cast<uint64_t> (std::min<nano::uint128_t> (weight_a, online_stake_a) * (1 << 20) / online_stake_a);
+	}
+	if (channel_a.get_type () == nano::transport::transport_type::tcp)
+	{
+		tcp_channels.set_sampling_weight (channel_a, weight);
+	}
+	else
+	{
+		udp_channels.set_sampling_weight (channel_a, weight);
+	}
+}
+
 void nano::network::random_fill (std::array<nano::endpoint, 8> & target_a) const
 {
 	auto peers (random_set (target_a.size (), 0, false)); // Don't include channels with ephemeral remote ports
@@ -716,6 +794,9 @@ void nano::network::cleanup (std::chrono::steady_clock::time_point const & cutof
 {
 	tcp_channels.purge (cutoff_a);
 	udp_channels.purge (cutoff_a);
+	limiter.purge (cutoff_a);
+	inbound_limiter.purge (cutoff_a);
+	block_announcer.purge (cutoff_a);
 	if (node.network.empty ())
 	{
 		disconnect_observer ();
@@ -887,6 +968,8 @@ void nano::message_buffer_manager::stop ()
 	condition.notify_all ();
 }
 
+constexpr size_t nano::tcp_message_manager::max_batch_size;
+
 nano::tcp_message_manager::tcp_message_manager (unsigned incoming_connections_max_a) :
 max_entries (incoming_connections_max_a * nano::tcp_message_manager::max_entries_per_connection + 1)
 {
@@ -928,6 +1011,23 @@ nano::tcp_message_item nano::tcp_message_manager::get_message ()
 	return result;
 }
 
+std::vector<nano::tcp_message_item> nano::tcp_message_manager::get_messages ()
+{
+	std::vector<nano::tcp_message_item> result;
+	nano::unique_lock<std::mutex> lock (mutex);
+	while (entries.empty () && !stopped)
+	{
+		consumer_condition.wait (lock);
+	}
+	auto count (std::min (entries.size (), max_batch_size));
+	result.reserve (count);
+	std::move (entries.begin (), entries.begin () + count, std::back_inserter (result));
+	entries.erase (entries.begin (), entries.begin () + count);
+	lock.unlock ();
+	producer_condition.notify_all ();
+	return result;
+}
+
 void nano::tcp_message_manager::stop ()
 {
 	{
@@ -1028,6 +1128,9 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ne
 	composite->add_component (network.tcp_channels.collect_container_info ("tcp_channels"));
 	composite->add_component (network.udp_channels.collect_container_info ("udp_channels"));
 	composite->add_component (network.syn_cookies.collect_container_info ("syn_cookies"));
+	composite->add_component (network.limiter.collect_container_info ("limiter"));
+	composite->add_component (network.inbound_limiter.collect_container_info ("inbound_limiter"));
+	composite->add_component (network.block_announcer.collect_container_info ("block_announcer"));
 	composite->add_component (collect_container_info (network.excluded_peers, "excluded_peers"));
 	return composite;
 }
@@ -1046,3 +1149,234 @@ std::unique_ptr<nano::container_info_component> nano::syn_cookies::collect_conta
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "syn_cookies_per_ip", syn_cookies_per_ip_count, sizeof (decltype (cookies_per_ip)::value_type) }));
 	return composite;
 }
+
+std::chrono::milliseconds constexpr nano::block_announcer::flush_interval;
+size_t constexpr nano::block_announcer::recent_max;
+size_t constexpr nano::block_announcer::eager_divisor;
+std::chrono::seconds constexpr nano::block_announcer::pull_timeout;
+size_t constexpr nano::block_announcer::pulls_max;
+size_t constexpr nano::block_announcer::answer_limit;
+
+nano::block_announcer::block_announcer (nano::node & node_a) :
+node (node_a),
+filter (256 * 1024),
+answer_limiter (1.0, 0, 0., answer_limit)
+{
+}
+
+void nano::block_announcer::announce (std::shared_ptr<nano::transport::channel> const & channel_a, std::shared_ptr<nano::block> const & block_a)
+{
+	auto hash (block_a->hash ());
+	seen (hash);
+	std::vector<nano::block_hash> batch;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		if (recent.emplace (hash, block_a).second)
+		{
+			recent_order.push_back (hash);
+			if (recent_order.size () > recent_max)
+			{
+				recent.erase (recent_order.front ());
+				recent_order.pop_front ();
+			}
+		}
+		auto & hashes (pending[channel_a]);
+		hashes.push_back (hash);
+		if (hashes.size () >= nano::block_announce::max_hashes)
+		{
+			batch.swap (hashes);
+			pending.erase (channel_a);
+		}
+	}
+	if (!batch.empty ())
+	{
+		send (channel_a, batch, false);
+	}
+}
+
+void nano::block_announcer::flush ()
+{
+	decltype (pending) pending_l;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		pending_l.swap (pending);
+	}
+	for (auto const & i : pending_l)
+	{
+		send (i.first, i.second, false);
+	}
+}
+
+void nano::block_announcer::ongoing_flush ()
+{
+	flush ();
+	std::weak_ptr<nano::node> node_w (node.shared ());
+	node.alarm.add (std::chrono::steady_clock::now () + flush_interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			if (!node_l->network.stopped)
+			{
+				node_l->network.block_announcer.ongoing_flush ();
+			}
+		}
+	});
+}
+
+void nano::block_announcer::process (nano::block_announce const & message_a, std::shared_ptr<nano::transport::channel> const & channel_a)
+{
+	if (message_a.is_pull ())
+	{
+		for (auto const & hash : message_a.hashes)
+		{
+			// Only blocks this node announced are served, pulls of other hashes are not answered
+			std::shared_ptr<nano::block> block;
+			{
+				nano::lock_guard<std::mutex> lock (mutex);
+				auto existing (recent.find (hash));
+				if (existing != recent.end ())
+				{
+					block = existing->second;
+				}
+			}
+			if (block != nullptr)
+			{
+				nano::publish message (block);
+				if (answer_limiter.should_drop (nano::message_header::size + message.header.payload_length_bytes (), nano::stat::detail::publish, channel_a->get_endpoint ()) == nano::bandwidth_limiter::level::none)
+				{
+					node.stats.inc (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::in);
+					channel_a->send (message);
+				}
+				else
+				{
+					node.stats.inc_detail_only (nano::stat::type::drop, nano::stat::detail::peer_limit, nano::stat::dir::out);
+				}
+			}
+		}
+	}
+	else
+	{
+		std::vector<nano::block_hash> unknown;
+		{
+			auto now (std::chrono::steady_clock::now ());
+			auto transaction (node.store.tx_begin_read ());
+			for (auto const & hash : message_a.hashes)
+			{
+				// Announcements from other neighbours are ignored while a pull of the hash is outstanding
+				if (!filter.check (hash.bytes.data (), hash.bytes.size ()) && !node.store.block_exists (transaction, hash) && request_pull (hash, now))
+				{
+					unknown.push_back (hash);
+				}
+			}
+		}
+		if (!unknown.empty ())
+		{
+			node.stats.add (nano::stat::type::message, nano::stat::detail::block_announce_pull, nano::stat::dir::out, unknown.size ());
+			send (channel_a, unknown, true);
+		}
+	}
+}
+
+bool nano::block_announcer::seen (nano::block_hash const & hash_a)
+{
+	auto result (filter.apply (hash_a.bytes.data (), hash_a.bytes.size ()));
+	if (!result)
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		pulls.erase (hash_a);
+	}
+	return result;
+}
+
+bool nano::block_announcer::request_pull (nano::block_hash const & hash_a, std::chrono::steady_clock::time_point const & now_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	while (!pulls_order.empty () && (pulls_order.front ().second + pull_timeout < now_a || pulls_order.size () >= pulls_max))
+	{
+		// The entry may have been erased on arrival or replaced by a later pull of the same hash
+		auto existing (pulls.find (pulls_order.front ().first));
+		if (existing != pulls.end () && existing->second == pulls_order.front ().second)
+		{
+			pulls.erase (existing);
+		}
+		pulls_order.pop_front ();
+	}
+	auto result (pulls.emplace (hash_a, now_a).second);
+	if (result)
+	{
+		pulls_order.emplace_back (hash_a, now_a);
+	}
+	return result;
+}
+
+void nano::block_announcer::set_capable (nano::account const & node_id_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	capable_ids.insert (node_id_a);
+}
+
+bool nano::block_announcer::capable (nano::transport::channel const & channel_a) const
+{
+	auto node_id (channel_a.get_node_id_optional ());
+	nano::lock_guard<std::mutex> lock (mutex);
+	return node_id.is_initialized () && capable_ids.count (node_id.get ()) > 0;
+}
+
+void nano::block_announcer::purge (std::chrono::steady_clock::time_point const & cutoff_a)
+{
+	answer_limiter.purge (cutoff_a);
+	decltype (capable_ids) capable_l;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		capable_l = capable_ids;
+	}
+	for (auto i (capable_l.begin ()), n (capable_l.end ()); i != n;)
+	{
+		if (node.network.find_node_id (*i) != nullptr)
+		{
+			i = capable_l.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	nano::lock_guard<std::mutex> lock (mutex);
+	for (auto const & node_id : capable_l)
+	{
+		capable_ids.erase (node_id);
+	}
+}
+
+size_t nano::block_announcer::size () const
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return pending.size ();
+}
+
+void nano::block_announcer::send (std::shared_ptr<nano::transport::channel> const & channel_a, std::vector<nano::block_hash> const & hashes_a, bool pull_a)
+{
+	nano::block_announce message (hashes_a, pull_a);
+	channel_a->send (message, nullptr, nano::buffer_drop_policy::no_limiter_drop);
+}
+
+std::unique_ptr<nano::container_info_component> nano::block_announcer::collect_container_info (std::string const & name)
+{
+	size_t pending_count;
+	size_t recent_count;
+	size_t capable_count;
+	size_t pulls_count;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		pending_count = pending.size ();
+		recent_count = recent.size ();
+		capable_count = capable_ids.size ();
+		pulls_count = pulls_order.size ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pending", pending_count, sizeof (decltype (pending)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recent", recent_count, sizeof (decltype (recent)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "capable", capable_count, sizeof (decltype (capable_ids)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pulls", pulls_count, sizeof (decltype (pulls_order)::value_type) }));
+	composite->add_component (answer_limiter.collect_container_info ("answer_limiter"));
+	return composite;
+}
@@ -72,6 +72,8 @@ public:
 	tcp_message_manager (unsigned incoming_connections_max_a);
 	void put_message (nano::tcp_message_item const & item_a);
 	nano::tcp_message_item get_message ();
+	// Waits for a message and then takes up to max_batch_size of the queued ones, empty once stopped
+	std::vector<nano::tcp_message_item> get_messages ();
 	// Stop container and notify waiting threads
 	void stop ();
 
@@ -82,6 +84,7 @@ private:
 	std::deque<nano::tcp_message_item> entries;
 	unsigned max_entries;
 	static unsigned const max_entries_per_connection = 16;
+	static constexpr size_t max_batch_size = 64;
 	bool stopped{ false };
 
 	friend class network_tcp_message_manager_Test;
@@ -115,6 +118,61 @@ private:
 	std::unordered_map<boost::asio::ip::address, unsigned> cookies_per_ip;
 	size_t max_cookies_per_ip;
 };
+/**
+  * Hash-only block announcements to peers which negotiated them in the node ID handshake.
+  * Hashes are batched per channel and announced peers pull only the blocks they don't know, instead of
+  * receiving the same full block from many neighbours. Only blocks recently announced by this node are served to pulls,
+  * at a limited rate per peer, so that small pull requests cannot make the node send arbitrary ledger blocks.
+  * A hash is known once its block arrives. A pull which got no answer expires, so that a later announcement retries it.
+*/
+class block_announcer final
+{
+public:
+	block_announcer (nano::node &);
+	/** Queues the hash of \p block_a for announcement to \p channel_a, sending the batch once full */
+	void announce (std::shared_ptr<nano::transport::channel> const & channel_a, std::shared_ptr<nano::block> const & block_a);
+	/** Sends partially filled batches */
+	void flush ();
+	void ongoing_flush ();
+	/** Pulls the unknown blocks of an announcement, or answers a pull request */
+	void process (nano::block_announce const &, std::shared_ptr<nano::transport::channel> const &);
+	/** Marks \p hash_a as known once its block arrived, so announcements of it are ignored, returns true if it already was */
+	bool seen (nano::block_hash const & hash_a);
+	void set_capable (nano::account const &);
+	bool capable (nano::transport::channel const &) const;
+	/** Forget capabilities of node IDs which no longer have a channel and answer limits of peers idle since \p cutoff_a */
+	void purge (std::chrono::steady_clock::time_point const & cutoff_a);
+	size_t size () const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const &);
+	static std::chrono::milliseconds constexpr flush_interval = std::chrono::milliseconds (20);
+	/** Number of recently announced blocks kept to answer pulls */
+	static size_t constexpr recent_max = 16 * 1024;
+	/** Every n-th channel of a flood still receives the full block, so propagation doesn't wait on pulls */
+	static size_t constexpr eager_divisor = 4;
+	/** Time after which an unanswered pull is forgotten and the hash may be pulled from the next peer announcing it */
+	static std::chrono::seconds constexpr pull_timeout = std::chrono::seconds (5);
+	/** Number of outstanding pulls tracked, the oldest are forgotten first */
+	static size_t constexpr pulls_max = 64 * 1024;
+	/** Bytes of pulled blocks served to a single peer per second */
+	static size_t constexpr answer_limit = 256 * 1024;
+
+private:
+	void send (std::shared_ptr<nano::transport::channel> const &, std::vector<nano::block_hash> const &, bool);
+	/** Records a pull of \p hash_a unless one is outstanding, returns true if the hash should be pulled */
+	bool request_pull (nano::block_hash const & hash_a, std::chrono::steady_clock::time_point const & now_a);
+	nano::node & node;
+	/** Hashes of blocks which arrived or which this node announced */
+	nano::network_filter filter;
+	std::unordered_map<nano::block_hash, std::chrono::steady_clock::time_point> pulls;
+	std::deque<std::pair<nano::block_hash, std::chrono::steady_clock::time_point>> pulls_order;
+	/** Limits answers to pulls per peer, without a global limit */
+	nano::bandwidth_limiter answer_limiter;
+	std::unordered_map<std::shared_ptr<nano::transport::channel>, std::vector<nano::block_hash>> pending;
+	std::unordered_map<nano::block_hash, std::shared_ptr<nano::block>> recent;
+	std::deque<nano::block_hash> recent_order;
+	std::unordered_set<nano::account> capable_ids;
+	mutable std::mutex mutex;
+};
 class network final
 {
 public:
@@ -166,6 +224,10 @@ public:
 	void fill_keepalive_self (std::array<nano::endpoint, 8> &) const;
 	// Note: The minimum protocol version is used after the random selection, so number of peers can be less than expected.
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> random_set (size_t, uint8_t = 0, bool = false) const;
+	// Random selection biased towards channels of representatives, in proportion to their share of online stake
+	std::vector<std::shared_ptr<nano::transport::channel>> random_set_weighted (size_t, uint8_t = 0) const;
+	// Sets the voting weight behind a channel for weighted selection, zero for non-representatives
+	void set_sampling_weight (nano::transport::channel const &, nano::uint128_t const &, nano::uint128_t const & online_stake_a);
 	// Get the next peer for attempting a tcp bootstrap connection
 	nano::tcp_endpoint bootstrap_peer (bool = false);
 	nano::endpoint endpoint ();
@@ -183,11 +245,15 @@ public:
 	nano::message_buffer_manager buffer_container;
 	boost::asio::ip::udp::resolver resolver;
 	std::vector<boost::thread> packet_processing_threads;
+	/** Outbound traffic shaping */
 	nano::bandwidth_limiter limiter;
+	/** Inbound traffic policing of realtime messages */
+	nano::bandwidth_limiter inbound_limiter;
 	nano::peer_exclusion excluded_peers;
 	nano::tcp_message_manager tcp_message_manager;
 	nano::node & node;
 	nano::network_filter publish_filter;
+	nano::block_announcer block_announcer;
 	nano::transport::udp_channels udp_channels;
 	nano::transport::tcp_channels tcp_channels;
 	std::atomic<uint16_t> port{ 0 };
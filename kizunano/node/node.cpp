@@ -104,6 +104,7 @@ wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_
 wallets_store (*wallets_store_impl),
 gap_cache (*this),
 ledger (store, stats, flags_a.generate_cache, [this]() { this->network.erase_below_version (network_params.protocol.protocol_version_min (true)); }),
+rpc_response_cache (config.rpc_response_cache_size, stats),
 checker (config.signature_checker_threads),
 network (*this, config.peering_port),
 telemetry (std::make_shared<nano::telemetry> (network, alarm, worker, observers.telemetry, stats, network_params, flags.disable_ongoing_telemetry_requests)),
@@ -273,6 +274,13 @@ node_seq (seq)
 				}
 			});
 		}
+		if (rpc_response_cache.enabled ())
+		{
+			// Confirmation heights are part of cached responses
+			confirmation_height_processor.add_cemented_observer ([this](std::shared_ptr<nano::block> block_a) {
+				this->rpc_response_cache.invalidate (*block_a);
+			});
+		}
 		// Add block confirmation type stats regardless of http-callback and websocket subscriptions
 		observers.blocks.add ([this](nano::election_status const & status_a, nano::account const & account_a, nano::amount const & amount_a, bool is_state_send_a) {
 			debug_assert (status_a.type != nano::election_status_type::ongoing);
@@ -353,7 +361,7 @@ node_seq (seq)
 			logger.always_log ("Constructing node");
 		}
 
-		logger.always_log (boost::str (boost::format ("Outbound Voting Bandwidth limited to %1% bytes per second, burst ratio %2%") % config.bandwidth_limit % config.bandwidth_limit_burst_ratio));
+		logger.always_log (boost::str (boost::format ("Outbound Voting Bandwidth limited to %1% bytes per second, burst ratio %2%, %3% reserved for votes, %4% bytes per second per peer") % config.bandwidth_limit % config.bandwidth_limit_burst_ratio % config.bandwidth_limit_vote_ratio % config.bandwidth_limit_peer));
 
 		// First do a pass with a read to see if any writing needs doing, this saves needing to open a write lock (and potentially blocking)
 		auto is_initialized (false);
@@ -366,7 +374,7 @@ node_seq (seq)
 		if (!is_initialized)
 		{
 			release_assert (!flags.read_only);
-			auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::confirmation_height, tables::frontiers, tables::open_blocks }));
+			auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::confirmation_height, tables::delegators, tables::frontiers, tables::heights, tables::open_blocks }));
 			// Store was empty meaning we just created it, add the genesis block
 			store.initialize (transaction, genesis, ledger.cache);
 		}
@@ -586,6 +594,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.worker, "worker"));
 	composite->add_component (collect_container_info (node.distributed_work, "distributed_work"));
 	composite->add_component (collect_container_info (node.aggregator, "request_aggregator"));
+	composite->add_component (collect_container_info (node.rpc_response_cache, "rpc_response_cache"));
 	return composite;
 }
 
@@ -597,8 +606,15 @@ void nano::node::process_active (std::shared_ptr<nano::block> incoming)
 
 nano::process_return nano::node::process (nano::block & block_a)
 {
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::change_blocks, tables::frontiers, tables::open_blocks, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks }, { tables::confirmation_height }));
-	auto result (ledger.process (transaction, block_a));
+	nano::process_return result;
+	{
+		auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::change_blocks, tables::delegators, tables::frontiers, tables::heights, tables::open_blocks, tables::pending, tables::pending_amounts, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks }, { tables::confirmation_height }));
+		result = ledger.process (transaction, block_a);
+	}
+	if (result.code == nano::process_result::progress)
+	{
+		rpc_response_cache.invalidate (block_a);
+	}
 	return result;
 }
 
@@ -612,7 +628,7 @@ nano::process_return nano::node::process_local (std::shared_ptr<nano::block> blo
 	block_processor.wait_write ();
 	// Process block
 	block_post_events events;
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::change_blocks, tables::frontiers, tables::open_blocks, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks }, { tables::confirmation_height }));
+	auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::change_blocks, tables::delegators, tables::frontiers, tables::heights, tables::open_blocks, tables::pending, tables::pending_amounts, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks }, { tables::confirmation_height }));
 	return block_processor.process_one (transaction, events, info, work_watcher_a, nano::block_origin::local);
 }
 
@@ -621,6 +637,12 @@ void nano::node::start ()
 	long_inactivity_cleanup ();
 	network.start ();
 	add_initial_peers ();
+	if (!flags.disable_legacy_bootstrap || !flags.disable_lazy_bootstrap)
+	{
+		// Resumed attempts take the place of the first ongoing legacy attempt
+		bootstrap_initiator.resume ();
+		ongoing_bootstrap_checkpoint ();
+	}
 	if (!flags.disable_legacy_bootstrap)
 	{
 		ongoing_bootstrap ();
@@ -651,7 +673,7 @@ void nano::node::start ()
 		backup_wallet ();
 	}
 	search_pending ();
-	if (!flags.disable_wallet_bootstrap)
+	if (!flags.disable_wallet_bootstrap || !flags.disable_priority_bootstrap)
 	{
 		// Delay to start wallet lazy bootstrap
 		auto this_l (shared ());
@@ -831,6 +853,20 @@ void nano::node::ongoing_bootstrap ()
 	});
 }
 
+void nano::node::ongoing_bootstrap_checkpoint ()
+{
+	bootstrap_initiator.save_checkpoints ();
+	std::weak_ptr<nano::node> node_w (shared_from_this ());
+	alarm.add (std::chrono::steady_clock::now () + nano::bootstrap_limits::bootstrap_checkpoint_interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->worker.push_task ([node_l]() {
+				node_l->ongoing_bootstrap_checkpoint ();
+			});
+		}
+	});
+}
+
 void nano::node::ongoing_store_flush ()
 {
 	{
@@ -914,7 +950,17 @@ void nano::node::bootstrap_wallet ()
 	}
 	if (!accounts.empty ())
 	{
-		bootstrap_initiator.bootstrap_wallet (accounts);
+		if (!flags.disable_priority_bootstrap)
+		{
+			for (auto const & account : accounts)
+			{
+				bootstrap_initiator.bootstrap_priority (account, nano::bootstrap_limits::priority_wallet);
+			}
+		}
+		if (!flags.disable_wallet_bootstrap)
+		{
+			bootstrap_initiator.bootstrap_wallet (accounts);
+		}
 	}
 }
 
@@ -1096,6 +1142,7 @@ void nano::node::add_initial_peers ()
 	for (auto i (store.peers_begin (transaction)), n (store.peers_end ()); i != n; ++i)
 	{
 		nano::endpoint endpoint (boost::asio::ip::address_v6 (i->first.address_bytes ()), i->first.port ());
+		bootstrap_initiator.connections->peer_restore (nano::transport::map_endpoint_to_tcp (endpoint), i->second);
 		if (!network.reachout (endpoint, config.allow_local_peers))
 		{
 			std::weak_ptr<nano::node> node_w (shared_from_this ());
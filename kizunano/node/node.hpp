@@ -21,6 +21,7 @@
 #include <kizunano/node/portmapping.hpp>
 #include <kizunano/node/repcrawler.hpp>
 #include <kizunano/node/request_aggregator.hpp>
+#include <kizunano/node/rpc_response_cache.hpp>
 #include <kizunano/node/signatures.hpp>
 #include <kizunano/node/telemetry.hpp>
 #include <kizunano/node/vote_processor.hpp>
@@ -118,6 +119,7 @@ public:
 	nano::uint128_t minimum_principal_weight (nano::uint128_t const &);
 	void ongoing_rep_calculation ();
 	void ongoing_bootstrap ();
+	void ongoing_bootstrap_checkpoint ();
 	void ongoing_store_flush ();
 	void ongoing_peer_store ();
 	void ongoing_unchecked_cleanup ();
@@ -168,6 +170,7 @@ public:
 	nano::wallets_store & wallets_store;
 	nano::gap_cache gap_cache;
 	nano::ledger ledger;
+	nano::rpc_response_cache rpc_response_cache;
 	nano::signature_checker checker;
 	nano::network network;
 	std::shared_ptr<nano::telemetry> telemetry;
@@ -20,6 +20,10 @@ nano::error nano::node_rpc_config::serialize_json (nano::jsonconfig & json) cons
 nano::error nano::node_rpc_config::serialize_toml (nano::tomlconfig & toml) const
 {
 	toml.put ("enable_sign_hash", enable_sign_hash, "Allow or disallow signing of hashes.\ntype:bool");
+	toml.put ("response_chunk_size", response_chunk_size, "Approximate size in bytes of the parts that large responses, such as ledger, frontiers and unchecked, are produced and sent in. Smaller parts use less memory and give the first bytes sooner.\ntype:uint64");
+	toml.put ("batch_max_requests", batch_max_requests, "Maximum number of sub-requests of a batch action. A batch holds one read transaction while its sub-requests run, and the responses until they are sent.\ntype:uint64");
+	toml.put ("scan_time_budget", scan_time_budget.count (), "Time a ledger, frontiers, delegators, unchecked_keys or unopened call may spend scanning, not counting time spent waiting for the client. A scan stopped early returns a cursor which the next call resumes from. 0, the default, is unlimited.\ntype:milliseconds");
+	toml.put ("in_process_threads", in_process_threads, "Number of threads which run requests when RPC runs inside the node. 0 runs them on the node I/O thread which read them, long running requests then hold up networking.\ntype:uint64");
 
 	nano::tomlconfig child_process_l;
 	child_process_l.put ("enable", child_process.enable, "Enable or disable RPC child process. If false, an in-process RPC server is used.\ntype:bool");
@@ -32,6 +36,16 @@ nano::error nano::node_rpc_config::deserialize_toml (nano::tomlconfig & toml)
 {
 	toml.get_optional ("enable_sign_hash", enable_sign_hash);
 	toml.get_optional<bool> ("enable_sign_hash", enable_sign_hash);
+	toml.get_optional<size_t> ("response_chunk_size", response_chunk_size);
+	toml.get_optional<size_t> ("batch_max_requests", batch_max_requests);
+	auto scan_time_budget_l (scan_time_budget.count ());
+	toml.get_optional ("scan_time_budget", scan_time_budget_l);
+	scan_time_budget = std::chrono::milliseconds (scan_time_budget_l);
+	toml.get_optional<unsigned> ("in_process_threads", in_process_threads);
+	if (response_chunk_size == 0)
+	{
+		toml.get_error ().set ("response_chunk_size must be greater than zero");
+	}
 
 	auto child_process_l (toml.get_optional_child ("child_process"));
 	if (child_process_l)
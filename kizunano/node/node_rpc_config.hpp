@@ -4,6 +4,7 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
+#include <chrono>
 #include <string>
 
 namespace boost
@@ -33,6 +34,14 @@ public:
 	nano::error deserialize_toml (nano::tomlconfig & toml);
 
 	bool enable_sign_hash{ false };
+	/** Approximate size of the parts large responses are sent in */
+	size_t response_chunk_size{ 64 * 1024 };
+	/** Most sub-requests of a batch, which all read the same ledger snapshot */
+	size_t batch_max_requests{ 1000 };
+	/** Longest a ledger scan runs in one call before it stops and returns a cursor to resume it, zero is unlimited */
+	std::chrono::milliseconds scan_time_budget{ 0 };
+	/** Threads running requests of the in-process RPC server, zero runs them on the I/O thread which read them */
+	unsigned in_process_threads{ 0 };
 	nano::rpc_child_process_config child_process;
 	static unsigned json_version ()
 	{
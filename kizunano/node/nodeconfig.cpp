@@ -79,6 +79,8 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 2.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
 	toml.put ("bootstrap_initiator_threads", bootstrap_initiator_threads, "Number of threads dedicated to concurrent bootstrap attempts. Defaults to 1.\nWarning: a larger amount of attempts may use additional system memory and disk IO.\ntype:uint64");
+	toml.put ("bootstrap_compression", bootstrap_compression, "Request zstd compressed bulk pull responses from peers and compress responses for peers requesting it. Trades CPU time for bootstrap bandwidth, only effective if the node was built with NANO_ZSTD.\ntype:bool");
+	toml.put ("bootstrap_pull_pipeline", bootstrap_pull_pipeline, "Number of bulk pulls sent at once over a single bootstrap connection. Responses arrive in request order, so further pulls do not wait a round trip for the previous one. 1 disables pipelining.\ntype:uint32,[1..64]");
 	toml.put ("lmdb_max_dbs", deprecated_lmdb_max_dbs, "DEPRECATED: use node.lmdb.max_databases instead.\nMaximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large number of wallets is required (see https://docs.kizunanocoin.com/integration-guides/key-management/).\ntype:uint64");
 	toml.put ("block_processor_batch_max_time", block_processor_batch_max_time.count (), "The maximum time the block processor can continuously process blocks for.\ntype:milliseconds");
 	toml.put ("allow_local_peers", allow_local_peers, "Enable or disable local host peering.\ntype:bool");
@@ -95,13 +97,19 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("confirmation_history_size", confirmation_history_size, "Maximum confirmation history size. If tracking the rate of block confirmations, the websocket feature is recommended instead.\ntype:uint64");
 	toml.put ("active_elections_size", active_elections_size, "Number of active elections. Elections beyond this limit have limited survival time.\nWarning: modifying this value may result in a lower confirmation rate.\ntype:uint64,[250..]");
 	toml.put ("bandwidth_limit", bandwidth_limit, "Outbound traffic limit in bytes/sec after which messages will be dropped.\nNote: changing to unlimited bandwidth (0) is not recommended for limited connections.\ntype:uint64");
-	toml.put ("bandwidth_limit_burst_ratio", bandwidth_limit_burst_ratio, "Burst ratio for outbound traffic shaping.\ntype:double");
+	toml.put ("bandwidth_limit_burst_ratio", bandwidth_limit_burst_ratio, "Burst ratio for outbound and inbound traffic shaping.\ntype:double");
+	toml.put ("bandwidth_limit_vote_ratio", bandwidth_limit_vote_ratio, "Share of bandwidth_limit and bandwidth_limit_inbound reserved for votes. Votes may also use the remaining share, other messages are limited to the remaining share.\ntype:double,[0..1)");
+	toml.put ("bandwidth_limit_peer", bandwidth_limit_peer, "Outbound traffic limit in bytes/sec towards a single peer, after which messages to that peer will be dropped.\ntype:uint64");
+	toml.put ("bandwidth_limit_inbound", bandwidth_limit_inbound, "Inbound traffic limit in bytes/sec of realtime messages after which they will be dropped. Traffic is accounted in the stats when unbounded (0).\ntype:uint64");
+	toml.put ("bandwidth_limit_inbound_peer", bandwidth_limit_inbound_peer, "Inbound traffic limit in bytes/sec of realtime messages from a single peer, after which messages from that peer will be dropped.\ntype:uint64");
+	toml.put ("block_announcements", block_announcements, "Announce republished blocks by hash to most peers supporting it instead of sending the full block. Peers then only pull blocks they are missing.\ntype:bool");
 	toml.put ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time.count (), "Minimum write batching time when there are blocks pending confirmation height.\ntype:milliseconds");
 	toml.put ("backup_before_upgrade", backup_before_upgrade, "Backup the ledger database before performing upgrades.\nWarning: uses more disk storage and increases startup time when upgrading.\ntype:bool");
 	toml.put ("work_watcher_period", work_watcher_period.count (), "Time between checks for confirmation and re-generating higher difficulty work if unconfirmed, for blocks in the work watcher.\ntype:seconds");
 	toml.put ("max_work_generate_multiplier", max_work_generate_multiplier, "Maximum allowed difficulty multiplier for work generation.\ntype:double,[1..]");
 	toml.put ("frontiers_confirmation", serialize_frontiers_confirmation (frontiers_confirmation), "Mode controlling frontier confirmation rate.\ntype:string,{auto,always,disabled}");
 	toml.put ("max_queued_requests", max_queued_requests, "Limit for number of queued confirmation requests for one channel, after which new requests are dropped until the queue drops below this value.\ntype:uint32");
+	toml.put ("rpc_response_cache_size", rpc_response_cache_size, "Number of responses to read-only RPC actions (account_info, account_balance, block_info, pending_exists) kept until a ledger change affects them. 0 disables the cache.\ntype:uint64");
 
 	auto work_peers_l (toml.create_array ("work_peers", "A list of \"address:port\" entries to identify work peers."));
 	for (auto i (work_peers.begin ()), n (work_peers.end ()); i != n; ++i)
@@ -308,6 +316,8 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<unsigned> ("bootstrap_connections", bootstrap_connections);
 		toml.get<unsigned> ("bootstrap_connections_max", bootstrap_connections_max);
 		toml.get<unsigned> ("bootstrap_initiator_threads", bootstrap_initiator_threads);
+		toml.get<bool> ("bootstrap_compression", bootstrap_compression);
+		toml.get<unsigned> ("bootstrap_pull_pipeline", bootstrap_pull_pipeline);
 		toml.get<bool> ("enable_voting", enable_voting);
 		toml.get<bool> ("allow_local_peers", allow_local_peers);
 		toml.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
@@ -349,6 +359,11 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<size_t> ("active_elections_size", active_elections_size);
 		toml.get<size_t> ("bandwidth_limit", bandwidth_limit);
 		toml.get<double> ("bandwidth_limit_burst_ratio", bandwidth_limit_burst_ratio);
+		toml.get<double> ("bandwidth_limit_vote_ratio", bandwidth_limit_vote_ratio);
+		toml.get<size_t> ("bandwidth_limit_peer", bandwidth_limit_peer);
+		toml.get<size_t> ("bandwidth_limit_inbound", bandwidth_limit_inbound);
+		toml.get<size_t> ("bandwidth_limit_inbound_peer", bandwidth_limit_inbound_peer);
+		toml.get<bool> ("block_announcements", block_announcements);
 		toml.get<bool> ("backup_before_upgrade", backup_before_upgrade);
 
 		auto work_watcher_period_l = work_watcher_period.count ();
@@ -363,6 +378,7 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<double> ("max_work_generate_multiplier", max_work_generate_multiplier);
 
 		toml.get<uint32_t> ("max_queued_requests", max_queued_requests);
+		toml.get<size_t> ("rpc_response_cache_size", rpc_response_cache_size);
 
 		if (toml.has_key ("frontiers_confirmation"))
 		{
@@ -408,6 +424,14 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			toml.get_error ().set ("bandwidth_limit unbounded = 0, default = 10485760, max = 18446744073709551615");
 		}
+		if (bandwidth_limit_vote_ratio < 0 || bandwidth_limit_vote_ratio >= 1)
+		{
+			toml.get_error ().set ("bandwidth_limit_vote_ratio must be a number between 0 and 1 (exclusive)");
+		}
+		if (bootstrap_pull_pipeline < 1 || bootstrap_pull_pipeline > 64)
+		{
+			toml.get_error ().set ("bootstrap_pull_pipeline must be a number between 1 and 64");
+		}
 		if (vote_generator_threshold < 1 || vote_generator_threshold > 11)
 		{
 			toml.get_error ().set ("vote_generator_threshold must be a number between 1 and 11");
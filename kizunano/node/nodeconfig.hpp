@@ -67,6 +67,10 @@ public:
 	unsigned bootstrap_connections{ 2 };
 	unsigned bootstrap_connections_max{ 64 };
 	unsigned bootstrap_initiator_threads{ 1 };
+	/** Request and serve zstd compressed bulk pulls, if built with NANO_ZSTD */
+	bool bootstrap_compression{ false };
+	/** Number of bulk pulls sent at once over a bootstrap connection */
+	unsigned bootstrap_pull_pipeline{ 4 };
 	nano::websocket::config websocket_config;
 	nano::diagnostics_config diagnostics_config;
 	size_t confirmation_history_size{ 2048 };
@@ -95,11 +99,23 @@ public:
 	size_t bandwidth_limit{ 10 * 1024 * 1024 };
 	/** By default, allow bursts of 15MB/s (not sustainable) */
 	double bandwidth_limit_burst_ratio{ 3. };
+	/** Share of the outbound and inbound limits reserved for votes, which other traffic cannot use, 0 = no reserve */
+	double bandwidth_limit_vote_ratio{ 0. };
+	/** Outbound traffic limit towards a single peer, 0 = unbounded */
+	size_t bandwidth_limit_peer{ 0 };
+	/** Inbound traffic limit of realtime messages, 0 = unbounded (accounting only) */
+	size_t bandwidth_limit_inbound{ 0 };
+	/** Inbound traffic limit of realtime messages from a single peer, 0 = unbounded */
+	size_t bandwidth_limit_inbound_peer{ 0 };
+	/** Announce republished blocks by hash to peers supporting it, which pull the blocks they are missing */
+	bool block_announcements{ true };
 	std::chrono::milliseconds conf_height_processor_batch_min_time{ 50 };
 	bool backup_before_upgrade{ false };
 	std::chrono::seconds work_watcher_period{ std::chrono::seconds (5) };
 	double max_work_generate_multiplier{ 64. };
 	uint32_t max_queued_requests{ 512 };
+	/** Responses of read-only RPC actions kept until the ledger changes the accounts they depend on, 0 = disabled */
+	size_t rpc_response_cache_size{ 0 };
 	nano::rocksdb_config rocksdb_config;
 	nano::lmdb_config lmdb_config;
 	nano::frontiers_confirmation_mode frontiers_confirmation{ nano::frontiers_confirmation_mode::disabled };
@@ -122,6 +138,7 @@ public:
 	bool disable_lazy_bootstrap{ false };
 	bool disable_legacy_bootstrap{ false };
 	bool disable_wallet_bootstrap{ false };
+	bool disable_priority_bootstrap{ true };
 	bool disable_bootstrap_listener{ false };
 	bool disable_bootstrap_bulk_pull_server{ false };
 	bool disable_bootstrap_bulk_push_client{ false };
@@ -149,5 +166,7 @@ public:
 	size_t block_processor_verification_size{ 0 };
 	size_t inactive_votes_cache_size{ 16 * 1024 };
 	size_t vote_processor_capacity{ 144 * 1024 };
+	/** Bytes lazy bootstrap may use for its block tracking before spilling to disk */
+	size_t lazy_bootstrap_memory_budget{ 256 * 1024 * 1024 };
 };
 }
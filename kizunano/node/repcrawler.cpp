@@ -90,6 +90,7 @@ void nano::rep_crawler::ongoing_crawl ()
 	cleanup_reps ();
 	update_weights ();
 	validate ();
+	update_sampling_weights ();
 	query (get_crawl_targets (total_weight_l));
 	auto sufficient_weight (total_weight_l > node.config.online_weight_minimum.number ());
 	// If online weight drops below minimum, reach out to preconfigured peers
@@ -310,6 +311,34 @@ void nano::rep_crawler::update_weights ()
 	}
 }
 
+void nano::rep_crawler::update_sampling_weights ()
+{
+	std::unordered_map<std::shared_ptr<nano::transport::channel>, nano::uint128_t> weights;
+	{
+		nano::lock_guard<std::mutex> lock (probable_reps_mutex);
+		for (auto const & rep : probable_reps)
+		{
+			// A single host may have multiple reps
+			weights[rep.channel] += rep.weight.number ();
+		}
+	}
+	auto online_stake (node.online_reps.online_stake ());
+	for (auto const & channel_w : weighted_channels)
+	{
+		auto channel (channel_w.lock ());
+		if (channel != nullptr && weights.count (channel) == 0)
+		{
+			node.network.set_sampling_weight (*channel, 0, online_stake);
+		}
+	}
+	weighted_channels.clear ();
+	for (auto const & weight : weights)
+	{
+		node.network.set_sampling_weight (*weight.first, weight.second, online_stake);
+		weighted_channels.push_back (weight.first);
+	}
+}
+
 std::vector<nano::representative> nano::rep_crawler::representatives (size_t count_a, nano::uint128_t const weight_a, boost::optional<decltype (nano::protocol_constants::protocol_version)> const & opt_version_min_a)
 {
 	auto version_min (opt_version_min_a.value_or (node.network_params.protocol.protocol_version_min (node.ledger.cache.epoch_2_started)));
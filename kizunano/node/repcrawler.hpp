@@ -141,6 +141,12 @@ private:
 	/** Update representatives weights from ledger */
 	void update_weights ();
 
+	/** Push the voting weight behind each representative channel to the network's weighted peer sampling */
+	void update_sampling_weights ();
+
+	/** Channels given a sampling weight by the last update_sampling_weights */
+	std::vector<std::weak_ptr<nano::transport::channel>> weighted_channels;
+
 	/** Protects the probable_reps container */
 	mutable std::mutex probable_reps_mutex;
 
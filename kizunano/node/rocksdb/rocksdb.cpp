@@ -3,13 +3,16 @@
 #include <kizunano/node/rocksdb/rocksdb.hpp>
 #include <kizunano/node/rocksdb/rocksdb_iterator.hpp>
 #include <kizunano/node/rocksdb/rocksdb_txn.hpp>
+#include <kizunano/secure/bulk_writer.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 
 #include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/backupable_db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
@@ -74,7 +77,7 @@ nano::rocksdb_store::~rocksdb_store ()
 
 void nano::rocksdb_store::open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a)
 {
-	std::initializer_list<const char *> names{ rocksdb::kDefaultColumnFamilyName.c_str (), "frontiers", "accounts", "send", "receive", "open", "change", "state_blocks", "pending", "representation", "unchecked", "vote", "online_weight", "meta", "peers", "cached_counts", "confirmation_height" };
+	std::initializer_list<const char *> names{ rocksdb::kDefaultColumnFamilyName.c_str (), "frontiers", "accounts", "send", "receive", "open", "change", "state_blocks", "pending", "representation", "unchecked", "vote", "online_weight", "meta", "peers", "cached_counts", "confirmation_height", "bootstrap_checkpoint", "delegators", "pending_amounts", "heights" };
 	std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
 	for (const auto & cf_name : names)
 	{
@@ -109,7 +112,222 @@ void nano::rocksdb_store::open (bool & error_a, boost::filesystem::path const &
 			error_a = true;
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
 		}
+		else if (!open_read_only_a)
+		{
+			if (version_l == 18)
+			{
+				upgrade_v18_to_v19 ();
+				version_l = 19;
+			}
+			if (version_l == 19)
+			{
+				upgrade_v19_to_v20 ();
+				version_l = 20;
+			}
+			if (version_l == 20)
+			{
+				upgrade_v20_to_v21 ();
+			}
+		}
+	}
+}
+
+constexpr size_t nano::rocksdb_store::upgrade_batch_size;
+
+namespace
+{
+/** Meta table key of the resume point, next to the version key 1 */
+nano::uint256_union const upgrade_resume_key (2);
+}
+
+bool nano::rocksdb_store::upgrade_resume_get (std::vector<uint8_t> & point_a)
+{
+	auto transaction (tx_begin_read ());
+	nano::rocksdb_val value;
+	auto result (!success (get (transaction, tables::meta, nano::rocksdb_val (upgrade_resume_key), value)));
+	if (!result)
+	{
+		point_a.assign (static_cast<uint8_t const *> (value.data ()), static_cast<uint8_t const *> (value.data ()) + value.size ());
+	}
+	return result;
+}
+
+void nano::rocksdb_store::upgrade_resume_put (std::vector<uint8_t> const & point_a)
+{
+	auto transaction (tx_begin_write ({ tables::meta }));
+	auto status (put (transaction, tables::meta, nano::rocksdb_val (upgrade_resume_key), nano::rocksdb_val (point_a.size (), const_cast<uint8_t *> (point_a.data ()))));
+	release_assert (success (status));
+}
+
+void nano::rocksdb_store::upgrade_finish (int version_a)
+{
+	auto transaction (tx_begin_write ({ tables::meta }));
+	auto status (del (transaction, tables::meta, nano::rocksdb_val (upgrade_resume_key)));
+	release_assert (success (status) || not_found (status));
+	version_put (transaction, version_a);
+}
+
+void nano::rocksdb_store::upgrade_v18_to_v19 ()
+{
+	logger.always_log ("Preparing v18 to v19 database upgrade...");
+	// Accounts are read in batches and their delegators loaded in bulk, a whole ledger in one transaction would be held in memory
+	nano::account start (0);
+	std::vector<uint8_t> point;
+	if (!upgrade_resume_get (point))
+	{
+		nano::bufferstream stream (point.data (), point.size ());
+		auto error (nano::try_read (stream, start.bytes));
+		release_assert (!error);
+		logger.always_log (boost::str (boost::format ("Resuming from account %1%") % start.to_account ()));
+	}
+	nano::bulk_writer writer (*this, tables::delegators);
+	std::vector<uint8_t> zero (sizeof (uint64_t), 0);
+	for (auto done (false); !done;)
+	{
+		{
+			auto transaction (tx_begin_read ());
+			auto i (latest_begin (transaction, start));
+			auto n (latest_end ());
+			for (size_t rows (0); i != n && rows < upgrade_batch_size; ++i, ++rows)
+			{
+				writer.put (nano::delegator_key (i->second.representative, i->first), zero);
+			}
+			done = i == n;
+			if (!done)
+			{
+				start = i->first;
+			}
+		}
+		release_assert (!writer.flush ());
+		if (!done)
+		{
+			point.clear ();
+			{
+				nano::vectorstream stream (point);
+				nano::write (stream, start.bytes);
+			}
+			upgrade_resume_put (point);
+		}
+	}
+	upgrade_finish (19);
+	logger.always_log (boost::str (boost::format ("Finished indexing delegators of %1% accounts") % writer.rows));
+}
+
+void nano::rocksdb_store::upgrade_v19_to_v20 ()
+{
+	logger.always_log ("Preparing v19 to v20 database upgrade...");
+	// Same batching as upgrade_v18_to_v19, resuming from the next pending key
+	nano::pending_key start;
+	std::vector<uint8_t> point;
+	if (!upgrade_resume_get (point))
+	{
+		nano::bufferstream stream (point.data (), point.size ());
+		auto error (nano::try_read (stream, start.account.bytes));
+		error = error || nano::try_read (stream, start.hash.bytes);
+		release_assert (!error);
+		logger.always_log (boost::str (boost::format ("Resuming from pending entries of account %1%") % start.account.to_account ()));
+	}
+	nano::bulk_writer writer (*this, tables::pending_amounts);
+	std::vector<uint8_t> zero (sizeof (uint64_t), 0);
+	for (auto done (false); !done;)
+	{
+		{
+			auto transaction (tx_begin_read ());
+			auto i (pending_begin (transaction, start));
+			auto n (pending_end ());
+			for (size_t rows (0); i != n && rows < upgrade_batch_size; ++i, ++rows)
+			{
+				nano::pending_key const & key (i->first);
+				writer.put (nano::pending_amount_key (key.account, i->second.amount, key.hash), zero);
+			}
+			done = i == n;
+			if (!done)
+			{
+				start = i->first;
+			}
+		}
+		release_assert (!writer.flush ());
+		if (!done)
+		{
+			point.clear ();
+			{
+				nano::vectorstream stream (point);
+				nano::write (stream, start.account.bytes);
+				nano::write (stream, start.hash.bytes);
+			}
+			upgrade_resume_put (point);
+		}
+	}
+	upgrade_finish (20);
+	logger.always_log (boost::str (boost::format ("Finished indexing %1% pending entries by amount") % writer.rows));
+}
+
+void nano::rocksdb_store::upgrade_v20_to_v21 ()
+{
+	logger.always_log ("Preparing v20 to v21 database upgrade...");
+	// Same batching as upgrade_v18_to_v19, a batch can end inside a chain so the next height and block are kept with the account
+	nano::account account (0);
+	// Zero starts the account at its open block
+	uint64_t height (0);
+	nano::block_hash hash (0);
+	std::vector<uint8_t> point;
+	if (!upgrade_resume_get (point))
+	{
+		nano::bufferstream stream (point.data (), point.size ());
+		auto error (nano::try_read (stream, account.bytes));
+		error = error || nano::try_read (stream, height);
+		error = error || nano::try_read (stream, hash.bytes);
+		release_assert (!error);
+		logger.always_log (boost::str (boost::format ("Resuming from account %1% at height %2%") % account.to_account () % height));
+	}
+	nano::bulk_writer writer (*this, tables::heights);
+	for (auto done (false); !done;)
+	{
+		{
+			auto transaction (tx_begin_read ());
+			auto i (latest_begin (transaction, account));
+			auto n (latest_end ());
+			for (size_t rows (0); i != n && rows < upgrade_batch_size;)
+			{
+				if (i->first != account || height == 0)
+				{
+					account = i->first;
+					height = 1;
+					hash = i->second.open_block;
+				}
+				for (; !hash.is_zero () && rows < upgrade_batch_size; hash = block_successor (transaction, hash), ++height, ++rows)
+				{
+					nano::account_height_key key (account, height);
+					writer.put (reinterpret_cast<uint8_t const *> (&key), sizeof (key), hash.bytes.data (), hash.bytes.size ());
+				}
+				if (hash.is_zero ())
+				{
+					++i;
+					height = 0;
+				}
+			}
+			done = i == n;
+			if (!done && height == 0)
+			{
+				account = i->first;
+			}
+		}
+		release_assert (!writer.flush ());
+		if (!done)
+		{
+			point.clear ();
+			{
+				nano::vectorstream stream (point);
+				nano::write (stream, account.bytes);
+				nano::write (stream, height);
+				nano::write (stream, hash.bytes);
+			}
+			upgrade_resume_put (point);
+			logger.always_log (boost::str (boost::format ("Database heights upgrade %1% blocks indexed") % writer.rows));
+		}
 	}
+	upgrade_finish (21);
+	logger.always_log ("Finished indexing block heights");
 }
 
 nano::write_transaction nano::rocksdb_store::tx_begin_write (std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a)
@@ -189,6 +407,14 @@ rocksdb::ColumnFamilyHandle * nano::rocksdb_store::table_to_column_family (table
 			return get_handle ("cached_counts");
 		case tables::confirmation_height:
 			return get_handle ("confirmation_height");
+		case tables::bootstrap_checkpoint:
+			return get_handle ("bootstrap_checkpoint");
+		case tables::delegators:
+			return get_handle ("delegators");
+		case tables::pending_amounts:
+			return get_handle ("pending_amounts");
+		case tables::heights:
+			return get_handle ("heights");
 		default:
 			release_assert (false);
 			return get_handle ("peers");
@@ -548,7 +774,7 @@ rocksdb::ColumnFamilyOptions nano::rocksdb_store::get_cf_options () const
 
 std::vector<nano::tables> nano::rocksdb_store::all_tables () const
 {
-	return std::vector<nano::tables>{ tables::accounts, tables::cached_counts, tables::change_blocks, tables::confirmation_height, tables::frontiers, tables::meta, tables::online_weight, tables::open_blocks, tables::peers, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked, tables::vote };
+	return std::vector<nano::tables>{ tables::accounts, tables::bootstrap_checkpoint, tables::cached_counts, tables::change_blocks, tables::confirmation_height, tables::delegators, tables::frontiers, tables::heights, tables::meta, tables::online_weight, tables::open_blocks, tables::peers, tables::pending, tables::pending_amounts, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked, tables::vote };
 }
 
 bool nano::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
@@ -624,6 +850,89 @@ void nano::rocksdb_store::rebuild_db (nano::write_transaction const & transactio
 	release_assert (false && "Not available for RocksDB");
 }
 
+void nano::rocksdb_store::table_for_each (nano::transaction const & transaction_a, nano::tables table_a, std::function<void (nano::store_entry_view const &)> const & action_a) const
+{
+	std::unique_ptr<rocksdb::Iterator> iterator;
+	if (is_read (transaction_a))
+	{
+		// Avoid evicting the working set while scanning a whole table
+		auto options (snapshot_options (transaction_a));
+		options.fill_cache = false;
+		iterator.reset (db->NewIterator (options, table_to_column_family (table_a)));
+	}
+	else
+	{
+		rocksdb::ReadOptions options;
+		options.fill_cache = false;
+		iterator.reset (tx (transaction_a)->GetIterator (options, table_to_column_family (table_a)));
+	}
+	for (iterator->SeekToFirst (); iterator->Valid (); iterator->Next ())
+	{
+		auto key (iterator->key ());
+		auto value (iterator->value ());
+		action_a (nano::store_entry_view{ reinterpret_cast<uint8_t const *> (key.data ()), key.size (), reinterpret_cast<uint8_t const *> (value.data ()), value.size () });
+	}
+	release_assert (iterator->status ().ok ());
+}
+
+bool nano::rocksdb_store::table_clear (nano::tables table_a)
+{
+	std::vector<nano::tables> tables_l{ table_a, tables::cached_counts };
+	std::sort (tables_l.begin (), tables_l.end ());
+	auto transaction (tx_begin_write (tables_l));
+	return !success (drop (transaction, table_a));
+}
+
+bool nano::rocksdb_store::table_load (nano::tables table_a, std::vector<nano::store_entry_view> const & entries_a)
+{
+	auto error (false);
+	if (!entries_a.empty ())
+	{
+		// Entries are written to a table file and moved into the column family, skipping the memtable and write ahead log
+		auto column_family (table_to_column_family (table_a));
+		auto path (boost::filesystem::path (db->GetName ()) / boost::str (boost::format ("load_%1%_%2%.sst") % column_family->GetName () % nano::random_pool::generate_word32 (0, std::numeric_limits<uint32_t>::max ())));
+		// Ingesting overwrites existing keys, only new ones are added to the cached count
+		uint64_t added (0);
+		if (is_caching_counts (table_a))
+		{
+			for (auto const & entry : entries_a)
+			{
+				rocksdb::Slice key (reinterpret_cast<char const *> (entry.key), entry.key_size);
+				std::string value;
+				if (!db->KeyMayExist (rocksdb::ReadOptions (), column_family, key, &value) || db->Get (rocksdb::ReadOptions (), column_family, key, &value).IsNotFound ())
+				{
+					++added;
+				}
+			}
+		}
+		rocksdb::SstFileWriter writer (rocksdb::EnvOptions (), rocksdb::Options (get_db_options (), get_cf_options ()), column_family);
+		auto status (writer.Open (path.string ()));
+		for (auto i (entries_a.begin ()), n (entries_a.end ()); i != n && status.ok (); ++i)
+		{
+			status = writer.Put (rocksdb::Slice (reinterpret_cast<char const *> (i->key), i->key_size), rocksdb::Slice (reinterpret_cast<char const *> (i->value), i->value_size));
+		}
+		if (status.ok ())
+		{
+			status = writer.Finish ();
+		}
+		if (status.ok ())
+		{
+			rocksdb::IngestExternalFileOptions options;
+			options.move_files = true;
+			status = db->IngestExternalFile (column_family, { path.string () }, options);
+		}
+		boost::system::error_code ec;
+		boost::filesystem::remove (path, ec);
+		error = !status.ok ();
+		if (!error && added != 0)
+		{
+			auto transaction (tx_begin_write ({ tables::cached_counts }));
+			error = !success (increment (transaction, tables::cached_counts, rocksdb_val (rocksdb::Slice (column_family->GetName ())), added));
+		}
+	}
+	return error;
+}
+
 bool nano::rocksdb_store::init_error () const
 {
 	return error;
@@ -57,6 +57,10 @@ public:
 	bool copy_db (boost::filesystem::path const & destination) override;
 	void rebuild_db (nano::write_transaction const & transaction_a) override;
 
+	void table_for_each (nano::transaction const &, nano::tables, std::function<void (nano::store_entry_view const &)> const &) const override;
+	bool table_clear (nano::tables) override;
+	bool table_load (nano::tables, std::vector<nano::store_entry_view> const &) override;
+
 	template <typename Key, typename Value>
 	nano::store_iterator<Key, Value> make_iterator (nano::transaction const & transaction_a, tables table_a) const
 	{
@@ -93,6 +97,16 @@ private:
 	int clear (rocksdb::ColumnFamilyHandle * column_family);
 
 	void open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a);
+	/** Rows read per batch by upgrades that backfill a table, each batch is loaded in its own write transactions */
+	static size_t constexpr upgrade_batch_size = 256 * 1024;
+	/** Where an upgrade interrupted after a batch continues, returns true if there is no such point */
+	bool upgrade_resume_get (std::vector<uint8_t> &);
+	void upgrade_resume_put (std::vector<uint8_t> const &);
+	/** Sets \p version_a and removes the resume point of the finished upgrade */
+	void upgrade_finish (int version_a);
+	void upgrade_v18_to_v19 ();
+	void upgrade_v19_to_v20 ();
+	void upgrade_v20_to_v21 ();
 	uint64_t count (nano::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle) const;
 	bool is_caching_counts (nano::tables table_a) const;
 
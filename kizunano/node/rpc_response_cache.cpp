@@ -0,0 +1,105 @@
+#include <kizunano/lib/blocks.hpp>
+#include <kizunano/lib/stats.hpp>
+#include <kizunano/node/rpc_response_cache.hpp>
+
+nano::rpc_response_cache::rpc_response_cache (size_t max_a, nano::stat & stats_a) :
+max (max_a),
+stats (stats_a)
+{
+}
+
+bool nano::rpc_response_cache::enabled () const
+{
+	return max != 0;
+}
+
+bool nano::rpc_response_cache::get (std::string const & key_a, std::string & response_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (entries.get<tag_key> ().find (key_a));
+	auto result (existing != entries.get<tag_key> ().end ());
+	if (result)
+	{
+		response_a = existing->response;
+		// Most recently used responses are evicted last
+		entries.relocate (entries.end (), entries.project<tag_sequence> (existing));
+	}
+	stats.inc (nano::stat::type::rpc, result ? nano::stat::detail::cache_hit : nano::stat::detail::cache_miss);
+	return result;
+}
+
+uint64_t nano::rpc_response_cache::generation () const
+{
+	return generation_m;
+}
+
+void nano::rpc_response_cache::put (std::string const & key_a, std::string const & response_a, std::vector<nano::account> const & accounts_a, uint64_t generation_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	if (enabled () && generation_m == generation_a)
+	{
+		erase (key_a);
+		entries.get<tag_sequence> ().push_back (entry{ key_a, response_a });
+		for (auto const & account : accounts_a)
+		{
+			dependencies.insert (dependency{ account, key_a });
+		}
+		if (entries.size () > max)
+		{
+			erase (entries.get<tag_sequence> ().front ().key);
+		}
+	}
+}
+
+void nano::rpc_response_cache::invalidate (nano::account const & account_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	++generation_m;
+	auto range (dependencies.get<tag_account> ().equal_range (account_a));
+	std::vector<std::string> keys;
+	for (auto i (range.first); i != range.second; ++i)
+	{
+		keys.push_back (i->key);
+	}
+	for (auto const & key : keys)
+	{
+		erase (key);
+	}
+}
+
+void nano::rpc_response_cache::invalidate (nano::block const & block_a)
+{
+	invalidate (block_a.account ().is_zero () ? block_a.sideband ().account : block_a.account ());
+	// Pending entries of the destination change with sends, the link of other state blocks matches no response
+	auto send_block (dynamic_cast<nano::send_block const *> (&block_a));
+	auto state_block (dynamic_cast<nano::state_block const *> (&block_a));
+	if (send_block != nullptr)
+	{
+		invalidate (send_block->hashables.destination);
+	}
+	else if (state_block != nullptr && !state_block->hashables.link.is_zero ())
+	{
+		invalidate (state_block->hashables.link);
+	}
+}
+
+size_t nano::rpc_response_cache::size ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+void nano::rpc_response_cache::erase (std::string const & key_a)
+{
+	entries.get<tag_key> ().erase (key_a);
+	dependencies.get<tag_key> ().erase (key_a);
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (rpc_response_cache & rpc_response_cache, const std::string & name)
+{
+	nano::lock_guard<std::mutex> lock (rpc_response_cache.mutex);
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", rpc_response_cache.entries.size (), sizeof (decltype (rpc_response_cache.entries)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "dependencies", rpc_response_cache.dependencies.size (), sizeof (decltype (rpc_response_cache.dependencies)::value_type) }));
+	return composite;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <kizunano/lib/utility.hpp>
+#include <kizunano/secure/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+class block;
+class stat;
+
+/**
+ * Serialized responses of read-only RPC actions, keyed by action and canonical parameters.
+ * Each response records the accounts it was built from and is dropped when the ledger changes one of them.
+ * A ledger generation, increased on every invalidation, keeps responses read before a change from being cached after it.
+ */
+class rpc_response_cache final
+{
+public:
+	rpc_response_cache (size_t, nano::stat &);
+	bool enabled () const;
+	/** Copies the response cached under \p key_a into \p response_a, returns true if there is one */
+	bool get (std::string const & key_a, std::string & response_a);
+	/** Generation to read before building a response and to pass back to put */
+	uint64_t generation () const;
+	/** Caches \p response_a unless an invalidation happened since \p generation_a was read */
+	void put (std::string const & key_a, std::string const & response_a, std::vector<nano::account> const & accounts_a, uint64_t generation_a);
+	/** Drops responses built from \p account_a, called after the change is committed */
+	void invalidate (nano::account const & account_a);
+	/** Drops responses built from the account of \p block_a or from the account it sends to */
+	void invalidate (nano::block const & block_a);
+	size_t size ();
+
+private:
+	class entry final
+	{
+	public:
+		std::string key;
+		std::string response;
+	};
+	class dependency final
+	{
+	public:
+		nano::account account;
+		std::string key;
+	};
+	void erase (std::string const &);
+	// clang-format off
+	class tag_sequence {};
+	class tag_key {};
+	class tag_account {};
+	using ordered_entries = boost::multi_index_container<entry,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequence>>,
+		mi::hashed_unique<mi::tag<tag_key>,
+			mi::member<entry, std::string, &entry::key>>>>;
+	using ordered_dependencies = boost::multi_index_container<dependency,
+	mi::indexed_by<
+		mi::hashed_non_unique<mi::tag<tag_account>,
+			mi::member<dependency, nano::account, &dependency::account>>,
+		mi::hashed_non_unique<mi::tag<tag_key>,
+			mi::member<dependency, std::string, &dependency::key>>>>;
+	// clang-format on
+	ordered_entries entries;
+	ordered_dependencies dependencies;
+	std::atomic<uint64_t> generation_m{ 0 };
+	size_t const max;
+	nano::stat & stats;
+	std::mutex mutex;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (rpc_response_cache &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (rpc_response_cache & rpc_response_cache, const std::string & name);
+}
@@ -119,9 +119,15 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 			auto node_id (channel_a->get_node_id ());
 			if (!channel_a->temporary)
 			{
-				channels.get<node_id_tag> ().erase (node_id);
+				auto existing_node_id (channels.get<node_id_tag> ().equal_range (node_id));
+				for (auto i (existing_node_id.first); i != existing_node_id.second; ++i)
+				{
+					sampler.erase (*i->channel);
+				}
+				channels.get<node_id_tag> ().erase (existing_node_id.first, existing_node_id.second);
 			}
 			channels.get<endpoint_tag> ().emplace (channel_a, socket_a, bootstrap_server_a);
+			sampler.insert (channel_a);
 			attempts.get<endpoint_tag> ().erase (endpoint);
 			error = false;
 			lock.unlock ();
@@ -138,7 +144,12 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 void nano::transport::tcp_channels::erase (nano::tcp_endpoint const & endpoint_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
+	if (existing != channels.get<endpoint_tag> ().end ())
+	{
+		sampler.erase (*existing->channel);
+		channels.get<endpoint_tag> ().erase (existing);
+	}
 }
 
 size_t nano::transport::tcp_channels::size () const
@@ -161,28 +172,23 @@ std::shared_ptr<nano::transport::channel_tcp> nano::transport::tcp_channels::fin
 
 std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::tcp_channels::random_set (size_t count_a, uint8_t min_version, bool include_temporary_channels_a) const
 {
-	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
-	result.reserve (count_a);
-	nano::lock_guard<std::mutex> lock (mutex);
-	// Stop trying to fill result with random samples after this many attempts
-	auto random_cutoff (count_a * 2);
-	auto peers_size (channels.size ());
-	// Usually count_a will be much smaller than peers.size()
-	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
-	{
-		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
-		{
-			auto index (nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (peers_size - 1)));
+	// Sampled without the channels mutex
+	auto sample (sampler.sample (count_a, [min_version, include_temporary_channels_a](nano::transport::channel const & channel_a) {
+		return channel_a.get_network_version () >= min_version && (include_temporary_channels_a || !static_cast<nano::transport::channel_tcp const &> (channel_a).temporary);
+	}));
+	return std::unordered_set<std::shared_ptr<nano::transport::channel>> (sample.begin (), sample.end ());
+}
 
-			auto channel = channels.get<random_access_tag> ()[index].channel;
-			if (channel->get_network_version () >= min_version && (include_temporary_channels_a || !channel->temporary))
-			{
-				result.insert (channel);
-			}
-		}
-	}
-	return result;
+std::vector<std::shared_ptr<nano::transport::channel>> nano::transport::tcp_channels::random_set_weighted (size_t count_a, uint8_t min_version) const
+{
+	return sampler.sample_weighted (count_a, [min_version](nano::transport::channel const & channel_a) {
+		return channel_a.get_network_version () >= min_version;
+	});
+}
+
+void nano::transport::tcp_channels::set_sampling_weight (nano::transport::channel const & channel_a, uint64_t weight_a)
+{
+	sampler.set_weight (channel_a, weight_a);
 }
 
 void nano::transport::tcp_channels::random_fill (std::array<nano::endpoint, 8> & target_a) const
@@ -212,6 +218,13 @@ bool nano::transport::tcp_channels::store_all (bool clear_peers)
 		std::transform (channels.begin (), channels.end (),
 		std::back_inserter (endpoints), [](const auto & channel) { return nano::transport::map_tcp_to_endpoint (channel.endpoint ()); });
 	}
+	// Bootstrap scores are stored with the peers so they outlive a restart
+	std::vector<nano::peer_info> infos;
+	infos.reserve (endpoints.size ());
+	for (auto const & endpoint : endpoints)
+	{
+		infos.push_back (node.bootstrap_initiator.connections->peer_info (nano::transport::map_endpoint_to_tcp (endpoint)));
+	}
 	bool result (false);
 	if (!endpoints.empty ())
 	{
@@ -221,10 +234,11 @@ bool nano::transport::tcp_channels::store_all (bool clear_peers)
 		{
 			node.store.peer_clear (transaction);
 		}
-		for (auto endpoint : endpoints)
+		for (size_t i (0), n (endpoints.size ()); i < n; ++i)
 		{
+			auto const & endpoint (endpoints[i]);
 			nano::endpoint_key endpoint_key (endpoint.address ().to_v6 ().to_bytes (), endpoint.port ());
-			node.store.peer_put (transaction, std::move (endpoint_key));
+			node.store.peer_put (transaction, endpoint_key, infos[i]);
 		}
 		result = true;
 	}
@@ -269,10 +283,56 @@ void nano::transport::tcp_channels::process_messages ()
 {
 	while (!stopped)
 	{
-		auto item (node.network.tcp_message_manager.get_message ());
-		if (item.message != nullptr)
+		auto items (node.network.tcp_message_manager.get_messages ());
+		filter_publishes (items);
+		for (auto const & item : items)
 		{
-			process_message (*item.message, item.endpoint, item.node_id, item.socket, item.type);
+			if (item.message != nullptr)
+			{
+				process_message (*item.message, item.endpoint, item.node_id, item.socket, item.type);
+			}
+		}
+	}
+}
+
+void nano::transport::tcp_channels::filter_publishes (std::vector<nano::tcp_message_item> & items_a)
+{
+	std::vector<nano::tcp_message_item *> publishes;
+	std::vector<std::vector<uint8_t>> payloads;
+	for (auto & item : items_a)
+	{
+		if (item.message != nullptr && item.message->header.type == nano::message_type::publish)
+		{
+			// The block serialization is the publish payload, which is what the parsers hash
+			payloads.emplace_back ();
+			{
+				nano::vectorstream stream (payloads.back ());
+				static_cast<nano::publish &> (*item.message).block->serialize (stream);
+			}
+			publishes.push_back (&item);
+		}
+	}
+	if (!publishes.empty ())
+	{
+		std::vector<std::pair<uint8_t const *, size_t>> bytes;
+		bytes.reserve (payloads.size ());
+		for (auto const & payload : payloads)
+		{
+			bytes.emplace_back (payload.data (), payload.size ());
+		}
+		std::vector<nano::uint128_t> digests;
+		auto existed (node.network.publish_filter.apply (bytes, &digests));
+		for (size_t i (0); i < publishes.size (); ++i)
+		{
+			if (existed[i])
+			{
+				node.stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish);
+				publishes[i]->message = nullptr;
+			}
+			else
+			{
+				static_cast<nano::publish &> (*publishes[i]->message).digest = digests[i];
+			}
 		}
 	}
 }
@@ -349,6 +409,7 @@ void nano::transport::tcp_channels::stop ()
 		}
 	}
 	channels.clear ();
+	sampler.clear ();
 	node_id_handshake_sockets.clear ();
 }
 
@@ -399,6 +460,7 @@ std::unique_ptr<nano::container_info_component> nano::transport::tcp_channels::c
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "node_id_handshake_sockets", node_id_handshake_sockets_count, sizeof (decltype (node_id_handshake_sockets)::value_type) }));
+	composite->add_component (sampler.collect_container_info ("sampler"));
 
 	return composite;
 }
@@ -407,6 +469,10 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 {
 	nano::lock_guard<std::mutex> lock (mutex);
 	auto disconnect_cutoff (channels.get<last_packet_sent_tag> ().lower_bound (cutoff_a));
+	for (auto i (channels.get<last_packet_sent_tag> ().begin ()); i != disconnect_cutoff; ++i)
+	{
+		sampler.erase (*i->channel);
+	}
 	channels.get<last_packet_sent_tag> ().erase (channels.get<last_packet_sent_tag> ().begin (), disconnect_cutoff);
 	// Remove keepalive attempt tracking for attempts older than cutoff
 	auto attempts_cutoff (attempts.get<last_attempt_tag> ().lower_bound (cutoff_a));
@@ -414,6 +480,10 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 
 	// Check if any tcp channels belonging to old protocol versions which may still be alive due to async operations
 	auto lower_bound = channels.get<version_tag> ().lower_bound (node.network_params.protocol.protocol_version_min (node.ledger.cache.epoch_2_started));
+	for (auto i (channels.get<version_tag> ().begin ()); i != lower_bound; ++i)
+	{
+		sampler.erase (*i->channel);
+	}
 	channels.get<version_tag> ().erase (channels.get<version_tag> ().begin (), lower_bound);
 
 	// Cleanup any sockets which may still be existing from failed node id handshakes
@@ -647,6 +717,10 @@ void nano::transport::tcp_channels::start_tcp_receive_node_id (std::shared_ptr<n
 								if (process)
 								{
 									channel_a->set_node_id (node_id);
+									if (header.node_id_handshake_is_block_announce_capable ())
+									{
+										node_l->network.block_announcer.set_capable (node_id);
+									}
 									channel_a->set_last_packet_received (std::chrono::steady_clock::now ());
 									boost::optional<std::pair<nano::account, nano::signature>> response (std::make_pair (node_l->node_id.pub, nano::sign_message (node_l->node_id.prv, node_l->node_id.pub, *message.query)));
 									nano::node_id_handshake response_message (boost::none, response);
@@ -97,6 +97,8 @@ namespace transport
 		std::shared_ptr<nano::transport::channel_tcp> find_channel (nano::tcp_endpoint const &) const;
 		void random_fill (std::array<nano::endpoint, 8> &) const;
 		std::unordered_set<std::shared_ptr<nano::transport::channel>> random_set (size_t, uint8_t = 0, bool = false) const;
+		std::vector<std::shared_ptr<nano::transport::channel>> random_set_weighted (size_t, uint8_t = 0) const;
+		void set_sampling_weight (nano::transport::channel const &, uint64_t);
 		bool store_all (bool = true);
 		std::shared_ptr<nano::transport::channel_tcp> find_node_id (nano::account const &);
 		// Get the next peer for attempting a tcp connection
@@ -105,6 +107,8 @@ namespace transport
 		void start ();
 		void stop ();
 		void process_messages ();
+		// Applies the publish filter to the publishes of a batch at once, dropping duplicates and recording the digest of the rest
+		void filter_publishes (std::vector<nano::tcp_message_item> &);
 		void process_message (nano::message const &, nano::tcp_endpoint const &, nano::account const &, std::shared_ptr<nano::socket>, nano::bootstrap_server_type);
 		bool max_ip_connections (nano::tcp_endpoint const &);
 		// Should we reach out to this endpoint with a keepalive message
@@ -229,6 +233,8 @@ namespace transport
 				mi::member<tcp_endpoint_attempt, std::chrono::steady_clock::time_point, &tcp_endpoint_attempt::last_attempt>>>>
 		attempts;
 		// clang-format on
+		/** Mirrors channels for sampling, updated under mutex */
+		nano::transport::channel_sampler sampler;
 		// This owns the sockets until the node_id_handshake has been completed. Needed to prevent self referencing callbacks, they are periodically removed if any are dangling.
 		std::vector<std::shared_ptr<nano::socket>> node_id_handshake_sockets;
 		std::atomic<bool> stopped{ false };
@@ -55,6 +55,10 @@ public:
 	{
 		result = nano::stat::detail::telemetry_ack;
 	}
+	void block_announce (nano::block_announce const & message_a) override
+	{
+		result = nano::stat::detail::block_announce;
+	}
 	nano::stat::detail result;
 };
 }
@@ -85,21 +89,29 @@ node (node_a)
 	set_network_version (node_a.network_params.protocol.protocol_version);
 }
 
-void nano::transport::channel::send (nano::message const & message_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a)
+nano::stat::detail nano::transport::message_detail (nano::message const & message_a)
 {
 	callback_visitor visitor;
 	message_a.visit (visitor);
+	return visitor.result;
+}
+
+void nano::transport::channel::send (nano::message const & message_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a)
+{
 	auto buffer (message_a.to_shared_const_buffer (node.ledger.cache.epoch_2_started));
-	auto detail (visitor.result);
+	auto detail (nano::transport::message_detail (message_a));
 	auto is_droppable_by_limiter = drop_policy_a == nano::buffer_drop_policy::limiter;
-	auto should_drop (node.network.limiter.should_drop (buffer.size ()));
-	if (!is_droppable_by_limiter || !should_drop)
+	// Non-droppable messages are still charged so they count against the budget of subsequent traffic
+	auto limited (node.network.limiter.should_drop (buffer.size (), detail, get_endpoint ()));
+	if (!is_droppable_by_limiter || limited == nano::bandwidth_limiter::level::none)
 	{
 		send_buffer (buffer, detail, callback_a, drop_policy_a);
 		node.stats.inc (nano::stat::type::message, detail, nano::stat::dir::out);
+		node.stats.add (nano::stat::type::bandwidth, detail, nano::stat::dir::out, buffer.size ());
 	}
 	else
 	{
+		node.stats.inc_detail_only (nano::stat::type::drop, limited == nano::bandwidth_limiter::level::peer ? nano::stat::detail::peer_limit : nano::stat::detail::global_limit, nano::stat::dir::out);
 		if (callback_a)
 		{
 			node.background ([callback_a]() {
@@ -225,12 +237,271 @@ bool nano::transport::reserved_address (nano::endpoint const & endpoint_a, bool
 
 using namespace std::chrono_literals;
 
-nano::bandwidth_limiter::bandwidth_limiter (const double limit_burst_ratio_a, const size_t limit_a) :
-bucket (limit_a * limit_burst_ratio_a, limit_a)
+namespace
 {
+/** Share \p ratio_a of \p limit_a, kept non-zero for a non-zero limit as zero means unbounded */
+size_t limit_share (size_t limit_a, double ratio_a)
+{
+	return limit_a == 0 ? 0 : std::max<size_t> (1, static_cast<size_t> (limit_a * ratio_a));
+}
 }
 
-bool nano::bandwidth_limiter::should_drop (const size_t & message_size_a)
+nano::bandwidth_limiter::peer_bucket::peer_bucket (size_t max_token_count_a, size_t refill_rate_a) :
+bucket (max_token_count_a, refill_rate_a),
+last_use (std::chrono::steady_clock::now ())
 {
-	return !bucket.try_consume (message_size_a);
+}
+
+nano::bandwidth_limiter::bandwidth_limiter (const double limit_burst_ratio_a, const size_t limit_a, const double vote_ratio_a, const size_t peer_limit_a) :
+burst_ratio (limit_burst_ratio_a),
+peer_limit (peer_limit_a),
+bucket (limit_share (limit_a, 1. - vote_ratio_a) * limit_burst_ratio_a, limit_share (limit_a, 1. - vote_ratio_a)),
+has_vote_reserve (limit_a != 0 && vote_ratio_a > 0.),
+vote_bucket (limit_share (limit_a, vote_ratio_a) * limit_burst_ratio_a, limit_share (limit_a, vote_ratio_a))
+{
+	debug_assert (vote_ratio_a >= 0. && vote_ratio_a < 1.);
+}
+
+nano::bandwidth_limiter::level nano::bandwidth_limiter::should_drop (size_t message_size_a, nano::stat::detail detail_a, nano::endpoint const & endpoint_a)
+{
+	auto result (level::none);
+	// Held until the global level decided, so that the peer can be refunded before purge may erase it
+	nano::unique_lock<std::mutex> lock (peers_mutex, std::defer_lock);
+	nano::rate::token_bucket * peer_bucket_l (nullptr);
+	if (peer_limit != 0)
+	{
+		lock.lock ();
+		auto existing (peers.find (endpoint_a));
+		if (existing == peers.end ())
+		{
+			existing = peers.emplace (std::piecewise_construct, std::forward_as_tuple (endpoint_a), std::forward_as_tuple (static_cast<size_t> (peer_limit * burst_ratio), peer_limit)).first;
+		}
+		existing->second.last_use = std::chrono::steady_clock::now ();
+		if (existing->second.bucket.try_consume (message_size_a))
+		{
+			peer_bucket_l = &existing->second.bucket;
+		}
+		else
+		{
+			result = level::peer;
+		}
+	}
+	if (result == level::none)
+	{
+		auto reserved (has_vote_reserve && is_vote (detail_a) && vote_bucket.try_consume (message_size_a));
+		if (!reserved && !bucket.try_consume (message_size_a))
+		{
+			result = level::global;
+			// The peer is only charged for messages which are sent
+			if (peer_bucket_l != nullptr)
+			{
+				peer_bucket_l->refund (message_size_a);
+			}
+		}
+	}
+	return result;
+}
+
+void nano::bandwidth_limiter::purge (std::chrono::steady_clock::time_point const & cutoff_a)
+{
+	nano::lock_guard<std::mutex> lock (peers_mutex);
+	for (auto i (peers.begin ()), n (peers.end ()); i != n;)
+	{
+		if (i->second.last_use < cutoff_a)
+		{
+			i = peers.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+size_t nano::bandwidth_limiter::peer_count () const
+{
+	nano::lock_guard<std::mutex> lock (peers_mutex);
+	return peers.size ();
+}
+
+bool nano::bandwidth_limiter::is_vote (nano::stat::detail detail_a)
+{
+	return detail_a == nano::stat::detail::confirm_ack || detail_a == nano::stat::detail::confirm_req;
+}
+
+std::unique_ptr<nano::container_info_component> nano::bandwidth_limiter::collect_container_info (std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", peer_count (), sizeof (decltype (peers)::value_type) }));
+	return composite;
+}
+
+void nano::transport::channel_sampler::insert (std::shared_ptr<nano::transport::channel> const & channel_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	if (positions.emplace (channel_a.get (), entries.size ()).second)
+	{
+		auto index (entries.size ());
+		entries.push_back ({ channel_a, base_weight });
+		// The new tree node covers entries (index + 1 - lowbit (index + 1), index + 1]
+		auto node (index + 1);
+		tree.push_back (base_weight + prefix (index) - prefix (node - (node & (~node + 1))));
+	}
+}
+
+void nano::transport::channel_sampler::erase (nano::transport::channel const & channel_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (positions.find (&channel_a));
+	if (existing != positions.end ())
+	{
+		auto index (existing->second);
+		positions.erase (existing);
+		auto last (entries.size () - 1);
+		auto last_weight (entries[last].weight);
+		if (index != last)
+		{
+			// Move the last entry into the hole so the array stays dense
+			add (index, last_weight - entries[index].weight);
+			entries[index] = std::move (entries[last]);
+			positions[entries[index].channel.get ()] = index;
+		}
+		// No remaining tree node covers the last entry once it is zeroed
+		add (last, ~last_weight + 1);
+		entries.pop_back ();
+		tree.pop_back ();
+	}
+}
+
+void nano::transport::channel_sampler::clear ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	entries.clear ();
+	positions.clear ();
+	tree.assign (1, 0);
+}
+
+bool nano::transport::channel_sampler::set_weight (nano::transport::channel const & channel_a, uint64_t weight_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (positions.find (&channel_a));
+	auto error (existing == positions.end ());
+	if (!error)
+	{
+		auto & entry (entries[existing->second]);
+		add (existing->second, weight_a - entry.weight);
+		entry.weight = weight_a;
+	}
+	return error;
+}
+
+std::vector<std::shared_ptr<nano::transport::channel>> nano::transport::channel_sampler::sample (size_t count_a, filter_t const & filter_a) const
+{
+	std::vector<std::shared_ptr<nano::transport::channel>> result;
+	result.reserve (count_a);
+	nano::lock_guard<std::mutex> lock (mutex);
+	// Partial Fisher-Yates shuffle over a virtual permutation, only the swapped positions are stored
+	std::unordered_map<size_t, size_t> swapped;
+	auto at = [&swapped](size_t index_a) {
+		auto existing (swapped.find (index_a));
+		return existing != swapped.end () ? existing->second : index_a;
+	};
+	for (size_t i (0), n (entries.size ()); i < n && result.size () < count_a; ++i)
+	{
+		auto j (nano::random_pool::generate_word32 (static_cast<unsigned> (i), static_cast<unsigned> (n - 1)));
+		auto index (at (j));
+		swapped[j] = at (i);
+		auto const & channel (entries[index].channel);
+		if (filter_a == nullptr || filter_a (*channel))
+		{
+			result.push_back (channel);
+		}
+	}
+	return result;
+}
+
+std::vector<std::shared_ptr<nano::transport::channel>> nano::transport::channel_sampler::sample_weighted (size_t count_a, filter_t const & filter_a) const
+{
+	std::vector<std::shared_ptr<nano::transport::channel>> result;
+	result.reserve (count_a);
+	nano::lock_guard<std::mutex> lock (mutex);
+	// Drawn entries are zeroed so they cannot be drawn again, then restored
+	std::vector<size_t> drawn;
+	auto total (prefix (entries.size ()));
+	while (result.size () < count_a && total > 0)
+	{
+		uint64_t random ((static_cast<uint64_t> (nano::random_pool::generate_word32 (0, std::numeric_limits<uint32_t>::max ())) << 32) | nano::random_pool::generate_word32 (0, std::numeric_limits<uint32_t>::max ()));
+		auto index (find (random % total));
+		auto const & entry (entries[index]);
+		debug_assert (entry.weight > 0);
+		add (index, ~entry.weight + 1);
+		total -= entry.weight;
+		drawn.push_back (index);
+		if (filter_a == nullptr || filter_a (*entry.channel))
+		{
+			result.push_back (entry.channel);
+		}
+	}
+	for (auto index : drawn)
+	{
+		add (index, entries[index].weight);
+	}
+	return result;
+}
+
+size_t nano::transport::channel_sampler::size () const
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::transport::channel_sampler::collect_container_info (std::string const & name)
+{
+	size_t entries_count;
+	{
+		nano::lock_guard<std::mutex> guard (mutex);
+		entries_count = entries.size ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", entries_count, sizeof (decltype (entries)::value_type) + sizeof (decltype (positions)::value_type) + sizeof (decltype (tree)::value_type) }));
+	return composite;
+}
+
+void nano::transport::channel_sampler::add (size_t index_a, uint64_t delta_a) const
+{
+	for (auto i (index_a + 1); i < tree.size (); i += i & (~i + 1))
+	{
+		tree[i] += delta_a;
+	}
+}
+
+uint64_t nano::transport::channel_sampler::prefix (size_t count_a) const
+{
+	uint64_t result (0);
+	for (auto i (count_a); i > 0; i -= i & (~i + 1))
+	{
+		result += tree[i];
+	}
+	return result;
+}
+
+size_t nano::transport::channel_sampler::find (uint64_t target_a) const
+{
+	auto size (tree.size () - 1);
+	size_t step (1);
+	while (step * 2 <= size)
+	{
+		step *= 2;
+	}
+	size_t position (0);
+	for (; step > 0; step /= 2)
+	{
+		if (position + step <= size && tree[position + step] <= target_a)
+		{
+			position += step;
+			target_a -= tree[position];
+		}
+	}
+	debug_assert (position < entries.size ());
+	return position;
 }
@@ -6,17 +6,55 @@
 #include <kizunano/node/common.hpp>
 #include <kizunano/node/socket.hpp>
 
+#include <unordered_map>
+
 namespace nano
 {
+/**
+ * Hierarchical token bucket limiter for one traffic direction.
+ * A message is first charged to the bucket of the peer it is exchanged with, then to its message class:
+ * votes (confirm_req and confirm_ack) draw from a share of the global limit reserved for them before borrowing
+ * from the shared remainder, while every other message only draws from the shared remainder.
+ * The peer is refunded when the global level rejects a message, so it is only charged for messages actually sent.
+ * Bootstrap requests are charged like other messages, bootstrap server responses are written to their socket directly and are not limited.
+ */
 class bandwidth_limiter final
 {
 public:
+	/** Level of the hierarchy which rejected a message */
+	enum class level
+	{
+		none,
+		peer,
+		global
+	};
 	// initialize with limit 0 = unbounded
-	bandwidth_limiter (const double, const size_t);
-	bool should_drop (const size_t &);
+	bandwidth_limiter (const double, const size_t, const double vote_ratio_a = 0., const size_t peer_limit_a = 0);
+	/** Charges \p message_size_a bytes of message type \p detail_a exchanged with \p endpoint_a, returns the level which rejected it, if any */
+	level should_drop (size_t message_size_a, nano::stat::detail detail_a, nano::endpoint const & endpoint_a);
+	/** Forget peers which have not exchanged any traffic since \p cutoff_a */
+	void purge (std::chrono::steady_clock::time_point const & cutoff_a);
+	size_t peer_count () const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const &);
+	static bool is_vote (nano::stat::detail);
 
 private:
+	class peer_bucket final
+	{
+	public:
+		peer_bucket (size_t, size_t);
+		nano::rate::token_bucket bucket;
+		std::chrono::steady_clock::time_point last_use;
+	};
+	double const burst_ratio;
+	size_t const peer_limit;
+	/** Global limit less the vote reserve */
 	nano::rate::token_bucket bucket;
+	/** Only consulted when a vote reserve is configured, as a zero limit means unbounded */
+	bool const has_vote_reserve;
+	nano::rate::token_bucket vote_bucket;
+	std::unordered_map<nano::endpoint, peer_bucket> peers;
+	mutable std::mutex peers_mutex;
 };
 
 namespace transport
@@ -25,6 +63,8 @@ namespace transport
 	nano::endpoint map_endpoint_to_v6 (nano::endpoint const &);
 	nano::endpoint map_tcp_to_endpoint (nano::tcp_endpoint const &);
 	nano::tcp_endpoint map_endpoint_to_tcp (nano::endpoint const &);
+	/** Message level stat detail of \p message_a, used for both traffic accounting and limiting */
+	nano::stat::detail message_detail (nano::message const & message_a);
 	// Unassigned, reserved, self
 	bool reserved_address (nano::endpoint const &, bool = false);
 	static std::chrono::seconds constexpr syn_cookie_cutoff = std::chrono::seconds (5);
@@ -132,6 +172,51 @@ namespace transport
 	protected:
 		nano::node & node;
 	};
+
+	/**
+	 * Indexed set of channels supporting uniform and weight-biased sampling of distinct channels.
+	 * Channels are kept in a dense array next to a Fenwick tree of their weights, so insertions, erasures and weight changes are O(log n) and can be applied as channels come and go.
+	 * Sampling k channels costs O(k) draws (O(k log n) when weighted) under this container's own mutex, independent of the owning channel container's lock.
+	 * @note This class is thread-safe.
+	 */
+	class channel_sampler final
+	{
+	public:
+		using filter_t = std::function<bool(nano::transport::channel const &)>;
+		/** Weight of channels which are not known representatives */
+		static uint64_t constexpr base_weight = 1;
+
+		void insert (std::shared_ptr<nano::transport::channel> const &);
+		void erase (nano::transport::channel const &);
+		void clear ();
+		/** Sets the sampling weight of \p channel_a if present, returns true if it is not */
+		bool set_weight (nano::transport::channel const & channel_a, uint64_t weight_a);
+		/** Up to \p count_a distinct channels accepted by \p filter_a, each equally likely */
+		std::vector<std::shared_ptr<nano::transport::channel>> sample (size_t count_a, filter_t const & filter_a = nullptr) const;
+		/** Up to \p count_a distinct channels accepted by \p filter_a, drawn without replacement with probability proportional to their weight */
+		std::vector<std::shared_ptr<nano::transport::channel>> sample_weighted (size_t count_a, filter_t const & filter_a = nullptr) const;
+		size_t size () const;
+		std::unique_ptr<container_info_component> collect_container_info (std::string const &);
+
+	private:
+		class entry final
+		{
+		public:
+			std::shared_ptr<nano::transport::channel> channel;
+			uint64_t weight;
+		};
+		/** Adds \p delta_a to the weight at \p index_a in the Fenwick tree */
+		void add (size_t index_a, uint64_t delta_a) const;
+		/** Sum of weights of entries [0, \p count_a) */
+		uint64_t prefix (size_t count_a) const;
+		/** Index of the entry whose cumulative weight range contains \p target_a */
+		size_t find (uint64_t target_a) const;
+		std::vector<entry> entries;
+		std::unordered_map<nano::transport::channel const *, size_t> positions;
+		/** 1-based Fenwick tree over entry weights, mutable as weighted sampling temporarily zeroes drawn entries */
+		mutable std::vector<uint64_t> tree{ 0 };
+		mutable std::mutex mutex;
+	};
 } // namespace transport
 } // namespace nano
 
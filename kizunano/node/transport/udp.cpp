@@ -116,6 +116,7 @@ std::shared_ptr<nano::transport::channel_udp> nano::transport::udp_channels::ins
 		{
 			result = std::make_shared<nano::transport::channel_udp> (*this, endpoint_a, network_version_a);
 			channels.get<endpoint_tag> ().insert (result);
+			sampler.insert (result);
 			attempts.get<endpoint_tag> ().erase (endpoint_a);
 			lock.unlock ();
 			node.network.channel_observer (result);
@@ -127,7 +128,12 @@ std::shared_ptr<nano::transport::channel_udp> nano::transport::udp_channels::ins
 void nano::transport::udp_channels::erase (nano::endpoint const & endpoint_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
+	if (existing != channels.get<endpoint_tag> ().end ())
+	{
+		sampler.erase (*existing->channel);
+		channels.get<endpoint_tag> ().erase (existing);
+	}
 }
 
 size_t nano::transport::udp_channels::size () const
@@ -150,27 +156,23 @@ std::shared_ptr<nano::transport::channel_udp> nano::transport::udp_channels::cha
 
 std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::udp_channels::random_set (size_t count_a, uint8_t min_version) const
 {
-	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
-	result.reserve (count_a);
-	nano::lock_guard<std::mutex> lock (mutex);
-	// Stop trying to fill result with random samples after this many attempts
-	auto random_cutoff (count_a * 2);
-	auto peers_size (channels.size ());
-	// Usually count_a will be much smaller than peers.size()
-	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
-	{
-		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
-		{
-			auto index (nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (peers_size - 1)));
-			auto channel = channels.get<random_access_tag> ()[index].channel;
-			if (channel->get_network_version () >= min_version)
-			{
-				result.insert (channel);
-			}
-		}
-	}
-	return result;
+	// Sampled without the channels mutex
+	auto sample (sampler.sample (count_a, [min_version](nano::transport::channel const & channel_a) {
+		return channel_a.get_network_version () >= min_version;
+	}));
+	return std::unordered_set<std::shared_ptr<nano::transport::channel>> (sample.begin (), sample.end ());
+}
+
+std::vector<std::shared_ptr<nano::transport::channel>> nano::transport::udp_channels::random_set_weighted (size_t count_a, uint8_t min_version) const
+{
+	return sampler.sample_weighted (count_a, [min_version](nano::transport::channel const & channel_a) {
+		return channel_a.get_network_version () >= min_version;
+	});
+}
+
+void nano::transport::udp_channels::set_sampling_weight (nano::transport::channel const & channel_a, uint64_t weight_a)
+{
+	sampler.set_weight (channel_a, weight_a);
 }
 
 void nano::transport::udp_channels::random_fill (std::array<nano::endpoint, 8> & target_a) const
@@ -200,6 +202,13 @@ bool nano::transport::udp_channels::store_all (bool clear_peers)
 		std::transform (channels.begin (), channels.end (),
 		std::back_inserter (endpoints), [](const auto & channel) { return channel.endpoint (); });
 	}
+	// Bootstrap scores are stored with the peers so they outlive a restart
+	std::vector<nano::peer_info> infos;
+	infos.reserve (endpoints.size ());
+	for (auto const & endpoint : endpoints)
+	{
+		infos.push_back (node.bootstrap_initiator.connections->peer_info (nano::transport::map_endpoint_to_tcp (endpoint)));
+	}
 	bool result (false);
 	if (!endpoints.empty ())
 	{
@@ -209,10 +218,11 @@ bool nano::transport::udp_channels::store_all (bool clear_peers)
 		{
 			node.store.peer_clear (transaction);
 		}
-		for (auto endpoint : endpoints)
+		for (size_t i (0), n (endpoints.size ()); i < n; ++i)
 		{
+			auto const & endpoint (endpoints[i]);
 			nano::endpoint_key endpoint_key (endpoint.address ().to_v6 ().to_bytes (), endpoint.port ());
-			node.store.peer_put (transaction, std::move (endpoint_key));
+			node.store.peer_put (transaction, endpoint_key, infos[i]);
 		}
 		result = true;
 	}
@@ -234,7 +244,12 @@ std::shared_ptr<nano::transport::channel_udp> nano::transport::udp_channels::fin
 void nano::transport::udp_channels::clean_node_id (nano::account const & node_id_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
-	channels.get<node_id_tag> ().erase (node_id_a);
+	auto existing (channels.get<node_id_tag> ().equal_range (node_id_a));
+	for (auto i (existing.first); i != existing.second; ++i)
+	{
+		sampler.erase (*i->channel);
+	}
+	channels.get<node_id_tag> ().erase (existing.first, existing.second);
 }
 
 void nano::transport::udp_channels::clean_node_id (nano::endpoint const & endpoint_a, nano::account const & node_id_a)
@@ -246,6 +261,7 @@ void nano::transport::udp_channels::clean_node_id (nano::endpoint const & endpoi
 		// Remove duplicate node ID for same IP address
 		if (record.endpoint ().address () == endpoint_a.address () && record.endpoint ().port () != endpoint_a.port ())
 		{
+			sampler.erase (*record.channel);
 			channels.get<endpoint_tag> ().erase (record.endpoint ());
 			break;
 		}
@@ -459,6 +475,10 @@ public:
 	{
 		message (message_a);
 	}
+	void block_announce (nano::block_announce const & message_a) override
+	{
+		message (message_a);
+	}
 	void node_id_handshake (nano::node_id_handshake const & message_a) override
 	{
 		if (node.config.logging.network_node_id_handshake_logging ())
@@ -477,6 +497,10 @@ public:
 			if (!node.network.syn_cookies.validate (endpoint, message_a.response->first, message_a.response->second))
 			{
 				validated_response = true;
+				if (message_a.header.node_id_handshake_is_block_announce_capable ())
+				{
+					node.network.block_announcer.set_capable (message_a.response->first);
+				}
 				if (message_a.response->first != node.node_id.pub && !node.network.tcp_channels.find_node_id (message_a.response->first))
 				{
 					node.network.udp_channels.clean_node_id (endpoint, message_a.response->first);
@@ -597,6 +621,9 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 				case nano::message_parser::parse_status::invalid_telemetry_ack_message:
 					node.stats.inc (nano::stat::type::udp, nano::stat::detail::invalid_telemetry_ack_message);
 					break;
+				case nano::message_parser::parse_status::invalid_block_announce_message:
+					node.stats.inc (nano::stat::type::udp, nano::stat::detail::invalid_block_announce_message);
+					break;
 				case nano::message_parser::parse_status::outdated_version:
 					node.stats.inc (nano::stat::type::udp, nano::stat::detail::outdated_version);
 					break;
@@ -677,6 +704,7 @@ std::unique_ptr<nano::container_info_component> nano::transport::udp_channels::c
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
+	composite->add_component (sampler.collect_container_info ("sampler"));
 
 	return composite;
 }
@@ -685,6 +713,10 @@ void nano::transport::udp_channels::purge (std::chrono::steady_clock::time_point
 {
 	nano::lock_guard<std::mutex> lock (mutex);
 	auto disconnect_cutoff (channels.get<last_packet_received_tag> ().lower_bound (cutoff_a));
+	for (auto i (channels.get<last_packet_received_tag> ().begin ()); i != disconnect_cutoff; ++i)
+	{
+		sampler.erase (*i->channel);
+	}
 	channels.get<last_packet_received_tag> ().erase (channels.get<last_packet_received_tag> ().begin (), disconnect_cutoff);
 	// Remove keepalive attempt tracking for attempts older than cutoff
 	auto attempts_cutoff (attempts.get<last_attempt_tag> ().lower_bound (cutoff_a));
@@ -83,6 +83,8 @@ namespace transport
 		std::shared_ptr<nano::transport::channel_udp> channel (nano::endpoint const &) const;
 		void random_fill (std::array<nano::endpoint, 8> &) const;
 		std::unordered_set<std::shared_ptr<nano::transport::channel>> random_set (size_t, uint8_t = 0) const;
+		std::vector<std::shared_ptr<nano::transport::channel>> random_set_weighted (size_t, uint8_t = 0) const;
+		void set_sampling_weight (nano::transport::channel const &, uint64_t);
 		bool store_all (bool = true);
 		std::shared_ptr<nano::transport::channel_udp> find_node_id (nano::account const &);
 		void clean_node_id (nano::account const &);
@@ -201,6 +203,8 @@ namespace transport
 				mi::member<endpoint_attempt, std::chrono::steady_clock::time_point, &endpoint_attempt::last_attempt>>>>
 		attempts;
 		// clang-format on
+		/** Mirrors channels for sampling, updated under mutex */
+		nano::transport::channel_sampler sampler;
 		boost::asio::strand<boost::asio::io_context::executor_type> strand;
 		std::unique_ptr<boost::asio::ip::udp::socket> socket;
 		nano::endpoint local_endpoint;
@@ -117,11 +117,18 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ());
 				auto request_id = ss.str ();
 				auto response_handler ([this_l, version, start, request_id, &stream](std::string const & tree_a) {
-					auto body = tree_a;
-					this_l->write_result (body, version);
-					boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
-						this_l->write_completion_handler (this_l);
-					}));
+					if (this_l->chunked)
+					{
+						this_l->write_chunk (stream, tree_a, version, true, [](bool) {});
+					}
+					else
+					{
+						auto body = tree_a;
+						this_l->write_result (body, version);
+						boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
+							this_l->write_completion_handler (this_l);
+						}));
+					}
 
 					std::stringstream ss;
 					if (this_l->rpc_config.rpc_logging.log_rpc)
@@ -131,6 +138,15 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 					}
 				});
 
+				// HTTP/1.0 has no chunked transfer encoding, responses are then sent whole
+				nano::rpc_response_part response_part_handler;
+				if (version >= 11)
+				{
+					response_part_handler = [this_l, version, &stream](std::string const & part_a, std::function<void(bool)> const & next_a) {
+						this_l->write_chunk (stream, part_a, version, false, next_a);
+					};
+				}
+
 				std::string api_path_l = "/api/v2";
 				int rpc_version_l = boost::starts_with (path_l, api_path_l) ? 2 : 1;
 
@@ -139,7 +155,7 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 				{
 					case boost::beast::http::verb::post:
 					{
-						auto handler (std::make_shared<nano::rpc_handler> (this_l->rpc_config, req.body (), request_id, response_handler, this_l->rpc_handler_interface, this_l->logger));
+						auto handler (std::make_shared<nano::rpc_handler> (this_l->rpc_config, req.body (), request_id, response_handler, response_part_handler, this_l->rpc_handler_interface, this_l->logger));
 						nano::rpc_handler_request_params request_params;
 						request_params.rpc_version = rpc_version_l;
 						request_params.credentials = header_field_credentials_l.to_string ();
@@ -173,6 +189,70 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 	}));
 }
 
+template <typename STREAM_TYPE>
+void nano::rpc_connection::write_chunk (STREAM_TYPE & stream, std::string const & body_a, unsigned version, bool last_a, std::function<void(bool)> const & callback_a)
+{
+	auto this_l (shared_from_this ());
+	auto body (std::make_shared<std::string> (body_a));
+	auto write_body ([this_l, &stream, body, last_a, callback_a](boost::system::error_code const & ec_a) {
+		auto written ([this_l, &stream, last_a, callback_a](boost::system::error_code const & ec_a) {
+			if (ec_a)
+			{
+				// The client is gone, the producer stops instead of preparing parts nobody reads
+				if (this_l->rpc_config.rpc_logging.log_rpc)
+				{
+					this_l->logger.always_log ("RPC: Write failed: ", ec_a.message ());
+				}
+				if (!last_a)
+				{
+					callback_a (true);
+				}
+			}
+			else if (last_a)
+			{
+				boost::asio::async_write (stream, boost::beast::http::make_chunk_last (), boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
+					this_l->write_completion_handler (this_l);
+				}));
+			}
+			else
+			{
+				callback_a (false);
+			}
+		});
+		// An empty chunk would end the response
+		if (ec_a || body->empty ())
+		{
+			written (ec_a);
+		}
+		else
+		{
+			boost::asio::async_write (stream, boost::beast::http::make_chunk (boost::asio::buffer (*body)), boost::asio::bind_executor (this_l->strand, [body, written](boost::system::error_code const & ec, size_t bytes_transferred) {
+				written (ec);
+			}));
+		}
+	});
+	if (!chunked.exchange (true))
+	{
+		if (!responded.test_and_set ())
+		{
+			prepare_head (version);
+			res.chunked (true);
+			auto serializer (std::make_shared<boost::beast::http::response_serializer<boost::beast::http::string_body>> (res));
+			boost::beast::http::async_write_header (stream, *serializer, boost::asio::bind_executor (strand, [serializer, write_body](boost::system::error_code const & ec, size_t bytes_transferred) {
+				write_body (ec);
+			}));
+		}
+		else
+		{
+			debug_assert (false && "RPC already responded and should only respond once");
+		}
+	}
+	else
+	{
+		write_body (boost::system::error_code ());
+	}
+}
+
 template void nano::rpc_connection::read (socket_type &);
 template void nano::rpc_connection::parse_request (socket_type &, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>>);
 #ifdef NANO_SECURE_RPC
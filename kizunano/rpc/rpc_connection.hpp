@@ -37,6 +37,8 @@ public:
 	boost::beast::http::response<boost::beast::http::string_body> res;
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	std::atomic_flag responded;
+	/** Set once the head of a chunked response is sent, the rest of the response follows as chunks */
+	std::atomic<bool> chunked{ false };
 	boost::asio::io_context & io_ctx;
 	nano::logger_mt & logger;
 	nano::rpc_config const & rpc_config;
@@ -48,5 +50,12 @@ protected:
 
 	template <typename STREAM_TYPE>
 	void parse_request (STREAM_TYPE & stream, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> header_parser);
+
+	/**
+	 * Sends \p body_a as a chunk, after the head of the response if it is the first one, and ends the response if \p last_a.
+	 * Otherwise \p callback_a is called once the chunk is sent, with true if writing failed.
+	 */
+	template <typename STREAM_TYPE>
+	void write_chunk (STREAM_TYPE & stream, std::string const & body_a, unsigned version, bool last_a, std::function<void(bool)> const & callback_a);
 };
 }
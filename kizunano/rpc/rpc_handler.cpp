@@ -1,6 +1,7 @@
 #include <kizunano/crypto_lib/random_pool.hpp>
 #include <kizunano/lib/errors.hpp>
 #include <kizunano/lib/json_error_response.hpp>
+#include <kizunano/lib/json_flat_object.hpp>
 #include <kizunano/lib/logger_mt.hpp>
 #include <kizunano/lib/numbers.hpp>
 #include <kizunano/lib/rpc_handler_interface.hpp>
@@ -18,10 +19,11 @@ std::unordered_set<std::string> rpc_control_impl_set = create_rpc_control_impls
 std::string filter_request (boost::property_tree::ptree tree_a);
 }
 
-nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void(std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger) :
+nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void(std::string const &)> const & response_a, nano::rpc_response_part const & response_part_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger) :
 body (body_a),
 request_id (request_id_a),
 response (response_a),
+response_part (response_part_a),
 rpc_config (rpc_config),
 rpc_handler_interface (rpc_handler_interface_a),
 logger (logger)
@@ -55,19 +57,34 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 			if (request_params.rpc_version == 1)
 			{
 				boost::property_tree::ptree request;
+				std::string action;
+				// Requests with scalar parameters only need the action, unless it is checked or rewritten below
+				nano::json_flat_object flat_request;
+				boost::optional<std::string> flat_action;
+				if (!rpc_config.rpc_logging.log_rpc && !flat_request.parse (body))
 				{
-					std::stringstream ss;
-					ss << body;
-					boost::property_tree::read_json (ss, request);
+					flat_action = flat_request.get ("action");
 				}
-
-				auto action = request.get<std::string> ("action");
-				if (rpc_config.rpc_logging.log_rpc)
+				if (flat_action && *flat_action != "stats" && *flat_action != "process" && *flat_action != "send")
 				{
-					// Creating same string via stringstream as using it directly is generating a TSAN warning
-					std::stringstream ss;
-					ss << request_id;
-					logger.always_log (ss.str (), " ", filter_request (request));
+					action = *flat_action;
+				}
+				else
+				{
+					{
+						std::stringstream ss;
+						ss << body;
+						boost::property_tree::read_json (ss, request);
+					}
+
+					action = request.get<std::string> ("action");
+					if (rpc_config.rpc_logging.log_rpc)
+					{
+						// Creating same string via stringstream as using it directly is generating a TSAN warning
+						std::stringstream ss;
+						ss << request_id;
+						logger.always_log (ss.str (), " ", filter_request (request));
+					}
 				}
 
 				// Check if this is a RPC command which requires RPC enabled control
@@ -117,7 +134,7 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 
 				if (!error)
 				{
-					rpc_handler_interface.process_request (action, body, this->response);
+					rpc_handler_interface.process_request (action, body, this->response, this->response_part);
 				}
 			}
 			else if (request_params.rpc_version == 2)
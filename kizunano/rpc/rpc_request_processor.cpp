@@ -60,24 +60,83 @@ void nano::rpc_request_processor::read_payload (std::shared_ptr<nano::ipc_connec
 	res->resize (payload_size_l);
 	// Read JSON payload
 	connection->client.async_read (res, payload_size_l, [this, connection, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
-		// We need 2 sequential reads to get both the header and payload, so only allow other writes
-		// when they have both been read.
-		make_available (*connection);
 		if (!err_read_a && size_read_a != 0)
 		{
-			rpc_request->response (std::string (res->begin (), res->end ()));
-			if (rpc_request->action == "stop")
+			if (rpc_request->response_part)
 			{
-				this->stop_callback ();
+				this->read_part (connection, std::make_shared<std::string> (res->begin (), res->end ()), rpc_request);
+			}
+			else
+			{
+				this->respond (connection, std::string (res->begin (), res->end ()), rpc_request);
+			}
+		}
+		else
+		{
+			make_available (*connection);
+			json_error_response (rpc_request->response, "Failed to read payload");
+		}
+	});
+}
+
+void nano::rpc_request_processor::read_part (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::string> part, std::shared_ptr<nano::rpc_request> rpc_request)
+{
+	// A part is passed on once the length of the next one tells whether it is the last, which ends the response with an empty part
+	auto res (std::make_shared<std::vector<uint8_t>> ());
+	connection->client.async_read (res, sizeof (uint32_t), [this, connection, part, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
+		if (!err_read_a && size_read_a != 0)
+		{
+			uint32_t part_size_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ()));
+			if (part_size_l == 0)
+			{
+				this->respond (connection, *part, rpc_request);
+			}
+			else
+			{
+				// The next part is only read once this one is sent to the client, so the node writes no faster than the client reads
+				rpc_request->response_part (*part, [this, connection, res, rpc_request, part_size_l](bool error_a) {
+					if (!error_a)
+					{
+						connection->client.async_read (res, part_size_l, [this, connection, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
+							if (!err_read_a && size_read_a != 0)
+							{
+								this->read_part (connection, std::make_shared<std::string> (res->begin (), res->end ()), rpc_request);
+							}
+							else
+							{
+								make_available (*connection);
+								json_error_response (rpc_request->response, "Failed to read payload");
+							}
+						});
+					}
+					else
+					{
+						// The client is gone, closing the connection stops the node from producing the rest. The next request reconnects it
+						connection->client.close ();
+						make_available (*connection);
+					}
+				});
 			}
 		}
 		else
 		{
+			make_available (*connection);
 			json_error_response (rpc_request->response, "Failed to read payload");
 		}
 	});
 }
 
+void nano::rpc_request_processor::respond (std::shared_ptr<nano::ipc_connection> connection, std::string const & body, std::shared_ptr<nano::rpc_request> rpc_request)
+{
+	// The whole response has been read, allow other requests to use the connection
+	make_available (*connection);
+	rpc_request->response (body);
+	if (rpc_request->action == "stop")
+	{
+		this->stop_callback ();
+	}
+}
+
 void nano::rpc_request_processor::make_available (nano::ipc_connection & connection)
 {
 	nano::lock_guard<std::mutex> lk (connections_mutex);
@@ -146,7 +205,7 @@ void nano::rpc_request_processor::run ()
 				auto connection = *it;
 				connection->is_available = false; // Make sure no one else can take it
 				conditions_lk.unlock ();
-				auto encoding (rpc_request->rpc_api_version == 1 ? nano::ipc::payload_encoding::json_v1 : nano::ipc::payload_encoding::flatbuffers_json);
+				auto encoding (rpc_request->rpc_api_version != 1 ? nano::ipc::payload_encoding::flatbuffers_json : rpc_request->response_part ? nano::ipc::payload_encoding::json_v1_chunked : nano::ipc::payload_encoding::json_v1);
 				auto req (nano::ipc::prepare_request (encoding, rpc_request->body));
 				auto res (std::make_shared<std::vector<uint8_t>> ());
 
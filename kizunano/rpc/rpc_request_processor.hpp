@@ -41,6 +41,8 @@ struct rpc_request
 	std::string action;
 	std::string body;
 	std::function<void(std::string const &)> response;
+	/** Leading parts of version 1 responses, which the node sends in parts */
+	nano::rpc_response_part response_part;
 };
 
 class rpc_request_processor
@@ -55,6 +57,8 @@ public:
 private:
 	void run ();
 	void read_payload (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request);
+	void read_part (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::string> part, std::shared_ptr<nano::rpc_request> rpc_request);
+	void respond (std::shared_ptr<nano::ipc_connection> connection, std::string const & body, std::shared_ptr<nano::rpc_request> rpc_request);
 	void try_reconnect_and_execute_request (std::shared_ptr<nano::ipc_connection> connection, nano::shared_const_buffer const & req, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request);
 	void make_available (nano::ipc_connection & connection);
 
@@ -77,9 +81,11 @@ public:
 	{
 	}
 
-	void process_request (std::string const & action_a, std::string const & body_a, std::function<void(std::string const &)> response_a) override
+	void process_request (std::string const & action_a, std::string const & body_a, std::function<void(std::string const &)> response_a, nano::rpc_response_part response_part_a) override
 	{
-		rpc_request_processor.add (std::make_shared<nano::rpc_request> (action_a, body_a, response_a));
+		auto request (std::make_shared<nano::rpc_request> (action_a, body_a, response_a));
+		request->response_part = response_part_a;
+		rpc_request_processor.add (request);
 	}
 
 	void process_request_v2 (rpc_handler_request_params const & params_a, std::string const & body_a, std::function<void(std::shared_ptr<std::string>)> response_a) override
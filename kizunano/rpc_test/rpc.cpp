@@ -16,6 +16,8 @@
 #include <boost/property_tree/json_parser.hpp>
 
 #include <algorithm>
+#include <map>
+#include <set>
 
 using namespace std::chrono_literals;
 
@@ -205,6 +207,86 @@ TEST (rpc, account_balance)
 	ASSERT_EQ ("0", pending_text);
 }
 
+TEST (rpc, account_balance_cached)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.rpc_response_cache_size = 16;
+	auto node = add_ipc_enabled_node (system, node_config);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "account_balance");
+	request.put ("account", nano::test_genesis_key.pub.to_account ());
+	auto check_balance = [&system, &rpc, &request](nano::uint128_t const & balance_a) {
+		test_response response (request, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ (balance_a.convert_to<std::string> (), response.json.get<std::string> ("balance"));
+	};
+	check_balance (nano::genesis_amount);
+	check_balance (nano::genesis_amount);
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc, nano::stat::detail::cache_miss));
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc, nano::stat::detail::cache_hit));
+	ASSERT_EQ (1, node->rpc_response_cache.size ());
+	// Processing a block of the account drops the cached response
+	nano::keypair key;
+	auto latest (node->latest (nano::test_genesis_key.pub));
+	nano::send_block send (latest, key.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *node->work_generate_blocking (latest));
+	ASSERT_EQ (nano::process_result::progress, node->process (send).code);
+	ASSERT_EQ (0, node->rpc_response_cache.size ());
+	check_balance (nano::genesis_amount - 100);
+	ASSERT_EQ (2, node->stats.count (nano::stat::type::rpc, nano::stat::detail::cache_miss));
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc, nano::stat::detail::cache_hit));
+}
+
+TEST (rpc, fast_path)
+{
+	nano::system system;
+	auto & node = *add_ipc_enabled_node (system);
+	nano::node_rpc_config node_rpc_config;
+	auto account_text (nano::test_genesis_key.pub.to_account ());
+	auto deprecated_text (account_text);
+	deprecated_text[deprecated_text.find ('_')] = '-';
+	auto hash_text (node.latest (nano::test_genesis_key.pub).to_string ());
+	std::vector<std::string> requests{
+		"{\"action\": \"account_balance\", \"account\": \"" + account_text + "\"}",
+		"{\"action\": \"account_balance\", \"account\": \"" + deprecated_text + "\"}",
+		"{\"action\": \"account_weight\", \"account\": \"" + account_text + "\"}",
+		"{\"action\": \"block_account\", \"hash\": \"" + hash_text + "\"}",
+		"{\"action\": \"block_count\"}",
+		"{\"action\": \"work_validate\", \"hash\": \"" + hash_text + "\", \"work\": \"" + nano::to_string_hex (*system.work.generate (node.latest (nano::test_genesis_key.pub))) + "\"}",
+		// Errors take the general path
+		"{\"action\": \"account_balance\", \"account\": \"invalid\"}",
+		"{\"action\": \"block_account\", \"hash\": \"" + nano::block_hash (1).to_string () + "\"}"
+	};
+	// Answers are the same, byte for byte, with and without the fast path
+	for (auto const & request : requests)
+	{
+		std::array<std::string, 2> responses;
+		for (auto fast : { false, true })
+		{
+			auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, request, [&responses, fast](std::string const & response_a) {
+				responses[fast] = response_a;
+			}));
+			handler->fast_path = fast;
+			handler->process_request ();
+		}
+		ASSERT_FALSE (responses[0].empty ());
+		ASSERT_EQ (responses[0], responses[1]);
+	}
+}
+
 TEST (rpc, account_block_count)
 {
 	nano::system system;
@@ -1531,6 +1613,146 @@ TEST (rpc, frontier_startpoint)
 	ASSERT_EQ (source.begin ()->first.to_account (), frontiers_node.begin ()->first);
 }
 
+TEST (rpc, frontier_chunked)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	std::map<nano::account, nano::block_hash> source;
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto i (0); i < 100; ++i)
+		{
+			nano::keypair key;
+			nano::block_hash hash;
+			nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+			source[key.pub] = hash;
+			node->store.confirmation_height_put (transaction, key.pub, { 0, nano::block_hash (0) });
+			node->store.account_put (transaction, key.pub, nano::account_info (hash, 0, 0, 0, 0, 0, nano::epoch::epoch_0));
+		}
+	}
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::node_rpc_config node_rpc_config;
+	// Every frontier is sent in its own part
+	node_rpc_config.response_chunk_size = 1;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "frontiers");
+	request.put ("account", source.begin ()->first.to_account ());
+	request.put ("count", std::to_string (50));
+	test_response response (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response.status);
+	ASSERT_TRUE (response.resp.chunked ());
+	auto & frontiers_node (response.json.get_child ("frontiers"));
+	ASSERT_EQ (50, frontiers_node.size ());
+	// Parts are written in account order, resuming where the previous part stopped
+	auto expected (source.begin ());
+	for (auto & frontier : frontiers_node)
+	{
+		if (frontier.first == nano::test_genesis_key.pub.to_account ())
+		{
+			continue;
+		}
+		ASSERT_EQ (expected->first.to_account (), frontier.first);
+		ASSERT_EQ (expected->second.to_string (), frontier.second.get<std::string> (""));
+		++expected;
+	}
+	// Requests after a chunked response reuse the node connection
+	request.put ("count", std::to_string (1));
+	test_response response2 (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response2.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response2.status);
+	ASSERT_EQ (1, response2.json.get_child ("frontiers").size ());
+}
+
+TEST (rpc, frontier_cursor)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	std::map<nano::account, nano::block_hash> source;
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto i (0); i < 1000; ++i)
+		{
+			nano::keypair key;
+			nano::block_hash hash;
+			nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+			source[key.pub] = hash;
+			node->store.confirmation_height_put (transaction, key.pub, { 0, nano::block_hash (0) });
+			node->store.account_put (transaction, key.pub, nano::account_info (hash, 0, 0, 0, 0, 0, nano::epoch::epoch_0));
+		}
+	}
+	source[nano::test_genesis_key.pub] = node->latest (nano::test_genesis_key.pub);
+	nano::node_rpc_config node_rpc_config;
+	// Scans are only cut short by time when a budget is configured
+	ASSERT_EQ (0, node_rpc_config.scan_time_budget.count ());
+	auto call ([&node, &node_rpc_config](boost::property_tree::ptree const & request_a) {
+		std::stringstream ostream;
+		boost::property_tree::write_json (ostream, request_a);
+		boost::property_tree::ptree response;
+		auto handler (std::make_shared<nano::json_handler> (*node, node_rpc_config, ostream.str (), [&response](std::string const & response_a) {
+			std::stringstream istream (response_a);
+			boost::property_tree::read_json (istream, response);
+		}));
+		handler->process_request ();
+		return response;
+	});
+	// Pages resume where the previous one stopped, whether it was cut short by the count or by the time budget
+	for (auto budget : { 0, 1 })
+	{
+		node_rpc_config.scan_time_budget = std::chrono::milliseconds (budget);
+		std::map<nano::account, nano::block_hash> frontiers;
+		boost::property_tree::ptree request;
+		request.put ("action", "frontiers");
+		request.put ("account", nano::account (0).to_account ());
+		request.put ("count", std::to_string (300));
+		for (auto more (true); more;)
+		{
+			auto response (call (request));
+			for (auto & frontier : response.get_child ("frontiers"))
+			{
+				nano::account account;
+				ASSERT_FALSE (account.decode_account (frontier.first));
+				ASSERT_EQ (0, frontiers.count (account));
+				frontiers[account] = nano::block_hash (frontier.second.get<std::string> (""));
+			}
+			auto cursor (response.get_optional<std::string> ("cursor"));
+			more = cursor.is_initialized ();
+			if (more)
+			{
+				request.erase ("account");
+				request.put ("cursor", *cursor);
+			}
+		}
+		ASSERT_TRUE (source == frontiers);
+	}
+	// Cursors only resume the scan they came from
+	boost::property_tree::ptree request;
+	request.put ("action", "frontiers");
+	request.put ("account", nano::account (0).to_account ());
+	request.put ("count", std::to_string (1));
+	auto cursor (call (request).get<std::string> ("cursor"));
+	request.put ("action", "ledger");
+	request.put ("cursor", cursor);
+	ASSERT_EQ (std::error_code (nano::error_rpc::bad_cursor).message (), call (request).get<std::string> ("error"));
+	request.put ("action", "frontiers");
+	request.put ("cursor", cursor.substr (1));
+	ASSERT_EQ (std::error_code (nano::error_rpc::bad_cursor).message (), call (request).get<std::string> ("error"));
+}
+
 TEST (rpc, history)
 {
 	nano::system system;
@@ -2871,6 +3093,50 @@ TEST (rpc, pending)
 	check_block_response_count (0);
 }
 
+TEST (rpc, pending_sorting_count)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	nano::keypair key1;
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	auto block1 (system.wallet (0)->send_action (nano::test_genesis_key.pub, key1.pub, 100));
+	auto block2 (system.wallet (0)->send_action (nano::test_genesis_key.pub, key1.pub, 300));
+	auto block3 (system.wallet (0)->send_action (nano::test_genesis_key.pub, key1.pub, 200));
+	scoped_io_thread_name_change scoped_thread_name_io;
+	system.deadline_set (5s);
+	while (node->active.active (*block1) || node->active.active (*block2) || node->active.active (*block3))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "pending");
+	request.put ("account", key1.pub.to_account ());
+	request.put ("count", "2");
+	request.put ("sorting", "true");
+	test_response response (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response.status);
+	// The largest pending amounts are returned, largest first
+	std::vector<std::pair<std::string, std::string>> blocks;
+	for (auto & block : response.json.get_child ("blocks"))
+	{
+		blocks.emplace_back (block.first, block.second.get<std::string> (""));
+	}
+	std::vector<std::pair<std::string, std::string>> expected{ { block2->hash ().to_string (), "300" }, { block3->hash ().to_string (), "200" } };
+	ASSERT_EQ (expected, blocks);
+}
+
 TEST (rpc, pending_burn)
 {
 	nano::system system;
@@ -3765,6 +4031,65 @@ TEST (rpc, available_supply)
 	ASSERT_EQ ("101", response3.json.get<std::string> ("available"));
 }
 
+TEST (rpc, batch)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::node_rpc_config node_rpc_config;
+	node_rpc_config.batch_max_requests = 3;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "batch");
+	boost::property_tree::ptree requests;
+	boost::property_tree::ptree entry;
+	entry.put ("action", "account_balance");
+	entry.put ("account", nano::test_genesis_key.pub.to_account ());
+	requests.push_back (std::make_pair ("", entry));
+	entry.put ("action", "account_block_count");
+	requests.push_back (std::make_pair ("", entry));
+	entry.clear ();
+	entry.put ("action", "block_count");
+	requests.push_back (std::make_pair ("", entry));
+	request.add_child ("requests", requests);
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response.status);
+		std::vector<boost::property_tree::ptree> responses;
+		for (auto & item : response.json.get_child ("responses"))
+		{
+			responses.push_back (item.second);
+		}
+		ASSERT_EQ (3, responses.size ());
+		ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), responses[0].get<std::string> ("balance"));
+		ASSERT_EQ ("1", responses[1].get<std::string> ("block_count"));
+		// Only actions reading the batch snapshot are run, anything else is answered with an error in its place
+		ASSERT_EQ (std::error_code (nano::error_rpc::batch_action_not_allowed).message (), responses[2].get<std::string> ("error"));
+	}
+	requests.push_back (std::make_pair ("", entry));
+	request.put_child ("requests", requests);
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ (std::error_code (nano::error_rpc::batch_too_large).message (), response.json.get<std::string> ("error"));
+	}
+}
+
 TEST (rpc, mrai_to_raw)
 {
 	nano::system system;
@@ -5423,6 +5748,63 @@ TEST (rpc, delegators)
 	ASSERT_EQ ("19999999999999900", delegators.get<std::string> (key.pub.to_account ()));
 }
 
+TEST (rpc, delegators_paging)
+{
+	nano::system system;
+	auto & node1 = *add_ipc_enabled_node (system);
+	nano::keypair key;
+	auto latest (node1.latest (nano::test_genesis_key.pub));
+	nano::send_block send (latest, key.pub, 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *node1.work_generate_blocking (latest));
+	ASSERT_EQ (nano::process_result::progress, node1.process (send).code);
+	nano::open_block open (send.hash (), nano::test_genesis_key.pub, key.pub, key.prv, key.pub, *node1.work_generate_blocking (key.pub));
+	ASSERT_EQ (nano::process_result::progress, node1.process (open).code);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (node1, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node1.config.ipc_config.transport_tcp.port;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "delegators");
+	request.put ("account", nano::test_genesis_key.pub.to_account ());
+	request.put ("count", 1);
+	test_response response (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response.status);
+	auto & delegators_node (response.json.get_child ("delegators"));
+	ASSERT_EQ (1, delegators_node.size ());
+	auto first (delegators_node.begin ()->first);
+	request.put ("start", first);
+	test_response response2 (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response2.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response2.status);
+	auto & delegators_node2 (response2.json.get_child ("delegators"));
+	ASSERT_EQ (1, delegators_node2.size ());
+	auto second (delegators_node2.begin ()->first);
+	ASSERT_NE (first, second);
+	std::set<std::string> expected{ nano::test_genesis_key.pub.to_account (), key.pub.to_account () };
+	ASSERT_EQ (expected, (std::set<std::string>{ first, second }));
+	request.put ("start", second);
+	test_response response3 (request, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response3.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response3.status);
+	ASSERT_TRUE (response3.json.get_child ("delegators").empty ());
+}
+
 TEST (rpc, delegators_count)
 {
 	nano::system system;
@@ -8104,6 +8486,41 @@ TEST (rpc, in_process)
 	ASSERT_EQ ("0", pending_text);
 }
 
+TEST (rpc, in_process_executor)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	nano::node_rpc_config node_rpc_config;
+	node_rpc_config.in_process_threads = 2;
+	node_rpc_config.response_chunk_size = 1;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::inprocess_rpc_handler inprocess_rpc_handler (*node, ipc_server, node_rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, inprocess_rpc_handler);
+	rpc.start ();
+	// Whole and chunked responses are both produced on the executor threads
+	boost::property_tree::ptree request;
+	request.put ("action", "account_balance");
+	request.put ("account", nano::test_genesis_key.pub.to_account ());
+	test_response response (request, rpc.config.port, system.io_ctx);
+	boost::property_tree::ptree request2;
+	request2.put ("action", "frontiers");
+	request2.put ("account", nano::account (0).to_account ());
+	request2.put ("count", std::to_string (10));
+	test_response response2 (request2, rpc.config.port, system.io_ctx);
+	system.deadline_set (5s);
+	while (response.status == 0 || response2.status == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (200, response.status);
+	ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), response.json.get<std::string> ("balance"));
+	ASSERT_EQ (200, response2.status);
+	ASSERT_TRUE (response2.resp.chunked ());
+	ASSERT_EQ (node->latest (nano::test_genesis_key.pub).to_string (), response2.json.get<std::string> ("frontiers." + nano::test_genesis_key.pub.to_account ()));
+}
+
 TEST (rpc_config, serialization)
 {
 	nano::rpc_config config1;
@@ -13,6 +13,7 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <functional>
 #include <stack>
 
 namespace nano
@@ -85,6 +86,24 @@ public:
 		static_assert (std::is_standard_layout<nano::pending_key>::value, "Standard layout is required");
 	}
 
+	db_val (nano::account_height_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::account_height_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::account_height_key>::value, "Standard layout is required");
+	}
+
+	db_val (nano::pending_amount_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::pending_amount_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::pending_amount_key>::value, "Standard layout is required");
+	}
+
+	db_val (nano::delegator_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::delegator_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::delegator_key>::value, "Standard layout is required");
+	}
+
 	db_val (nano::unchecked_info const & val_a) :
 	buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -123,6 +142,12 @@ public:
 		static_assert (std::is_standard_layout<nano::endpoint_key>::value, "Standard layout is required");
 	}
 
+	db_val (nano::peer_info const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::peer_info *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::peer_info>::value, "Standard layout is required");
+	}
+
 	db_val (std::shared_ptr<nano::block> const & val_a) :
 	buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -202,6 +227,33 @@ public:
 		return result;
 	}
 
+	explicit operator nano::account_height_key () const
+	{
+		nano::account_height_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (nano::account_height_key::account) + sizeof (nano::account_height_key::height_big_endian) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator nano::pending_amount_key () const
+	{
+		nano::pending_amount_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (nano::pending_amount_key::account) + sizeof (nano::pending_amount_key::amount_complement) + sizeof (nano::pending_amount_key::hash) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator nano::delegator_key () const
+	{
+		nano::delegator_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (nano::delegator_key::representative) + sizeof (nano::delegator_key::account) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator nano::confirmation_height_info () const
 	{
 		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -273,6 +325,17 @@ public:
 		return result;
 	}
 
+	explicit operator nano::peer_info () const
+	{
+		nano::peer_info result;
+		// Peers written before scores were kept hold a zero counter instead
+		if (size () == sizeof (result))
+		{
+			std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		}
+		return result;
+	}
+
 	explicit operator state_block_w_sideband () const
 	{
 		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -573,15 +636,19 @@ enum class tables
 {
 	accounts,
 	blocks_info, // LMDB only
+	bootstrap_checkpoint,
 	cached_counts, // RocksDB only
 	change_blocks,
 	confirmation_height,
+	delegators,
 	frontiers,
+	heights,
 	meta,
 	online_weight,
 	open_blocks,
 	peers,
 	pending,
+	pending_amounts,
 	receive_blocks,
 	representation,
 	send_blocks,
@@ -590,6 +657,18 @@ enum class tables
 	vote
 };
 
+/**
+ * Raw key and value of a table entry, pointing into memory owned by the store or the caller
+ */
+class store_entry_view final
+{
+public:
+	uint8_t const * key;
+	size_t key_size;
+	uint8_t const * value;
+	size_t value_size;
+};
+
 class transaction_impl
 {
 public:
@@ -668,6 +747,8 @@ public:
 	virtual void block_successor_clear (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> block_get (nano::transaction const &, nano::block_hash const &) const = 0;
 	virtual std::shared_ptr<nano::block> block_get_no_sideband (nano::transaction const &, nano::block_hash const &) const = 0;
+	/** Appends the block as written by serialize_block to the buffer without deserializing it and reads its previous, returns true if it doesn't exist */
+	virtual bool block_serialized (nano::transaction const &, nano::block_hash const &, std::vector<uint8_t> &, nano::block_hash &) const = 0;
 	virtual std::shared_ptr<nano::block> block_get_v14 (nano::transaction const &, nano::block_hash const &, nano::block_sideband_v14 * = nullptr, bool * = nullptr) const = 0;
 	virtual std::shared_ptr<nano::block> block_random (nano::transaction const &) = 0;
 	virtual void block_del (nano::write_transaction const &, nano::block_hash const &, nano::block_type) = 0;
@@ -702,6 +783,15 @@ public:
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &, nano::pending_key const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_end () = 0;
+	/** Pending entries of an account from the largest amount down start at pending_amount_key (account, max amount, 0) */
+	virtual nano::store_iterator<nano::pending_amount_key, nano::no_value> pending_amounts_begin (nano::transaction const &, nano::pending_amount_key const &) const = 0;
+	virtual nano::store_iterator<nano::pending_amount_key, nano::no_value> pending_amounts_end () const = 0;
+
+	virtual void delegator_put (nano::write_transaction const &, nano::delegator_key const &) = 0;
+	virtual void delegator_del (nano::write_transaction const &, nano::delegator_key const &) = 0;
+	/** Accounts delegating to a representative start at delegator_key (representative, 0) */
+	virtual nano::store_iterator<nano::delegator_key, nano::no_value> delegators_begin (nano::transaction const &, nano::delegator_key const &) const = 0;
+	virtual nano::store_iterator<nano::delegator_key, nano::no_value> delegators_end () const = 0;
 
 	virtual bool block_info_get (nano::transaction const &, nano::block_hash const &, nano::block_info &) const = 0;
 	virtual nano::uint128_t block_balance (nano::transaction const &, nano::block_hash const &) = 0;
@@ -743,12 +833,17 @@ public:
 	virtual int version_get (nano::transaction const &) const = 0;
 
 	virtual void peer_put (nano::write_transaction const & transaction_a, nano::endpoint_key const & endpoint_a) = 0;
+	virtual void peer_put (nano::write_transaction const & transaction_a, nano::endpoint_key const & endpoint_a, nano::peer_info const & info_a) = 0;
 	virtual void peer_del (nano::write_transaction const & transaction_a, nano::endpoint_key const & endpoint_a) = 0;
 	virtual bool peer_exists (nano::transaction const & transaction_a, nano::endpoint_key const & endpoint_a) const = 0;
 	virtual size_t peer_count (nano::transaction const & transaction_a) const = 0;
 	virtual void peer_clear (nano::write_transaction const & transaction_a) = 0;
-	virtual nano::store_iterator<nano::endpoint_key, nano::no_value> peers_begin (nano::transaction const & transaction_a) const = 0;
-	virtual nano::store_iterator<nano::endpoint_key, nano::no_value> peers_end () const = 0;
+	virtual nano::store_iterator<nano::endpoint_key, nano::peer_info> peers_begin (nano::transaction const & transaction_a) const = 0;
+	virtual nano::store_iterator<nano::endpoint_key, nano::peer_info> peers_end () const = 0;
+
+	virtual void bootstrap_checkpoint_put (nano::write_transaction const &, uint64_t, std::vector<uint8_t> const &) = 0;
+	virtual bool bootstrap_checkpoint_get (nano::transaction const &, uint64_t, std::vector<uint8_t> &) const = 0;
+	virtual void bootstrap_checkpoint_del (nano::write_transaction const &, uint64_t) = 0;
 
 	virtual void confirmation_height_put (nano::write_transaction const & transaction_a, nano::account const & account_a, nano::confirmation_height_info const & confirmation_height_info_a) = 0;
 	virtual bool confirmation_height_get (nano::transaction const & transaction_a, nano::account const & account_a, nano::confirmation_height_info & confirmation_height_info_a) = 0;
@@ -760,11 +855,26 @@ public:
 	virtual nano::store_iterator<nano::account, nano::confirmation_height_info> confirmation_height_end () = 0;
 
 	virtual uint64_t block_account_height (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const = 0;
+	/** Hash of the block at \p height_a in the chain of \p account_a, zero if the chain is shorter */
+	virtual nano::block_hash block_at_height (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) const = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> heights_begin (nano::transaction const & transaction_a, nano::account_height_key const & key_a) const = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> heights_end () const = 0;
 	virtual std::mutex & get_cache_mutex () = 0;
 
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 	virtual void rebuild_db (nano::write_transaction const & transaction_a) = 0;
 
+	/** Calls \p action_a with every entry of \p table_a in key order, views are only valid during the call */
+	virtual void table_for_each (nano::transaction const &, nano::tables, std::function<void (nano::store_entry_view const &)> const & action_a) const = 0;
+	/** Removes every entry of \p table_a in its own write transaction, returns true on error */
+	virtual bool table_clear (nano::tables) = 0;
+	/**
+	 * Adds entries sorted by key in its own write transaction, see nano::bulk_writer. Backends use their bulk
+	 * loading path instead of individual puts, which is fastest when the keys follow those already in the table.
+	 * Keys already in the table are overwritten. Returns true on error
+	 */
+	virtual bool table_load (nano::tables, std::vector<nano::store_entry_view> const &) = 0;
+
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds) = 0;
 
@@ -39,6 +39,7 @@ public:
 		account_put (transaction_a, network_params.ledger.genesis_account, { hash_l, network_params.ledger.genesis_account, genesis_a.open->hash (), nano::total_supply, nano::seconds_since_epoch (), 1, nano::epoch::epoch_0 });
 		++ledger_cache_a.account_count;
 		ledger_cache_a.rep_weights.representation_put (network_params.ledger.genesis_account, nano::total_supply);
+		delegator_put (transaction_a, nano::delegator_key (network_params.ledger.genesis_account, network_params.ledger.genesis_account));
 		frontier_put (transaction_a, hash_l, network_params.ledger.genesis_account);
 	}
 
@@ -113,6 +114,8 @@ public:
 			block_a.sideband ().serialize (stream, block_a.type ());
 		}
 		block_raw_put (transaction_a, vector, block_a.type (), hash_a);
+		auto status = put (transaction_a, tables::heights, height_key (block_a), hash_a);
+		release_assert (success (status));
 		nano::block_predecessor_set<Val, Derived_Store> predecessor (transaction_a, *this);
 		block_a.visit (predecessor);
 		debug_assert (block_a.previous ().is_zero () || block_successor (transaction_a, block_a.previous ()) == hash_a);
@@ -125,6 +128,24 @@ public:
 		return block->sideband ().height;
 	}
 
+	nano::block_hash block_at_height (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) const override
+	{
+		nano::db_val<Val> value;
+		auto status (get (transaction_a, tables::heights, nano::db_val<Val> (nano::account_height_key (account_a, height_a)), value));
+		release_assert (success (status) || not_found (status));
+		return success (status) ? static_cast<nano::block_hash> (value) : nano::block_hash (0);
+	}
+
+	nano::store_iterator<nano::account_height_key, nano::block_hash> heights_begin (nano::transaction const & transaction_a, nano::account_height_key const & key_a) const override
+	{
+		return make_iterator<nano::account_height_key, nano::block_hash> (transaction_a, tables::heights, nano::db_val<Val> (key_a));
+	}
+
+	nano::store_iterator<nano::account_height_key, nano::block_hash> heights_end () const override
+	{
+		return nano::store_iterator<nano::account_height_key, nano::block_hash> (nullptr);
+	}
+
 	std::shared_ptr<nano::block> block_get (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override
 	{
 		nano::block_type type;
@@ -170,6 +191,31 @@ public:
 		return result;
 	}
 
+	bool block_serialized (nano::transaction const & transaction_a, nano::block_hash const & hash_a, std::vector<uint8_t> & buffer_a, nano::block_hash & previous_a) const override
+	{
+		nano::block_type type;
+		auto value (block_raw_get (transaction_a, hash_a, type));
+		auto error (value.size () == 0);
+		if (!error)
+		{
+			auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+			auto size (nano::block::size (type));
+			debug_assert (value.size () >= size);
+			buffer_a.push_back (static_cast<uint8_t> (type));
+			buffer_a.insert (buffer_a.end (), data, data + size);
+			previous_a.clear ();
+			// Open blocks have no previous, state blocks start with the account
+			if (type != nano::block_type::open)
+			{
+				nano::bufferstream stream (data + (type == nano::block_type::state ? sizeof (nano::account) : 0), sizeof (nano::block_hash));
+				auto error_l (nano::try_read (stream, previous_a.bytes));
+				(void)error_l;
+				debug_assert (!error_l);
+			}
+		}
+		return error;
+	}
+
 	bool block_exists (nano::transaction const & transaction_a, nano::block_type type, nano::block_hash const & hash_a) override
 	{
 		auto junk = block_raw_get_by_type (transaction_a, hash_a, type);
@@ -352,9 +398,9 @@ public:
 		return nano::store_iterator<nano::account, std::shared_ptr<nano::vote>> (nullptr);
 	}
 
-	nano::store_iterator<nano::endpoint_key, nano::no_value> peers_end () const override
+	nano::store_iterator<nano::endpoint_key, nano::peer_info> peers_end () const override
 	{
-		return nano::store_iterator<nano::endpoint_key, nano::no_value> (nullptr);
+		return nano::store_iterator<nano::endpoint_key, nano::peer_info> (nullptr);
 	}
 
 	nano::store_iterator<nano::pending_key, nano::pending_info> pending_end () override
@@ -384,6 +430,17 @@ public:
 
 	void block_del (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a, nano::block_type block_type_a) override
 	{
+		auto block (block_get (transaction_a, hash_a));
+		if (block != nullptr)
+		{
+			// Only the entry still pointing at this block, another one may have been put at the same height
+			auto key (height_key (*block));
+			if (block_at_height (transaction_a, key.account, key.height ()) == hash_a)
+			{
+				auto status = del (transaction_a, tables::heights, key);
+				release_assert (success (status));
+			}
+		}
 		auto table = tables::state_blocks;
 		switch (block_type_a)
 		{
@@ -450,12 +507,34 @@ public:
 		nano::db_val<Val> pending (pending_info_a);
 		auto status = put (transaction_a, tables::pending, key_a, pending);
 		release_assert (success (status));
+		nano::db_val<Val> zero (static_cast<uint64_t> (0));
+		status = put (transaction_a, tables::pending_amounts, nano::pending_amount_key (key_a.account, pending_info_a.amount, key_a.hash), zero);
+		release_assert (success (status));
 	}
 
 	void pending_del (nano::write_transaction const & transaction_a, nano::pending_key const & key_a) override
 	{
+		// The amount is needed to find the entry in the pending amounts index
+		nano::pending_info pending;
+		auto error (pending_get (transaction_a, key_a, pending));
+		release_assert (!error);
 		auto status = del (transaction_a, tables::pending, key_a);
 		release_assert (success (status));
+		status = del (transaction_a, tables::pending_amounts, nano::pending_amount_key (key_a.account, pending.amount, key_a.hash));
+		release_assert (success (status));
+	}
+
+	void delegator_put (nano::write_transaction const & transaction_a, nano::delegator_key const & key_a) override
+	{
+		nano::db_val<Val> zero (static_cast<uint64_t> (0));
+		auto status = put (transaction_a, tables::delegators, key_a, zero);
+		release_assert (success (status));
+	}
+
+	void delegator_del (nano::write_transaction const & transaction_a, nano::delegator_key const & key_a) override
+	{
+		auto status = del (transaction_a, tables::delegators, key_a);
+		release_assert (success (status));
 	}
 
 	bool pending_get (nano::transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info & pending_a) override
@@ -613,12 +692,48 @@ public:
 		release_assert (success (status));
 	}
 
+	void peer_put (nano::write_transaction const & transaction_a, nano::endpoint_key const & endpoint_a, nano::peer_info const & info_a) override
+	{
+		auto status = put (transaction_a, tables::peers, endpoint_a, info_a);
+		release_assert (success (status));
+	}
+
 	void peer_del (nano::write_transaction const & transaction_a, nano::endpoint_key const & endpoint_a) override
 	{
 		auto status (del (transaction_a, tables::peers, endpoint_a));
 		release_assert (success (status));
 	}
 
+	void bootstrap_checkpoint_put (nano::write_transaction const & transaction_a, uint64_t key_a, std::vector<uint8_t> const & data_a) override
+	{
+		nano::db_val<Val> value (data_a.size (), const_cast<uint8_t *> (data_a.data ()));
+		auto status (put (transaction_a, tables::bootstrap_checkpoint, key_a, value));
+		release_assert (success (status));
+	}
+
+	bool bootstrap_checkpoint_get (nano::transaction const & transaction_a, uint64_t key_a, std::vector<uint8_t> & data_a) const override
+	{
+		nano::db_val<Val> value;
+		auto status (get (transaction_a, tables::bootstrap_checkpoint, nano::db_val<Val> (key_a), value));
+		release_assert (success (status) || not_found (status));
+		auto result (!success (status));
+		if (!result)
+		{
+			auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+			data_a.assign (data, data + value.size ());
+		}
+		return result;
+	}
+
+	void bootstrap_checkpoint_del (nano::write_transaction const & transaction_a, uint64_t key_a) override
+	{
+		if (exists (transaction_a, tables::bootstrap_checkpoint, nano::db_val<Val> (key_a)))
+		{
+			auto status (del (transaction_a, tables::bootstrap_checkpoint, key_a));
+			release_assert (success (status));
+		}
+	}
+
 	bool peer_exists (nano::transaction const & transaction_a, nano::endpoint_key const & endpoint_a) const override
 	{
 		return exists (transaction_a, tables::peers, nano::db_val<Val> (endpoint_a));
@@ -756,6 +871,26 @@ public:
 		return make_iterator<nano::pending_key, nano::pending_info> (transaction_a, tables::pending);
 	}
 
+	nano::store_iterator<nano::pending_amount_key, nano::no_value> pending_amounts_begin (nano::transaction const & transaction_a, nano::pending_amount_key const & key_a) const override
+	{
+		return make_iterator<nano::pending_amount_key, nano::no_value> (transaction_a, tables::pending_amounts, nano::db_val<Val> (key_a));
+	}
+
+	nano::store_iterator<nano::pending_amount_key, nano::no_value> pending_amounts_end () const override
+	{
+		return nano::store_iterator<nano::pending_amount_key, nano::no_value> (nullptr);
+	}
+
+	nano::store_iterator<nano::delegator_key, nano::no_value> delegators_begin (nano::transaction const & transaction_a, nano::delegator_key const & key_a) const override
+	{
+		return make_iterator<nano::delegator_key, nano::no_value> (transaction_a, tables::delegators, nano::db_val<Val> (key_a));
+	}
+
+	nano::store_iterator<nano::delegator_key, nano::no_value> delegators_end () const override
+	{
+		return nano::store_iterator<nano::delegator_key, nano::no_value> (nullptr);
+	}
+
 	nano::store_iterator<nano::unchecked_key, nano::unchecked_info> unchecked_begin (nano::transaction const & transaction_a) const override
 	{
 		return make_iterator<nano::unchecked_key, nano::unchecked_info> (transaction_a, tables::unchecked);
@@ -776,9 +911,9 @@ public:
 		return make_iterator<uint64_t, nano::amount> (transaction_a, tables::online_weight);
 	}
 
-	nano::store_iterator<nano::endpoint_key, nano::no_value> peers_begin (nano::transaction const & transaction_a) const override
+	nano::store_iterator<nano::endpoint_key, nano::peer_info> peers_begin (nano::transaction const & transaction_a) const override
 	{
-		return make_iterator<nano::endpoint_key, nano::no_value> (transaction_a, tables::peers);
+		return make_iterator<nano::endpoint_key, nano::peer_info> (transaction_a, tables::peers);
 	}
 
 	nano::store_iterator<nano::account, nano::confirmation_height_info> confirmation_height_begin (nano::transaction const & transaction_a, nano::account const & account_a) override
@@ -800,7 +935,14 @@ protected:
 	nano::network_params network_params;
 	std::unordered_map<nano::account, std::shared_ptr<nano::vote>> vote_cache_l1;
 	std::unordered_map<nano::account, std::shared_ptr<nano::vote>> vote_cache_l2;
-	static int constexpr version{ 18 };
+	static int constexpr version{ 21 };
+
+	/** Open and state blocks carry their account, the sideband holds it for the others */
+	static nano::account_height_key height_key (nano::block const & block_a)
+	{
+		auto account (block_a.account ());
+		return nano::account_height_key (account.is_zero () ? block_a.sideband ().account : account, block_a.sideband ().height);
+	}
 
 	template <typename T>
 	std::shared_ptr<nano::block> block_random (nano::transaction const & transaction_a, tables table_a)
@@ -0,0 +1,76 @@
+#include <kizunano/secure/bulk_writer.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+nano::bulk_writer::bulk_writer (nano::block_store & store_a, nano::tables table_a, size_t batch_size_a) :
+store (store_a),
+table (table_a),
+batch_size (batch_size_a)
+{
+}
+
+void nano::bulk_writer::put (uint8_t const * key_a, size_t key_size_a, uint8_t const * value_a, size_t value_size_a)
+{
+	entry entry_l{ buffer.size (), static_cast<uint32_t> (key_size_a), static_cast<uint32_t> (value_size_a) };
+	buffer.insert (buffer.end (), key_a, key_a + key_size_a);
+	buffer.insert (buffer.end (), value_a, value_a + value_size_a);
+	if (!entries.empty () && !less (entries.back (), entry_l))
+	{
+		sorted = false;
+	}
+	entries.push_back (entry_l);
+	if (buffer.size () >= batch_size)
+	{
+		flush ();
+	}
+}
+
+bool nano::bulk_writer::less (entry const & first_a, entry const & second_a) const
+{
+	// Bytewise order with shorter keys first on a common prefix, as compared by both backends
+	auto result (std::memcmp (buffer.data () + first_a.offset, buffer.data () + second_a.offset, std::min (first_a.key_size, second_a.key_size)));
+	return result < 0 || (result == 0 && first_a.key_size < second_a.key_size);
+}
+
+bool nano::bulk_writer::flush ()
+{
+	if (!error && !entries.empty ())
+	{
+		auto start (std::chrono::steady_clock::now ());
+		if (!sorted)
+		{
+			// Stable so the last of equal keys ends up last, duplicates are then dropped keeping it
+			std::stable_sort (entries.begin (), entries.end (), [this](entry const & first_a, entry const & second_a) {
+				return less (first_a, second_a);
+			});
+		}
+		std::vector<nano::store_entry_view> views;
+		views.reserve (entries.size ());
+		for (auto i (entries.begin ()), n (entries.end ()); i != n; ++i)
+		{
+			auto next (i + 1);
+			if (next == n || less (*i, *next))
+			{
+				auto data (buffer.data () + i->offset);
+				views.push_back (nano::store_entry_view{ data, i->key_size, data + i->key_size, i->value_size });
+			}
+		}
+		error = store.table_load (table, views);
+		if (!error)
+		{
+			rows += views.size ();
+		}
+		buffer.clear ();
+		entries.clear ();
+		sorted = true;
+		elapsed += std::chrono::steady_clock::now () - start;
+	}
+	return error;
+}
+
+double nano::bulk_writer::rows_per_second () const
+{
+	auto seconds (std::chrono::duration<double> (elapsed).count ());
+	return seconds > 0 ? rows / seconds : 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <kizunano/secure/blockstore.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Buffers new entries of a table and hands them to block_store::table_load in key order, so that
+ * LMDB appends them to the last page and RocksDB ingests them as table files instead of inserting
+ * each key at a random position of the tree.
+ * Keys already in the table are overwritten. Input already in key order is not sorted again,
+ * a key queued twice in one batch keeps the last value.
+ */
+class bulk_writer final
+{
+public:
+	bulk_writer (nano::block_store &, nano::tables, size_t batch_size_a = 64 * 1024 * 1024);
+	void put (uint8_t const * key_a, size_t key_size_a, uint8_t const * value_a, size_t value_size_a);
+	/** Keys stored as their bytes, such as hashes, accounts and pending keys */
+	template <typename Key>
+	void put (Key const & key_a, std::vector<uint8_t> const & value_a)
+	{
+		put (reinterpret_cast<uint8_t const *> (&key_a), sizeof (key_a), value_a.data (), value_a.size ());
+	}
+	/** Loads queued entries into the store, also called once a batch reaches its size. Returns true on error, which is sticky */
+	bool flush ();
+	/** Entries loaded so far */
+	uint64_t rows{ 0 };
+	/** Time spent sorting and loading */
+	std::chrono::steady_clock::duration elapsed{ 0 };
+	double rows_per_second () const;
+	bool error{ false };
+
+private:
+	class entry final
+	{
+	public:
+		size_t offset;
+		uint32_t key_size;
+		uint32_t value_size;
+	};
+	bool less (entry const &, entry const &) const;
+	nano::block_store & store;
+	nano::tables table;
+	size_t batch_size;
+	std::vector<uint8_t> buffer;
+	std::vector<entry> entries;
+	bool sorted{ true };
+};
+}
@@ -341,6 +341,50 @@ nano::account const & nano::pending_key::key () const
 	return account;
 }
 
+nano::pending_amount_key::pending_amount_key (nano::account const & account_a, nano::amount const & amount_a, nano::block_hash const & hash_a) :
+account (account_a),
+amount_complement (~amount_a.number ()),
+hash (hash_a)
+{
+}
+
+bool nano::pending_amount_key::operator== (nano::pending_amount_key const & other_a) const
+{
+	return account == other_a.account && amount_complement == other_a.amount_complement && hash == other_a.hash;
+}
+
+nano::amount nano::pending_amount_key::amount () const
+{
+	return ~amount_complement.number ();
+}
+
+nano::account_height_key::account_height_key (nano::account const & account_a, uint64_t height_a) :
+account (account_a),
+height_big_endian (boost::endian::native_to_big (height_a))
+{
+}
+
+bool nano::account_height_key::operator== (nano::account_height_key const & other_a) const
+{
+	return account == other_a.account && height_big_endian == other_a.height_big_endian;
+}
+
+uint64_t nano::account_height_key::height () const
+{
+	return boost::endian::big_to_native (height_big_endian);
+}
+
+nano::delegator_key::delegator_key (nano::account const & representative_a, nano::account const & account_a) :
+representative (representative_a),
+account (account_a)
+{
+}
+
+bool nano::delegator_key::operator== (nano::delegator_key const & other_a) const
+{
+	return representative == other_a.representative && account == other_a.account;
+}
+
 nano::unchecked_info::unchecked_info (std::shared_ptr<nano::block> block_a, nano::account const & account_a, uint64_t modified_a, nano::signature_verification verified_a, bool confirmed_a) :
 block (block_a),
 account (account_a),
@@ -394,6 +438,17 @@ uint16_t nano::endpoint_key::port () const
 	return boost::endian::big_to_native (network_port);
 }
 
+nano::peer_info::peer_info (double rate_a, double failures_a) :
+rate (rate_a),
+failures (failures_a)
+{
+}
+
+bool nano::peer_info::operator== (nano::peer_info const & other_a) const
+{
+	return rate == other_a.rate && failures == other_a.failures;
+}
+
 nano::confirmation_height_info::confirmation_height_info (uint64_t confirmation_height_a, nano::block_hash const & confirmed_frontier_a) :
 height (confirmation_height_a),
 frontier (confirmed_frontier_a)
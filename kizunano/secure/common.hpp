@@ -127,6 +127,50 @@ public:
 	nano::block_hash hash{ 0 };
 };
 
+/**
+ * Key of the pending amounts index, ordering the receivable blocks of an account from the largest amount down
+ */
+class pending_amount_key final
+{
+public:
+	pending_amount_key () = default;
+	pending_amount_key (nano::account const &, nano::amount const &, nano::block_hash const &);
+	bool operator== (nano::pending_amount_key const &) const;
+	nano::amount amount () const;
+	nano::account account{ 0 };
+	/** Stored as its complement so that bytewise order puts larger amounts first */
+	nano::amount amount_complement{ 0 };
+	nano::block_hash hash{ 0 };
+};
+
+/**
+ * Key of the heights index, ordering the blocks of an account chain from the open block up
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+	account_height_key (nano::account const &, uint64_t);
+	bool operator== (nano::account_height_key const &) const;
+	uint64_t height () const;
+	nano::account account{ 0 };
+	/** Big endian so that bytewise order follows the chain */
+	uint64_t height_big_endian{ 0 };
+};
+
+/**
+ * Key of the delegators index, ordered by representative so the accounts delegating to one of them are adjacent
+ */
+class delegator_key final
+{
+public:
+	delegator_key () = default;
+	delegator_key (nano::account const &, nano::account const &);
+	bool operator== (nano::delegator_key const &) const;
+	nano::account representative{ 0 };
+	nano::account account{ 0 };
+};
+
 class endpoint_key final
 {
 public:
@@ -154,6 +198,19 @@ private:
 	uint16_t network_port{ 0 };
 };
 
+/**
+ * Bootstrap score kept with a stored peer, peers stored before scores were kept read as unscored
+ */
+class peer_info final
+{
+public:
+	peer_info () = default;
+	peer_info (double, double);
+	bool operator== (nano::peer_info const &) const;
+	double rate{ 0.0 };
+	double failures{ 0.0 };
+};
+
 enum class no_value
 {
 	dummy
@@ -1158,6 +1158,17 @@ void nano::ledger::change_latest (nano::write_transaction const & transaction_a,
 		debug_assert (cache.account_count > 0);
 		--cache.account_count;
 	}
+	if (old_a.representative != new_a.representative || old_a.head.is_zero () != new_a.head.is_zero ())
+	{
+		if (!old_a.head.is_zero ())
+		{
+			store.delegator_del (transaction_a, nano::delegator_key (old_a.representative, account_a));
+		}
+		if (!new_a.head.is_zero ())
+		{
+			store.delegator_put (transaction_a, nano::delegator_key (new_a.representative, account_a));
+		}
+	}
 }
 
 std::shared_ptr<nano::block> nano::ledger::successor (nano::transaction const & transaction_a, nano::qualified_root const & root_a)
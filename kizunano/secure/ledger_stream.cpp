@@ -0,0 +1,220 @@
+#include <kizunano/lib/blocks.hpp>
+#include <kizunano/lib/work.hpp>
+#include <kizunano/secure/blockstore.hpp>
+#include <kizunano/secure/buffer.hpp>
+#include <kizunano/secure/ledger.hpp>
+#include <kizunano/secure/ledger_stream.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+std::array<uint8_t, 4> const nano::ledger_stream::magic{ { 'k', 'l', 'b', 's' } };
+constexpr uint8_t nano::ledger_stream::version;
+constexpr size_t nano::ledger_stream::chunk_size;
+constexpr size_t nano::ledger_stream::chunk_max;
+
+namespace
+{
+uint64_t checksum (uint8_t const * data_a, size_t size_a)
+{
+	uint64_t result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result));
+	blake2b_update (&state, data_a, size_a);
+	blake2b_final (&state, &result, sizeof (result));
+	return result;
+}
+
+void write_u32 (std::ostream & stream_a, uint32_t value_a)
+{
+	boost::endian::native_to_little_inplace (value_a);
+	stream_a.write (reinterpret_cast<char const *> (&value_a), sizeof (value_a));
+}
+
+bool read_u32 (std::istream & stream_a, uint32_t & value_a)
+{
+	stream_a.read (reinterpret_cast<char *> (&value_a), sizeof (value_a));
+	boost::endian::little_to_native_inplace (value_a);
+	return !stream_a.good ();
+}
+}
+
+nano::ledger_stream::ledger_stream (nano::ledger & ledger_a) :
+ledger (ledger_a)
+{
+}
+
+bool nano::ledger_stream::export_blocks (std::ostream & stream_a)
+{
+	stream_a.write (reinterpret_cast<char const *> (magic.data ()), magic.size ());
+	stream_a.put (static_cast<char> (version));
+	auto const & genesis_hash (ledger.network_params.ledger.genesis_hash);
+	stream_a.write (reinterpret_cast<char const *> (genesis_hash.bytes.data ()), genesis_hash.bytes.size ());
+	auto error (!stream_a.good ());
+	// Height and hash of the last block written for each account
+	std::unordered_map<nano::account, std::pair<uint64_t, nano::block_hash>> written;
+	// Accounts to write up to a height, sources of the top entry are pushed above it
+	std::vector<std::pair<nano::account, uint64_t>> pending;
+	std::vector<uint8_t> chunk;
+	uint32_t chunk_count (0);
+	auto transaction (ledger.store.tx_begin_read ());
+	for (auto i (ledger.store.latest_begin (transaction)), n (ledger.store.latest_end ()); i != n && !error; ++i)
+	{
+		pending.emplace_back (i->first, i->second.block_count);
+		while (!pending.empty () && !error)
+		{
+			auto account (pending.back ().first);
+			auto & progress (written[account]);
+			if (progress.first >= pending.back ().second)
+			{
+				pending.pop_back ();
+				continue;
+			}
+			nano::block_hash hash (0);
+			if (progress.first == 0)
+			{
+				nano::account_info info;
+				if (!ledger.store.account_get (transaction, account, info))
+				{
+					hash = info.open_block;
+				}
+			}
+			else
+			{
+				hash = ledger.store.block_successor (transaction, progress.second);
+			}
+			auto block (hash.is_zero () ? nullptr : ledger.store.block_get (transaction, hash));
+			error = block == nullptr;
+			if (error)
+			{
+				error_message = "Missing block in account " + account.to_account ();
+				break;
+			}
+			auto dependency_pending (false);
+			for (auto const & dependency : ledger.dependent_blocks (transaction, *block))
+			{
+				if (!dependency.is_zero () && dependency != block->previous ())
+				{
+					auto source (ledger.store.block_get (transaction, dependency));
+					if (source != nullptr && written[source->sideband ().account].first < source->sideband ().height)
+					{
+						pending.emplace_back (source->sideband ().account, source->sideband ().height);
+						dependency_pending = true;
+					}
+				}
+			}
+			if (!dependency_pending)
+			{
+				{
+					nano::vectorstream block_stream (chunk);
+					nano::serialize_block (block_stream, *block);
+				}
+				++chunk_count;
+				++blocks;
+				progress = std::make_pair (progress.first + 1, hash);
+				if (chunk.size () >= chunk_size)
+				{
+					error = write_chunk (stream_a, chunk, chunk_count);
+					chunk.clear ();
+					chunk_count = 0;
+				}
+			}
+		}
+	}
+	if (!error && chunk_count != 0)
+	{
+		error = write_chunk (stream_a, chunk, chunk_count);
+		chunk.clear ();
+	}
+	if (!error)
+	{
+		error = write_chunk (stream_a, chunk, 0);
+	}
+	if (error && error_message.empty ())
+	{
+		error_message = "Write error";
+	}
+	return error;
+}
+
+bool nano::ledger_stream::write_chunk (std::ostream & stream_a, std::vector<uint8_t> const & chunk_a, uint32_t count_a)
+{
+	write_u32 (stream_a, count_a);
+	write_u32 (stream_a, static_cast<uint32_t> (chunk_a.size ()));
+	stream_a.write (reinterpret_cast<char const *> (chunk_a.data ()), chunk_a.size ());
+	auto checksum_l (boost::endian::native_to_little (checksum (chunk_a.data (), chunk_a.size ())));
+	stream_a.write (reinterpret_cast<char const *> (&checksum_l), sizeof (checksum_l));
+	return !stream_a.good ();
+}
+
+bool nano::ledger_stream::import_blocks (std::istream & stream_a)
+{
+	std::array<uint8_t, 4> magic_l;
+	uint8_t version_l (0);
+	nano::block_hash genesis_hash;
+	stream_a.read (reinterpret_cast<char *> (magic_l.data ()), magic_l.size ());
+	stream_a.read (reinterpret_cast<char *> (&version_l), sizeof (version_l));
+	stream_a.read (reinterpret_cast<char *> (genesis_hash.bytes.data ()), genesis_hash.bytes.size ());
+	auto error (!stream_a.good () || magic_l != magic || version_l != version);
+	if (error)
+	{
+		error_message = "Not a ledger stream or unsupported version";
+	}
+	else if (genesis_hash != ledger.network_params.ledger.genesis_hash)
+	{
+		error = true;
+		error_message = "Ledger stream belongs to a different network";
+	}
+	std::vector<uint8_t> chunk;
+	for (auto finished (false); !error && !finished;)
+	{
+		uint32_t count (0);
+		uint32_t size (0);
+		uint64_t checksum_l (0);
+		error = read_u32 (stream_a, count) || read_u32 (stream_a, size) || size > chunk_max;
+		if (!error)
+		{
+			chunk.resize (size);
+			stream_a.read (reinterpret_cast<char *> (chunk.data ()), size);
+			stream_a.read (reinterpret_cast<char *> (&checksum_l), sizeof (checksum_l));
+			error = !stream_a.good () || boost::endian::little_to_native (checksum_l) != checksum (chunk.data (), chunk.size ());
+		}
+		if (error)
+		{
+			error_message = "Truncated or corrupted chunk after " + std::to_string (blocks + skipped) + " blocks";
+			break;
+		}
+		finished = count == 0;
+		nano::bufferstream block_stream (chunk.data (), chunk.size ());
+		auto transaction (ledger.store.tx_begin_write ({ nano::tables::accounts, nano::tables::cached_counts, nano::tables::change_blocks, nano::tables::delegators, nano::tables::frontiers, nano::tables::heights, nano::tables::open_blocks, nano::tables::pending, nano::tables::pending_amounts, nano::tables::receive_blocks, nano::tables::representation, nano::tables::send_blocks, nano::tables::state_blocks }, { nano::tables::confirmation_height }));
+		for (uint32_t i (0); i < count && !error; ++i)
+		{
+			auto block (nano::deserialize_block (block_stream));
+			error = block == nullptr || nano::work_validate_entry (*block);
+			if (!error)
+			{
+				auto result (ledger.process (transaction, *block));
+				switch (result.code)
+				{
+					case nano::process_result::progress:
+						++blocks;
+						break;
+					case nano::process_result::old:
+						++skipped;
+						break;
+					default:
+						error = true;
+						break;
+				}
+			}
+			if (error)
+			{
+				error_message = "Invalid block after " + std::to_string (blocks + skipped) + " blocks" + (block != nullptr ? ": " + block->hash ().to_string () : "");
+			}
+		}
+	}
+	return error;
+}
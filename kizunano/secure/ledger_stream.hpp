@@ -0,0 +1,43 @@
+#pragma once
+
+#include <kizunano/lib/numbers.hpp>
+
+#include <array>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class ledger;
+/**
+ * Sequential stream of ledger blocks in dependency order, used to provision a node from a local file
+ * instead of bootstrapping the same ledger over the network.
+ * Layout: magic, version and genesis hash, followed by chunks of
+ * [uint32 block count][uint32 size][serialized blocks][uint64 blake2b checksum of the blocks],
+ * the final chunk being empty. Integers are little endian.
+ */
+class ledger_stream final
+{
+public:
+	explicit ledger_stream (nano::ledger &);
+	/** Writes every block of the ledger, each one after its previous block and its source, returns true on error */
+	bool export_blocks (std::ostream &);
+	/** Checks work and signatures of each block and processes it into the ledger, returns true on error */
+	bool import_blocks (std::istream &);
+	/** Blocks written by export_blocks or added by import_blocks */
+	uint64_t blocks{ 0 };
+	/** Blocks import_blocks found already in the ledger */
+	uint64_t skipped{ 0 };
+	std::string error_message;
+	static std::array<uint8_t, 4> const magic;
+	static uint8_t constexpr version = 1;
+	/** Serialized bytes after which a chunk is closed, also the upper bound accepted when importing */
+	static size_t constexpr chunk_size = 1024 * 1024;
+	static size_t constexpr chunk_max = 4 * chunk_size;
+
+private:
+	bool write_chunk (std::ostream &, std::vector<uint8_t> const &, uint32_t);
+	nano::ledger & ledger;
+};
+}
@@ -4,8 +4,206 @@
 #include <kizunano/secure/common.hpp>
 #include <kizunano/secure/network_filter.hpp>
 
-nano::network_filter::network_filter (size_t size_a) :
-items (size_a, nano::uint128_t{ 0 })
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+/**
+ * SipHash 2/4/128 over several messages at once, one message per lane.
+ * Full 8-byte words are compressed in lockstep while every lane still has one, the remainder of each message is finished per lane.
+ * Produces the same digests as CryptoPP::SipHash<2, 4, true>.
+ */
+class siphash_lanes final
+{
+public:
+	static constexpr size_t width = 4;
+
+	siphash_lanes (uint64_t k0_a, uint64_t k1_a, size_t count_a) :
+	count (count_a)
+	{
+		debug_assert (count_a <= width);
+		v0.fill (k0_a ^ 0x736f6d6570736575ULL);
+		v1.fill (k1_a ^ 0x646f72616e646f6dULL ^ 0xee);
+		v2.fill (k0_a ^ 0x6c7967656e657261ULL);
+		v3.fill (k1_a ^ 0x7465646279746573ULL);
+	}
+
+	void digest (std::pair<uint8_t const *, size_t> const * items_a, nano::uint128_union * digests_a)
+	{
+		size_t common_words (std::numeric_limits<size_t>::max ());
+		for (size_t lane (0); lane < count; ++lane)
+		{
+			common_words = std::min (common_words, items_a[lane].second / 8);
+		}
+		for (size_t word (0); word < common_words; ++word)
+		{
+			std::array<uint64_t, width> m{};
+			for (size_t lane (0); lane < count; ++lane)
+			{
+				m[lane] = load (items_a[lane].first + word * 8);
+			}
+			compress (m);
+		}
+		for (size_t lane (0); lane < count; ++lane)
+		{
+			auto const & item (items_a[lane]);
+			uint64_t state[4] = { v0[lane], v1[lane], v2[lane], v3[lane] };
+			auto words (item.second / 8);
+			for (auto word (common_words); word < words; ++word)
+			{
+				compress_one (state, load (item.first + word * 8));
+			}
+			uint64_t last (static_cast<uint64_t> (item.second) << 56);
+			auto tail (item.first + words * 8);
+			for (size_t i (0), n (item.second % 8); i < n; ++i)
+			{
+				last |= static_cast<uint64_t> (tail[i]) << (8 * i);
+			}
+			compress_one (state, last);
+			state[2] ^= 0xee;
+			rounds (state, 4);
+			auto first_half (state[0] ^ state[1] ^ state[2] ^ state[3]);
+			state[1] ^= 0xdd;
+			rounds (state, 4);
+			auto second_half (state[0] ^ state[1] ^ state[2] ^ state[3]);
+			store (digests_a[lane].bytes.data (), first_half);
+			store (digests_a[lane].bytes.data () + 8, second_half);
+		}
+	}
+
+private:
+	static uint64_t load (uint8_t const * bytes_a)
+	{
+		uint64_t result;
+		std::memcpy (&result, bytes_a, sizeof (result));
+		return boost::endian::little_to_native (result);
+	}
+
+	static void store (uint8_t * bytes_a, uint64_t value_a)
+	{
+		value_a = boost::endian::native_to_little (value_a);
+		std::memcpy (bytes_a, &value_a, sizeof (value_a));
+	}
+
+	static uint64_t rotl (uint64_t value_a, int bits_a)
+	{
+		return (value_a << bits_a) | (value_a >> (64 - bits_a));
+	}
+
+	static void rounds (uint64_t (&v_a)[4], int count_a)
+	{
+		for (auto i (0); i < count_a; ++i)
+		{
+			v_a[0] += v_a[1];
+			v_a[1] = rotl (v_a[1], 13);
+			v_a[1] ^= v_a[0];
+			v_a[0] = rotl (v_a[0], 32);
+			v_a[2] += v_a[3];
+			v_a[3] = rotl (v_a[3], 16);
+			v_a[3] ^= v_a[2];
+			v_a[0] += v_a[3];
+			v_a[3] = rotl (v_a[3], 21);
+			v_a[3] ^= v_a[0];
+			v_a[2] += v_a[1];
+			v_a[1] = rotl (v_a[1], 17);
+			v_a[1] ^= v_a[2];
+			v_a[2] = rotl (v_a[2], 32);
+		}
+	}
+
+	static void compress_one (uint64_t (&v_a)[4], uint64_t m_a)
+	{
+		v_a[3] ^= m_a;
+		rounds (v_a, 2);
+		v_a[0] ^= m_a;
+	}
+
+#ifdef __AVX2__
+	static __m256i rotl (__m256i value_a, int bits_a)
+	{
+		return _mm256_or_si256 (_mm256_slli_epi64 (value_a, bits_a), _mm256_srli_epi64 (value_a, 64 - bits_a));
+	}
+
+	void compress (std::array<uint64_t, width> const & m_a)
+	{
+		static_assert (width == 4, "AVX2 path compresses four lanes");
+		auto m (_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (m_a.data ())));
+		auto a (_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (v0.data ())));
+		auto b (_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (v1.data ())));
+		auto c (_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (v2.data ())));
+		auto d (_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (v3.data ())));
+		d = _mm256_xor_si256 (d, m);
+		for (auto i (0); i < 2; ++i)
+		{
+			a = _mm256_add_epi64 (a, b);
+			b = _mm256_xor_si256 (rotl (b, 13), a);
+			a = rotl (a, 32);
+			c = _mm256_add_epi64 (c, d);
+			d = _mm256_xor_si256 (rotl (d, 16), c);
+			a = _mm256_add_epi64 (a, d);
+			d = _mm256_xor_si256 (rotl (d, 21), a);
+			c = _mm256_add_epi64 (c, b);
+			b = _mm256_xor_si256 (rotl (b, 17), c);
+			c = rotl (c, 32);
+		}
+		a = _mm256_xor_si256 (a, m);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i *> (v0.data ()), a);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i *> (v1.data ()), b);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i *> (v2.data ()), c);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i *> (v3.data ()), d);
+	}
+#else
+	/** Structure-of-arrays form of compress_one which the compiler can vectorize across lanes */
+	void compress (std::array<uint64_t, width> const & m_a)
+	{
+		for (size_t lane (0); lane < width; ++lane)
+		{
+			v3[lane] ^= m_a[lane];
+		}
+		for (auto i (0); i < 2; ++i)
+		{
+			for (size_t lane (0); lane < width; ++lane)
+			{
+				v0[lane] += v1[lane];
+				v1[lane] = rotl (v1[lane], 13) ^ v0[lane];
+				v0[lane] = rotl (v0[lane], 32);
+				v2[lane] += v3[lane];
+				v3[lane] = rotl (v3[lane], 16) ^ v2[lane];
+				v0[lane] += v3[lane];
+				v3[lane] = rotl (v3[lane], 21) ^ v0[lane];
+				v2[lane] += v1[lane];
+				v1[lane] = rotl (v1[lane], 17) ^ v2[lane];
+				v2[lane] = rotl (v2[lane], 32);
+			}
+		}
+		for (size_t lane (0); lane < width; ++lane)
+		{
+			v0[lane] ^= m_a[lane];
+		}
+	}
+#endif
+
+	size_t count;
+	std::array<uint64_t, width> v0;
+	std::array<uint64_t, width> v1;
+	std::array<uint64_t, width> v2;
+	std::array<uint64_t, width> v3;
+};
+}
+
+nano::network_filter::network_filter (size_t size_a, size_t stripes_a) :
+items (size_a, nano::uint128_t{ 0 }),
+stripes (std::max<size_t> (1, std::min (stripes_a, size_a))),
+stripe_size (std::max<size_t> (1, (size_a + stripes.size () - 1) / stripes.size ()))
 {
 	nano::random_pool::generate_block (key, key.size ());
 }
@@ -14,25 +212,70 @@ bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano:
 {
 	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
+	auto existed (insert (digest));
+	if (digest_a)
+	{
+		*digest_a = digest;
+	}
+	return existed;
+}
 
-	nano::lock_guard<std::mutex> lock (mutex);
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
+bool nano::network_filter::check (uint8_t const * bytes_a, size_t count_a)
+{
+	auto digest (hash (bytes_a, count_a));
+	nano::lock_guard<std::mutex> lock (stripe_mutex (index (digest)));
+	return get_element (digest) == digest;
+}
+
+std::vector<bool> nano::network_filter::apply (std::vector<std::pair<uint8_t const *, size_t>> const & items_a, std::vector<nano::uint128_t> * digests_a)
+{
+	std::vector<nano::uint128_union> digests (items_a.size ());
+	uint64_t k0, k1;
+	std::memcpy (&k0, key.data (), sizeof (k0));
+	std::memcpy (&k1, key.data () + sizeof (k0), sizeof (k1));
+	k0 = boost::endian::little_to_native (k0);
+	k1 = boost::endian::little_to_native (k1);
+	for (size_t i (0); i < items_a.size (); i += siphash_lanes::width)
 	{
-		// Replace likely old element with a new one
-		element = digest;
+		auto count (std::min (siphash_lanes::width, items_a.size () - i));
+		siphash_lanes lanes (k0, k1, count);
+		lanes.digest (items_a.data () + i, digests.data () + i);
 	}
-	if (digest_a)
+	std::vector<bool> result;
+	result.reserve (items_a.size ());
+	if (digests_a)
 	{
-		*digest_a = digest;
+		digests_a->clear ();
+		digests_a->reserve (items_a.size ());
+	}
+	for (auto const & digest : digests)
+	{
+		auto number (digest.number ());
+		result.push_back (insert (number));
+		if (digests_a)
+		{
+			digests_a->push_back (number);
+		}
+	}
+	return result;
+}
+
+bool nano::network_filter::insert (nano::uint128_t const & digest_a)
+{
+	nano::lock_guard<std::mutex> lock (stripe_mutex (index (digest_a)));
+	auto & element (get_element (digest_a));
+	bool existed (element == digest_a);
+	if (!existed)
+	{
+		// Replace likely old element with a new one
+		element = digest_a;
 	}
 	return existed;
 }
 
-void nano::network_filter::clear (nano::uint128_t const & digest_a)
+void nano::network_filter::erase (nano::uint128_t const & digest_a)
 {
-	nano::lock_guard<std::mutex> lock (mutex);
+	nano::lock_guard<std::mutex> lock (stripe_mutex (index (digest_a)));
 	auto & element (get_element (digest_a));
 	if (element == digest_a)
 	{
@@ -40,16 +283,16 @@ void nano::network_filter::clear (nano::uint128_t const & digest_a)
 	}
 }
 
+void nano::network_filter::clear (nano::uint128_t const & digest_a)
+{
+	erase (digest_a);
+}
+
 void nano::network_filter::clear (std::vector<nano::uint128_t> const & digests_a)
 {
-	nano::lock_guard<std::mutex> lock (mutex);
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = nano::uint128_t{ 0 };
-		}
+		erase (digest);
 	}
 }
 
@@ -66,8 +309,13 @@ void nano::network_filter::clear (OBJECT const & object_a)
 
 void nano::network_filter::clear ()
 {
-	nano::lock_guard<std::mutex> lock (mutex);
-	items.assign (items.size (), nano::uint128_t{ 0 });
+	for (size_t i (0); i < stripes.size (); ++i)
+	{
+		nano::lock_guard<std::mutex> lock (stripes[i].mutex);
+		auto begin (std::min (items.size (), i * stripe_size));
+		auto end (std::min (items.size (), begin + stripe_size));
+		std::fill (items.begin () + begin, items.begin () + end, nano::uint128_t{ 0 });
+	}
 }
 
 template <typename OBJECT>
@@ -81,12 +329,23 @@ nano::uint128_t nano::network_filter::hash (OBJECT const & object_a) const
 	return hash (bytes.data (), bytes.size ());
 }
 
-nano::uint128_t & nano::network_filter::get_element (nano::uint128_t const & hash_a)
+size_t nano::network_filter::index (nano::uint128_t const & hash_a) const
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (items.size () > 0);
-	size_t index (hash_a % items.size ());
-	return items[index];
+	return static_cast<size_t> (hash_a % items.size ());
+}
+
+std::mutex & nano::network_filter::stripe_mutex (size_t index_a)
+{
+	debug_assert (index_a / stripe_size < stripes.size ());
+	return stripes[index_a / stripe_size].mutex;
+}
+
+nano::uint128_t & nano::network_filter::get_element (nano::uint128_t const & hash_a)
+{
+	auto index_l (index (hash_a));
+	debug_assert (!stripe_mutex (index_l).try_lock ());
+	return items[index_l];
 }
 
 nano::uint128_t nano::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
@@ -7,6 +7,8 @@
 #include <crypto/cryptopp/siphash.h>
 
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace nano
 {
@@ -14,13 +16,18 @@ namespace nano
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
  * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
+ * The filter is split into contiguous stripes, each guarded by its own mutex, so that concurrent callers only contend when their digests land in the same stripe.
  * @note This class is thread-safe.
  */
 class network_filter final
 {
 public:
 	network_filter () = delete;
-	network_filter (size_t size_a);
+	/**
+	 * @param size_a number of elements in the filter
+	 * @param stripes_a number of independently locked stripes, capped by \p size_a
+	 */
+	network_filter (size_t size_a, size_t stripes_a = 64);
 	/**
 	 * Reads \p count_a bytes starting from \p bytes_a and inserts the siphash digest in the filter.
 	 * @param \p digest_a if given, will be set to the resulting siphash digest
@@ -29,6 +36,20 @@ public:
 	 **/
 	bool apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a = nullptr);
 
+	/**
+	 * Reads \p count_a bytes starting from \p bytes_a and looks up the siphash digest, without inserting it.
+	 * @warning will read out of bounds if [ \p bytes_a, \p bytes_a + \p count_a ] is not a valid range
+	 * @return a boolean representing the existence of the hash in the filter.
+	 **/
+	bool check (uint8_t const * bytes_a, size_t count_a);
+
+	/**
+	 * Batch version of apply. Digests \p items_a, given as pointer and size pairs, several at a time and then inserts them in order.
+	 * @param \p digests_a if given, will be filled with the resulting siphash digests
+	 * @return for each item, the previous existence of its hash in the filter, including earlier items of the same batch.
+	 **/
+	std::vector<bool> apply (std::vector<std::pair<uint8_t const *, size_t>> const & items_a, std::vector<nano::uint128_t> * digests_a = nullptr);
+
 	/**
 	 * Sets the corresponding element in the filter to zero, if it matches \p digest_a exactly.
 	 **/
@@ -65,13 +86,36 @@ public:
 private:
 	using siphash_t = CryptoPP::SipHash<2, 4, true>;
 
+	/**
+	 * Followed by a full cache line of padding so that the mutexes of neighbouring stripes never share a line.
+	 * Padding rather than alignas, as the vector holding the stripes does not honour over-alignment before C++17.
+	 */
+	class stripe final
+	{
+	public:
+		std::mutex mutex;
+		char padding[64];
+	};
+
+	/** @return index of the element with key \p hash_a */
+	size_t index (nano::uint128_t const & hash_a) const;
+
+	/** @return the mutex guarding the element at \p index_a */
+	std::mutex & stripe_mutex (size_t index_a);
+
 	/**
 	 * Get element from digest.
-	 * @note must have a lock on mutex
+	 * @note must have a lock on the stripe mutex of the element
 	 * @return a reference to the element with key \p hash_a
 	 **/
 	nano::uint128_t & get_element (nano::uint128_t const & hash_a);
 
+	/** Inserts \p digest_a in the filter, returning its previous existence */
+	bool insert (nano::uint128_t const & digest_a);
+
+	/** Sets the element of \p digest_a to zero if it matches exactly */
+	void erase (nano::uint128_t const & digest_a);
+
 	/**
 	 * Hashes \p count_a bytes starting from \p bytes_a .
 	 * @return the siphash digest of the contents in \p bytes_a .
@@ -80,6 +124,7 @@ private:
 
 	std::vector<nano::uint128_t> items;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	std::mutex mutex;
+	std::vector<stripe> stripes;
+	size_t stripe_size;
 };
 }
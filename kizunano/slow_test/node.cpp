@@ -1861,3 +1861,207 @@ TEST (node, mass_block_new)
 	process_all (receive_blocks);
 	std::cout << "Receive blocks time: " << timer.stop ().count () << " " << timer.unit () << "\n\n";
 }
+
+namespace
+{
+/** Bytes of block traffic, full publishes and announcements, sent across a network of nodes per block confirmed everywhere */
+void block_traffic_per_block (bool announcements_a, double & result_a)
+{
+	nano::system system;
+	auto const node_count (8);
+	auto const block_count (50);
+	for (auto i (0); i < node_count; ++i)
+	{
+		nano::node_config node_config (nano::get_available_port (), system.logging);
+		node_config.block_announcements = announcements_a;
+		node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+		system.add_node (node_config);
+	}
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	nano::keypair key;
+	for (auto i (0); i < block_count; ++i)
+	{
+		ASSERT_NE (nullptr, system.wallet (0)->send_action (nano::test_genesis_key.pub, key.pub, 1));
+	}
+	system.deadline_set (120s);
+	while (std::any_of (system.nodes.begin (), system.nodes.end (), [block_count](std::shared_ptr<nano::node> const & node_a) { return node_a->ledger.cache.cemented_count < block_count + 1; }))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	uint64_t bytes (0);
+	for (auto const & node : system.nodes)
+	{
+		bytes += node->stats.count (nano::stat::type::bandwidth, nano::stat::detail::publish, nano::stat::dir::out);
+		bytes += node->stats.count (nano::stat::type::bandwidth, nano::stat::detail::block_announce, nano::stat::dir::out);
+	}
+	result_a = static_cast<double> (bytes) / block_count;
+}
+}
+
+TEST (node, block_announce_bandwidth)
+{
+	double full (0);
+	double announced (0);
+	block_traffic_per_block (false, full);
+	block_traffic_per_block (true, announced);
+	std::cout << boost::str (boost::format ("Block traffic per confirmed block: %1% bytes with full blocks, %2% bytes with block announcements\n") % full % announced);
+	ASSERT_LT (announced, full);
+}
+
+namespace
+{
+/** Forwards TCP connections to a target, delaying data by a fixed latency in each direction */
+class latency_proxy final
+{
+public:
+	latency_proxy (nano::tcp_endpoint const & target_a, std::chrono::milliseconds latency_a) :
+	acceptor (io_ctx, nano::tcp_endpoint (boost::asio::ip::address_v6::loopback (), 0)),
+	work (boost::asio::make_work_guard (io_ctx)),
+	target (target_a),
+	latency (latency_a)
+	{
+		accept ();
+		thread = std::thread ([this]() { io_ctx.run (); });
+	}
+	~latency_proxy ()
+	{
+		work.reset ();
+		io_ctx.stop ();
+		thread.join ();
+	}
+	nano::endpoint endpoint () const
+	{
+		return nano::endpoint (acceptor.local_endpoint ().address (), acceptor.local_endpoint ().port ());
+	}
+
+private:
+	using socket_ptr = std::shared_ptr<boost::asio::ip::tcp::socket>;
+	class pipe final : public std::enable_shared_from_this<pipe>
+	{
+	public:
+		pipe (socket_ptr from_a, socket_ptr to_a, std::chrono::milliseconds latency_a) :
+		from (from_a),
+		to (to_a),
+		latency (latency_a),
+		timer (from_a->get_executor ())
+		{
+		}
+		void read ()
+		{
+			auto this_l (shared_from_this ());
+			auto buffer (std::make_shared<std::vector<uint8_t>> (16 * 1024));
+			from->async_read_some (boost::asio::buffer (*buffer), [this_l, buffer](boost::system::error_code const & ec, size_t size_a) {
+				if (!ec)
+				{
+					buffer->resize (size_a);
+					this_l->queue.emplace_back (std::chrono::steady_clock::now () + this_l->latency, buffer);
+					if (this_l->queue.size () == 1)
+					{
+						this_l->write ();
+					}
+					this_l->read ();
+				}
+				else
+				{
+					boost::system::error_code ignored;
+					this_l->to->close (ignored);
+				}
+			});
+		}
+		void write ()
+		{
+			auto this_l (shared_from_this ());
+			timer.expires_at (queue.front ().first);
+			timer.async_wait ([this_l](boost::system::error_code const &) {
+				boost::asio::async_write (*this_l->to, boost::asio::buffer (*this_l->queue.front ().second), [this_l](boost::system::error_code const & ec, size_t) {
+					this_l->queue.pop_front ();
+					if (!ec && !this_l->queue.empty ())
+					{
+						this_l->write ();
+					}
+				});
+			});
+		}
+		socket_ptr from;
+		socket_ptr to;
+		std::chrono::milliseconds latency;
+		boost::asio::steady_timer timer;
+		std::deque<std::pair<std::chrono::steady_clock::time_point, std::shared_ptr<std::vector<uint8_t>>>> queue;
+	};
+	void accept ()
+	{
+		auto client (std::make_shared<boost::asio::ip::tcp::socket> (io_ctx));
+		acceptor.async_accept (*client, [this, client](boost::system::error_code const & ec) {
+			if (!ec)
+			{
+				auto server (std::make_shared<boost::asio::ip::tcp::socket> (io_ctx));
+				server->async_connect (target, [this, client, server](boost::system::error_code const & ec) {
+					if (!ec)
+					{
+						std::make_shared<pipe> (client, server, latency)->read ();
+						std::make_shared<pipe> (server, client, latency)->read ();
+					}
+				});
+				accept ();
+			}
+		});
+	}
+	boost::asio::io_context io_ctx;
+	boost::asio::ip::tcp::acceptor acceptor;
+	boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
+	nano::tcp_endpoint target;
+	std::chrono::milliseconds latency;
+	std::thread thread;
+};
+
+/** Time taken by a legacy bootstrap of many small accounts through a connection with 25ms latency each way */
+void bootstrap_time (unsigned pipeline_a, std::chrono::milliseconds & result_a)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.enable_voting = false;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_lazy_bootstrap = true;
+	auto node0 (system.add_node (node_config, node_flags));
+	auto const account_count (100);
+	{
+		nano::genesis genesis;
+		auto latest (genesis.hash ());
+		auto transaction (node0->store.tx_begin_write ());
+		for (auto i (0); i < account_count; ++i)
+		{
+			nano::keypair key;
+			nano::state_block send (nano::test_genesis_key.pub, latest, nano::test_genesis_key.pub, nano::genesis_amount - i - 1, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (latest));
+			ASSERT_EQ (nano::process_result::progress, node0->ledger.process (transaction, send).code);
+			latest = send.hash ();
+			nano::state_block open (key.pub, 0, key.pub, 1, send.hash (), key.prv, key.pub, *system.work.generate (key.pub));
+			ASSERT_EQ (nano::process_result::progress, node0->ledger.process (transaction, open).code);
+		}
+	}
+	latency_proxy proxy (node0->bootstrap.endpoint (), 25ms);
+	node_config.peering_port = nano::get_available_port ();
+	node_config.bootstrap_pull_pipeline = pipeline_a;
+	auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::unique_path (), system.alarm, node_config, system.work, node_flags));
+	auto start (std::chrono::steady_clock::now ());
+	node1->bootstrap_initiator.bootstrap (proxy.endpoint (), false);
+	system.deadline_set (120s);
+	while (node1->ledger.cache.block_count < node0->ledger.cache.block_count)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	result_a = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+	node1->stop ();
+}
+}
+
+TEST (bootstrap, pull_pipeline_latency)
+{
+	std::chrono::milliseconds single (0);
+	std::chrono::milliseconds pipelined (0);
+	bootstrap_time (1, single);
+	bootstrap_time (8, pipelined);
+	std::cout << boost::str (boost::format ("Bootstrap through 50ms round trips: %1% ms with one pull per connection, %2% ms with 8 pipelined pulls\n") % single.count () % pipelined.count ());
+	ASSERT_LT (pipelined, single);
+}